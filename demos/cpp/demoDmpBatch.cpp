@@ -0,0 +1,93 @@
+/**
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <chrono>
+#include <cstdlib>
+#include <eigen3/Eigen/Core>
+#include <fstream>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include <string>
+
+#include "dmp/Dmp.hpp"
+
+using namespace std;
+using namespace Eigen;
+using namespace nlohmann;
+using namespace DmpBbo;
+
+int main(int n_args, char** args)
+{
+  string filename_dmp = "../demos/cpp/json/Dmp_for_cpp.json";
+  ifstream file(filename_dmp);
+  if (file.fail()) {
+    cerr << "ERROR: Could not find file: " << filename_dmp << endl;
+    return -1;
+  }
+  Dmp* dmp = json::parse(file).get<Dmp*>();
+
+  int n_samples = 100;
+  if (n_args > 1) n_samples = atoi(args[1]);
+  int n_time_steps = 500;
+  VectorXd ts = VectorXd::LinSpaced(n_time_steps, 0.0, 1.2 * dmp->tau());
+
+  // Sample parameter vectors around the current one, as in an optimization
+  // update.
+  VectorXd mean;
+  dmp->getLinearParameterVector(mean);
+  MatrixXd samples = mean.transpose().replicate(n_samples, 1);
+  samples += 10.0 * MatrixXd::Random(n_samples, mean.size());
+
+  for (string integration : {"EULER", "EXACT_FOH"}) {
+    cout << "* " << integration << " (" << n_samples << " samples, "
+         << n_time_steps << " time steps)" << endl;
+    dmp->set_analytical_solution_integration(integration);
+
+    // One analytical solution per sample
+    int D = dmp->dim_y();
+    MatrixXd ys_loop(n_time_steps, n_samples * D);
+    MatrixXd xs, xds, forcing_terms, fa_outputs;
+    auto start = chrono::steady_clock::now();
+    for (int i_sample = 0; i_sample < n_samples; i_sample++) {
+      dmp->setLinearParameterVector(samples.row(i_sample));
+      dmp->analyticalSolution(ts, xs, xds, forcing_terms, fa_outputs);
+      ys_loop.middleCols(i_sample * D, D) = xs.leftCols(D);
+    }
+    double time_loop =
+        chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    // All samples at once. The first call also computes the cached features.
+    MatrixXd ys, yds, ydds;
+    dmp->analyticalSolutionBatch(ts, samples, ys, yds, ydds);
+    start = chrono::steady_clock::now();
+    dmp->analyticalSolutionBatch(ts, samples, ys, yds, ydds);
+    double time_batch =
+        chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    double max_diff = (ys - ys_loop).cwiseAbs().maxCoeff();
+    cout << "  max |y_batch - y_loop| = " << max_diff << endl;
+    cout << "  time loop  : " << time_loop << "s" << endl;
+    cout << "  time batch : " << time_batch << "s" << endl;
+  }
+
+  delete dmp;
+
+  return 0;
+}
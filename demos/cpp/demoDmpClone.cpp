@@ -0,0 +1,116 @@
+/**
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <chrono>
+#include <cstdlib>
+#include <eigen3/Eigen/Core>
+#include <fstream>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+
+#include "dmp/Dmp.hpp"
+
+using namespace std;
+using namespace Eigen;
+using namespace nlohmann;
+using namespace DmpBbo;
+
+int main(int n_args, char** args)
+{
+  string filename_dmp = "../demos/cpp/json/Dmp_for_cpp.json";
+  ifstream file(filename_dmp);
+  if (file.fail()) {
+    cerr << "ERROR: Could not find file: " << filename_dmp << endl;
+    return -1;
+  }
+  Dmp* dmp = json::parse(file).get<Dmp*>();
+
+  int n_agents = 1000;
+  if (n_args > 1) n_agents = atoi(args[1]);
+
+  cout << "* Cloning the Dmp for " << n_agents << " agents." << endl;
+  auto start = chrono::steady_clock::now();
+  vector<Dmp*> agents(n_agents);
+  for (int i_agent = 0; i_agent < n_agents; i_agent++)
+    agents[i_agent] = dmp->clone();
+  double time_clone =
+      chrono::duration<double>(chrono::steady_clock::now() - start).count();
+  cout << "  time per clone : " << time_clone / n_agents << "s" << endl;
+
+  // Each agent has its own goal
+  int D = dmp->dim_y();
+  MatrixXd y_attrs = MatrixXd::Random(n_agents, D);
+  for (int i_agent = 0; i_agent < n_agents; i_agent++) {
+    VectorXd y_attr = y_attrs.row(i_agent);
+    agents[i_agent]->set_y_attr(y_attr);
+  }
+
+  // Integrate all agents
+  double dt = 0.01;
+  int n_steps = 100;
+  MatrixXd xs(dmp->dim(), n_agents);
+  MatrixXd xds(dmp->dim(), n_agents);
+  VectorXd x(dmp->dim());
+  VectorXd xd(dmp->dim());
+  for (int i_agent = 0; i_agent < n_agents; i_agent++) {
+    agents[i_agent]->integrateStart(x, xd);
+    xs.col(i_agent) = x;
+  }
+  for (int i_step = 0; i_step < n_steps; i_step++) {
+    for (int i_agent = 0; i_agent < n_agents; i_agent++) {
+      agents[i_agent]->integrateStep(dt, xs.col(i_agent), x, xd);
+      xs.col(i_agent) = x;
+    }
+  }
+
+  // Compare the last agent to the original Dmp with the same goal
+  int last = n_agents - 1;
+  VectorXd y_attr = y_attrs.row(last);
+  dmp->set_y_attr(y_attr);
+  dmp->integrateStart(x, xd);
+  for (int i_step = 0; i_step < n_steps; i_step++)
+    dmp->integrateStep(dt, x, x, xd);
+  cout << "  max |x_clone - x_original| = "
+       << (xs.col(last) - x).cwiseAbs().maxCoeff() << endl;
+
+  // Changing the parameters of a clone does not affect the others
+  VectorXd parameters;
+  agents[0]->getLinearParameterVector(parameters);
+  agents[0]->setLinearParameterVector(2.0 * parameters);
+  cout << "* Shared function approximator after changing clone 0: "
+       << (agents[0]->function_approximator(0) ==
+                   agents[1]->function_approximator(0)
+               ? "yes"
+               : "no")
+       << endl;
+  cout << "  Clone 1 and 2 still share: "
+       << (agents[1]->function_approximator(0) ==
+                   agents[2]->function_approximator(0)
+               ? "yes"
+               : "no")
+       << endl;
+
+  for (int i_agent = 0; i_agent < n_agents; i_agent++) delete agents[i_agent];
+  delete dmp;
+
+  return 0;
+}
@@ -0,0 +1,112 @@
+/**
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define EIGEN_RUNTIME_NO_MALLOC  // Enable runtime tests for allocations
+
+#include <chrono>
+#include <eigen3/Eigen/Core>
+#include <fstream>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include <string>
+
+#include "dmp/Dmp.hpp"
+#include "eigenutils/eigen_realtime_check.hpp"
+
+using namespace std;
+using namespace Eigen;
+using namespace nlohmann;
+using namespace DmpBbo;
+
+int main(int n_args, char** args)
+{
+  string filename_dmp = "../demos/cpp/json/Dmp_for_cpp.json";
+  ifstream file(filename_dmp);
+  if (file.fail()) {
+    cerr << "ERROR: Could not find file: " << filename_dmp << endl;
+    return -1;
+  }
+  Dmp* dmp = json::parse(file).get<Dmp*>();
+
+  // Integrate at 500Hz, output at 4kHz
+  double dt_integrate = 1.0 / 500.0;
+  int n_outputs_per_step = 8;
+  double dt_output = dt_integrate / n_outputs_per_step;
+  int n_steps = floor(1.2 * dmp->tau() / dt_integrate);
+
+  VectorXd x(dmp->dim(), 1);
+  VectorXd xd(dmp->dim(), 1);
+  VectorXd x_interp(dmp->dim(), 1);
+  VectorXd xd_interp(dmp->dim(), 1);
+  VectorXd y(dmp->dim_y(), 1);
+  VectorXd yd(dmp->dim_y(), 1);
+  VectorXd ydd(dmp->dim_y(), 1);
+
+  int n_outputs = n_steps * n_outputs_per_step;
+  MatrixXd ys_dense(n_outputs, dmp->dim_y());
+  MatrixXd ys_full(n_outputs, dmp->dim_y());
+
+  cout << "* Integrating at " << 1.0 / dt_integrate << "Hz, output at "
+       << 1.0 / dt_output << "Hz (dense output)." << endl;
+  double max_error_estimate = 0.0;
+  auto start = chrono::steady_clock::now();
+  dmp->integrateStart(x, xd);
+  {
+    ENTERING_REAL_TIME_CRITICAL_CODE
+    for (int i_step = 0; i_step < n_steps; i_step++) {
+      dmp->integrateStepRungeKutta(dt_integrate, x, x, xd);
+      max_error_estimate =
+          max(max_error_estimate, dmp->interpolateStepErrorEstimate());
+      for (int i_out = 0; i_out < n_outputs_per_step; i_out++) {
+        dmp->interpolateStep((i_out + 1) * dt_output, x_interp, xd_interp);
+        // Convert complete DMP state to end-eff state
+        dmp->stateAsPosVelAcc(x_interp, xd_interp, y, yd, ydd);
+        ys_dense.row(i_step * n_outputs_per_step + i_out) = y;
+      }
+    }
+    EXITING_REAL_TIME_CRITICAL_CODE
+  }
+  double time_dense =
+      chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+  cout << "* Integrating at " << 1.0 / dt_output << "Hz." << endl;
+  start = chrono::steady_clock::now();
+  dmp->integrateStart(x, xd);
+  {
+    ENTERING_REAL_TIME_CRITICAL_CODE
+    for (int i_out = 0; i_out < n_outputs; i_out++) {
+      dmp->integrateStepRungeKutta(dt_output, x, x, xd);
+      dmp->stateAsPosVelAcc(x, xd, y, yd, ydd);
+      ys_full.row(i_out) = y;
+    }
+    EXITING_REAL_TIME_CRITICAL_CODE
+  }
+  double time_full =
+      chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+  double max_diff = (ys_dense - ys_full).cwiseAbs().maxCoeff();
+  cout << "  max |y_dense - y_full|   = " << max_diff << endl;
+  cout << "  max error estimate       = " << max_error_estimate << endl;
+  cout << "  time dense / time full   = " << time_dense << "s / " << time_full
+       << "s" << endl;
+
+  delete dmp;
+
+  return 0;
+}
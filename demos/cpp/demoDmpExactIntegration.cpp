@@ -0,0 +1,110 @@
+/**
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define EIGEN_RUNTIME_NO_MALLOC  // Enable runtime tests for allocations
+
+#include <chrono>
+#include <eigen3/Eigen/Core>
+#include <fstream>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <thread>
+
+#include "dmp/Dmp.hpp"
+#include "eigenutils/eigen_realtime_check.hpp"
+
+using namespace std;
+using namespace Eigen;
+using namespace nlohmann;
+using namespace DmpBbo;
+
+/** Compute the analytical solution, and return the duration.
+ * \param[in] dmp The Dmp
+ * \param[in] ts Times at which to compute the solution
+ * \param[out] xs States over time
+ * \return Duration of the computation in seconds
+ */
+double timedAnalyticalSolution(const Dmp* dmp, const VectorXd& ts,
+                               MatrixXd& xs)
+{
+  MatrixXd xds;
+  auto start = chrono::steady_clock::now();
+  dmp->analyticalSolution(ts, xs, xds);
+  return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+int main(int n_args, char** args)
+{
+  string filename_dmp = "../demos/cpp/json/Dmp_for_cpp.json";
+  ifstream file(filename_dmp);
+  if (file.fail()) {
+    cerr << "ERROR: Could not find file: " << filename_dmp << endl;
+    return -1;
+  }
+  Dmp* dmp = json::parse(file).get<Dmp*>();
+  int D = dmp->dim_y();
+  double duration = 1.2 * dmp->tau();
+
+  // Reference solution on a very fine grid
+  int n_fine = 100000;
+  VectorXd ts_fine = VectorXd::LinSpaced(n_fine + 1, 0.0, duration);
+  MatrixXd xs_fine;
+  dmp->set_analytical_solution_integration("EXACT_FOH");
+  timedAnalyticalSolution(dmp, ts_fine, xs_fine);
+
+  cout << "* Accuracy (max |y - y_reference|)" << endl;
+  for (int n_coarse : {100, 1000}) {
+    VectorXd ts = VectorXd::LinSpaced(n_coarse + 1, 0.0, duration);
+    int step = n_fine / n_coarse;
+    MatrixXd ys_reference(n_coarse + 1, D);
+    for (int tt = 0; tt <= n_coarse; tt++)
+      ys_reference.row(tt) = xs_fine.block(tt * step, 0, 1, D);
+    cout << "  dt=" << duration / n_coarse;
+    for (string integration : {"EULER", "EXACT_ZOH", "EXACT_FOH"}) {
+      dmp->set_analytical_solution_integration(integration);
+      MatrixXd xs;
+      timedAnalyticalSolution(dmp, ts, xs);
+      double max_diff = (xs.leftCols(D) - ys_reference).cwiseAbs().maxCoeff();
+      cout << "  " << integration << ": " << max_diff;
+    }
+    cout << endl;
+  }
+
+  cout << "* Timing (" << n_fine << " time steps)" << endl;
+  MatrixXd xs_euler, xs_exact_serial, xs_exact_parallel;
+  dmp->set_analytical_solution_integration("EULER");
+  double time_euler = timedAnalyticalSolution(dmp, ts_fine, xs_euler);
+  cout << "  EULER                : " << time_euler << "s" << endl;
+  dmp->set_analytical_solution_integration("EXACT_FOH");
+  double time_serial = timedAnalyticalSolution(dmp, ts_fine, xs_exact_serial);
+  cout << "  EXACT_FOH (1 thread) : " << time_serial << "s" << endl;
+  int n_threads = max(2u, thread::hardware_concurrency());
+  dmp->set_analytical_solution_n_threads(n_threads);
+  double time_parallel =
+      timedAnalyticalSolution(dmp, ts_fine, xs_exact_parallel);
+  cout << "  EXACT_FOH (" << n_threads << " threads): " << time_parallel << "s"
+       << endl;
+  double max_diff = (xs_exact_parallel - xs_exact_serial).cwiseAbs().maxCoeff();
+  cout << "  max |x_parallel - x_serial| = " << max_diff << endl;
+
+  delete dmp;
+
+  return 0;
+}
@@ -0,0 +1,112 @@
+/**
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <eigen3/Eigen/Core>
+#include <fstream>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include <string>
+
+#include "dmp/Dmp.hpp"
+
+using namespace std;
+using namespace Eigen;
+using namespace nlohmann;
+using namespace DmpBbo;
+
+int main(int n_args, char** args)
+{
+  string filename_dmp = "../demos/cpp/json/Dmp_for_cpp.json";
+  ifstream file(filename_dmp);
+  if (file.fail()) {
+    cerr << "ERROR: Could not find file: " << filename_dmp << endl;
+    return -1;
+  }
+  Dmp* dmp = json::parse(file).get<Dmp*>();
+
+  int n_time_steps = 10000;
+  if (n_args > 1) n_time_steps = atoi(args[1]);
+  VectorXd ts = VectorXd::LinSpaced(n_time_steps, 0.0, 1.2 * dmp->tau());
+  int T = n_time_steps;
+  int D = dmp->dim_y();
+
+  // Reference: T x dim() states
+  MatrixXd xs, xds;
+  auto start = chrono::steady_clock::now();
+  dmp->analyticalSolution(ts, xs, xds);
+  double time_rows =
+      chrono::duration<double>(chrono::steady_clock::now() - start).count();
+  MatrixXd ys_ref = xs.leftCols(D);
+  MatrixXd yds_ref = xds.leftCols(D);
+  MatrixXd ydds_ref = xds.middleCols(D, D) / dmp->tau();
+
+  // dim() x T states, written directly in that layout
+  MatrixXd xs_cols, xds_cols;
+  start = chrono::steady_clock::now();
+  dmp->analyticalSolution(ts, xs_cols, xds_cols,
+                          DynamicalSystem::TIME_STEPS_IN_COLUMNS);
+  double time_cols =
+      chrono::duration<double>(chrono::steady_clock::now() - start).count();
+  double max_diff_cols = (xs_cols.transpose() - xs).cwiseAbs().maxCoeff();
+  max_diff_cols = max(max_diff_cols,
+                      (xds_cols.transpose() - xds).cwiseAbs().maxCoeff());
+
+  // Every other row of a larger matrix, e.g. a buffer shared with other data
+  MatrixXd buffer = MatrixXd::Zero(2 * T, dmp->dim());
+  MatrixXd buffer_d = MatrixXd::Zero(2 * T, dmp->dim());
+  typedef Stride<Dynamic, Dynamic> DynamicStride;
+  DynamicStride every_other_row(buffer.rows(), 2);
+  dmp->analyticalSolution(
+      ts, StridedMatrixMap(buffer.data(), T, dmp->dim(), every_other_row),
+      StridedMatrixMap(buffer_d.data(), T, dmp->dim(), every_other_row));
+  double max_diff_strided = 0.0;
+  for (int tt = 0; tt < T; tt++) {
+    double diff = (buffer.row(2 * tt) - xs.row(tt)).cwiseAbs().maxCoeff();
+    double diff_d = (buffer_d.row(2 * tt) - xds.row(tt)).cwiseAbs().maxCoeff();
+    max_diff_strided = max(max_diff_strided, max(diff, diff_d));
+  }
+
+  // Only the positions, velocities and accelerations
+  MatrixXd ys, yds, ydds;
+  start = chrono::steady_clock::now();
+  dmp->analyticalSolutionTrajectory(ts, ys, yds, ydds);
+  double time_trajectory =
+      chrono::duration<double>(chrono::steady_clock::now() - start).count();
+  double max_diff_trajectory = (ys - ys_ref).cwiseAbs().maxCoeff();
+  max_diff_trajectory =
+      max(max_diff_trajectory, (yds - yds_ref).cwiseAbs().maxCoeff());
+  max_diff_trajectory =
+      max(max_diff_trajectory, (ydds - ydds_ref).cwiseAbs().maxCoeff());
+
+  cout << "* " << n_time_steps << " time steps" << endl;
+  cout << "  max |xs_columns - xs|    = " << max_diff_cols << endl;
+  cout << "  max |xs_strided - xs|    = " << max_diff_strided << endl;
+  cout << "  max |ys_trajectory - ys| = " << max_diff_trajectory << endl;
+  cout << "  time T x dim()     : " << time_rows << "s" << endl;
+  cout << "  time dim() x T     : " << time_cols << "s" << endl;
+  cout << "  time y, yd and ydd : " << time_trajectory << "s" << endl;
+
+  delete dmp;
+
+  bool all_equal = (max_diff_cols == 0.0 && max_diff_strided == 0.0 &&
+                    max_diff_trajectory == 0.0);
+  return all_equal ? 0 : -1;
+}
@@ -0,0 +1,114 @@
+/**
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <chrono>
+#include <cstdlib>
+#include <eigen3/Eigen/Core>
+#include <fstream>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+
+#include "dmp/Dmp.hpp"
+#include "dmp/DmpLibrary.hpp"
+#include "eigenutils/eigen_json.hpp"
+
+using namespace std;
+using namespace Eigen;
+using namespace nlohmann;
+using namespace DmpBbo;
+
+int main(int n_args, char** args)
+{
+  string filename_dmp = "../demos/cpp/json/Dmp_for_cpp.json";
+  ifstream file(filename_dmp);
+  if (file.fail()) {
+    cerr << "ERROR: Could not find file: " << filename_dmp << endl;
+    return -1;
+  }
+  json j_dmp = json::parse(file);
+
+  int n_dmps = 5000;
+  if (n_args > 1) n_dmps = atoi(args[1]);
+  string filename_library = "/tmp/demoDmpLibrary.dmplib";
+  if (n_args > 2) filename_library = args[2];
+
+  cout << "* Writing a library with " << n_dmps << " Dmps." << endl;
+  VectorXd y_attr = j_dmp.at("_y_attr");
+  vector<json> j_dmps(n_dmps);
+  vector<string> names(n_dmps);
+  for (int i_dmp = 0; i_dmp < n_dmps; i_dmp++) {
+    j_dmps[i_dmp] = j_dmp;
+    VectorXd y_attr_i = y_attr + VectorXd::Constant(y_attr.size(), i_dmp);
+    j_dmps[i_dmp]["_y_attr"] = y_attr_i;
+    // The goal system stores its own copy of the attractor state.
+    j_dmps[i_dmp]["_goal_system"]["_x_attr"] = y_attr_i;
+    names[i_dmp] = "dmp_" + to_string(i_dmp);
+  }
+  if (!DmpLibrary::write(filename_library, names, j_dmps)) return -1;
+
+  auto start = chrono::steady_clock::now();
+  DmpLibrary* library = DmpLibrary::open(filename_library, 16);
+  double time_open =
+      chrono::duration<double>(chrono::steady_clock::now() - start).count();
+  if (library == NULL) return -1;
+  cout << "  library size  : " << library->n_bytes() / 1024 << "kB" << endl;
+  cout << "  time to open  : " << time_open << "s" << endl;
+
+  cout << "* Loading Dmps from the library." << endl;
+  int n_requests = 1000;
+  srand(0);
+  start = chrono::steady_clock::now();
+  for (int i_request = 0; i_request < n_requests; i_request++) {
+    // Mostly request a small working set, sometimes another Dmp.
+    int i_dmp = rand() % 8;
+    if (i_request % 10 == 0) i_dmp = rand() % n_dmps;
+    shared_ptr<Dmp> loaded = library->get(names[i_dmp]);
+    if (!loaded) return -1;
+  }
+  double time_get =
+      chrono::duration<double>(chrono::steady_clock::now() - start).count();
+  cout << "  time per request        : " << time_get / n_requests << "s"
+       << endl;
+  cout << "  cached Dmps             : " << library->n_cached_dmps() << endl;
+
+  // Compare loaded Dmps to Dmps parsed directly from their json.
+  VectorXd ts = VectorXd::LinSpaced(101, 0.0, 1.5);
+  MatrixXd xs, xds, xs_loaded, xds_loaded;
+  double max_diff = 0.0;
+  for (int i_dmp = 0; i_dmp < n_dmps; i_dmp += n_dmps / 10 + 1) {
+    Dmp* dmp = j_dmps[i_dmp].get<Dmp*>();
+    dmp->analyticalSolution(ts, xs, xds);
+    library->get(names[i_dmp])->analyticalSolution(ts, xs_loaded, xds_loaded);
+    max_diff = max(max_diff, (xs - xs_loaded).cwiseAbs().maxCoeff());
+    delete dmp;
+  }
+  cout << "  max |xs - xs_loaded|    : " << max_diff << endl;
+
+  int i_last = library->find(names[n_dmps - 1]);
+  cout << "  descriptors of " << library->name(i_last) << " : tau="
+       << library->tau(i_last)
+       << " y_attr=" << library->y_attr(i_last).transpose() << endl;
+
+  delete library;
+
+  return 0;
+}
@@ -0,0 +1,153 @@
+/**
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <eigen3/Eigen/Core>
+#include <fstream>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+
+#include "dmp/Dmp.hpp"
+#include "dmp/DmpLibrary.hpp"
+#include "dmp/DmpLibraryIndex.hpp"
+#include "eigenutils/eigen_json.hpp"
+
+using namespace std;
+using namespace Eigen;
+using namespace nlohmann;
+using namespace DmpBbo;
+
+int main(int n_args, char** args)
+{
+  string filename_dmp = "../demos/cpp/json/Dmp_for_cpp.json";
+  ifstream file(filename_dmp);
+  if (file.fail()) {
+    cerr << "ERROR: Could not find file: " << filename_dmp << endl;
+    return -1;
+  }
+  json j_dmp = json::parse(file);
+
+  int n_dmps = 10000;
+  if (n_args > 1) n_dmps = atoi(args[1]);
+  string filename_library = "/tmp/demoDmpLibraryIndex.dmplib";
+
+  cout << "* Writing a library with " << n_dmps << " Dmps." << endl;
+  srand(0);
+  vector<json> j_dmps(n_dmps);
+  vector<string> names(n_dmps);
+  for (int i_dmp = 0; i_dmp < n_dmps; i_dmp++) {
+    j_dmps[i_dmp] = j_dmp;
+    VectorXd y_init = VectorXd::Random(2);
+    VectorXd y_attr = VectorXd::Random(2);
+    j_dmps[i_dmp]["_y_init"] = y_init;
+    j_dmps[i_dmp]["_y_attr"] = y_attr;
+    // The goal system stores its own copy of the initial and attractor state.
+    j_dmps[i_dmp]["_goal_system"]["_x_init"] = y_init;
+    j_dmps[i_dmp]["_goal_system"]["_x_attr"] = y_attr;
+    names[i_dmp] = "dmp_" + to_string(i_dmp);
+  }
+  if (!DmpLibrary::write(filename_library, names, j_dmps)) return -1;
+  j_dmps.clear();
+
+  DmpLibrary* library = DmpLibrary::open(filename_library);
+  if (library == NULL) return -1;
+
+  // A context feature for each Dmp, e.g. the mass of the object to move.
+  MatrixXd contexts = MatrixXd::Random(n_dmps, 1);
+  VectorXd weights(6);
+  weights << 1.0, 1.0, 1.0, 1.0, 0.5, 0.1;  // y_init, y_attr, tau, context
+
+  auto start = chrono::steady_clock::now();
+  DmpLibraryIndex index(library, contexts, weights);
+  double time_build =
+      chrono::duration<double>(chrono::steady_clock::now() - start).count();
+  cout << "  time to build index : " << time_build << "s" << endl;
+
+  int n_queries = 1000;
+  int k = 5;
+  double radius = 0.2;
+  MatrixXd queries(index.dim_descriptor(), n_queries);
+  for (int i_query = 0; i_query < n_queries; i_query++)
+    queries.col(i_query) = index.descriptor(
+        VectorXd::Random(2), VectorXd::Random(2), 1.43, VectorXd::Random(1));
+
+  cout << "* Querying the index." << endl;
+  vector<vector<int> > nearest(n_queries), within(n_queries);
+  vector<double> distances;
+  start = chrono::steady_clock::now();
+  for (int i_query = 0; i_query < n_queries; i_query++)
+    index.nearest(queries.col(i_query), k, nearest[i_query], distances);
+  double time_nearest =
+      chrono::duration<double>(chrono::steady_clock::now() - start).count();
+  start = chrono::steady_clock::now();
+  for (int i_query = 0; i_query < n_queries; i_query++)
+    index.withinRadius(queries.col(i_query), radius, within[i_query],
+                       distances);
+  double time_within =
+      chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+  // Brute force search, for comparison
+  MatrixXd descriptors(index.dim_descriptor(), n_dmps);
+  for (int i_dmp = 0; i_dmp < n_dmps; i_dmp++) {
+    VectorXd context = contexts.row(i_dmp);
+    descriptors.col(i_dmp) =
+        index.descriptor(library->y_init(i_dmp), library->y_attr(i_dmp),
+                         library->tau(i_dmp), context);
+  }
+  int n_different = 0;
+  start = chrono::steady_clock::now();
+  for (int i_query = 0; i_query < n_queries; i_query++) {
+    VectorXd sq_dists =
+        (descriptors.colwise() - queries.col(i_query)).colwise().squaredNorm();
+    vector<int> order(n_dmps);
+    for (int i_dmp = 0; i_dmp < n_dmps; i_dmp++) order[i_dmp] = i_dmp;
+    sort(order.begin(), order.end(),
+         [&sq_dists](int a, int b) { return sq_dists(a) < sq_dists(b); });
+    vector<int> within_brute;
+    for (int i = 0; i < n_dmps && sq_dists(order[i]) <= radius * radius; i++)
+      within_brute.push_back(order[i]);
+    order.resize(k);
+    if (order != nearest[i_query] || within_brute != within[i_query])
+      n_different++;
+  }
+  double time_brute =
+      chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+  cout << "  time per " << k << "-NN query    : " << time_nearest / n_queries
+       << "s" << endl;
+  cout << "  time per radius query : " << time_within / n_queries << "s"
+       << endl;
+  cout << "  time per brute force  : " << time_brute / n_queries << "s"
+       << endl;
+  cout << "  results that differ   : " << n_different << endl;
+
+  // The indices are handles into the library.
+  cout << "  nearest Dmp to first query: "
+       << library->name(nearest[0][0]) << " with "
+       << library->get(nearest[0][0])->dim_y() << " dimensions" << endl;
+
+  delete library;
+
+  return 0;
+}
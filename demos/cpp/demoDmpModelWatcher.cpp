@@ -0,0 +1,122 @@
+/**
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#define EIGEN_RUNTIME_NO_MALLOC  // Enable runtime tests for allocations
+
+#include <chrono>
+#include <cstdio>
+#include <eigen3/Eigen/Core>
+#include <fstream>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <thread>
+
+#include "dmp/Dmp.hpp"
+#include "dmp/DmpModelWatcher.hpp"
+#include "eigenutils/eigen_json.hpp"
+#include "eigenutils/eigen_realtime_check.hpp"
+
+using namespace std;
+using namespace Eigen;
+using namespace nlohmann;
+using namespace DmpBbo;
+
+/** Write a file, and move it into place, as an optimization loop would. */
+void writeModel(const string& filename, const string& contents)
+{
+  ofstream file(filename + ".tmp");
+  file << contents;
+  file.close();
+  rename((filename + ".tmp").c_str(), filename.c_str());
+}
+
+int main(int n_args, char** args)
+{
+  string filename_dmp = "../demos/cpp/json/Dmp_for_cpp.json";
+  ifstream file(filename_dmp);
+  if (file.fail()) {
+    cerr << "ERROR: Could not find file: " << filename_dmp << endl;
+    return -1;
+  }
+  json j_dmp = json::parse(file);
+
+  string filename_model = "/tmp/demoDmpModelWatcher.json";
+  writeModel(filename_model, j_dmp.dump());
+  Dmp* dmp = j_dmp.get<Dmp*>();
+
+  DmpModelWatcher watcher(filename_model);
+  if (!watcher.isWatching()) return -1;
+  watcher.addConsumer(dmp);
+
+  // The optimization writes new models while the controller is running.
+  thread optimization([&j_dmp, &filename_model] {
+    VectorXd y_attr = j_dmp.at("_y_attr");
+    for (int i_update = 1; i_update <= 3; i_update++) {
+      this_thread::sleep_for(chrono::milliseconds(300));
+      json j_update = j_dmp;
+      VectorXd y_attr_update = y_attr + VectorXd::Constant(2, 0.1 * i_update);
+      j_update["_y_attr"] = y_attr_update;
+      j_update["_goal_system"]["_x_attr"] = y_attr_update;
+      writeModel(filename_model, j_update.dump());
+      cout << "  optimization wrote update " << i_update << endl;
+
+      this_thread::sleep_for(chrono::milliseconds(100));
+      writeModel(filename_model, "{ \"this is\": \"not a Dmp\" }");
+      cout << "  optimization wrote an invalid model" << endl;
+    }
+  });
+
+  cout << "* Running a 1kHz control loop." << endl;
+  VectorXd x(dmp->dim(), 1);
+  VectorXd xd(dmp->dim(), 1);
+  double dt = 0.001;
+  int n_steps = 1500;
+  dmp->integrateStart(x, xd);
+  for (int i_step = 0; i_step < n_steps; i_step++) {
+    // Only the swap and the integration step are real-time. With
+    // REALTIME_CHECKS, the background thread may not parse models during this
+    // section (cf. DmpModelWatcher).
+    ENTERING_REAL_TIME_CRITICAL_CODE
+    // Safe point: between two integration steps.
+    int n_swapped = watcher.swapIfUpdated();
+    dmp->integrateStep(dt, x, x, xd);
+    EXITING_REAL_TIME_CRITICAL_CODE
+    if (n_swapped > 0)
+      cout << "  swapped in a new model at step " << i_step
+           << ", goal = " << x.segment(2 * dmp->dim_y(), 2).transpose() << endl;
+    this_thread::sleep_for(chrono::microseconds(1000));
+  }
+  optimization.join();
+
+  DmpModelWatcher::Statistics statistics = watcher.statistics();
+  cout << "  reloads           : " << statistics.n_reloads << endl;
+  cout << "  failed parses     : " << statistics.n_failed_parses << endl;
+  cout << "  last parse error  : " << statistics.last_parse_error << endl;
+  cout << "  last parse time   : " << statistics.last_parse_duration << "s"
+       << endl;
+  cout << "  max reload latency: " << statistics.max_reload_latency << "s"
+       << endl;
+  cout << "  final y           : " << x.head(2).transpose() << endl;
+
+  delete dmp;
+
+  return 0;
+}
@@ -0,0 +1,101 @@
+/**
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define EIGEN_RUNTIME_NO_MALLOC  // Enable runtime tests for allocations
+
+#include <chrono>
+#include <eigen3/Eigen/Core>
+#include <fstream>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include <string>
+
+#include "dmp/Dmp.hpp"
+#include "eigenutils/eigen_realtime_check.hpp"
+
+using namespace std;
+using namespace Eigen;
+using namespace nlohmann;
+using namespace DmpBbo;
+
+/** Integrate a Dmp, and return the positions over time.
+ * \param[in] dmp The Dmp to integrate
+ * \param[in] dt Integration time step
+ * \param[in] n_steps Number of time steps
+ * \param[out] ys Positions over time (n_steps x dim_y)
+ * \return Duration of the integration in seconds
+ */
+double integrate(const Dmp* dmp, double dt, int n_steps, MatrixXd& ys)
+{
+  VectorXd x(dmp->dim(), 1);
+  VectorXd xd(dmp->dim(), 1);
+  VectorXd y(dmp->dim_y(), 1);
+  VectorXd yd(dmp->dim_y(), 1);
+  VectorXd ydd(dmp->dim_y(), 1);
+  ys.resize(n_steps, dmp->dim_y());
+
+  auto start = chrono::steady_clock::now();
+  dmp->integrateStart(x, xd);
+  ENTERING_REAL_TIME_CRITICAL_CODE
+  for (int i_step = 0; i_step < n_steps; i_step++) {
+    dmp->integrateStep(dt, x, x, xd);
+    dmp->stateAsPosVelAcc(x, xd, y, yd, ydd);
+    ys.row(i_step) = y;
+  }
+  EXITING_REAL_TIME_CRITICAL_CODE
+  return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+int main(int n_args, char** args)
+{
+  string filename_dmp = "../demos/cpp/json/Dmp_for_cpp.json";
+  ifstream file(filename_dmp);
+  if (file.fail()) {
+    cerr << "ERROR: Could not find file: " << filename_dmp << endl;
+    return -1;
+  }
+  Dmp* dmp = json::parse(file).get<Dmp*>();
+
+  // Integrate at 1kHz
+  double dt = 0.001;
+  int n_steps = floor(1.2 * dmp->tau() / dt);
+
+  MatrixXd ys_full;
+  double time_full = integrate(dmp, dt, n_steps, ys_full);
+  cout << "* Full rate (" << 1.0 / dt << "Hz): " << time_full << "s" << endl;
+
+  // The Dmp has a TimeSystem as phase system, so the phase interval for a
+  // certain update rate of the forcing term is dt_update/tau
+  for (double rate_forcing_term : {200.0, 100.0, 50.0}) {
+    for (string interpolation : {"LINEAR", "CUBIC"}) {
+      double phase_interval = 1.0 / (rate_forcing_term * dmp->tau());
+      dmp->set_forcing_term_phase_interval(phase_interval, interpolation);
+      MatrixXd ys_multi;
+      double time_multi = integrate(dmp, dt, n_steps, ys_multi);
+      double max_diff = (ys_multi - ys_full).cwiseAbs().maxCoeff();
+      cout << "* Forcing term at " << rate_forcing_term << "Hz ("
+           << interpolation << "): " << time_multi
+           << "s, max |y_multi - y_full| = " << max_diff << endl;
+    }
+  }
+
+  delete dmp;
+
+  return 0;
+}
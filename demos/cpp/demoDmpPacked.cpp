@@ -0,0 +1,132 @@
+/**
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#define EIGEN_RUNTIME_NO_MALLOC  // Enable runtime tests for allocations
+
+#include <chrono>
+#include <cstdlib>
+#include <eigen3/Eigen/Core>
+#include <fstream>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+
+#include "dmp/Dmp.hpp"
+#include "dynamicalsystems/ExponentialSystem.hpp"
+#include "dynamicalsystems/SigmoidSystem.hpp"
+#include "dynamicalsystems/TimeSystem.hpp"
+#include "eigenutils/eigen_realtime_check.hpp"
+#include "functionapproximators/FunctionApproximatorRBFN.hpp"
+
+using namespace std;
+using namespace Eigen;
+using namespace nlohmann;
+using namespace DmpBbo;
+
+/** Integrate a Dmp step by step, and return the duration.
+ * \param[in] dmp The Dmp
+ * \param[in] n_steps Number of integration steps
+ * \param[out] x_final State after the last step
+ * \return Duration of the integration in seconds
+ */
+double timedIntegration(Dmp* dmp, int n_steps, VectorXd& x_final)
+{
+  double dt = 1.2 * dmp->tau() / n_steps;
+  VectorXd x(dmp->dim());
+  VectorXd xd(dmp->dim());
+  dmp->integrateStart(x, xd);
+  auto start = chrono::steady_clock::now();
+  ENTERING_REAL_TIME_CRITICAL_CODE
+  for (int i_step = 0; i_step < n_steps; i_step++)
+    dmp->integrateStep(dt, x, x, xd);
+  EXITING_REAL_TIME_CRITICAL_CODE
+  x_final = x;
+  return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+/** Compare integration with and without packing the forcing term.
+ * \param[in] dmp The Dmp
+ * \param[in] n_steps Number of integration steps
+ */
+void compare(Dmp* dmp, int n_steps)
+{
+  VectorXd x_unpacked, x_packed;
+  double time_unpacked = timedIntegration(dmp, n_steps, x_unpacked);
+  if (!dmp->packForcingTerm()) {
+    cout << "  Function approximators cannot be packed." << endl;
+    return;
+  }
+  double time_packed = timedIntegration(dmp, n_steps, x_packed);
+  dmp->unpackForcingTerm();
+
+  cout << "  max |x_packed - x_unpacked| = "
+       << (x_packed - x_unpacked).cwiseAbs().maxCoeff() << endl;
+  cout << "  time unpacked : " << time_unpacked << "s" << endl;
+  cout << "  time packed   : " << time_packed << "s" << endl;
+}
+
+int main(int n_args, char** args)
+{
+  string filename_dmp = "../demos/cpp/json/Dmp_for_cpp.json";
+  ifstream file(filename_dmp);
+  if (file.fail()) {
+    cerr << "ERROR: Could not find file: " << filename_dmp << endl;
+    return -1;
+  }
+  Dmp* dmp = json::parse(file).get<Dmp*>();
+
+  int n_steps = 10000;
+  if (n_args > 1) n_steps = atoi(args[1]);
+
+  cout << "* Dmp from " << filename_dmp << " (" << dmp->dim_y()
+       << " dimensions)" << endl;
+  compare(dmp, n_steps);
+  delete dmp;
+
+  // A Dmp with more dimensions and basis functions, e.g. for a 7-DOF arm
+  int n_dims = 7;
+  int n_basis_functions = 50;
+  VectorXd centers = VectorXd::LinSpaced(n_basis_functions, 0.0, 1.0);
+  VectorXd widths = VectorXd::Constant(n_basis_functions, 0.02);
+  vector<FunctionApproximator*> function_approximators(n_dims);
+  for (int i_dim = 0; i_dim < n_dims; i_dim++) {
+    VectorXd weights = 100.0 * VectorXd::Random(n_basis_functions);
+    function_approximators[i_dim] =
+        new FunctionApproximatorRBFN(centers, widths, weights);
+  }
+  VectorXd y_init = VectorXd::Zero(n_dims);
+  VectorXd y_attr = VectorXd::Ones(n_dims);
+  double tau = 1.0;
+  VectorXd one_1 = VectorXd::Ones(1);
+  ExponentialSystem* goal_system =
+      new ExponentialSystem(tau, y_init, y_attr, 15);
+  SigmoidSystem* gating_system = new SigmoidSystem(tau, one_1, -10, 0.9 * tau);
+  TimeSystem* phase_system = new TimeSystem(tau);
+  dmp = new Dmp(tau, y_init, y_attr, function_approximators, 20.0, goal_system,
+                phase_system, gating_system);
+
+  cout << "* Dmp with " << n_dims << " dimensions and " << n_basis_functions
+       << " basis functions" << endl;
+  compare(dmp, n_steps);
+  delete dmp;
+
+  return 0;
+}
@@ -0,0 +1,93 @@
+/**
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define EIGEN_RUNTIME_NO_MALLOC  // Enable runtime tests for allocations
+
+#include <chrono>
+#include <cstdlib>
+#include <eigen3/Eigen/Core>
+#include <fstream>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <thread>
+
+#include "dmp/Dmp.hpp"
+#include "eigenutils/eigen_realtime_check.hpp"
+
+using namespace std;
+using namespace Eigen;
+using namespace nlohmann;
+using namespace DmpBbo;
+
+/** Compute the analytical solution, and return the duration.
+ * \param[in] dmp The Dmp
+ * \param[in] ts Times at which to compute the solution
+ * \param[out] xs States over time
+ * \return Duration of the computation in seconds
+ */
+double timedAnalyticalSolution(const Dmp* dmp, const VectorXd& ts,
+                               MatrixXd& xs)
+{
+  MatrixXd xds;
+  auto start = chrono::steady_clock::now();
+  dmp->analyticalSolution(ts, xs, xds);
+  return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+int main(int n_args, char** args)
+{
+  string filename_dmp = "../demos/cpp/json/Dmp_for_cpp.json";
+  ifstream file(filename_dmp);
+  if (file.fail()) {
+    cerr << "ERROR: Could not find file: " << filename_dmp << endl;
+    return -1;
+  }
+  Dmp* dmp = json::parse(file).get<Dmp*>();
+
+  int n_time_steps = 1000000;
+  if (n_args > 1) n_time_steps = atoi(args[1]);
+  VectorXd ts = VectorXd::LinSpaced(n_time_steps, 0.0, 1.2 * dmp->tau());
+
+  for (string integration : {"EULER", "EXACT_FOH"}) {
+    cout << "* " << integration << " (" << n_time_steps << " time steps)"
+         << endl;
+    dmp->set_analytical_solution_integration(integration);
+
+    dmp->set_analytical_solution_n_threads(1);
+    MatrixXd xs_serial;
+    double time_serial = timedAnalyticalSolution(dmp, ts, xs_serial);
+    cout << "  1 thread : " << time_serial << "s" << endl;
+
+    int n_hardware = thread::hardware_concurrency();
+    for (int n_threads : {2, 4, n_hardware}) {
+      dmp->set_analytical_solution_n_threads(n_threads);
+      MatrixXd xs_parallel;
+      double time_parallel = timedAnalyticalSolution(dmp, ts, xs_parallel);
+      double max_diff = (xs_parallel - xs_serial).cwiseAbs().maxCoeff();
+      cout << "  " << n_threads << " threads: " << time_parallel
+           << "s (speed-up " << time_serial / time_parallel
+           << "), max |x_parallel - x_serial| = " << max_diff << endl;
+    }
+  }
+
+  delete dmp;
+
+  return 0;
+}
@@ -0,0 +1,120 @@
+/**
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <chrono>
+#include <eigen3/Eigen/Core>
+#include <fstream>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+
+#include "dmp/Dmp.hpp"
+#include "functionapproximators/FunctionApproximatorRBFN.hpp"
+#include "functionapproximators/FunctionApproximatorRBFNQuantized.hpp"
+
+using namespace std;
+using namespace Eigen;
+using namespace nlohmann;
+using namespace DmpBbo;
+
+/** Integrate a Dmp, and return the time required. */
+double integrate(Dmp* dmp, int n_steps, double dt, MatrixXd& ys)
+{
+  VectorXd x(dmp->dim(), 1);
+  VectorXd xd(dmp->dim(), 1);
+  ys.resize(n_steps, dmp->dim_y());
+  auto start = chrono::steady_clock::now();
+  dmp->integrateStart(x, xd);
+  for (int i_step = 0; i_step < n_steps; i_step++) {
+    dmp->integrateStep(dt, x, x, xd);
+    ys.row(i_step) = x.head(dmp->dim_y());
+  }
+  return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+int main(int n_args, char** args)
+{
+  string filename_dmp = "../demos/cpp/json/Dmp_for_cpp.json";
+  ifstream file(filename_dmp);
+  if (file.fail()) {
+    cerr << "ERROR: Could not find file: " << filename_dmp << endl;
+    return -1;
+  }
+  Dmp* dmp = json::parse(file).get<Dmp*>();
+
+  int n_steps = 20000;
+  double dt = 1.2 * dmp->tau() / n_steps;
+  MatrixXd ys, ys_quantized;
+  double time_double = integrate(dmp, n_steps, dt, ys);
+
+  int n_bytes_double = 0;
+  for (int i_dim = 0; i_dim < dmp->dim_y(); i_dim++) {
+    const FunctionApproximatorRBFN* rbfn =
+        dynamic_cast<const FunctionApproximatorRBFN*>(
+            dmp->function_approximator(i_dim));
+    n_bytes_double += sizeof(double) * (rbfn->centers().size() +
+                                        rbfn->widths().size() +
+                                        rbfn->weights().size());
+  }
+  cout << "* DOUBLE  : " << n_bytes_double << " bytes, time " << time_double
+       << "s" << endl;
+
+  vector<string> formats = {"FLOAT32", "FLOAT16", "INT16"};
+  for (string format : formats) {
+    Dmp* quantized = dmp->clone();
+    VectorXd max_errors;
+    if (!quantized->quantizeFunctionApproximators(format, max_errors))
+      return -1;
+
+    int n_bytes = 0;
+    double max_error_json = 0.0;
+    for (int i_dim = 0; i_dim < dmp->dim_y(); i_dim++) {
+      const FunctionApproximatorRBFNQuantized* fa =
+          dynamic_cast<const FunctionApproximatorRBFNQuantized*>(
+              quantized->function_approximator(i_dim));
+      n_bytes += fa->n_bytes();
+
+      // The quantized parameters are written to json without loss.
+      json j = fa;
+      FunctionApproximator* from_json = j.get<FunctionApproximator*>();
+      MatrixXd inputs = VectorXd::LinSpaced(101, 0.0, 1.0);
+      MatrixXd outputs, outputs_json;
+      fa->predict(inputs, outputs);
+      from_json->predict(inputs, outputs_json);
+      max_error_json = max(max_error_json,
+                           (outputs - outputs_json).cwiseAbs().maxCoeff());
+      delete from_json;
+    }
+
+    double time = integrate(quantized, n_steps, dt, ys_quantized);
+    cout << "* " << format << (format == "INT16" ? "   : " : " : ") << n_bytes
+         << " bytes, time " << time << "s" << endl;
+    cout << "    max FA output error : " << max_errors.transpose() << endl;
+    cout << "    max |y - y_quant|   : "
+         << (ys - ys_quantized).cwiseAbs().maxCoeff() << endl;
+    cout << "    json round trip err : " << max_error_json << endl;
+    delete quantized;
+  }
+
+  delete dmp;
+
+  return 0;
+}
@@ -0,0 +1,83 @@
+/**
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#define EIGEN_RUNTIME_NO_MALLOC  // Enable runtime tests for allocations
+
+#include <eigen3/Eigen/Core>
+#include <fstream>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include <string>
+
+#include "dmp/Dmp.hpp"
+#include "eigenutils/eigen_realtime_check.hpp"
+
+using namespace std;
+using namespace Eigen;
+using namespace nlohmann;
+using namespace DmpBbo;
+
+int main(int n_args, char** args)
+{
+  string filename_dmp = "../demos/cpp/json/Dmp_for_cpp.json";
+  ifstream file(filename_dmp);
+  if (file.fail()) {
+    cerr << "ERROR: Could not find file: " << filename_dmp << endl;
+    return -1;
+  }
+  json j = json::parse(file);
+
+  // Construct both Dmps before entering the real-time loop
+  Dmp* dmp = j.get<Dmp*>();
+  Dmp* dmp_new = j.get<Dmp*>();
+  VectorXd parameters;
+  dmp_new->getLinearParameterVector(parameters);
+  dmp_new->setLinearParameterVector(-parameters);
+  VectorXd y_attr_new = VectorXd::Zero(dmp_new->dim_y());
+  dmp_new->set_y_attr(y_attr_new);
+
+  double dt = 0.01;
+  int n_steps = floor(1.5 * dmp->tau() / dt);
+  VectorXd x(dmp->dim());
+  VectorXd xd(dmp->dim());
+  VectorXd y(dmp->dim_y());
+  VectorXd yd(dmp->dim_y());
+  VectorXd ydd(dmp->dim_y());
+  bool success = false;
+
+  cout << "* Switching to the new parameters half-way." << endl;
+  dmp->integrateStart(x, xd);
+  ENTERING_REAL_TIME_CRITICAL_CODE
+  for (int i_step = 0; i_step < n_steps; i_step++) {
+    if (i_step == n_steps / 2) success = dmp->copyParametersRealTime(*dmp_new);
+    dmp->integrateStep(dt, x, x, xd);
+  }
+  EXITING_REAL_TIME_CRITICAL_CODE
+
+  dmp->stateAsPosVelAcc(x, xd, y, yd, ydd);
+  cout << "  Switch successful: " << (success ? "yes" : "no") << endl;
+  cout << "  Final position: " << y.transpose() << endl;
+  cout << "  New attractor : " << y_attr_new.transpose() << endl;
+
+  delete dmp;
+  delete dmp_new;
+
+  return 0;
+}
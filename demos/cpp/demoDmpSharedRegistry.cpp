@@ -0,0 +1,134 @@
+/**
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <eigen3/Eigen/Core>
+#include <fstream>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+
+#include "dmp/Dmp.hpp"
+#include "dmp/DmpLibrary.hpp"
+#include "dmp/DmpSharedRegistry.hpp"
+#include "eigenutils/eigen_json.hpp"
+
+using namespace std;
+using namespace Eigen;
+using namespace nlohmann;
+using namespace DmpBbo;
+
+/** Make Dmps whose attractor states are offset by different amounts. */
+void makeDmps(const json& j_dmp, int n_dmps, double offset,
+              vector<string>& names, vector<json>& j_dmps)
+{
+  VectorXd y_attr = j_dmp.at("_y_attr");
+  names.resize(n_dmps);
+  j_dmps.resize(n_dmps);
+  for (int i_dmp = 0; i_dmp < n_dmps; i_dmp++) {
+    j_dmps[i_dmp] = j_dmp;
+    VectorXd y_attr_i =
+        y_attr + VectorXd::Constant(y_attr.size(), offset + i_dmp);
+    j_dmps[i_dmp]["_y_attr"] = y_attr_i;
+    // The goal system stores its own copy of the attractor state.
+    j_dmps[i_dmp]["_goal_system"]["_x_attr"] = y_attr_i;
+    names[i_dmp] = "dmp_" + to_string(i_dmp);
+  }
+}
+
+int main(int n_args, char** args)
+{
+  string filename_dmp = "../demos/cpp/json/Dmp_for_cpp.json";
+  ifstream file(filename_dmp);
+  if (file.fail()) {
+    cerr << "ERROR: Could not find file: " << filename_dmp << endl;
+    return -1;
+  }
+  json j_dmp = json::parse(file);
+
+  string registry_name = "demoDmpSharedRegistry";
+  int n_dmps = 1000;
+  vector<string> names;
+  vector<json> j_dmps;
+
+  cout << "* Publishing " << n_dmps << " Dmps." << endl;
+  makeDmps(j_dmp, n_dmps, 0.0, names, j_dmps);
+  uint64_t version;
+  if (!DmpSharedRegistry::publish(registry_name, names, j_dmps, &version))
+    return -1;
+  cout << "  published version " << version << endl;
+
+  pid_t pid = fork();
+  if (pid == 0) {
+    // Another process attaches to the registry, and executes a Dmp.
+    auto start = chrono::steady_clock::now();
+    uint64_t attached_version;
+    DmpLibrary* library =
+        DmpSharedRegistry::attach(registry_name, 16, &attached_version);
+    double time_attach =
+        chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    if (library == NULL) return -1;
+    MatrixXd xs, xds;
+    VectorXd ts = VectorXd::LinSpaced(101, 0.0, 1.5);
+    library->get("dmp_10")->analyticalSolution(ts, xs, xds);
+    cout << "* Child process attached to version " << attached_version
+         << " in " << time_attach << "s" << endl;
+    cout << "  " << library->n_dmps() << " Dmps, final state of dmp_10: "
+         << xs.row(xs.rows() - 1).head(2) << endl;
+    delete library;
+    return 0;
+  }
+  waitpid(pid, NULL, 0);
+
+  cout << "* Attaching to version " << DmpSharedRegistry::version(registry_name)
+       << endl;
+  uint64_t old_version;
+  DmpLibrary* old_library =
+      DmpSharedRegistry::attach(registry_name, 16, &old_version);
+  if (old_library == NULL) return -1;
+
+  cout << "* Publishing an update." << endl;
+  makeDmps(j_dmp, n_dmps, 100.0, names, j_dmps);
+  if (!DmpSharedRegistry::publish(registry_name, names, j_dmps, &version))
+    return -1;
+  cout << "  published version " << version << endl;
+
+  uint64_t new_version;
+  DmpLibrary* new_library =
+      DmpSharedRegistry::attach(registry_name, 16, &new_version);
+  if (new_library == NULL) return -1;
+
+  int i_dmp = old_library->find("dmp_10");
+  cout << "  y_attr of dmp_10 in version " << old_version << " : "
+       << old_library->y_attr(i_dmp).transpose() << endl;
+  i_dmp = new_library->find("dmp_10");
+  cout << "  y_attr of dmp_10 in version " << new_version << " : "
+       << new_library->y_attr(i_dmp).transpose() << endl;
+
+  delete old_library;  // Releases the old version
+  delete new_library;
+  DmpSharedRegistry::remove(registry_name);
+
+  return 0;
+}
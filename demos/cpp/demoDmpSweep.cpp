@@ -0,0 +1,100 @@
+/**
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <chrono>
+#include <cstdlib>
+#include <eigen3/Eigen/Core>
+#include <fstream>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include <string>
+
+#include "dmp/Dmp.hpp"
+#include "eigenutils/eigen_json.hpp"
+
+using namespace std;
+using namespace Eigen;
+using namespace nlohmann;
+using namespace DmpBbo;
+
+int main(int n_args, char** args)
+{
+  string filename_dmp = "../demos/cpp/json/Dmp_for_cpp.json";
+  ifstream file(filename_dmp);
+  if (file.fail()) {
+    cerr << "ERROR: Could not find file: " << filename_dmp << endl;
+    return -1;
+  }
+  json j = json::parse(file);
+
+  int n_candidates = 200;
+  if (n_args > 1) n_candidates = atoi(args[1]);
+  int n_time_steps = 500;
+
+  for (string scaling : {"AMPLITUDE_SCALING", "G_MINUS_Y0_SCALING"}) {
+    j["_forcing_term_scaling"] = scaling;
+    Dmp* dmp = j.get<Dmp*>();
+    VectorXd ts = VectorXd::LinSpaced(n_time_steps, 0.0, 1.2 * dmp->tau());
+    cout << "* " << scaling << " (" << n_candidates << " candidates, "
+         << n_time_steps << " time steps)" << endl;
+
+    // Candidate start and goal states around the ones of the Dmp
+    int D = dmp->dim_y();
+    VectorXd y_init = j.at("_y_init");
+    VectorXd y_attr = j.at("_y_attr");
+    MatrixXd y_inits = y_init.transpose().replicate(n_candidates, 1);
+    MatrixXd y_attrs = y_attr.transpose().replicate(n_candidates, 1);
+    y_inits += 0.5 * MatrixXd::Random(n_candidates, D);
+    y_attrs += 0.5 * MatrixXd::Random(n_candidates, D);
+
+    // One analytical solution per candidate
+    MatrixXd ys_loop(n_time_steps, n_candidates * D);
+    MatrixXd xs, xds;
+    auto start = chrono::steady_clock::now();
+    for (int i_cand = 0; i_cand < n_candidates; i_cand++) {
+      VectorXd y_init_cand = y_inits.row(i_cand);
+      VectorXd y_attr_cand = y_attrs.row(i_cand);
+      dmp->set_y_init(y_init_cand);
+      dmp->set_y_attr(y_attr_cand);
+      dmp->analyticalSolution(ts, xs, xds);
+      ys_loop.middleCols(i_cand * D, D) = xs.leftCols(D);
+    }
+    double time_loop =
+        chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    dmp->set_y_init(y_init);
+    dmp->set_y_attr(y_attr);
+
+    // All candidates at once
+    MatrixXd ys, yds, ydds;
+    start = chrono::steady_clock::now();
+    dmp->analyticalSolutionSweep(ts, y_inits, y_attrs, ys, yds, ydds);
+    double time_sweep =
+        chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    double max_diff = (ys - ys_loop).cwiseAbs().maxCoeff();
+    cout << "  max |y_sweep - y_loop| = " << max_diff << endl;
+    cout << "  time loop  : " << time_loop << "s" << endl;
+    cout << "  time sweep : " << time_sweep << "s" << endl;
+
+    delete dmp;
+  }
+
+  return 0;
+}
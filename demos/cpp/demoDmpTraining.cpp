@@ -0,0 +1,87 @@
+/**
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <eigen3/Eigen/Core>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include <string>
+
+#include "dmp/Dmp.hpp"
+#include "dmp/Trajectory.hpp"
+#include "threadutils/ThreadPool.hpp"
+
+using namespace std;
+using namespace Eigen;
+using namespace nlohmann;
+using namespace DmpBbo;
+
+int main(int n_args, char** args)
+{
+  // Make a demonstration
+  VectorXd ts = VectorXd::LinSpaced(201, 0.0, 1.0);
+  VectorXd y_init(3), y_attr(3);
+  y_init << 0.0, 1.0, -0.5;
+  y_attr << 0.4, 0.5, 1.5;
+  VectorXd y_yd_ydd_viapoint = VectorXd::Zero(9);
+  y_yd_ydd_viapoint.head(3) << 0.8, 1.2, 0.3;
+  Trajectory trajectory =
+      Trajectory::generatePolynomialTrajectoryThroughViapoint(
+          ts, y_init, y_yd_ydd_viapoint, 0.4, y_attr);
+
+  json fa_meta_params = {
+      {"class", "FunctionApproximatorLWR"},
+      {"_meta_params",
+       {{"n_basis_functions_per_dim", {15}}, {"intersection_height", 0.5}}}};
+
+  ThreadPool thread_pool;
+  for (string scaling : {"NO_SCALING", "G_MINUS_Y0_SCALING"}) {
+    // Train the Dmp, with one task for each dimension
+    Dmp* dmp = Dmp::fromTrajectory(trajectory, fa_meta_params,
+                                   "KULVICIUS_2012_JOINING", scaling,
+                                   &thread_pool);
+    if (dmp == NULL) return -1;
+
+    // Reproduce the demonstration. Exact integration of the spring-damper
+    // system avoids the integration error of the default Euler integration.
+    dmp->set_analytical_solution_integration("EXACT_FOH");
+    MatrixXd xs, xds;
+    dmp->analyticalSolution(ts, xs, xds);
+    Trajectory reproduced;
+    dmp->statesAsTrajectory(ts, xs, xds, reproduced);
+    double max_diff =
+        (reproduced.ys() - trajectory.ys()).cwiseAbs().maxCoeff();
+    cout << scaling << ": max difference between demonstration and"
+         << " reproduction: " << max_diff << endl;
+
+    // The trained Dmp can be saved, and read again
+    json j = dmp;
+    Dmp* dmp_read = j.get<Dmp*>();
+    dmp_read->set_analytical_solution_integration("EXACT_FOH");
+    MatrixXd xs_read, xds_read;
+    dmp_read->analyticalSolution(ts, xs_read, xds_read);
+    cout << "  max difference after json round trip: "
+         << (xs_read - xs).cwiseAbs().maxCoeff() << endl;
+
+    delete dmp_read;
+    delete dmp;
+  }
+
+  return 0;
+}
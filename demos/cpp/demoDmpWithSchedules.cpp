@@ -0,0 +1,188 @@
+/**
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <cmath>
+#include <eigen3/Eigen/Core>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+
+#include "dmp/Dmp.hpp"
+#include "dmp/DmpWithSchedules.hpp"
+#include "dmp/Trajectory.hpp"
+#include "functionapproximators/FunctionApproximatorRBFN.hpp"
+
+using namespace std;
+using namespace Eigen;
+using namespace nlohmann;
+using namespace DmpBbo;
+
+/** Compute the schedules as in the Python class DmpWithSchedules, i.e. by
+ * calling predict() for each function approximator, and clipping the outputs.
+ * \param[in] dmp The Dmp with schedules
+ * \param[in] phases Phases for which to compute the schedules
+ * \return The schedules (T x dim_schedules())
+ */
+MatrixXd referenceSchedules(const DmpWithSchedules* dmp, const VectorXd& phases)
+{
+  MatrixXd schedules(phases.size(), dmp->dim_schedules());
+  MatrixXd output;
+  for (int i_dim = 0; i_dim < dmp->dim_schedules(); i_dim++) {
+    dmp->function_approximator_schedules(i_dim)->predict(phases, output);
+    schedules.col(i_dim) = output.col(0)
+                               .cwiseMax(dmp->min_schedules()[i_dim])
+                               .cwiseMin(dmp->max_schedules()[i_dim]);
+  }
+  return schedules;
+}
+
+/** Integrate a Dmp with schedules step by step.
+ * \param[in] dmp The Dmp with schedules
+ * \param[in] ts Times at which to integrate
+ * \param[out] xs States (T x dim())
+ * \param[out] schedules Schedules (T x dim_schedules())
+ * \return Duration of the integration in microseconds per step
+ */
+double integrate(const DmpWithSchedules* dmp, const VectorXd& ts, MatrixXd& xs,
+                 MatrixXd& schedules)
+{
+  xs.resize(ts.size(), dmp->dim());
+  schedules.resize(ts.size(), dmp->dim_schedules());
+  VectorXd x(dmp->dim()), xd(dmp->dim()), sched(dmp->dim_schedules());
+
+  auto start = chrono::steady_clock::now();
+  dmp->integrateStartSched(x, xd, sched);
+  xs.row(0) = x;
+  schedules.row(0) = sched;
+  for (int tt = 1; tt < ts.size(); tt++) {
+    dmp->integrateStepSched(ts[tt] - ts[tt - 1], x, x, xd, sched);
+    xs.row(tt) = x;
+    schedules.row(tt) = sched;
+  }
+  auto end = chrono::steady_clock::now();
+  return chrono::duration<double, micro>(end - start).count() / ts.size();
+}
+
+int main(int n_args, char** args)
+{
+  // Train a Dmp with a trajectory
+  int n_time_steps = 201;
+  VectorXd ts = VectorXd::LinSpaced(n_time_steps, 0.0, 1.0);
+  VectorXd y_init(2), viapoint(6), y_attr(2);
+  y_init << 0.0, 0.0;
+  viapoint << 0.4, 0.7, 0.0, 0.0, 0.0, 0.0;  // y, yd and ydd
+  y_attr << 1.0, 0.5;
+  Trajectory trajectory =
+      Trajectory::generatePolynomialTrajectoryThroughViapoint(
+          ts, y_init, viapoint, 0.4, y_attr);
+
+  int n_bfs = 15;
+  json fa_meta_params = {
+      {"class", "FunctionApproximatorRBFN"},
+      {"_meta_params",
+       {{"n_basis_functions_per_dim", {n_bfs}}, {"intersection_height", 0.7}}}};
+  Dmp* dmp = Dmp::fromTrajectory(trajectory, fa_meta_params);
+  if (dmp == NULL) return -1;
+
+  // Train a stiffness and a force schedule, which have the phase as input.
+  // The phase of a KULVICIUS_2012_JOINING Dmp is the normalized time.
+  VectorXd phases = ts / ts[ts.size() - 1];
+  VectorXd stiffness(n_time_steps), force(n_time_steps);
+  for (int tt = 0; tt < n_time_steps; tt++) {
+    stiffness[tt] = 100.0 + 400.0 * exp(-pow((phases[tt] - 0.5) / 0.2, 2));
+    force[tt] = 20.0 * sin(2.0 * M_PI * phases[tt]);
+  }
+  VectorXi n_bfs_per_dim(1);
+  n_bfs_per_dim << n_bfs;
+  vector<FunctionApproximator*> fas_schedules;
+  fas_schedules.push_back(
+      FunctionApproximatorRBFN::train(phases, stiffness, n_bfs_per_dim));
+  fas_schedules.push_back(
+      FunctionApproximatorRBFN::train(phases, force, n_bfs_per_dim));
+
+  // The stiffness should remain within [150, 400]; the force is unbounded.
+  double inf = numeric_limits<double>::infinity();
+  VectorXd min_schedules(2), max_schedules(2);
+  min_schedules << 150.0, -inf;
+  max_schedules << 400.0, inf;
+  DmpWithSchedules* dmp_sched = new DmpWithSchedules(
+      *dmp, fas_schedules, min_schedules, max_schedules);
+
+  // Integrate step by step, and compare with the analytical solution and with
+  // the schedules as they are computed in Python.
+  MatrixXd xs_step, schedules_step;
+  double us_per_step = integrate(dmp_sched, ts, xs_step, schedules_step);
+  MatrixXd xs, xds, schedules;
+  dmp_sched->analyticalSolutionSched(ts, xs, xds, schedules);
+  int i_phase = 3 * dmp_sched->dim_y();
+  MatrixXd reference = referenceSchedules(dmp_sched, xs_step.col(i_phase));
+  cout << "Integration: " << us_per_step << " us per step" << endl;
+  cout << "Max difference schedules integrateStepSched/Python: "
+       << (schedules_step - reference).cwiseAbs().maxCoeff() << endl;
+  reference = referenceSchedules(dmp_sched, xs.col(i_phase));
+  cout << "Max difference schedules analyticalSolutionSched/Python: "
+       << (schedules - reference).cwiseAbs().maxCoeff() << endl;
+  cout << "Stiffness range: [" << schedules.col(0).minCoeff() << ", "
+       << schedules.col(0).maxCoeff() << "]" << endl;
+
+  // The Dmp itself should not be affected by the schedules.
+  MatrixXd xs_dmp(ts.size(), dmp->dim());
+  VectorXd x(dmp->dim()), xd(dmp->dim());
+  dmp->integrateStart(x, xd);
+  xs_dmp.row(0) = x;
+  for (int tt = 1; tt < ts.size(); tt++) {
+    dmp->integrateStep(ts[tt] - ts[tt - 1], x, x, xd);
+    xs_dmp.row(tt) = x;
+  }
+  cout << "Max difference states DmpWithSchedules/Dmp: "
+       << (xs_step - xs_dmp).cwiseAbs().maxCoeff() << endl;
+
+  // For comparison: integrate the Dmp, and compute the schedules with their
+  // function approximators separately.
+  VectorXd sched(2), output(1);
+  auto start = chrono::steady_clock::now();
+  dmp->integrateStart(x, xd);
+  for (int tt = 1; tt < ts.size(); tt++) {
+    dmp->integrateStep(ts[tt] - ts[tt - 1], x, x, xd);
+    for (int i_dim = 0; i_dim < 2; i_dim++) {
+      fas_schedules[i_dim]->predictRealTime(x.segment(i_phase, 1), output);
+      sched[i_dim] = output[0];
+    }
+    sched = sched.cwiseMax(min_schedules).cwiseMin(max_schedules);
+  }
+  auto end = chrono::steady_clock::now();
+  cout << "Integration with separate schedules: "
+       << chrono::duration<double, micro>(end - start).count() / ts.size()
+       << " us per step" << endl;
+
+  // Save to json and read it again
+  json j = dmp_sched;
+  DmpWithSchedules* dmp_loaded = j.get<DmpWithSchedules*>();
+  MatrixXd xs_loaded, schedules_loaded;
+  integrate(dmp_loaded, ts, xs_loaded, schedules_loaded);
+  cout << "Max difference schedules after json: "
+       << (schedules_loaded - schedules_step).cwiseAbs().maxCoeff() << endl;
+
+  delete dmp_loaded;
+  delete dmp_sched;
+  delete dmp;
+  return 0;
+}
@@ -0,0 +1,184 @@
+/**
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include <string>
+
+#include "eigenutils/eigen_json.hpp"
+#include "functionapproximators/FunctionApproximatorLWR.hpp"
+#include "functionapproximators/FunctionApproximatorRBFN.hpp"
+#include "functionapproximators/FunctionApproximatorWLS.hpp"
+#include "threadutils/ThreadPool.hpp"
+
+using namespace std;
+using namespace Eigen;
+using namespace DmpBbo;
+using namespace nlohmann;
+
+/** Same as numpy.linspace, which differs from VectorXd::LinSpaced in the last
+ * digits.
+ * \param[in] low First value
+ * \param[in] high Last value
+ * \param[in] n Number of values
+ * \return The values
+ */
+VectorXd linspace(double low, double high, int n)
+{
+  VectorXd values(n);
+  double step = (high - low) / (n - 1);
+  for (int i = 0; i < n - 1; i++) values[i] = i * step + low;
+  values[n - 1] = high;
+  return values;
+}
+
+/** Generate the training data, as target_function() in
+ * tests/integration/test_function_approximators.py
+ * \param[in] n_dims Dimensionality of the input (1 or 2)
+ * \param[out] inputs The inputs (n_samples x n_dims)
+ * \param[out] targets The targets (n_samples)
+ */
+void targetFunction(int n_dims, MatrixXd& inputs, VectorXd& targets)
+{
+  if (n_dims == 1) {
+    inputs = linspace(0.0, 2.0, 30);
+    targets = 3 * (-inputs.array()).exp() * (2 * inputs.array().square()).sin();
+  } else {
+    VectorXd xs = linspace(-2.0, 2.0, 10);
+    inputs.resize(xs.size() * xs.size(), 2);
+    targets.resize(inputs.rows());
+    int ii = 0;
+    for (int i1 = 0; i1 < xs.size(); i1++) {
+      for (int i2 = 0; i2 < xs.size(); i2++) {
+        double x1 = xs[i1];
+        double x2 = xs[i2];
+        inputs(ii, 0) = x1;
+        inputs(ii, 1) = x2;
+        targets[ii] = 2.5 * x1 * exp(-x1 * x1 - x2 * x2);
+        ii++;
+      }
+    }
+  }
+}
+
+/** Get the largest difference between the model parameters in two json
+ * objects.
+ * \param[in] j1 First json object
+ * \param[in] j2 Second json object
+ * \return The largest absolute difference
+ */
+double maxDiffModelParams(const json& j1, const json& j2)
+{
+  double max_diff = 0.0;
+  for (auto& item : j1.at("_model_params").items()) {
+    MatrixXd values1 = item.value();
+    MatrixXd values2 = j2.at("_model_params").at(item.key());
+    max_diff = max(max_diff, (values1 - values2).cwiseAbs().maxCoeff());
+  }
+  return max_diff;
+}
+
+int main(int n_args, char** args)
+{
+  string directory = "../demos/cpp/json/";
+  ThreadPool thread_pool;
+
+  for (int n_dims : {1, 2}) {
+    MatrixXd inputs;
+    VectorXd targets;
+    targetFunction(n_dims, inputs, targets);
+    VectorXi n_bfs_per_dim = VectorXi::Constant(n_dims, (n_dims == 1 ? 9 : 5));
+
+    for (string fa_name : {"RBFN", "LWR"}) {
+      string label = fa_name + "_" + to_string(n_dims) + "D";
+
+      // Train with the same meta-parameters as
+      // tests/integration/test_function_approximators.py
+      FunctionApproximator* fa;
+      if (fa_name == "RBFN")
+        fa = FunctionApproximatorRBFN::train(inputs, targets, n_bfs_per_dim,
+                                             0.7);
+      else
+        fa = FunctionApproximatorLWR::train(inputs, targets, n_bfs_per_dim,
+                                            0.2, 0.0, &thread_pool);
+      if (fa == NULL) return -1;
+
+      MatrixXd outputs;
+      fa->predict(inputs, outputs);
+      double error = (outputs.col(0) - targets).cwiseAbs().mean();
+
+      // Compare to the model parameters trained in Python
+      string filename = directory + label + "_for_cpp.json";
+      ifstream file(filename);
+      if (file.fail()) {
+        cerr << "ERROR: Could not find file: " << filename << endl;
+        return -1;
+      }
+      json j_python = json::parse(file);
+      json j_cpp = fa;
+      double max_diff = maxDiffModelParams(j_python, j_cpp);
+
+      cout << label << ": mean abs error = " << error
+           << "   max diff to Python = " << max_diff << endl;
+      if (n_dims == 1) cout << "  " << j_cpp.dump() << endl;
+
+      delete fa;
+    }
+  }
+
+  // Time the training of many models, e.g. one for each dimension of many
+  // demonstrations. The regressions of the basis functions of one model are
+  // too small to benefit from parallelization, so train the models in
+  // parallel instead.
+  int n_models = 1000;
+  MatrixXd inputs = linspace(0.0, 1.0, 500);
+  VectorXd targets = (10 * inputs.array()).sin();
+  VectorXi n_bfs_per_dim = VectorXi::Constant(1, 25);
+  auto train_model = [&](int i_model) {
+    delete FunctionApproximatorLWR::train(inputs, targets, n_bfs_per_dim);
+  };
+
+  auto start = chrono::steady_clock::now();
+  for (int i_model = 0; i_model < n_models; i_model++) train_model(i_model);
+  chrono::duration<double> duration = chrono::steady_clock::now() - start;
+  cout << "Training " << n_models << " LWR models sequentially took "
+       << duration.count() << "s" << endl;
+
+  start = chrono::steady_clock::now();
+  thread_pool.parallelFor(n_models, train_model);
+  duration = chrono::steady_clock::now() - start;
+  cout << "Training " << n_models << " LWR models with "
+       << thread_pool.n_threads() << " threads took " << duration.count() << "s"
+       << endl;
+
+  // WLS, and its json round trip
+  FunctionApproximatorWLS* wls =
+      FunctionApproximatorWLS::train(inputs, targets, true, 0.1);
+  json j_wls = wls;
+  FunctionApproximator* wls2 = j_wls.get<FunctionApproximator*>();
+  cout << "WLS: " << j_wls.dump() << endl;
+  cout << "WLS after json round trip: " << *wls2 << endl;
+  delete wls;
+  delete wls2;
+
+  return 0;
+}
@@ -0,0 +1,184 @@
+/**
+ * @file demoLearningSessionLog.cpp
+ * @brief  Demonstrates how to store a learning session in a binary log.
+ *
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <boost/filesystem.hpp>
+#include <chrono>
+#include <eigen3/Eigen/Core>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include <string>
+
+#include "bbo/LearningSessionLog.hpp"
+#include "eigenutils/eigen_file_io.hpp"
+
+using namespace std;
+using namespace Eigen;
+using namespace nlohmann;
+using namespace DmpBbo;
+
+const int n_updates = 20;
+const int n_samples = 10;
+const int n_dims = 30;
+
+/** Cost-relevant variables of a rollout (ts, ys, yds, ydds). */
+MatrixXd costVars(int i_update, int i_sample)
+{
+  MatrixXd cost_vars = MatrixXd::Random(201, 7);
+  cost_vars(0, 0) = i_update + 0.01 * i_sample;
+  return cost_vars;
+}
+
+/** Store a learning session as the Python class LearningSession does when
+ * saving to a directory, i.e. with one text file for each object.
+ * \param[in] directory Directory to save the files to
+ * \return Duration in milliseconds
+ */
+double saveSessionToFiles(const string& directory)
+{
+  auto start = chrono::steady_clock::now();
+  for (int i_update = 0; i_update < n_updates; i_update++) {
+    char update_dir[32];
+    snprintf(update_dir, sizeof(update_dir), "/update%05d", i_update);
+    string dir = directory + update_dir;
+    MatrixXd samples = MatrixXd::Random(n_samples, n_dims);
+    for (int i_sample = 0; i_sample < n_samples; i_sample++) {
+      char prefix[8];
+      snprintf(prefix, sizeof(prefix), "%03d_", i_sample);
+      VectorXd sample = samples.row(i_sample);
+      MatrixXd cost_vars = costVars(i_update, i_sample);
+      VectorXd cost = VectorXd::Random(3);
+      saveMatrix(dir, prefix + string("sample.txt"), sample, true);
+      saveMatrix(dir, prefix + string("cost_vars.txt"), cost_vars, true);
+      saveMatrix(dir, prefix + string("cost.txt"), cost, true);
+    }
+    saveMatrix(dir, "samples.txt", samples, true);
+  }
+  auto end = chrono::steady_clock::now();
+  return chrono::duration<double, milli>(end - start).count();
+}
+
+/** Store a learning session in a binary log.
+ * \param[in] log The log
+ * \return Duration in milliseconds
+ */
+double saveSessionToLog(LearningSessionLog* log)
+{
+  auto start = chrono::steady_clock::now();
+  for (int i_update = 0; i_update < n_updates; i_update++) {
+    MatrixXd samples = MatrixXd::Random(n_samples, n_dims);
+    for (int i_sample = 0; i_sample < n_samples; i_sample++) {
+      MatrixXd cost_vars = costVars(i_update, i_sample);
+      log->appendRollout(i_update, i_sample, samples.row(i_sample), cost_vars,
+                         VectorXd::Random(3));
+    }
+    log->appendMatrix(LearningSessionLog::key("samples", i_update), samples);
+
+    json distribution;
+    distribution["mean"] = vector<double>(n_dims, 0.1 * i_update);
+    log->appendJson(LearningSessionLog::key("distribution", i_update),
+                    distribution);
+  }
+  auto end = chrono::steady_clock::now();
+  return chrono::duration<double, milli>(end - start).count();
+}
+
+/** Check whether the cost_vars of all rollouts can be read from a log.
+ * \param[in] log The log
+ * \param[in] n_updates_expected Number of updates that should be in the log
+ * \return true if all cost_vars could be read and have the expected values
+ */
+bool checkSession(const LearningSessionLog* log, int n_updates_expected)
+{
+  if (log->getNumberOfUpdates() != n_updates_expected) return false;
+  MatrixXd cost_vars;
+  for (int i_update = 0; i_update < n_updates_expected; i_update++) {
+    for (int i_sample = 0; i_sample < n_samples; i_sample++) {
+      string key = LearningSessionLog::key("cost_vars", i_update, i_sample);
+      if (!log->readMatrix(key, cost_vars)) return false;
+      if (cost_vars.rows() != 201 || cost_vars.cols() != 7) return false;
+      if (cost_vars(0, 0) != i_update + 0.01 * i_sample) return false;
+    }
+  }
+  json distribution;
+  if (!log->readJson(LearningSessionLog::key("distribution", 0), distribution))
+    return false;
+  return distribution["mean"].size() == n_dims;
+}
+
+int main(int n_args, char** args)
+{
+  namespace fs = boost::filesystem;
+  fs::path directory = fs::temp_directory_path() / fs::unique_path();
+  fs::create_directories(directory);
+  string filename = (directory / "session.dmpbbolog").string();
+
+  double duration_files = saveSessionToFiles((directory / "files").string());
+
+  LearningSessionLog* log = LearningSessionLog::open(filename);
+  if (log == NULL) return -1;
+  double duration_log = saveSessionToLog(log);
+  delete log;
+
+  cout << "Storing " << n_updates << " updates with " << n_samples
+       << " rollouts each took" << endl;
+  cout << "  " << duration_files << "ms with one text file per object" << endl;
+  cout << "  " << duration_log << "ms with a binary log ("
+       << fs::file_size(filename) / 1024 << "kB)" << endl;
+
+  // Reading the log only requires reading the index
+  auto start = chrono::steady_clock::now();
+  log = LearningSessionLog::open(filename, true);
+  auto end = chrono::steady_clock::now();
+  if (log == NULL) return -1;
+  cout << "Opening the log took "
+       << chrono::duration<double, milli>(end - start).count() << "ms ("
+       << log->keys().size() << " records)" << endl;
+  bool all_ok = checkSession(log, n_updates);
+  delete log;
+
+  // Simulate a program that was interrupted while appending: remove the end of
+  // the data file (which cuts the last record), and the whole index.
+  fs::resize_file(filename, fs::file_size(filename) - 100);
+  fs::remove(filename + ".idx");
+  log = LearningSessionLog::open(filename);
+  if (log == NULL) return -1;
+  string last_key = LearningSessionLog::key("distribution", n_updates - 1);
+  cout << "After interruption, the last record '" << last_key << "' is "
+       << (log->exists(last_key) ? "still there" : "missing") << endl;
+  all_ok = all_ok && !log->exists(last_key) && checkSession(log, n_updates);
+
+  // The log can be appended to again
+  json distribution;
+  distribution["mean"] = vector<double>(n_dims, 0.0);
+  log->appendJson(last_key, distribution);
+  delete log;
+  log = LearningSessionLog::open(filename, true);
+  all_ok = all_ok && log->exists(last_key) && checkSession(log, n_updates);
+  delete log;
+
+  fs::remove_all(directory);
+
+  cout << (all_ok ? "All records were read correctly."
+                  : "ERROR: Records were not read correctly.")
+       << endl;
+  return all_ok ? 0 : -1;
+}
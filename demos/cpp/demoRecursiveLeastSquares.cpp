@@ -0,0 +1,191 @@
+/**
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <cmath>
+#include <eigen3/Eigen/Core>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "dmp/Dmp.hpp"
+#include "dmp/Trajectory.hpp"
+#include "functionapproximators/FunctionApproximatorLWR.hpp"
+#include "functionapproximators/FunctionApproximatorRBFN.hpp"
+#include "functionapproximators/RecursiveLeastSquares.hpp"
+
+using namespace std;
+using namespace Eigen;
+using namespace nlohmann;
+using namespace DmpBbo;
+
+/** Target function before (bump=0) and after the change (bump=1).
+ * \param[in] x Input
+ * \param[in] bump Height of the bump that is added to the function
+ * \return The target value
+ */
+double targetFunction(double x, double bump)
+{
+  return sin(2 * M_PI * x) + bump * exp(-pow((x - 0.6) / 0.1, 2));
+}
+
+/** Adapt an RBFN and an LWR online to a changed target function.
+ */
+void demoFunctionApproximators(void)
+{
+  VectorXd inputs = VectorXd::LinSpaced(200, 0.0, 1.0);
+  VectorXd targets_before(inputs.size()), targets_after(inputs.size());
+  for (int ii = 0; ii < inputs.size(); ii++) {
+    targets_before[ii] = targetFunction(inputs[ii], 0.0);
+    targets_after[ii] = targetFunction(inputs[ii], 1.0);
+  }
+  VectorXi n_bfs(1);
+  n_bfs << 15;
+
+  for (string fa_name : {"RBFN", "LWR"}) {
+    // Train offline before the change, and (for comparison) after it
+    FunctionApproximator* fa_before;
+    FunctionApproximator* fa_batch;
+    if (fa_name == "RBFN") {
+      fa_before =
+          FunctionApproximatorRBFN::train(inputs, targets_before, n_bfs);
+      fa_batch = FunctionApproximatorRBFN::train(inputs, targets_after, n_bfs);
+    } else {
+      fa_before = FunctionApproximatorLWR::train(inputs, targets_before, n_bfs);
+      fa_batch = FunctionApproximatorLWR::train(inputs, targets_after, n_bfs);
+    }
+
+    for (double threshold : {0.0, 0.001}) {
+      // Adapt online with samples from the changed function
+      RecursiveLeastSquares* rls =
+          RecursiveLeastSquares::create(*fa_before, 1.0, 1000.0, threshold);
+      mt19937 generator(0);
+      uniform_real_distribution<double> distribution(0.0, 1.0);
+      RowVectorXd input(1);
+      int n_updates = 5000;
+      long n_active = 0;
+      auto start = chrono::steady_clock::now();
+      for (int i_update = 0; i_update < n_updates; i_update++) {
+        input[0] = distribution(generator);
+        rls->updateRealTime(input, targetFunction(input[0], 1.0));
+        n_active += rls->n_active_basis_functions();
+      }
+      chrono::duration<double> duration = chrono::steady_clock::now() - start;
+
+      MatrixXd outputs_before, outputs_online, outputs_batch;
+      fa_before->predict(inputs, outputs_before);
+      rls->function_approximator().predict(inputs, outputs_online);
+      fa_batch->predict(inputs, outputs_batch);
+      cout << fa_name << " (activation threshold " << threshold << ")" << endl;
+      cout << "  max error before adaptation: "
+           << (outputs_before - targets_after).cwiseAbs().maxCoeff() << endl;
+      cout << "  max error after " << n_updates << " updates: "
+           << (outputs_online - targets_after).cwiseAbs().maxCoeff() << endl;
+      cout << "  max error of batch training: "
+           << (outputs_batch - targets_after).cwiseAbs().maxCoeff() << endl;
+      cout << "  " << 1e6 * duration.count() / n_updates
+           << "us per update, with on average "
+           << (double)n_active / n_updates << " of " << n_bfs[0]
+           << " basis functions updated" << endl;
+      delete rls;
+    }
+    delete fa_before;
+    delete fa_batch;
+  }
+}
+
+/** Adapt a Dmp online to a corrective demonstration, during execution.
+ */
+void demoDmp(void)
+{
+  // The Dmp is trained with a demonstration, but the trajectory that the
+  // robot should follow goes through a different viapoint.
+  VectorXd ts = VectorXd::LinSpaced(201, 0.0, 1.0);
+  double dt = ts[1] - ts[0];
+  VectorXd y_init(2), y_attr(2);
+  y_init << 0.0, 1.0;
+  y_attr << 0.4, 0.5;
+  VectorXd viapoint = VectorXd::Zero(6);
+  viapoint.head(2) << 0.8, 1.2;
+  Trajectory demonstration =
+      Trajectory::generatePolynomialTrajectoryThroughViapoint(
+          ts, y_init, viapoint, 0.4, y_attr);
+  viapoint.head(2) << 0.6, 1.4;
+  Trajectory correction =
+      Trajectory::generatePolynomialTrajectoryThroughViapoint(
+          ts, y_init, viapoint, 0.4, y_attr);
+
+  json fa_meta_params = {
+      {"class", "FunctionApproximatorRBFN"},
+      {"_meta_params",
+       {{"n_basis_functions_per_dim", {15}}, {"intersection_height", 0.7}}}};
+  Dmp* dmp = Dmp::fromTrajectory(demonstration, fa_meta_params);
+  if (dmp == NULL) return;
+  dmp->set_analytical_solution_integration("EXACT_FOH");
+
+  int n_dims = dmp->dim_y();
+  vector<RecursiveLeastSquares*> learners(n_dims);
+  for (int i_dim = 0; i_dim < n_dims; i_dim++)
+    learners[i_dim] =
+        RecursiveLeastSquares::create(*dmp->function_approximator(i_dim));
+
+  // Preallocate all memory for the control loop
+  VectorXd x(dmp->dim()), xd(dmp->dim());
+  RowVectorXd phase(1);
+  VectorXd f_targets(n_dims);
+  MatrixXd xs, xds;
+
+  for (int i_episode = 0; i_episode <= 5; i_episode++) {
+    dmp->analyticalSolution(ts, xs, xds);
+    double max_error =
+        (xs.leftCols(n_dims) - correction.ys()).cwiseAbs().maxCoeff();
+    cout << "Episode " << i_episode
+         << ": max distance to corrective demonstration: " << max_error
+         << endl;
+    if (i_episode == 5) break;
+
+    // Execute the Dmp, and adapt it to the corrective demonstration at each
+    // time step. The updated weights are used in the next integration step.
+    dmp->integrateStart(x, xd);
+    for (int tt = 1; tt < ts.size(); tt++) {
+      dmp->computeTargetsRealTime(x, correction.ys().row(tt - 1),
+                                  correction.yds().row(tt - 1),
+                                  correction.ydds().row(tt - 1), phase,
+                                  f_targets);
+      for (int i_dim = 0; i_dim < n_dims; i_dim++) {
+        learners[i_dim]->updateRealTime(phase, f_targets[i_dim]);
+        dmp->copyFunctionApproximatorParametersRealTime(
+            i_dim, learners[i_dim]->function_approximator());
+      }
+      dmp->integrateStep(dt, x, x, xd);
+    }
+  }
+
+  for (int i_dim = 0; i_dim < n_dims; i_dim++) delete learners[i_dim];
+  delete dmp;
+}
+
+int main(int n_args, char** args)
+{
+  demoFunctionApproximators();
+  demoDmp();
+  return 0;
+}
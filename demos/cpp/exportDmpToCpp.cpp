@@ -0,0 +1,82 @@
+/**
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include <string>
+
+#include "dmp/DmpCodeGenerator.hpp"
+
+using namespace std;
+using namespace nlohmann;
+using namespace DmpBbo;
+
+void help(char* binary_name)
+{
+  cout << "Usage: " << binary_name
+       << " <dmp filename.json> <output filename.hpp> <namespace> <dt>"
+       << " [EULER|RUNGE_KUTTA]" << endl;
+}
+
+/** Main function
+ * \param[in] n_args Number of arguments
+ * \param[in] args Arguments themselves
+ * \return Success of exection. 0 if successful.
+ */
+int main(int n_args, char** args)
+{
+  if (n_args > 1 && string(args[1]).compare("--help") == 0) {
+    help(args[0]);
+    return 0;
+  }
+  if (n_args != 5 && n_args != 6) {
+    help(args[0]);
+    return -1;
+  }
+
+  string filename_dmp = args[1];
+  string filename_header = args[2];
+  string name = args[3];
+  double dt = atof(args[4]);
+  string integration = (n_args == 6 ? args[5] : "RUNGE_KUTTA");
+
+  ifstream file(filename_dmp);
+  if (file.fail()) {
+    cerr << "ERROR: Could not find file: " << filename_dmp << endl;
+    return -1;
+  }
+  json j = json::parse(file);
+
+  ofstream header(filename_header);
+  if (header.fail()) {
+    cerr << "ERROR: Could not open file for writing: " << filename_header
+         << endl;
+    return -1;
+  }
+  if (!DmpCodeGenerator::generate(j, name, integration, dt, header)) {
+    header.close();
+    remove(filename_header.c_str());
+    return -1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,180 @@
+/**
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <boost/filesystem.hpp>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+
+#include "dmp/Dmp.hpp"
+#include "dmp/DmpModelSelection.hpp"
+#include "dmp/Trajectory.hpp"
+#include "threadutils/ThreadPool.hpp"
+
+using namespace std;
+using namespace Eigen;
+using namespace nlohmann;
+using namespace DmpBbo;
+
+void help(char* binary_name)
+{
+  cout << "Usage: " << binary_name
+       << " <trajectory file> <output directory> [grid.json] [n_threads]"
+       << endl;
+  cout << "Trains a Dmp with the trajectory for each point on a grid of "
+       << "meta-parameters, and writes the reconstruction errors to "
+       << "report.txt and the best Dmp to dmp_best.json in the output "
+       << "directory." << endl;
+  cout << "grid.json may contain the following (default values):" << endl;
+  cout << "  {\"class\": \"FunctionApproximatorRBFN\"," << endl;
+  cout << "   \"n_basis_functions\": [3, 4, ..., 15]," << endl;
+  cout << "   \"intersection_heights\": [0.5, 0.6, 0.7, 0.8, 0.9]," << endl;
+  cout << "   \"regularizations\": [0.0, 1e-6, 1e-4, 1e-2]," << endl;
+  cout << "   \"max_error\": 0.0," << endl;
+  cout << "   \"dmp_type\": \"KULVICIUS_2012_JOINING\"," << endl;
+  cout << "   \"scaling\": \"NO_SCALING\"," << endl;
+  cout << "   \"integration\": \"EULER\"}" << endl;
+  cout << "The best Dmp is the one with the fewest parameters whose mean "
+       << "absolute error is at most max_error, or the one with the lowest "
+       << "error if max_error is 0." << endl;
+}
+
+/** Main function
+ * \param[in] n_args Number of arguments
+ * \param[in] args Arguments themselves
+ * \return Success of exection. 0 if successful.
+ */
+int main(int n_args, char** args)
+{
+  if (n_args > 1 && string(args[1]).compare("--help") == 0) {
+    help(args[0]);
+    return 0;
+  }
+  if (n_args < 3 || n_args > 5) {
+    help(args[0]);
+    return -1;
+  }
+
+  string trajectory_filename = args[1];
+  string output_directory = args[2];
+
+  json grid = json::object();
+  if (n_args > 3) {
+    ifstream file(args[3]);
+    if (file.fail()) {
+      cerr << "ERROR: Could not find file: " << args[3] << endl;
+      return -1;
+    }
+    grid = json::parse(file);
+  }
+  int n_threads = (n_args > 4 ? atoi(args[4]) : 0);
+
+  vector<int> default_n_bfs;
+  for (int n_bfs = 3; n_bfs <= 15; n_bfs++) default_n_bfs.push_back(n_bfs);
+  string fa_class = grid.value("class", "FunctionApproximatorRBFN");
+  vector<int> n_bfs_list = grid.value("n_basis_functions", default_n_bfs);
+  vector<double> heights = grid.value("intersection_heights",
+                                      vector<double>{0.5, 0.6, 0.7, 0.8, 0.9});
+  vector<double> regularizations =
+      grid.value("regularizations", vector<double>{0.0, 1e-6, 1e-4, 1e-2});
+  double max_error = grid.value("max_error", 0.0);
+  string dmp_type = grid.value("dmp_type", "KULVICIUS_2012_JOINING");
+  string scaling = grid.value("scaling", "NO_SCALING");
+  string integration = grid.value("integration", "EULER");
+
+  Trajectory trajectory = Trajectory::readFromFile(trajectory_filename);
+  if (trajectory.length() < 2) {
+    cerr << "ERROR: Could not read trajectory from: " << trajectory_filename
+         << endl;
+    return -1;
+  }
+
+  ThreadPool thread_pool(n_threads);
+  vector<DmpModelSelection::Candidate> candidates;
+  auto start = chrono::steady_clock::now();
+  bool success = DmpModelSelection::evaluate(
+      trajectory, fa_class, n_bfs_list, heights, regularizations, candidates,
+      dmp_type, scaling, integration, &thread_pool);
+  chrono::duration<double> duration = chrono::steady_clock::now() - start;
+  if (!success) {
+    cerr << "ERROR: Could not train all Dmps." << endl;
+    return -1;
+  }
+  int i_best = DmpModelSelection::selectBest(candidates, max_error);
+  if (i_best < 0) {
+    cerr << "ERROR: The grid is empty." << endl;
+    return -1;
+  }
+
+  // The report contains one line per point on the grid
+  namespace fs = boost::filesystem;
+  fs::create_directories(output_directory);
+  string filename_report = (fs::path(output_directory) / "report.txt").string();
+  ofstream report(filename_report);
+  report << "# " << fa_class << " " << dmp_type << " " << scaling << " "
+         << integration << endl;
+  report << "# n_bfs  height  regularization  n_params  mean_abs_error  "
+         << "max_abs_error" << endl;
+  for (unsigned int i = 0; i < candidates.size(); i++) {
+    const DmpModelSelection::Candidate& c = candidates[i];
+    report << setw(7) << c.n_basis_functions << setw(8)
+           << c.intersection_height << setw(16) << c.regularization
+           << setw(10) << c.n_parameters << setw(16) << c.mean_absolute_error
+           << setw(15) << c.max_absolute_error
+           << ((int)i == i_best ? "  (best)" : "") << endl;
+  }
+  if (report.fail()) {
+    cerr << "ERROR: Could not write to: " << filename_report << endl;
+    return -1;
+  }
+
+  // Retrain the best Dmp, and save it
+  const DmpModelSelection::Candidate& best = candidates[i_best];
+  Dmp* dmp = Dmp::fromTrajectory(trajectory,
+                                 DmpModelSelection::toMetaParams(best),
+                                 dmp_type, scaling);
+  if (dmp == NULL) {
+    cerr << "ERROR: Could not train the best Dmp." << endl;
+    return -1;
+  }
+  json j = dmp;
+  delete dmp;
+  string filename_dmp = (fs::path(output_directory) / "dmp_best.json").string();
+  ofstream file(filename_dmp);
+  file << j.dump(4);
+  if (file.fail()) {
+    cerr << "ERROR: Could not write to: " << filename_dmp << endl;
+    return -1;
+  }
+
+  cout << "Evaluated " << candidates.size() << " Dmps with "
+       << thread_pool.n_threads() << " threads in " << duration.count() << "s"
+       << endl;
+  cout << "Best: n_bfs=" << best.n_basis_functions
+       << " intersection_height=" << best.intersection_height
+       << " regularization=" << best.regularization
+       << " mean_abs_error=" << best.mean_absolute_error << endl;
+  cout << "Wrote " << filename_report << " and " << filename_dmp << endl;
+  return 0;
+}
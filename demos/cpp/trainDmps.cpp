@@ -0,0 +1,143 @@
+/**
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <algorithm>
+#include <boost/filesystem.hpp>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+
+#include "dmp/Dmp.hpp"
+#include "dmp/Trajectory.hpp"
+#include "threadutils/ThreadPool.hpp"
+
+using namespace std;
+using namespace Eigen;
+using namespace nlohmann;
+using namespace DmpBbo;
+
+void help(char* binary_name)
+{
+  cout << "Usage: " << binary_name
+       << " <trajectory directory> <output directory> [fa_meta_params.json]"
+       << " [n_threads] [dmp_type] [forcing_term_scaling]" << endl;
+  cout << "Trains one Dmp for each trajectory file (*.txt) in the trajectory"
+       << " directory, and saves it as a json file with the same name in the"
+       << " output directory." << endl;
+  cout << "fa_meta_params.json contains the class and meta-parameters of the"
+       << " function approximators, e.g." << endl;
+  cout << "  {\"class\": \"FunctionApproximatorRBFN\", \"_meta_params\": "
+       << "{\"n_basis_functions_per_dim\": [10], \"intersection_height\": 0.7}}"
+       << endl;
+  cout << "which is also the default." << endl;
+}
+
+/** Main function
+ * \param[in] n_args Number of arguments
+ * \param[in] args Arguments themselves
+ * \return Success of exection. 0 if successful.
+ */
+int main(int n_args, char** args)
+{
+  if (n_args > 1 && string(args[1]).compare("--help") == 0) {
+    help(args[0]);
+    return 0;
+  }
+  if (n_args < 3 || n_args > 7) {
+    help(args[0]);
+    return -1;
+  }
+
+  string input_directory = args[1];
+  string output_directory = args[2];
+
+  json fa_meta_params = {
+      {"class", "FunctionApproximatorRBFN"},
+      {"_meta_params",
+       {{"n_basis_functions_per_dim", {10}}, {"intersection_height", 0.7}}}};
+  if (n_args > 3) {
+    ifstream file(args[3]);
+    if (file.fail()) {
+      cerr << "ERROR: Could not find file: " << args[3] << endl;
+      return -1;
+    }
+    fa_meta_params = json::parse(file);
+  }
+  int n_threads = (n_args > 4 ? atoi(args[4]) : 0);
+  string dmp_type = (n_args > 5 ? args[5] : "KULVICIUS_2012_JOINING");
+  string scaling = (n_args > 6 ? args[6] : "NO_SCALING");
+
+  // Get the trajectory files, sorted for reproducible output
+  namespace fs = boost::filesystem;
+  if (!fs::is_directory(input_directory)) {
+    cerr << "ERROR: Not a directory: " << input_directory << endl;
+    return -1;
+  }
+  vector<fs::path> filenames;
+  for (fs::directory_iterator it(input_directory);
+       it != fs::directory_iterator(); ++it)
+    if (fs::is_regular_file(it->path()) && it->path().extension() == ".txt")
+      filenames.push_back(it->path());
+  sort(filenames.begin(), filenames.end());
+  fs::create_directories(output_directory);
+
+  // Train the Dmps in parallel, one trajectory per task. The dimensions of
+  // each Dmp are trained in the same task, as there are usually many more
+  // trajectories than threads.
+  ThreadPool thread_pool(n_threads);
+  vector<char> success(filenames.size(), 0);
+  auto train_task = [&](int i_file) {
+    string filename = filenames[i_file].string();
+    Trajectory trajectory = Trajectory::readFromFile(filename);
+    if (trajectory.length() < 2) return;
+    Dmp* dmp =
+        Dmp::fromTrajectory(trajectory, fa_meta_params, dmp_type, scaling);
+    if (dmp == NULL) return;
+
+    json j = dmp;
+    delete dmp;
+    fs::path filename_out = fs::path(output_directory) /
+                            filenames[i_file].stem().replace_extension(".json");
+    ofstream file(filename_out.string());
+    file << j.dump();
+    success[i_file] = !file.fail();
+  };
+
+  auto start = chrono::steady_clock::now();
+  thread_pool.parallelFor(filenames.size(), train_task);
+  chrono::duration<double> duration = chrono::steady_clock::now() - start;
+
+  int n_failed = 0;
+  for (unsigned int i_file = 0; i_file < filenames.size(); i_file++) {
+    if (!success[i_file]) {
+      cerr << "ERROR: Could not train Dmp for " << filenames[i_file] << endl;
+      n_failed++;
+    }
+  }
+  cout << "Trained " << filenames.size() - n_failed << " Dmps with "
+       << thread_pool.n_threads() << " threads in " << duration.count() << "s"
+       << endl;
+
+  return (n_failed == 0 ? 0 : -1);
+}
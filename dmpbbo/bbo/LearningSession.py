@@ -31,6 +31,7 @@ import numpy as np
 from pylab import mean
 
 import dmpbbo.json_for_cpp as jc
+from dmpbbo.bbo.LearningSessionLog import LearningSessionLog
 
 # Avoid warnings when plotting very narrow covariance matrices
 warnings.simplefilter("ignore", np.ComplexWarning)
@@ -231,16 +232,28 @@ def plot_update(distribution, samples, weights, distribution_new, **kwargs):
 
 class LearningSession:
     """ Database for storing information about learning progress.
+
+    If a root directory is given, the information is saved to it, either with one file for each
+    object, or in a binary log (see LearningSessionLog) with one append for each call to tell()
+    or tell_all().
     """
 
-    def __init__(self, n_samples_per_update, root_directory=None, **kwargs):
+    log_filename = "session.dmpbbolog"
+
+    def __init__(self, n_samples_per_update, root_directory=None, binary_log=False, **kwargs):
 
         self._n_samples_per_update = n_samples_per_update
         self._root_dir = root_directory
         self._cache = {}
         self._last_update_added = None
 
-        self.tell(n_samples_per_update, "n_samples_per_update")
+        self._log = None
+        if root_directory and binary_log:
+            os.makedirs(root_directory, exist_ok=True)
+            self._log = LearningSessionLog(Path(root_directory, self.log_filename))
+
+        if self._log is None or not self._log.exists("n_samples_per_update"):
+            self.tell(n_samples_per_update, "n_samples_per_update")
 
         for name, value in kwargs.items():
             self.tell(value, name)
@@ -261,6 +274,14 @@ class LearningSession:
         @param directory: The directory to load from.
         @return: The learning session stored in the directory.
         """
+        log_filename = Path(directory, cls.log_filename)
+        if log_filename.is_file():
+            log = LearningSessionLog(log_filename, read_only=True)
+            n_samples_per_update = log.read("n_samples_per_update")
+            log.close()
+            n_samples_per_update = np.atleast_1d(n_samples_per_update)
+            return cls(int(n_samples_per_update[0]), directory, binary_log=True)
+
         filename = str(Path(directory, "n_samples_per_update.txt"))
         n_samples_per_update = np.atleast_1d(np.loadtxt(filename))
         n_samples_per_update = int(n_samples_per_update[0])
@@ -273,8 +294,7 @@ class LearningSession:
         @param eval_sample: The sample for which the evaluation was made.
         @param eval_cost: The cost of the evaluation sample
         """
-        self.tell(eval_cost, "eval_cost", i_update)
-        self.tell(eval_sample, "eval_sample", i_update)
+        self.tell_all([(eval_cost, "eval_cost"), (eval_sample, "eval_sample")], i_update)
 
     def add_update(self, i_update, distribution, samples, costs, weights, distribution_new=None):
         """ Add the information relevant to one distribution update.
@@ -286,12 +306,15 @@ class LearningSession:
         @param weights: The weights to perform the update (derived from the costs)
         @param distribution_new: The distribution after the update (optional).
         """
-        self.tell(distribution, "distribution", i_update)
-        self.tell(samples, "samples", i_update)
-        self.tell(costs, "costs", i_update)
-        self.tell(weights, "weights", i_update)
+        objects_and_names = [
+            (distribution, "distribution"),
+            (samples, "samples"),
+            (costs, "costs"),
+            (weights, "weights"),
+        ]
         if distribution_new is not None:
-            self.tell(distribution_new, "distribution_new", i_update)
+            objects_and_names.append((distribution_new, "distribution_new"))
+        self.tell_all(objects_and_names, i_update)
         self._last_update_added = i_update
 
     def get_n_updates(self):
@@ -301,6 +324,8 @@ class LearningSession:
         """
         if not self._root_dir:
             return self._last_update_added
+        elif self._log is not None:
+            return self._log.get_n_updates()
         else:
             update_dirs = sorted(glob(str(Path(self._root_dir, "update")) + "[0-9]*"))
             last_dir = update_dirs[-1]
@@ -346,6 +371,8 @@ class LearningSession:
         basename = self.get_base_name(name, i_update, i_sample)
         if basename in self._cache:
             return True
+        if self._log is not None:
+            return self._log.exists(Path(basename).as_posix())
         if self._root_dir is not None:
             abs_basename = Path(self._root_dir, basename)
             for extension in ["json", "txt"]:
@@ -371,6 +398,11 @@ class LearningSession:
             # Not in cache, and no directory given: Error
             raise KeyError(f"Could not find basename in cache: {basename}")
 
+        elif self._log is not None:
+            obj = self._log.read(Path(basename).as_posix())
+            self._cache[basename] = obj
+            return obj
+
         else:
             abs_basename = Path(self._root_dir, basename)
             if os.path.isfile(f"{abs_basename}.json"):
@@ -397,9 +429,41 @@ class LearningSession:
         """
         basename = self.get_base_name(name, i_update, i_sample)
         self._cache[basename] = copy.deepcopy(obj)
-        if self._root_dir is not None:
+        if self._log is not None:
+            self._log.append_all(self._log_entries(obj, basename))
+        elif self._root_dir is not None:
             return LearningSession.save(obj, self._root_dir, basename)
 
+    def tell_all(self, objects_and_names, i_update=None, i_sample=None):
+        """ Add several objects with the same update and sample number to the database.
+
+        With a binary log, the objects are appended to it with one write.
+
+        @param objects_and_names:  List of (object, name) tuples
+        @param i_update:  The update number
+        @param i_sample:  The sample number
+        """
+        if self._log is None:
+            for obj, name in objects_and_names:
+                self.tell(obj, name, i_update, i_sample)
+            return
+
+        entries = []
+        for obj, name in objects_and_names:
+            basename = self.get_base_name(name, i_update, i_sample)
+            self._cache[basename] = copy.deepcopy(obj)
+            entries.extend(self._log_entries(obj, basename))
+        self._log.append_all(entries)
+
+    def _log_entries(self, obj, basename):
+        """ Get the entries to append to the binary log for one object.
+
+        @param obj:  The object to add
+        @param basename:  The basename of the object (see get_base_name)
+        @return: List of (key, object) tuples
+        """
+        return [(Path(basename).as_posix(), obj)]
+
     @staticmethod
     def save(obj, directory, basename):
         """ Save an object to a file.
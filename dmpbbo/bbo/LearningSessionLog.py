@@ -0,0 +1,299 @@
+# This file is part of DmpBbo, a set of libraries and programs for the
+# black-box optimization of dynamical movement primitives.
+# Copyright (C) 2026 The DmpBbo contributors
+#
+# DmpBbo is free software: you can redistribute it and/or modify
+# it under the terms of the GNU Lesser General Public License as published by
+# the Free Software Foundation, either version 2 of the License, or
+# (at your option) any later version.
+#
+# DmpBbo is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public License
+# along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+""" Module for the LearningSessionLog class. """
+
+import os
+import struct
+
+import jsonpickle
+import numpy as np
+
+_DATA_MAGIC = b"DMPBBOLG"
+_INDEX_MAGIC = b"DMPBBOIX"
+_RECORD_MAGIC = b"DBSR"
+_VERSION = 1
+
+_FILE_HEADER = struct.Struct("<8sII")  # magic, version, reserved
+_HEADER = struct.Struct("<BBHQ")  # kind, n_dims, key length, payload size
+_OFFSET = struct.Struct("<Q")
+
+FLOAT64_ARRAY = 0
+JSON_TEXT = 1
+
+
+class LearningSessionLog:
+    """ Append-only binary log of a learning session.
+
+    The log stores the objects of a learning session (samples, costs, cost_vars, distributions,
+    ...) in a single file, rather than in one file per object. Objects are identified by the
+    basenames of LearningSession, e.g. "update00003/006_cost_vars". Float64 arrays, and lists of
+    floats, are stored as float64 arrays, all other objects (including ints and bools) as
+    jsonpickle text.
+
+    The container format is the same as that of the C++ class LearningSessionLog (see
+    src/bbo/LearningSessionLog.hpp). JSON text is written with jsonpickle though, which the C++
+    class does not convert back to objects such as distributions. In short, the data
+    file contains the records (header, key and payload), and the index file (the data file name
+    with ".idx" appended) contains the offset of each payload and the record header. Opening a
+    log only reads the index; payloads are read on demand.
+    """
+
+    def __init__(self, filename, read_only=False):
+        """ Open a log, and create it if it does not exist yet.
+
+        @param filename: Name of the data file, e.g. "session.dmpbbolog"
+        @param read_only: Whether to open the log for reading only (default: False)
+        """
+        self._filename = str(filename)
+        self._index_filename = self._filename + ".idx"
+        self._read_only = read_only
+        self._index = {}  # key => (offset, size, kind, dims)
+        self._data_size = _FILE_HEADER.size
+
+        if not read_only and not os.path.isfile(self._filename):
+            header = _FILE_HEADER.pack(_DATA_MAGIC, _VERSION, 0)
+            with open(self._filename, "wb") as f:
+                f.write(header)
+            with open(self._index_filename, "wb") as f:
+                f.write(_FILE_HEADER.pack(_INDEX_MAGIC, _VERSION, 0))
+
+        self._data_in = open(self._filename, "rb")
+        self._data_out = None
+        self._index_out = None
+        self._read_index()
+
+    def __del__(self):
+        self.close()
+
+    def close(self):
+        """ Close the files of the log. """
+        for f in [self._data_in, self._data_out, self._index_out]:
+            if f is not None and not f.closed:
+                f.close()
+
+    @staticmethod
+    def _check_file_header(header, magic, filename):
+        if len(header) < _FILE_HEADER.size:
+            return False
+        file_magic, version, _ = _FILE_HEADER.unpack_from(header)
+        if file_magic != magic:
+            return False
+        if version > _VERSION:
+            raise IOError(f"Log '{filename}' has unknown version {version}")
+        return True
+
+    @staticmethod
+    def _parse_header(buffer, pos):
+        """ Parse the part of a record header that is shared with the index entries, and the key.
+
+        @return: (kind, dims, size, key, position after the key), or None if incomplete.
+        """
+        if pos + _HEADER.size > len(buffer):
+            return None
+        kind, n_dims, key_length, size = _HEADER.unpack_from(buffer, pos)
+        pos += _HEADER.size
+        if pos + 8 * n_dims + key_length > len(buffer):
+            return None
+        dims = struct.unpack_from(f"<{n_dims}Q", buffer, pos)
+        pos += 8 * n_dims
+        key = bytes(buffer[pos : pos + key_length]).decode("utf-8")
+        return kind, dims, size, key, pos + key_length
+
+    @staticmethod
+    def _pack_header(kind, dims, size, key):
+        key = key.encode("utf-8")
+        header = _HEADER.pack(kind, len(dims), len(key), size)
+        return header + struct.pack(f"<{len(dims)}Q", *dims) + key
+
+    def _read_index(self):
+        data_file_size = os.path.getsize(self._filename)
+        header = self._data_in.read(_FILE_HEADER.size)
+        if not self._check_file_header(header, _DATA_MAGIC, self._filename):
+            raise IOError(f"Could not read log '{self._filename}'")
+
+        # Read the entries from the index, up to the first incomplete one
+        index_valid_size = 0
+        if os.path.isfile(self._index_filename):
+            with open(self._index_filename, "rb") as f:
+                buffer = f.read()
+            if self._check_file_header(buffer, _INDEX_MAGIC, self._index_filename):
+                pos = _FILE_HEADER.size
+                index_valid_size = pos
+                while pos + _OFFSET.size <= len(buffer):
+                    (offset,) = _OFFSET.unpack_from(buffer, pos)
+                    parsed = self._parse_header(buffer, pos + _OFFSET.size)
+                    if parsed is None:
+                        break
+                    kind, dims, size, key, pos = parsed
+                    if offset + size > data_file_size:
+                        break
+                    self._index[key] = (offset, size, kind, dims)
+                    self._data_size = max(self._data_size, offset + size)
+                    index_valid_size = pos
+
+        # Recover the entries of the records that are not in the index
+        recovered = b""
+        self._data_in.seek(self._data_size)
+        while True:
+            magic = self._data_in.read(len(_RECORD_MAGIC))
+            if magic != _RECORD_MAGIC:
+                break
+            header = self._data_in.read(_HEADER.size)
+            if len(header) < _HEADER.size:
+                break
+            _, n_dims, key_length, _ = _HEADER.unpack(header)
+            buffer = header + self._data_in.read(8 * n_dims + key_length)
+            parsed = self._parse_header(buffer, 0)
+            if parsed is None:
+                break
+            kind, dims, size, key, _ = parsed
+            offset = self._data_in.tell()
+            if offset + size > data_file_size:
+                break
+            self._index[key] = (offset, size, kind, dims)
+            recovered += _OFFSET.pack(offset) + self._pack_header(kind, dims, size, key)
+            self._data_size = offset + size
+            self._data_in.seek(self._data_size)
+
+        if self._read_only:
+            return
+
+        # Repair the files, and open them for appending
+        if index_valid_size < _FILE_HEADER.size:
+            with open(self._index_filename, "wb") as f:
+                f.write(_FILE_HEADER.pack(_INDEX_MAGIC, _VERSION, 0))
+            index_valid_size = _FILE_HEADER.size
+        if os.path.getsize(self._index_filename) > index_valid_size:
+            os.truncate(self._index_filename, index_valid_size)
+        if data_file_size > self._data_size:
+            os.truncate(self._filename, self._data_size)
+            # Do not read stale bytes of the removed records from the buffer
+            self._data_in.close()
+            self._data_in = open(self._filename, "rb")
+
+        self._data_out = open(self._filename, "ab")
+        self._index_out = open(self._index_filename, "ab")
+        self._index_out.write(recovered)
+        self._index_out.flush()
+
+    def append(self, key, obj):
+        """ Append an object to the log.
+
+        @param key: The key of the object, e.g. "update00003/006_cost_vars"
+        @param obj: The object to append.
+        """
+        self.append_all([(key, obj)])
+
+    @staticmethod
+    def _as_float64_array(obj):
+        """ Get an object as a float64 array, if it is stored as one.
+
+        Only float64 arrays, and lists that numpy converts to a floating point array, are stored
+        as float64 arrays, so that read() returns the values that were appended.
+
+        @param obj: The object to append.
+        @return: The float64 array (at least 1D), or None if the object is stored as JSON text.
+        """
+        if isinstance(obj, np.ndarray):
+            if obj.dtype != np.float64:
+                return None
+            array = obj
+        elif isinstance(obj, list):
+            try:
+                array = np.asarray(obj)
+            except ValueError:  # E.g. lists of lists with different lengths
+                return None
+            if array.dtype.kind != "f":
+                return None
+        else:
+            return None
+        return np.atleast_1d(array.astype("<f8", copy=False))
+
+    def append_all(self, keys_and_objects):
+        """ Append several objects to the log, with one write to the data and index file.
+
+        @param keys_and_objects: List of (key, object) tuples
+        """
+        if self._read_only:
+            raise IOError(f"Cannot append to log '{self._filename}' opened for reading only")
+
+        data = []
+        index = []
+        entries = []
+        offset = self._data_size
+        for key, obj in keys_and_objects:
+            array = self._as_float64_array(obj)
+            if array is not None:
+                kind, dims, payload = FLOAT64_ARRAY, array.shape, array.tobytes(order="C")
+            else:
+                kind, dims, payload = JSON_TEXT, (), jsonpickle.encode(obj).encode("utf-8")
+
+            header = _RECORD_MAGIC + self._pack_header(kind, dims, len(payload), key)
+            offset += len(header)
+            data.extend([header, payload])
+            index.append(_OFFSET.pack(offset) + header[len(_RECORD_MAGIC) :])
+            entries.append((key, (offset, len(payload), kind, dims)))
+            offset += len(payload)
+
+        self._data_out.write(b"".join(data))
+        self._data_out.flush()
+        self._index_out.write(b"".join(index))
+        self._index_out.flush()
+
+        self._index.update(entries)
+        self._data_size = offset
+
+    def exists(self, key):
+        """ Check whether the log contains an object.
+
+        @param key: The key of the object
+        @return: True if the object is in the log, False otherwise.
+        """
+        return key in self._index
+
+    def keys(self):
+        """ Get the keys of all objects in the log, in the order in which they were first appended.
+
+        @return: The keys
+        """
+        return list(self._index.keys())
+
+    def get_n_updates(self):
+        """ Get the highest update number in the keys of the log.
+
+        @return: The highest update number (None if there are no updates in the log)
+        """
+        updates = [int(k[6:11]) for k in self._index if k.startswith("update")]
+        return max(updates) if updates else None
+
+    def read(self, key):
+        """ Read an object from the log.
+
+        @param key: The key of the object
+        @return: The object
+        """
+        if key not in self._index:
+            raise KeyError(f"Could not find key in log: {key}")
+        offset, size, kind, dims = self._index[key]
+        self._data_in.seek(offset)
+        payload = self._data_in.read(size)
+        if len(payload) < size:
+            raise IOError(f"Could not read '{key}' from log '{self._filename}'")
+
+        if kind == FLOAT64_ARRAY:
+            return np.frombuffer(payload, dtype="<f8").reshape(dims).copy()
+        return jsonpickle.decode(payload.decode("utf-8"))
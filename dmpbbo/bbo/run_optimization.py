@@ -21,7 +21,13 @@ from dmpbbo.bbo.LearningSession import LearningSession
 
 
 def run_optimization(
-    cost_function, initial_distribution, updater, n_updates, n_samples_per_update, directory=None
+    cost_function,
+    initial_distribution,
+    updater,
+    n_updates,
+    n_samples_per_update,
+    directory=None,
+    binary_log=False,
 ):
     """ Run an evolutionary optimization process, see \ref page_bbo
 
@@ -31,6 +37,8 @@ def run_optimization(
         @param n_updates: The number of updates to perform
         @param n_samples_per_update: The number of samples per update
         @param directory: Optional directory to save to (default: don't save)
+        @param binary_log: Save to a binary log in the directory, rather than to one file for each
+        object (default: False)
         @return: A learning curve that has the following format
         #rows is number of optimization updates
         column 0: Number of samples at which the cost was evaluated
@@ -39,7 +47,11 @@ def run_optimization(
     """
 
     session = LearningSession(
-        n_samples_per_update, directory, cost_function=cost_function, updater=updater
+        n_samples_per_update,
+        directory,
+        binary_log=binary_log,
+        cost_function=cost_function,
+        updater=updater,
     )
 
     distribution = initial_distribution
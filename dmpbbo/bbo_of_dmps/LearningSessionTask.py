@@ -17,6 +17,7 @@
 """ Module for the LearningSessionTask class. """
 
 import inspect
+import json
 from pathlib import Path
 
 import numpy as np
@@ -50,9 +51,9 @@ class LearningSessionTask(LearningSession):
         @param i_update:  The update number
         @param i_sample:  The sample number
         """
-        # If it's a Dmp, save it in a C++-readable format also
+        # If it's a Dmp, save it in a C++-readable format also (see _log_entries for binary logs)
         if "dmp" in name:
-            if self._root_dir is not None:
+            if self._root_dir is not None and self._log is None:
                 basename = self.get_base_name(name, i_update, i_sample)
                 abs_basename = Path(self._root_dir, basename)
                 jc.savejson(f"{abs_basename}.json", obj)
@@ -61,6 +62,20 @@ class LearningSessionTask(LearningSession):
         filename = super().tell(obj, name, i_update, i_sample)
         return filename
 
+    def _log_entries(self, obj, basename):
+        """ Get the entries to append to the binary log for one object.
+
+        @param obj:  The object to add
+        @param basename:  The basename of the object (see get_base_name)
+        @return: List of (key, object) tuples
+        """
+        entries = super()._log_entries(obj, basename)
+        # If it's a Dmp, add it in a C++-readable format also
+        if "dmp" in Path(basename).name:
+            obj_for_cpp = json.loads(jc.dumps_for_cpp(obj))
+            entries.append((f"{Path(basename).as_posix()}_for_cpp", obj_for_cpp))
+        return entries
+
     def add_rollout(self, i_update, i_sample, sample, cost_vars, cost):
         """
 
@@ -70,9 +85,8 @@ class LearningSessionTask(LearningSession):
         @param cost_vars: The cost-relevant variables for the rollout.
         @param cost: The cost of the rollout
         """
-        self.tell(sample, "sample", i_update, i_sample)
-        self.tell(cost_vars, "cost_vars", i_update, i_sample)
-        self.tell(cost, "cost", i_update, i_sample)
+        objects_and_names = [(sample, "sample"), (cost_vars, "cost_vars"), (cost, "cost")]
+        self.tell_all(objects_and_names, i_update, i_sample)
 
     def add_eval_task(self, i_update, eval_sample, eval_cost_vars, eval_cost):
         """ Add an evaluation of the task
@@ -82,8 +96,12 @@ class LearningSessionTask(LearningSession):
         @param eval_sample: The sample for which the evaluation was made.
         @param eval_cost: The cost of the evaluation sample
         """
-        super().add_eval(i_update, eval_sample, eval_cost)
-        self.tell(eval_cost_vars, "eval_cost_vars", i_update)
+        objects_and_names = [
+            (eval_cost, "eval_cost"),
+            (eval_sample, "eval_sample"),
+            (eval_cost_vars, "eval_cost_vars"),
+        ]
+        self.tell_all(objects_and_names, i_update)
 
     @staticmethod
     def _set_style(handle, i_update, n_updates):
@@ -27,6 +27,7 @@ def run_optimization_task(
     n_updates,
     n_samples_per_update,
     directory=None,
+    binary_log=False,
 ):
     """ Run the optimization of a task with a task solver
 
@@ -37,10 +38,17 @@ def run_optimization_task(
     @param n_updates: The number of updates in the optimization.
     @param n_samples_per_update:  The number of samples for one update
     @param directory:  The directory to save results to (default: None)
+    @param binary_log:  Save to a binary log in the directory, rather than to one file for each
+    object (default: False)
     @return: The learning session (see LearningSessionTask)
     """
     session = LearningSessionTask(
-        n_samples_per_update, directory, task=task, task_solver=task_solver, updater=updater
+        n_samples_per_update,
+        directory,
+        binary_log=binary_log,
+        task=task,
+        task_solver=task_solver,
+        updater=updater,
     )
 
     distribution = initial_distribution
@@ -53,6 +53,15 @@ class DmpBboJSONEncoder(JSONEncoder):
         return json.JSONEncoder.default(self, obj)
 
 
+def dumps_for_cpp(obj):
+    """ Convert an object to a json string that can be read by the C++ implementation of dmpbbo.
+
+    @param obj: Object to convert.
+    @return: The json string
+    """
+    return json.dumps(obj, cls=DmpBboJSONEncoder, indent=2)
+
+
 def savejson_for_cpp(filename, obj):
     """ Save an object to a file that can be read by the C++ implementation of dmpbbo.
 
@@ -61,7 +70,7 @@ def savejson_for_cpp(filename, obj):
     """
     # Save a simple JSON version that can be read by the C++ code.
     filename = str(filename)  # In case it is path
-    j = json.dumps(obj, cls=DmpBboJSONEncoder, indent=2)
+    j = dumps_for_cpp(obj)
     with open(filename, "w") as out_file:
         out_file.write(j)
 
@@ -0,0 +1,426 @@
+/**
+ * @file LearningSessionLog.cpp
+ * @brief  LearningSessionLog class source file.
+ *
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "bbo/LearningSessionLog.hpp"
+
+#include <boost/filesystem.hpp>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <nlohmann/json.hpp>
+
+using namespace std;
+using namespace Eigen;
+
+namespace DmpBbo {
+
+namespace {
+
+const char* kDataMagic = "DMPBBOLG";
+const char* kIndexMagic = "DMPBBOIX";
+const char* kRecordMagic = "DBSR";
+const uint32_t kVersion = 1;
+const uint64_t kFileHeaderSize = 16;
+
+/** Append the bytes of a number to a buffer (little-endian hosts only). */
+template <typename T>
+void put(string& buffer, T value)
+{
+  buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+/** Read a number from a stream (little-endian hosts only). */
+template <typename T>
+bool get(istream& in, T& value)
+{
+  in.read(reinterpret_cast<char*>(&value), sizeof(T));
+  return in.good();
+}
+
+/** Header of the data file or the index file. */
+string fileHeader(const char* magic)
+{
+  string header(magic, 8);
+  put<uint32_t>(header, kVersion);
+  put<uint32_t>(header, 0);
+  return header;
+}
+
+/** Read and check the header of the data file or the index file. */
+bool readFileHeader(istream& in, const char* magic)
+{
+  char file_magic[8];
+  uint32_t version, reserved;
+  in.read(file_magic, 8);
+  if (!in.good() || memcmp(file_magic, magic, 8) != 0) return false;
+  if (!get(in, version) || !get(in, reserved)) return false;
+  return version <= kVersion;
+}
+
+/** Read the part of a record header that is shared with the index entries,
+ * and the key. */
+bool readHeader(istream& in, uint8_t& kind, vector<uint64_t>& dims,
+                uint64_t& size, string& key)
+{
+  uint8_t n_dims;
+  uint16_t key_length;
+  if (!get(in, kind) || !get(in, n_dims) || !get(in, key_length)) return false;
+  if (!get(in, size)) return false;
+  dims.resize(n_dims);
+  for (uint8_t i_dim = 0; i_dim < n_dims; i_dim++)
+    if (!get(in, dims[i_dim])) return false;
+  key.resize(key_length);
+  if (key_length > 0) in.read(&key[0], key_length);
+  return in.good();
+}
+
+/** Write the part of a record header that is shared with the index entries,
+ * and the key. */
+void putHeader(string& buffer, uint8_t kind, const vector<uint64_t>& dims,
+               uint64_t size, const string& key)
+{
+  put<uint8_t>(buffer, kind);
+  put<uint8_t>(buffer, dims.size());
+  put<uint16_t>(buffer, key.size());
+  put<uint64_t>(buffer, size);
+  for (unsigned int i_dim = 0; i_dim < dims.size(); i_dim++)
+    put<uint64_t>(buffer, dims[i_dim]);
+  buffer.append(key);
+}
+
+/** Size of a file, or 0 if it does not exist. */
+uint64_t fileSize(const string& filename)
+{
+  boost::system::error_code error;
+  uintmax_t size = boost::filesystem::file_size(filename, error);
+  return error ? 0 : size;
+}
+
+}  // namespace
+
+LearningSessionLog::LearningSessionLog(const string& filename, bool read_only)
+    : filename_(filename), read_only_(read_only), data_size_(kFileHeaderSize)
+{
+}
+
+LearningSessionLog::~LearningSessionLog(void) {}
+
+LearningSessionLog* LearningSessionLog::open(const string& filename,
+                                             bool read_only)
+{
+  if (!read_only && !boost::filesystem::exists(filename)) {
+    ofstream data_file(filename.c_str(), ios::binary);
+    ofstream index_file((filename + ".idx").c_str(), ios::binary);
+    data_file << fileHeader(kDataMagic);
+    index_file << fileHeader(kIndexMagic);
+    if (!data_file.good() || !index_file.good()) {
+      cerr << __FILE__ << ":" << __LINE__ << ":";
+      cerr << "Could not create log '" << filename << "'" << endl;
+      return NULL;
+    }
+  }
+
+  LearningSessionLog* log = new LearningSessionLog(filename, read_only);
+  if (!log->readIndex()) {
+    delete log;
+    return NULL;
+  }
+  return log;
+}
+
+bool LearningSessionLog::readIndex(void)
+{
+  data_in_.open(filename_.c_str(), ios::binary);
+  if (!data_in_.is_open() || !readFileHeader(data_in_, kDataMagic)) {
+    cerr << __FILE__ << ":" << __LINE__ << ":";
+    cerr << "Could not read log '" << filename_ << "'" << endl;
+    return false;
+  }
+  uint64_t data_file_size = fileSize(filename_);
+
+  // Read the entries from the index, up to the first incomplete one
+  string index_filename = filename_ + ".idx";
+  uint64_t index_valid_size = 0;
+  ifstream index_in(index_filename.c_str(), ios::binary);
+  if (index_in.is_open() && readFileHeader(index_in, kIndexMagic)) {
+    index_valid_size = kFileHeaderSize;
+    IndexEntry entry;
+    string key;
+    while (get(index_in, entry.offset) &&
+           readHeader(index_in, entry.kind, entry.dims, entry.size, key)) {
+      if (entry.offset + entry.size > data_file_size) break;
+      addToIndex(key, entry);
+      data_size_ = max(data_size_, entry.offset + entry.size);
+      index_valid_size = index_in.tellg();
+    }
+  }
+  index_in.close();
+
+  // Recover the entries of the records that are not in the index
+  string recovered;
+  data_in_.clear();
+  data_in_.seekg(data_size_);
+  char magic[4];
+  IndexEntry entry;
+  string key;
+  while (data_in_.read(magic, 4) && memcmp(magic, kRecordMagic, 4) == 0 &&
+         readHeader(data_in_, entry.kind, entry.dims, entry.size, key)) {
+    entry.offset = data_in_.tellg();
+    if (entry.offset + entry.size > data_file_size) break;
+    addToIndex(key, entry);
+    put<uint64_t>(recovered, entry.offset);
+    putHeader(recovered, entry.kind, entry.dims, entry.size, key);
+    data_size_ = entry.offset + entry.size;
+    data_in_.seekg(data_size_);
+  }
+  data_in_.clear();
+
+  if (read_only_) return true;
+
+  // Repair the files, and open them for appending
+  if (index_valid_size < kFileHeaderSize) {
+    ofstream index_file(index_filename.c_str(), ios::binary);
+    index_file << fileHeader(kIndexMagic);
+    index_valid_size = kFileHeaderSize;
+  }
+  if (fileSize(index_filename) > index_valid_size)
+    boost::filesystem::resize_file(index_filename, index_valid_size);
+  if (data_file_size > data_size_) {
+    boost::filesystem::resize_file(filename_, data_size_);
+    // Do not read stale bytes of the removed records from the buffer
+    data_in_.close();
+    data_in_.open(filename_.c_str(), ios::binary);
+  }
+
+  data_out_.open(filename_.c_str(), ios::binary | ios::app);
+  index_out_.open(index_filename.c_str(), ios::binary | ios::app);
+  index_out_.write(recovered.data(), recovered.size());
+  index_out_.flush();
+  if (!data_out_.good() || !index_out_.good()) {
+    cerr << __FILE__ << ":" << __LINE__ << ":";
+    cerr << "Could not open log '" << filename_ << "' for appending" << endl;
+    return false;
+  }
+  return true;
+}
+
+void LearningSessionLog::addToIndex(const string& key, const IndexEntry& entry)
+{
+  if (index_.find(key) == index_.end()) keys_.push_back(key);
+  index_[key] = entry;
+}
+
+string LearningSessionLog::key(const string& name, int i_update, int i_sample)
+{
+  if (i_sample < 0) return key(name, i_update, "");
+  char prefix[16];
+  snprintf(prefix, sizeof(prefix), "%03d", i_sample);
+  return key(name, i_update, string(prefix));
+}
+
+string LearningSessionLog::key(const string& name, int i_update,
+                               const string& prefix)
+{
+  string basename = prefix.empty() ? name : prefix + "_" + name;
+  if (i_update < 0) return basename;
+  char update_dir[32];
+  snprintf(update_dir, sizeof(update_dir), "update%05d/", i_update);
+  return string(update_dir) + basename;
+}
+
+LearningSessionLog::Record LearningSessionLog::makeArrayRecord(
+    const string& key, const vector<uint64_t>& dims, const double* data)
+{
+  uint64_t n_values = 1;
+  for (unsigned int i_dim = 0; i_dim < dims.size(); i_dim++)
+    n_values *= dims[i_dim];
+
+  Record record;
+  record.key = key;
+  record.kind = FLOAT64_ARRAY;
+  record.dims = dims;
+  record.payload.assign(reinterpret_cast<const char*>(data),
+                        n_values * sizeof(double));
+  return record;
+}
+
+bool LearningSessionLog::appendMatrix(const string& key,
+                                      const MatrixXd& matrix)
+{
+  Matrix<double, Dynamic, Dynamic, RowMajor> row_major = matrix;
+  vector<uint64_t> dims(2);
+  dims[0] = matrix.rows();
+  dims[1] = matrix.cols();
+  return append(
+      vector<Record>(1, makeArrayRecord(key, dims, row_major.data())));
+}
+
+bool LearningSessionLog::appendVector(const string& key,
+                                      const VectorXd& vector)
+{
+  std::vector<uint64_t> dims(1, vector.size());
+  return append(
+      std::vector<Record>(1, makeArrayRecord(key, dims, vector.data())));
+}
+
+bool LearningSessionLog::appendJson(const string& key, const nlohmann::json& j)
+{
+  Record record;
+  record.key = key;
+  record.kind = JSON_TEXT;
+  record.payload = j.dump();
+  return append(vector<Record>(1, record));
+}
+
+bool LearningSessionLog::appendRollout(int i_update, int i_sample,
+                                       const VectorXd& sample,
+                                       const MatrixXd& cost_vars,
+                                       const VectorXd& cost)
+{
+  Matrix<double, Dynamic, Dynamic, RowMajor> cost_vars_row_major = cost_vars;
+  vector<uint64_t> dims_cost_vars(2);
+  dims_cost_vars[0] = cost_vars.rows();
+  dims_cost_vars[1] = cost_vars.cols();
+
+  vector<Record> records;
+  records.push_back(makeArrayRecord(key("sample", i_update, i_sample),
+                                    vector<uint64_t>(1, sample.size()),
+                                    sample.data()));
+  records.push_back(makeArrayRecord(key("cost_vars", i_update, i_sample),
+                                    dims_cost_vars,
+                                    cost_vars_row_major.data()));
+  records.push_back(makeArrayRecord(key("cost", i_update, i_sample),
+                                    vector<uint64_t>(1, cost.size()),
+                                    cost.data()));
+  return append(records);
+}
+
+bool LearningSessionLog::append(const vector<Record>& records)
+{
+  if (read_only_) {
+    cerr << __FILE__ << ":" << __LINE__ << ":";
+    cerr << "Cannot append to log opened for reading only." << endl;
+    return false;
+  }
+
+  string data;
+  string index;
+  vector<IndexEntry> entries(records.size());
+  uint64_t offset = data_size_;
+  for (unsigned int i = 0; i < records.size(); i++) {
+    const Record& record = records[i];
+    data.append(kRecordMagic, 4);
+    putHeader(data, record.kind, record.dims, record.payload.size(),
+              record.key);
+    entries[i].offset = offset + data.size();
+    entries[i].size = record.payload.size();
+    entries[i].kind = record.kind;
+    entries[i].dims = record.dims;
+    data.append(record.payload);
+
+    put<uint64_t>(index, entries[i].offset);
+    putHeader(index, record.kind, record.dims, record.payload.size(),
+              record.key);
+  }
+
+  data_out_.write(data.data(), data.size());
+  data_out_.flush();
+  index_out_.write(index.data(), index.size());
+  index_out_.flush();
+  if (!data_out_.good() || !index_out_.good()) {
+    cerr << __FILE__ << ":" << __LINE__ << ":";
+    cerr << "Could not append to log '" << filename_ << "'" << endl;
+    return false;
+  }
+
+  for (unsigned int i = 0; i < records.size(); i++)
+    addToIndex(records[i].key, entries[i]);
+  data_size_ = offset + data.size();
+  return true;
+}
+
+bool LearningSessionLog::exists(const string& key) const
+{
+  return index_.find(key) != index_.end();
+}
+
+vector<string> LearningSessionLog::keys(void) const { return keys_; }
+
+int LearningSessionLog::getNumberOfUpdates(void) const
+{
+  int n_updates = 0;
+  for (unsigned int i = 0; i < keys_.size(); i++) {
+    int i_update;
+    if (sscanf(keys_[i].c_str(), "update%d/", &i_update) == 1)
+      n_updates = max(n_updates, i_update + 1);
+  }
+  return n_updates;
+}
+
+bool LearningSessionLog::readPayload(const IndexEntry& entry,
+                                     char* payload) const
+{
+  data_in_.clear();
+  data_in_.seekg(entry.offset);
+  data_in_.read(payload, entry.size);
+  return data_in_.good();
+}
+
+bool LearningSessionLog::readMatrix(const string& key, MatrixXd& matrix) const
+{
+  map<string, IndexEntry>::const_iterator it = index_.find(key);
+  if (it == index_.end() || it->second.kind != FLOAT64_ARRAY ||
+      it->second.dims.size() > 2) {
+    cerr << __FILE__ << ":" << __LINE__ << ":";
+    cerr << "No matrix with key '" << key << "' in log." << endl;
+    return false;
+  }
+
+  const IndexEntry& entry = it->second;
+  int n_rows = entry.dims.size() > 0 ? entry.dims[0] : 1;
+  int n_cols = entry.dims.size() > 1 ? entry.dims[1] : 1;
+  if (entry.size != n_rows * n_cols * sizeof(double)) return false;
+
+  Matrix<double, Dynamic, Dynamic, RowMajor> row_major(n_rows, n_cols);
+  if (!readPayload(entry, reinterpret_cast<char*>(row_major.data())))
+    return false;
+  matrix = row_major;
+  return true;
+}
+
+bool LearningSessionLog::readJson(const string& key, nlohmann::json& j) const
+{
+  map<string, IndexEntry>::const_iterator it = index_.find(key);
+  if (it == index_.end() || it->second.kind != JSON_TEXT) {
+    cerr << __FILE__ << ":" << __LINE__ << ":";
+    cerr << "No JSON object with key '" << key << "' in log." << endl;
+    return false;
+  }
+
+  string payload(it->second.size, '\0');
+  if (payload.size() > 0 && !readPayload(it->second, &payload[0]))
+    return false;
+  j = nlohmann::json::parse(payload, nullptr, false);
+  return !j.is_discarded();
+}
+
+}  // namespace DmpBbo
@@ -0,0 +1,307 @@
+/**
+ * @file LearningSessionLog.hpp
+ * @brief  LearningSessionLog class header file.
+ *
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _LEARNING_SESSION_LOG_H_
+#define _LEARNING_SESSION_LOG_H_
+
+#include <stdint.h>
+
+#include <eigen3/Eigen/Core>
+#include <fstream>
+#include <map>
+#include <nlohmann/json_fwd.hpp>
+#include <string>
+#include <vector>
+
+namespace DmpBbo {
+
+/**
+ * \brief Append-only binary log of a learning session.
+ *
+ * The log stores the same objects as the directory of a learning session
+ * written by the Python class dmpbbo.bbo.LearningSession (samples, costs,
+ * cost_vars, distributions, ...), but in a single file. Objects are
+ * identified by the same keys as the files in such a directory, e.g.
+ * "update00003/006_cost_vars", cf. key(). Storing an object appends one
+ * record to the log, rather than creating a file. The Python class
+ * dmpbbo.bbo.LearningSessionLog uses the same container format. The JSON
+ * text it writes is made with jsonpickle though, e.g. with "py/object" tags
+ * for distributions. readJson() returns such text as is, rather than
+ * converting it to the corresponding C++ objects.
+ *
+ * The log consists of two files. The data file (e.g. "session.dmpbbolog")
+ * starts with a header (the magic string "DMPBBOLG", and the uint32 format
+ * version and a uint32 that is 0), which is followed by the records. Each
+ * record has a header, the key (UTF-8) and the payload:
+ * \code
+ * char[4]  magic "DBSR"
+ * uint8    kind (0: float64 array in row-major order, 1: JSON text)
+ * uint8    number of dimensions of the array (0 for JSON text)
+ * uint16   length of the key in bytes
+ * uint64   size of the payload in bytes
+ * uint64[] size of each dimension of the array
+ * \endcode
+ * All numbers are little-endian. The index file (the data file name with
+ * ".idx" appended) has the same header (with the magic string "DMPBBOIX"),
+ * followed by one entry per record. Each entry contains the offset of the
+ * payload in the data file (uint64), followed by the record header without
+ * its magic string, and the key. The index is small, so opening a log only
+ * requires reading the index; the payloads are read on demand.
+ *
+ * If the index is behind the data file (e.g. because a program was
+ * interrupted between the two writes), the missing entries are recovered by
+ * scanning the headers of the records in the data file. Incomplete records
+ * at the end of the data file are ignored, and removed before appending.
+ *
+ * If a key is appended several times, the last record is returned.
+ */
+class LearningSessionLog {
+ public:
+  /** Kind of payload of a record. */
+  enum RecordKind {
+    /** Array of doubles, stored in row-major order. */
+    FLOAT64_ARRAY = 0,
+    /** JSON text. */
+    JSON_TEXT = 1
+  };
+
+  /**
+   * Open a log, and create it if it does not exist yet.
+   *
+   * \param[in] filename Name of the data file, e.g. "session.dmpbbolog"
+   * \param[in] read_only Whether to open the log for reading only. The log
+   * must then exist already.
+   * \return The log, or NULL if it could not be opened. The caller is
+   * responsible for deleting it.
+   */
+  static LearningSessionLog* open(const std::string& filename,
+                                  bool read_only = false);
+
+  /** Destructor, which closes the files. */
+  ~LearningSessionLog(void);
+
+  /**
+   * Get the key under which the Python class dmpbbo.bbo.LearningSession
+   * stores an object, cf. LearningSession.get_base_name().
+   *
+   * Examples: key("cost", 3, 6) => "update00003/006_cost",
+   * key("samples", 3) => "update00003/samples" and key("task") => "task".
+   *
+   * \param[in] name The name of the object
+   * \param[in] i_update The update number (-1 for none)
+   * \param[in] i_sample The sample number (-1 for none)
+   * \return The key
+   */
+  static std::string key(const std::string& name, int i_update = -1,
+                         int i_sample = -1);
+
+  /**
+   * Get the key of an object that has a prefix instead of a sample number,
+   * e.g. key("cost", 3, "eval") => "update00003/eval_cost".
+   *
+   * \param[in] name The name of the object
+   * \param[in] i_update The update number (-1 for none)
+   * \param[in] prefix The prefix
+   * \return The key
+   */
+  static std::string key(const std::string& name, int i_update,
+                         const std::string& prefix);
+
+  /**
+   * Append a matrix to the log.
+   * \param[in] key Key of the matrix, cf. key()
+   * \param[in] matrix The matrix
+   * \return true if appending was successful, false otherwise
+   */
+  bool appendMatrix(const std::string& key, const Eigen::MatrixXd& matrix);
+
+  /**
+   * Append a vector to the log. It is stored as a 1-D array.
+   * \param[in] key Key of the vector, cf. key()
+   * \param[in] vector The vector
+   * \return true if appending was successful, false otherwise
+   */
+  bool appendVector(const std::string& key, const Eigen::VectorXd& vector);
+
+  /**
+   * Append a JSON object to the log.
+   * \param[in] key Key of the object, cf. key()
+   * \param[in] j The object
+   * \return true if appending was successful, false otherwise
+   */
+  bool appendJson(const std::string& key, const nlohmann::json& j);
+
+  /**
+   * Append the sample, cost-relevant variables and cost of one rollout,
+   * as LearningSessionTask.add_rollout() in Python. The three records are
+   * written with one append.
+   *
+   * \param[in] i_update The update number
+   * \param[in] i_sample The sample number
+   * \param[in] sample The sample for this rollout
+   * \param[in] cost_vars The cost-relevant variables for the rollout
+   * \param[in] cost The cost of the rollout
+   * \return true if appending was successful, false otherwise
+   */
+  bool appendRollout(int i_update, int i_sample, const Eigen::VectorXd& sample,
+                     const Eigen::MatrixXd& cost_vars,
+                     const Eigen::VectorXd& cost);
+
+  /**
+   * Check whether the log contains a record with a certain key.
+   * \param[in] key The key
+   * \return true if the record exists, false otherwise
+   */
+  bool exists(const std::string& key) const;
+
+  /** Get the keys of all records, in the order in which they were first
+   * appended.
+   * \return The keys
+   */
+  std::vector<std::string> keys(void) const;
+
+  /** Get the number of updates in the log, i.e. the highest update number
+   * in the keys plus one.
+   * \return The number of updates
+   */
+  int getNumberOfUpdates(void) const;
+
+  /**
+   * Read an array from the log.
+   * \param[in] key Key of the array
+   * \param[out] matrix The array. A 1-D array is returned as a column vector,
+   * a 0-D array as a 1x1 matrix.
+   * \return true if reading was successful, false otherwise (e.g. if the key
+   * does not exist, or if the array has more than 2 dimensions)
+   */
+  bool readMatrix(const std::string& key, Eigen::MatrixXd& matrix) const;
+
+  /**
+   * Read a JSON object from the log.
+   * \param[in] key Key of the object
+   * \param[out] j The object
+   * \return true if reading was successful, false otherwise
+   */
+  bool readJson(const std::string& key, nlohmann::json& j) const;
+
+ private:
+  /** Entry in the index, for one record. */
+  struct IndexEntry {
+    /** Offset of the payload in the data file. */
+    uint64_t offset;
+    /** Size of the payload in bytes. */
+    uint64_t size;
+    /** Kind of the payload. */
+    uint8_t kind;
+    /** Size of each dimension of the array. */
+    std::vector<uint64_t> dims;
+  };
+
+  /** Record to be appended. */
+  struct Record {
+    /** Key of the record. */
+    std::string key;
+    /** Kind of the payload. */
+    uint8_t kind;
+    /** Size of each dimension of the array. */
+    std::vector<uint64_t> dims;
+    /** The payload. */
+    std::string payload;
+  };
+
+  /**
+   * Constructor.
+   * \param[in] filename Name of the data file
+   * \param[in] read_only Whether the log is opened for reading only
+   */
+  LearningSessionLog(const std::string& filename, bool read_only);
+
+  /** Read the index file, and recover the index entries that are missing
+   * from the data file. Unless the log is read-only, the recovered entries
+   * are appended to the index file, incomplete records are removed from the
+   * data file, and both files are opened for appending.
+   * \return true if successful, false otherwise
+   */
+  bool readIndex(void);
+
+  /**
+   * Add an entry to the in-memory index.
+   * \param[in] key Key of the record
+   * \param[in] entry The entry
+   */
+  void addToIndex(const std::string& key, const IndexEntry& entry);
+
+  /**
+   * Make a record for an array.
+   * \param[in] key Key of the record
+   * \param[in] dims Size of each dimension of the array
+   * \param[in] data The array in row-major order
+   * \return The record
+   */
+  static Record makeArrayRecord(const std::string& key,
+                                const std::vector<uint64_t>& dims,
+                                const double* data);
+
+  /**
+   * Append records to the data file and the index file, with one write to
+   * each file.
+   * \param[in] records The records
+   * \return true if appending was successful, false otherwise
+   */
+  bool append(const std::vector<Record>& records);
+
+  /**
+   * Read the payload of a record.
+   * \param[in] entry Index entry of the record
+   * \param[out] payload The payload
+   * \return true if reading was successful, false otherwise
+   */
+  bool readPayload(const IndexEntry& entry, char* payload) const;
+
+  /** Name of the data file. */
+  std::string filename_;
+
+  /** Whether the log was opened for reading only. */
+  bool read_only_;
+
+  /** Index entry of the last record for each key. */
+  std::map<std::string, IndexEntry> index_;
+
+  /** Keys in the order in which they were first appended. */
+  std::vector<std::string> keys_;
+
+  /** Size of the data file up to the end of the last complete record. */
+  uint64_t data_size_;
+
+  /** Stream for reading payloads from the data file. */
+  mutable std::ifstream data_in_;
+
+  /** Stream for appending records to the data file. */
+  std::ofstream data_out_;
+
+  /** Stream for appending entries to the index file. */
+  std::ofstream index_out_;
+};
+
+}  // namespace DmpBbo
+
+#endif  // _LEARNING_SESSION_LOG_H_
@@ -23,13 +23,17 @@
 
 #include "dmp/Dmp.hpp"
 
+#include <algorithm>
 #include <cmath>
 #include <fstream>
 #include <iostream>
+#include <limits>
 #include <nlohmann/json.hpp>
 #include <sstream>
 #include <string>
+#include <thread>
 
+#include "dmp/PackedForcingTerm.hpp"
 #include "dmp/Trajectory.hpp"
 #include "dynamicalsystems/DynamicalSystem.hpp"
 #include "dynamicalsystems/ExponentialSystem.hpp"
@@ -40,6 +44,9 @@
 #include "eigenutils/eigen_json.hpp"
 #include "eigenutils/eigen_realtime_check.hpp"
 #include "functionapproximators/FunctionApproximator.hpp"
+#include "functionapproximators/FunctionApproximatorRBFN.hpp"
+#include "functionapproximators/FunctionApproximatorRBFNQuantized.hpp"
+#include "threadutils/ThreadPool.hpp"
 
 using namespace std;
 using namespace Eigen;
@@ -104,7 +111,7 @@ Dmp::Dmp(int n_dims_dmp,
          double alpha_spring_damper, ExponentialSystem* goal_system,
          DynamicalSystem* phase_system, DynamicalSystem* gating_system,
          std::string scaling, Eigen::VectorXd scaling_amplitudes)
-    : DynamicalSystem(1, 1.0, VectorXd::Zero(n_dims_dmp)),
+    : DynamicalSystem(1.0, VectorXd::Zero(n_dims_dmp), 3 * n_dims_dmp + 2),
       y_attr_(VectorXd::Ones(n_dims_dmp)),
       goal_system_(goal_system),
       phase_system_(phase_system),
@@ -120,7 +127,7 @@ Dmp::Dmp(double tau, Eigen::VectorXd y_init, Eigen::VectorXd y_attr,
          std::vector<FunctionApproximator*> function_approximators,
          std::string dmp_type, std::string scaling,
          Eigen::VectorXd scaling_amplitudes)
-    : DynamicalSystem(1, tau, y_init),
+    : DynamicalSystem(tau, y_init, 3 * y_init.size() + 2),
       y_attr_(y_attr),
       forcing_term_scaling_(scaling),
       scaling_amplitudes_(scaling_amplitudes)
@@ -133,7 +140,7 @@ Dmp::Dmp(int n_dims_dmp,
          std::vector<FunctionApproximator*> function_approximators,
          std::string dmp_type, std::string scaling,
          Eigen::VectorXd scaling_amplitudes)
-    : DynamicalSystem(1, 1.0, VectorXd::Zero(n_dims_dmp)),
+    : DynamicalSystem(1.0, VectorXd::Zero(n_dims_dmp), 3 * n_dims_dmp + 2),
       y_attr_(VectorXd::Ones(n_dims_dmp)),
       forcing_term_scaling_(scaling),
       scaling_amplitudes_(scaling_amplitudes)
@@ -144,7 +151,7 @@ Dmp::Dmp(int n_dims_dmp,
 
 Dmp::Dmp(double tau, Eigen::VectorXd y_init, Eigen::VectorXd y_attr,
          double alpha_spring_damper, ExponentialSystem* goal_system)
-    : DynamicalSystem(1, tau, y_init),
+    : DynamicalSystem(tau, y_init, 3 * y_init.size() + 2),
       y_attr_(y_attr),
       forcing_term_scaling_("NO_SCALING"),
       scaling_amplitudes_(VectorXd::Zero(0))
@@ -175,7 +182,7 @@ void Dmp::initSubSystems(std::string dmp_type)
   } else if (dmp_type == "KULVICIUS_2012_JOINING" ||
              dmp_type == "COUNTDOWN_2013") {
     goal_system = new ExponentialSystem(tau(), y_init(), y_attr_, 15);
-    gating_system = new SigmoidSystem(tau(), one_1, -10, 0.9 * tau());
+    gating_system = new SigmoidSystem(tau(), one_1, -15.0, 0.85);
     bool count_down = (dmp_type == "COUNTDOWN_2013");
     phase_system = new TimeSystem(tau(), count_down);
   }
@@ -217,15 +224,38 @@ void Dmp::initSubSystems(double alpha_spring_damper,
   fa_output_prealloc_ = MatrixXd(1, dim_y());
   forcing_term_prealloc_ = VectorXd(dim_y());
   g_minus_y0_prealloc_ = VectorXd(dim_y());
+
+  seek_checkpoint_interval_ = 0;
+  seek_block_index_ = -1;
+  analytical_solution_integration_ = "EULER";
+  thread_pool_.reset();
+  limit_to_hardware_threads_ = true;
+  packed_forcing_term_.reset();
+  batch_tau_ = 0.0;
+  batch_features_shared_ = false;
+  batch_features_mutex_ = make_shared<std::mutex>();
+  trajectory_xs_prealloc_.resize(0, 0);
+  trajectory_xds_prealloc_.resize(0, 0);
+  trajectory_prealloc_mutex_ = make_shared<std::mutex>();
+
+  // Multi-rate evaluation of the function approximators is off by default
+  forcing_term_phase_interval_ = 0.0;
+  forcing_term_interpolation_ = "LINEAR";
+  phase_knot_prealloc_ = VectorXd(1);
+  fa_knots_prealloc_ = MatrixXd(4, dim_y());
+  fa_knot_indices_prealloc_ = VectorXi(4);
+  clearFunctionApproximatorKnots();
 }
 
 void Dmp::set_damping_coefficient(double damping_coefficient)
 {
   spring_system_->set_damping_coefficient(damping_coefficient);
+  clearSeek();
 }
 void Dmp::set_spring_constant(double spring_constant)
 {
   spring_system_->set_spring_constant(spring_constant);
+  clearSeek();
 }
 
 void Dmp::initFunctionApproximators(
@@ -235,7 +265,9 @@ void Dmp::initFunctionApproximators(
 
   assert(dim_y() == (int)function_approximators.size());
 
-  function_approximators_ = function_approximators;
+  function_approximators_.resize(function_approximators.size());
+  for (unsigned int ff = 0; ff < function_approximators.size(); ff++)
+    function_approximators_[ff].reset(function_approximators[ff]);
 }
 
 Dmp::~Dmp(void)
@@ -244,8 +276,64 @@ Dmp::~Dmp(void)
   delete spring_system_;
   delete phase_system_;
   delete gating_system_;
-  for (unsigned int ff = 0; ff < function_approximators_.size(); ff++)
-    delete (function_approximators_[ff]);
+}
+
+Dmp::Dmp(const Dmp& other)
+    : DynamicalSystem(other),
+      y_attr_(other.y_attr_),
+      goal_system_(other.goal_system_),
+      spring_system_(other.spring_system_),
+      phase_system_(other.phase_system_),
+      gating_system_(other.gating_system_),
+      function_approximators_(other.function_approximators_),
+      forcing_term_scaling_(other.forcing_term_scaling_),
+      scaling_amplitudes_(other.scaling_amplitudes_),
+      y_init_prealloc_(other.y_init_prealloc_.size()),
+      fa_output_one_prealloc_(other.fa_output_one_prealloc_.size()),
+      fa_output_prealloc_(other.fa_output_prealloc_.rows(),
+                          other.fa_output_prealloc_.cols()),
+      forcing_term_prealloc_(other.forcing_term_prealloc_.size()),
+      g_minus_y0_prealloc_(other.g_minus_y0_prealloc_.size()),
+      packed_forcing_term_(other.packed_forcing_term_),
+      forcing_term_phase_interval_(other.forcing_term_phase_interval_),
+      forcing_term_interpolation_(other.forcing_term_interpolation_),
+      phase_knot_prealloc_(other.phase_knot_prealloc_.size()),
+      fa_knots_prealloc_(other.fa_knots_prealloc_.rows(),
+                         other.fa_knots_prealloc_.cols()),
+      fa_knot_indices_prealloc_(other.fa_knot_indices_prealloc_.size()),
+      batch_tau_(0.0),
+      batch_features_shared_(false),
+      batch_features_mutex_(make_shared<std::mutex>()),
+      trajectory_xs_prealloc_(other.trajectory_xs_prealloc_.rows(),
+                              other.trajectory_xs_prealloc_.cols()),
+      trajectory_xds_prealloc_(other.trajectory_xds_prealloc_.rows(),
+                               other.trajectory_xds_prealloc_.cols()),
+      trajectory_prealloc_mutex_(make_shared<std::mutex>()),
+      seek_checkpoint_interval_(0),
+      seek_block_index_(-1),
+      analytical_solution_integration_(other.analytical_solution_integration_),
+      thread_pool_(other.thread_pool_),
+      limit_to_hardware_threads_(other.limit_to_hardware_threads_)
+{
+  clearFunctionApproximatorKnots();
+}
+
+Dmp* Dmp::clone(void) const
+{
+  // The copy constructor shares the function approximators, the packed forcing
+  // term and the thread pool (they are shared pointers), but the subsystems
+  // must be copied, as their state changes during integration.
+  Dmp* dmp = new Dmp(*this);
+  dmp->cloneSubSystems();
+  return dmp;
+}
+
+void Dmp::cloneSubSystems(void)
+{
+  spring_system_ = spring_system_->clone();
+  goal_system_ = (goal_system_ == NULL ? NULL : goal_system_->clone());
+  phase_system_ = (phase_system_ == NULL ? NULL : phase_system_->clone());
+  gating_system_ = (gating_system_ == NULL ? NULL : gating_system_->clone());
 }
 
 void Dmp::integrateStart(Ref<VectorXd> x, Ref<VectorXd> xd) const
@@ -269,6 +357,9 @@ void Dmp::integrateStart(Ref<VectorXd> x, Ref<VectorXd> xd) const
   // Set the attractor state of the spring system
   spring_system_->set_y_attr(x.GOAL);
 
+  // Function approximator outputs at the phase knots must be recomputed
+  clearFunctionApproximatorKnots();
+
   // Start integrating all futher subsystems
   spring_system_->integrateStart(y_init(), x.SPRING, xd.SPRING);
   phase_system_->integrateStart(x.PHASE, xd.PHASE);
@@ -306,10 +397,11 @@ void Dmp::differentialEquation(const Eigen::Ref<const Eigen::VectorXd>& x,
   gating_system_->differentialEquation(x.GATING, xd.GATING);
 
   // Compute output of the funciton approximators
-  for (int i_dim = 0; i_dim < dim_y(); i_dim++) {
-    function_approximators_[i_dim]->predictRealTime(x.PHASE,
-                                                    fa_output_one_prealloc_);
-    fa_output_prealloc_(0, i_dim) = fa_output_one_prealloc_(0, 0);
+  if (forcing_term_phase_interval_ > 0.0) {
+    // Multi-rate: interpolate between outputs computed at the phase knots
+    interpolateFunctionApproximatorOutput((x.PHASE)[0]);
+  } else {
+    predictFunctionApproximatorsRealTime(x.PHASE, fa_output_prealloc_.row(0));
   }
 
   // Gate the output of the function approximators
@@ -334,6 +426,301 @@ void Dmp::differentialEquation(const Eigen::Ref<const Eigen::VectorXd>& x,
   EXITING_REAL_TIME_CRITICAL_CODE
 }
 
+void Dmp::set_forcing_term_phase_interval(double phase_interval,
+                                          std::string interpolation)
+{
+  if (interpolation != "LINEAR" && interpolation != "CUBIC") {
+    cerr << __FILE__ << ":" << __LINE__ << ":";
+    cerr << "Unknown interpolation '" << interpolation
+         << "'. Using 'LINEAR' instead." << endl;
+    interpolation = "LINEAR";
+  }
+  forcing_term_phase_interval_ = std::max(0.0, phase_interval);
+  forcing_term_interpolation_ = interpolation;
+  clearFunctionApproximatorKnots();
+}
+
+bool Dmp::packForcingTerm(string scalar_type)
+{
+  packed_forcing_term_.reset(
+      PackedForcingTerm::create(function_approximators_, scalar_type));
+  return packed_forcing_term_ != NULL;
+}
+
+void Dmp::unpackForcingTerm(void)
+{
+  packed_forcing_term_.reset();
+}
+
+bool Dmp::quantizeFunctionApproximators(string format, VectorXd& max_errors)
+{
+  for (int i_dim = 0; i_dim < dim_y(); i_dim++) {
+    if (dynamic_cast<const FunctionApproximatorRBFN*>(
+            function_approximators_[i_dim].get()) == NULL) {
+      cerr << __FILE__ << ":" << __LINE__ << ":";
+      cerr << "Only RBFNs can be quantized." << endl;
+      return false;
+    }
+  }
+
+  max_errors.resize(dim_y());
+  for (int i_dim = 0; i_dim < dim_y(); i_dim++) {
+    const FunctionApproximatorRBFN* rbfn =
+        static_cast<const FunctionApproximatorRBFN*>(
+            function_approximators_[i_dim].get());
+    FunctionApproximatorRBFNQuantized* quantized =
+        new FunctionApproximatorRBFNQuantized(*rbfn, format);
+    max_errors[i_dim] = quantized->maxError(*rbfn);
+    // Function approximators shared with clones are not modified.
+    function_approximators_[i_dim].reset(quantized);
+  }
+
+  unpackForcingTerm();
+  clearFunctionApproximatorKnots();
+  batch_tau_ = 0.0;  // Invalidates the cached features of the batch solution
+  clearSeek();
+  return true;
+}
+
+Dmp* Dmp::fromTrajectory(const Trajectory& trajectory,
+                         const nlohmann::json& fa_meta_params,
+                         std::string dmp_type, std::string scaling,
+                         ThreadPool* thread_pool)
+{
+  // Relevant variables from trajectory
+  double tau = trajectory.duration();
+  VectorXd y_init = trajectory.initial_y();
+  VectorXd y_attr = trajectory.final_y();
+  VectorXd scaling_amplitudes = trajectory.getRangePerDim();
+
+  // The function approximators are set by train()
+  vector<FunctionApproximator*> function_approximators;
+  Dmp* dmp = new Dmp(tau, y_init, y_attr, function_approximators, dmp_type,
+                     scaling, scaling_amplitudes);
+  if (!dmp->train(trajectory, fa_meta_params, thread_pool)) {
+    delete dmp;
+    return NULL;
+  }
+  return dmp;
+}
+
+bool Dmp::train(const Trajectory& trajectory,
+                const nlohmann::json& fa_meta_params, ThreadPool* thread_pool)
+{
+  if (trajectory.dim() != dim_y()) {
+    cerr << __FILE__ << ":" << __LINE__ << ":";
+    cerr << "Dimensionality of trajectory (" << trajectory.dim()
+         << ") and Dmp (" << dim_y() << ") must be the same." << endl;
+    return false;
+  }
+
+  // computeTargets() uses tau, initial_state, attractor_state and the
+  // scaling amplitudes of the trajectory. They are set for computing the
+  // targets only, and only kept once all function approximators are trained.
+  double tau_prev = tau();
+  VectorXd y_init_prev = y_init();
+  VectorXd y_attr_prev = y_attr_;
+  VectorXd scaling_amplitudes_prev = scaling_amplitudes_;
+  auto set_state = [this](double tau, const VectorXd& y_init,
+                          const VectorXd& y_attr,
+                          const VectorXd& scaling_amplitudes) {
+    set_tau(tau);
+    set_y_init(y_init);
+    set_y_attr(y_attr);
+    scaling_amplitudes_ = scaling_amplitudes;
+  };
+  set_state(trajectory.duration(), trajectory.initial_y(),
+            trajectory.final_y(), trajectory.getRangePerDim());
+  MatrixXd fa_inputs_phase, f_targets;
+  computeTargets(trajectory, fa_inputs_phase, f_targets);
+  set_state(tau_prev, y_init_prev, y_attr_prev, scaling_amplitudes_prev);
+
+  // Train one function approximator for each dimension. The dimensions are
+  // trained in parallel, so a thread pool is only passed on to the function
+  // approximators if there is only one dimension (calling parallelFor() from
+  // within a task leads to a deadlock).
+  vector<FunctionApproximator*> fas(dim_y(), NULL);
+  ThreadPool* fa_thread_pool = (dim_y() == 1 ? thread_pool : NULL);
+  auto train_task = [&](int i_dim) {
+    fas[i_dim] = FunctionApproximator::train(
+        fa_meta_params, fa_inputs_phase, f_targets.col(i_dim), fa_thread_pool);
+  };
+  if (thread_pool == NULL || dim_y() == 1)
+    for (int i_dim = 0; i_dim < dim_y(); i_dim++) train_task(i_dim);
+  else
+    thread_pool->parallelFor(dim_y(), train_task);
+
+  bool success = true;
+  for (int i_dim = 0; i_dim < dim_y(); i_dim++)
+    if (fas[i_dim] == NULL) success = false;
+  if (!success) {
+    for (int i_dim = 0; i_dim < dim_y(); i_dim++) delete fas[i_dim];
+    return false;
+  }
+
+  set_state(trajectory.duration(), trajectory.initial_y(),
+            trajectory.final_y(), trajectory.getRangePerDim());
+
+  // Function approximators shared with clones are not modified.
+  function_approximators_.resize(dim_y());
+  for (int i_dim = 0; i_dim < dim_y(); i_dim++)
+    function_approximators_[i_dim].reset(fas[i_dim]);
+
+  unpackForcingTerm();
+  clearFunctionApproximatorKnots();
+  batch_tau_ = 0.0;  // Invalidates the cached features of the batch solution
+  clearSeek();
+  return true;
+}
+
+bool Dmp::computeTargets(const Trajectory& trajectory,
+                         Eigen::MatrixXd& fa_inputs_phase,
+                         Eigen::MatrixXd& f_targets) const
+{
+  if (trajectory.dim() != dim_y()) {
+    cerr << __FILE__ << ":" << __LINE__ << ":";
+    cerr << "Dimensionality of trajectory (" << trajectory.dim()
+         << ") and Dmp (" << dim_y() << ") must be the same." << endl;
+    return false;
+  }
+
+  const VectorXd& ts = trajectory.ts();
+  int n_time_steps = ts.size();
+
+  // Closed-form solutions of the phase, gating and goal systems
+  MatrixXd xds_phase, xs_gating, xds_gating, xs_goal, xds_goal;
+  phase_system_->analyticalSolution(ts, fa_inputs_phase, xds_phase);
+  gating_system_->analyticalSolution(ts, xs_gating, xds_gating);
+  if (goal_system_ == NULL)
+    xs_goal = y_attr_.transpose().replicate(n_time_steps, 1);
+  else
+    goal_system_->analyticalSolution(ts, xs_goal, xds_goal);
+
+  // Compute the inverse of the spring-damper system
+  double k = spring_system_->spring_constant();
+  double c = spring_system_->damping_coefficient();
+  double m = spring_system_->mass();
+  double tau = this->tau();
+  f_targets =
+      tau * tau * trajectory.ydds() +
+      (k * (trajectory.ys() - xs_goal) + c * tau * trajectory.yds()) / m;
+
+  // Factor out gating term
+  f_targets = xs_gating.col(0).cwiseInverse().asDiagonal() * f_targets;
+
+  // Factor out scaling
+  if (forcing_term_scaling_ == "G_MINUS_Y0_SCALING") {
+    RowVectorXd g_minus_y0 = (y_attr_ - y_init()).transpose();
+    f_targets.array().rowwise() /= g_minus_y0.array();
+  } else if (forcing_term_scaling_ == "AMPLITUDE_SCALING") {
+    RowVectorXd amplitudes = scaling_amplitudes_.transpose();
+    f_targets.array().rowwise() /= amplitudes.array();
+  }
+  return true;
+}
+
+void Dmp::computeTargetsRealTime(
+    const Eigen::Ref<const Eigen::VectorXd>& x,
+    const Eigen::Ref<const Eigen::VectorXd>& y,
+    const Eigen::Ref<const Eigen::VectorXd>& yd,
+    const Eigen::Ref<const Eigen::VectorXd>& ydd,
+    Eigen::Ref<Eigen::RowVectorXd> fa_input_phase,
+    Eigen::Ref<Eigen::VectorXd> f_targets) const
+{
+  ENTERING_REAL_TIME_CRITICAL_CODE
+
+  assert(x.size() == dim());
+  assert(y.size() == dim_y() && yd.size() == dim_y() && ydd.size() == dim_y());
+  assert(fa_input_phase.size() == 1);
+  assert(f_targets.size() == dim_y());
+
+  fa_input_phase[0] = (x.PHASE)[0];
+
+  // Compute the inverse of the spring-damper system
+  double k = spring_system_->spring_constant();
+  double c = spring_system_->damping_coefficient();
+  double m = spring_system_->mass();
+  double tau = this->tau();
+  f_targets = tau * tau * ydd + (k * (y - x.GOAL) + c * tau * yd) / m;
+
+  // Factor out gating term
+  f_targets /= (x.GATING)[0];
+
+  // Factor out scaling
+  if (forcing_term_scaling_ == "G_MINUS_Y0_SCALING") {
+    get_y_init(y_init_prealloc_);
+    f_targets.array() /= (y_attr_ - y_init_prealloc_).array();
+  } else if (forcing_term_scaling_ == "AMPLITUDE_SCALING") {
+    f_targets.array() /= scaling_amplitudes_.array();
+  }
+
+  EXITING_REAL_TIME_CRITICAL_CODE
+}
+
+void Dmp::predictFunctionApproximatorsRealTime(
+    const Eigen::Ref<const Eigen::VectorXd>& phase,
+    Eigen::Ref<Eigen::RowVectorXd, 0, Eigen::InnerStride<> > outputs) const
+{
+  if (packed_forcing_term_ != NULL) {
+    packed_forcing_term_->predictRealTime(phase[0], outputs);
+    return;
+  }
+  for (int i_dim = 0; i_dim < dim_y(); i_dim++) {
+    function_approximators_[i_dim]->predictRealTime(phase,
+                                                    fa_output_one_prealloc_);
+    outputs[i_dim] = fa_output_one_prealloc_(0, 0);
+  }
+}
+
+void Dmp::clearFunctionApproximatorKnots(void) const
+{
+  fa_knot_indices_prealloc_.fill(std::numeric_limits<int>::min());
+}
+
+int Dmp::functionApproximatorKnot(int i_knot) const
+{
+  // Knots are stored in a ring buffer of 4 slots, which is sufficient for
+  // cubic interpolation with a monotonic phase.
+  int slot = ((i_knot % 4) + 4) % 4;
+  if (fa_knot_indices_prealloc_[slot] != i_knot) {
+    phase_knot_prealloc_[0] = i_knot * forcing_term_phase_interval_;
+    predictFunctionApproximatorsRealTime(phase_knot_prealloc_,
+                                         fa_knots_prealloc_.row(slot));
+    fa_knot_indices_prealloc_[slot] = i_knot;
+  }
+  return slot;
+}
+
+void Dmp::interpolateFunctionApproximatorOutput(double phase) const
+{
+  double knot = phase / forcing_term_phase_interval_;
+  int i_knot = floor(knot);
+  double u = knot - i_knot;
+
+  if (forcing_term_interpolation_ == "CUBIC") {
+    // Catmull-Rom spline through the knots i-1, i, i+1, i+2
+    // https://en.wikipedia.org/wiki/Cubic_Hermite_spline#Catmull%E2%80%93Rom_spline
+    int s0 = functionApproximatorKnot(i_knot - 1);
+    int s1 = functionApproximatorKnot(i_knot);
+    int s2 = functionApproximatorKnot(i_knot + 1);
+    int s3 = functionApproximatorKnot(i_knot + 2);
+    double u2 = u * u;
+    double u3 = u2 * u;
+    double w0 = 0.5 * (-u3 + 2.0 * u2 - u);
+    double w1 = 0.5 * (3.0 * u3 - 5.0 * u2 + 2.0);
+    double w2 = 0.5 * (-3.0 * u3 + 4.0 * u2 + u);
+    double w3 = 0.5 * (u3 - u2);
+    fa_output_prealloc_.row(0) =
+        w0 * fa_knots_prealloc_.row(s0) + w1 * fa_knots_prealloc_.row(s1) +
+        w2 * fa_knots_prealloc_.row(s2) + w3 * fa_knots_prealloc_.row(s3);
+  } else {
+    int s1 = functionApproximatorKnot(i_knot);
+    int s2 = functionApproximatorKnot(i_knot + 1);
+    fa_output_prealloc_.row(0) = (1.0 - u) * fa_knots_prealloc_.row(s1) +
+                                 u * fa_knots_prealloc_.row(s2);
+  }
+}
+
 void Dmp::statesAsTrajectory(const Eigen::MatrixXd& x_in,
                              const Eigen::MatrixXd& xd_in,
                              Eigen::MatrixXd& y_out, Eigen::MatrixXd& yd_out,
@@ -392,39 +779,191 @@ void Dmp::analyticalSolution(const Eigen::VectorXd& ts, Eigen::MatrixXd& xs,
                              Eigen::MatrixXd& forcing_terms,
                              Eigen::MatrixXd& fa_outputs) const
 {
-  int n_time_steps = ts.size();
-  assert(n_time_steps > 0);
+  // Usually, we expect xs and xds to be of size T X dim(). However, if the
+  // input matrices were of size dim() X T, we write into them in that layout,
+  // so that the user can also request dim() X T sized matrices.
+  StateLayout layout = TIME_STEPS_IN_ROWS;
+  if (xs.rows() == dim() && xs.cols() == ts.size())
+    layout = TIME_STEPS_IN_COLUMNS;
+  if (layout == TIME_STEPS_IN_ROWS) {
+    xs.resize(ts.size(), dim());
+    xds.resize(ts.size(), dim());
+  } else {
+    xds.resize(dim(), ts.size());
+  }
+  analyticalSolution(ts, stridedMap(xs, layout), stridedMap(xds, layout),
+                     forcing_terms, fa_outputs);
+}
+
+void Dmp::analyticalSolution(const Eigen::VectorXd& ts, StridedMatrixMap xs,
+                             StridedMatrixMap xds) const
+{
+  MatrixXd forcing_terms, fa_outputs;
+  analyticalSolution(ts, xs, xds, forcing_terms, fa_outputs);
+}
 
-  // Usually, we expect xs and xds to be of size T X dim(), so we resize to
-  // that. However, if the input matrices were of size dim() X T, we return the
-  // matrices of that size by doing a transposeInPlace at the end. That way, the
-  // user can also request dim() X T sized matrices.
-  bool caller_expects_transposed =
-      (xs.rows() == dim() && xs.cols() == n_time_steps);
+void Dmp::analyticalSolution(const Eigen::VectorXd& ts, StridedMatrixMap xs,
+                             StridedMatrixMap xds,
+                             Eigen::MatrixXd& forcing_terms,
+                             Eigen::MatrixXd& fa_outputs) const
+{
+  assert(ts.size() > 0);
 
   // INTEGRATE SYSTEMS ANALYTICALLY AS MUCH AS POSSIBLE
+  analyticalSolutionSubSystems(ts, xs, xds, forcing_terms, fa_outputs);
 
-  // Integrate phase
-  MatrixXd xs_phase;
-  MatrixXd xds_phase;
-  phase_system_->analyticalSolution(ts, xs_phase, xds_phase);
+  // THE REST CANNOT BE DONE ANALYTICALLY
 
-  // Compute gating term
-  MatrixXd xs_gating;
-  MatrixXd xds_gating;
-  gating_system_->analyticalSolution(ts, xs_gating, xds_gating);
+  // Reset the dynamical system, and get the first state
+  double damping = spring_system_->damping_coefficient();
+  SpringDamperSystem localspring_system_(tau(), y_init(), y_attr_, damping);
+
+  // Set first attractor state
+  int t0 = 0;
+  localspring_system_.set_y_attr(xs.row(t0).GOAL);
+
+  // Start integrating spring damper system
+  int dim_spring = localspring_system_.dim();
+  VectorXd x_spring(dim_spring),
+      xd_spring(dim_spring);  // todo Why are these needed?
+  localspring_system_.integrateStart(x_spring, xd_spring);
+  xs.row(t0).SPRING = x_spring;
+  xds.row(t0).SPRING = xd_spring;
+
+  // Add forcing term to the acceleration of the spring state
+  xds.SPRINGM_Z(1) = xds.SPRINGM_Z(1) + forcing_terms.row(t0) / tau();
+
+  integrateSpring(ts, forcing_terms, xs, xds);
+}
+
+void Dmp::analyticalSolutionTrajectory(const Eigen::VectorXd& ts,
+                                       StridedMatrixMap ys,
+                                       StridedMatrixMap yds,
+                                       StridedMatrixMap ydds) const
+{
+  int T = ts.size();
+  assert(ys.rows() == T && ys.cols() == dim_y());
+  assert(yds.rows() == T && yds.cols() == dim_y());
+  assert(ydds.rows() == T && ydds.cols() == dim_y());
+
+  // The spring state depends on z and the goal, so the whole state must be
+  // integrated. Only y, yd and ydd are copied to the output though. The state
+  // is integrated in pre-allocated memory, which only grows if more time steps
+  // are requested than before. If another thread is using it, temporary
+  // memory is used instead, so that calls do not wait for each other.
+  std::unique_lock<std::mutex> lock(*trajectory_prealloc_mutex_,
+                                    std::try_to_lock);
+  MatrixXd xs_tmp, xds_tmp;
+  MatrixXd& xs_mem = lock.owns_lock() ? trajectory_xs_prealloc_ : xs_tmp;
+  MatrixXd& xds_mem = lock.owns_lock() ? trajectory_xds_prealloc_ : xds_tmp;
+  if (xs_mem.rows() < T || xs_mem.cols() != dim()) {
+    xs_mem.resize(T, dim());
+    xds_mem.resize(T, dim());
+  }
+  typedef Stride<Dynamic, Dynamic> DynamicStride;
+  DynamicStride stride(xs_mem.rows(), 1);
+  StridedMatrixMap xs(xs_mem.data(), T, dim(), stride);
+  StridedMatrixMap xds(xds_mem.data(), T, dim(), stride);
+  analyticalSolution(ts, xs, xds);
+
+  // Same as in statesAsTrajectory()
+  ys = xs.SPRINGM_Y(T);
+  yds = xds.SPRINGM_Y(T);
+  ydds = xds.SPRINGM_Z(T) / tau();
+}
+
+void Dmp::analyticalSolutionTrajectory(const Eigen::VectorXd& ts,
+                                       Eigen::MatrixXd& ys,
+                                       Eigen::MatrixXd& yds,
+                                       Eigen::MatrixXd& ydds,
+                                       StateLayout layout) const
+{
+  if (layout == TIME_STEPS_IN_ROWS) {
+    ys.resize(ts.size(), dim_y());
+    yds.resize(ts.size(), dim_y());
+    ydds.resize(ts.size(), dim_y());
+  } else {
+    ys.resize(dim_y(), ts.size());
+    yds.resize(dim_y(), ts.size());
+    ydds.resize(dim_y(), ts.size());
+  }
+  analyticalSolutionTrajectory(ts, stridedMap(ys, layout),
+                               stridedMap(yds, layout),
+                               stridedMap(ydds, layout));
+}
+
+void Dmp::analyticalSolutionSubSystems(const Eigen::VectorXd& ts,
+                                       StridedMatrixMap xs,
+                                       StridedMatrixMap xds,
+                                       Eigen::MatrixXd& forcing_terms,
+                                       Eigen::MatrixXd& fa_outputs) const
+{
+  int n_time_steps = ts.size();
+  int n_threads = n_parallel_threads();
+  const int min_steps_per_block = 1024;
+  if (n_time_steps < min_steps_per_block) n_threads = 1;
+
+  // The phase, gating and goal systems are independent, and the function
+  // approximators for different dimensions and time steps also. Each task
+  // writes to its own output, so results do not depend on the number of
+  // threads.
+  MatrixXd xs_phase, xds_phase;
+  MatrixXd xs_gating, xds_gating;
+  MatrixXd xs_goal, xds_goal;
+  auto subsystem_task = [&](int i_task) {
+    if (i_task == 0) {
+      // Integrate phase
+      phase_system_->analyticalSolution(ts, xs_phase, xds_phase);
+    } else if (i_task == 1) {
+      // Compute gating term
+      gating_system_->analyticalSolution(ts, xs_gating, xds_gating);
+    } else {
+      // Get current delayed goal
+      if (goal_system_ == NULL) {
+        // If there is no dynamical system for the delayed goal, the goal is
+        // simply the attractor state
+        xs_goal = y_attr_.transpose().replicate(n_time_steps, 1);
+        // with zero change
+        xds_goal = MatrixXd::Zero(n_time_steps, dim_y());
+      } else {
+        // Integrate goal system and get current goal state
+        goal_system_->analyticalSolution(ts, xs_goal, xds_goal);
+      }
+    }
+  };
 
   // Compute the output of the function approximator
   fa_outputs.resize(ts.size(), dim_y());
   fa_outputs.fill(0.0);
 
-  MatrixXd fa_output_one_dim(n_time_steps, 1);
-  for (int i_dim = 0; i_dim < dim_y(); i_dim++) {
-    function_approximators_[i_dim]->predict(xs_phase, fa_output_one_dim);
-    fa_outputs.col(i_dim) = fa_output_one_dim;
+  // Divide the time steps into blocks, such that there are at least as many
+  // tasks as threads.
+  int n_blocks = 1;
+  if (n_threads > 1) {
+    n_blocks = (n_threads + dim_y() - 1) / dim_y();
+    n_blocks = std::min(n_blocks, n_time_steps / min_steps_per_block);
+    n_blocks = std::max(1, n_blocks);
+  }
+  auto fa_task = [&](int i_task) {
+    int i_dim = i_task / n_blocks;
+    int i_block = i_task % n_blocks;
+    int t_begin = (long)n_time_steps * i_block / n_blocks;
+    int n_steps = (long)n_time_steps * (i_block + 1) / n_blocks - t_begin;
+    MatrixXd fa_output_one_dim(n_steps, 1);
+    function_approximators_[i_dim]->predict(
+        xs_phase.middleRows(t_begin, n_steps), fa_output_one_dim);
+    fa_outputs.col(i_dim).segment(t_begin, n_steps) = fa_output_one_dim;
+  };
+
+  if (n_threads > 1) {
+    thread_pool_->parallelFor(3, subsystem_task);
+    thread_pool_->parallelFor(dim_y() * n_blocks, fa_task);
+  } else {
+    for (int i_task = 0; i_task < 3; i_task++) subsystem_task(i_task);
+    for (int i_task = 0; i_task < dim_y(); i_task++) fa_task(i_task);
   }
 
-  // Gate the output to get the forcing ter4m
+  // Gate the output to get the forcing term
   MatrixXd xs_gating_rep = xs_gating.replicate(1, fa_outputs.cols());
   forcing_terms = fa_outputs.array() * xs_gating_rep.array();
 
@@ -439,21 +978,8 @@ void Dmp::analyticalSolution(const Eigen::VectorXd& ts, Eigen::MatrixXd& xs,
     forcing_terms = forcing_terms.array() * scaling_amplitudes_rep.array();
   }
 
-  MatrixXd xs_goal, xds_goal;
-  // Get current delayed goal
-  if (goal_system_ == NULL) {
-    // If there is no dynamical system for the delayed goal, the goal is
-    // simply the attractor state
-    xs_goal = y_attr_.transpose().replicate(n_time_steps, 1);
-    // with zero change
-    xds_goal = MatrixXd::Zero(n_time_steps, dim_y());
-  } else {
-    // Integrate goal system and get current goal state
-    goal_system_->analyticalSolution(ts, xs_goal, xds_goal);
-  }
-
-  xs.resize(n_time_steps, dim());
-  xds.resize(n_time_steps, dim());
+  assert(xs.rows() == n_time_steps && xs.cols() == dim());
+  assert(xds.rows() == n_time_steps && xds.cols() == dim());
 
   int T = n_time_steps;
 
@@ -463,29 +989,17 @@ void Dmp::analyticalSolution(const Eigen::VectorXd& ts, Eigen::MatrixXd& xs,
   xds.PHASEM(T) = xds_phase;
   xs.GATINGM(T) = xs_gating;
   xds.GATINGM(T) = xds_gating;
+}
 
-  // THE REST CANNOT BE DONE ANALYTICALLY
-
-  // Reset the dynamical system, and get the first state
+void Dmp::integrateSpringEuler(const Eigen::VectorXd& ts,
+                               const Eigen::MatrixXd& forcing_terms,
+                               StridedMatrixMap xs, StridedMatrixMap xds) const
+{
   double damping = spring_system_->damping_coefficient();
   SpringDamperSystem localspring_system_(tau(), y_init(), y_attr_, damping);
+  VectorXd xd_spring(localspring_system_.dim());
 
-  // Set first attractor state
-  localspring_system_.set_y_attr(xs_goal.row(0));
-
-  // Start integrating spring damper system
-  int dim_spring = localspring_system_.dim();
-  VectorXd x_spring(dim_spring),
-      xd_spring(dim_spring);  // todo Why are these needed?
-  int t0 = 0;
-  localspring_system_.integrateStart(x_spring, xd_spring);
-  xs.row(t0).SPRING = x_spring;
-  xds.row(t0).SPRING = xd_spring;
-
-  // Add forcing term to the acceleration of the spring state
-  xds.SPRINGM_Z(1) = xds.SPRINGM_Z(1) + forcing_terms.row(t0) / tau();
-
-  for (int tt = 1; tt < n_time_steps; tt++) {
+  for (int tt = 1; tt < ts.size(); tt++) {
     double dt = ts[tt] - ts[tt - 1];
 
     // Euler integration
@@ -503,16 +1017,669 @@ void Dmp::analyticalSolution(const Eigen::VectorXd& ts, Eigen::MatrixXd& xs,
     // Compute y component from z
     xds.row(tt).SPRING_Y = xs.row(tt).SPRING_Z / tau();
   }
+}
+
+void Dmp::integrateSpring(const Eigen::VectorXd& ts,
+                          const Eigen::MatrixXd& forcing_terms,
+                          StridedMatrixMap xs, StridedMatrixMap xds) const
+{
+  if (analytical_solution_integration_ == "EXACT_ZOH" ||
+      analytical_solution_integration_ == "EXACT_FOH")
+    integrateSpringExact(ts, forcing_terms, xs, xds);
+  else
+    integrateSpringEuler(ts, forcing_terms, xs, xds);
+}
+
+void Dmp::integrateSpringExact(const Eigen::VectorXd& ts,
+                               const Eigen::MatrixXd& forcing_terms,
+                               StridedMatrixMap xs, StridedMatrixMap xds) const
+{
+  // With the goal g and forcing term f held constant during each time step
+  // (zero-order hold) or interpolated linearly (first-order hold), the
+  // spring-damper system is a linear recurrence
+  //   s_t = Phi_t s_{t-1} + Gamma0_t u_{t-1} + Gamma1_t (u_t - u_{t-1})
+  // for each dimension, with s = [y z] and u = [g f]. The Gamma1_t term is only
+  // used for the first-order hold. Phi_t and Gamma*_t are the same for all
+  // dimensions. Affine maps compose associatively, so the recurrence is
+  // evaluated as a blocked parallel prefix scan:
+  //   1) in parallel, scan each block of time steps from a zero state, and
+  //      multiply the Phi_t's of the block
+  //   2) serially, propagate the initial state of each block over the blocks
+  //   3) in parallel, scan each block again from its correct initial state
+
+  int n_time_steps = ts.size();
+  int D = dim_y();
+  double damping = spring_system_->damping_coefficient();
+  SpringDamperSystem localspring_system_(tau(), y_init(), y_attr_, damping);
+  double k = localspring_system_.spring_constant();
+  double m = localspring_system_.mass();
+  bool first_order_hold = (analytical_solution_integration_ == "EXACT_FOH");
+
+  // Divide the time steps 1..T-1 into blocks, one per thread. Because each
+  // block is scanned twice, this is only faster than a serial scan with at
+  // least 3 threads.
+  const int min_steps_per_block = 4096;
+  int n_threads = n_parallel_threads();
+  if (n_threads < 3) n_threads = 1;
+  int n_blocks = std::min(n_threads, (n_time_steps - 1) / min_steps_per_block);
+  n_blocks = std::max(1, n_blocks);
+  vector<int> block_begin(n_blocks + 1);
+  for (int i_block = 0; i_block <= n_blocks; i_block++)
+    block_begin[i_block] = 1 + (long)(n_time_steps - 1) * i_block / n_blocks;
+
+  // Scans the time steps [t_begin,t_end) starting from the state y0,z0 (size
+  // D). If write is true, the states and rates of change are written to xs and
+  // xds. The product of the Phi_t's is returned in Phi_block.
+  auto scan = [&](int t_begin, int t_end, VectorXd& y, VectorXd& z,
+                  bool write, Matrix2d& Phi_block) {
+    Matrix2d Phi, Gamma0, Gamma1;
+    double dt_cached = -1.0;
+    Phi_block.setIdentity();
+    for (int tt = t_begin; tt < t_end; tt++) {
+      double dt = ts[tt] - ts[tt - 1];
+      if (dt != dt_cached) {
+        localspring_system_.discretizeExact(dt, Phi, Gamma0, Gamma1);
+        if (!first_order_hold) Gamma1.setZero();
+        dt_cached = dt;
+      }
+      Phi_block = Phi * Phi_block;
+      for (int i_dim = 0; i_dim < D; i_dim++) {
+        // Goal (index 2*D+i_dim in the state) and forcing term
+        double g = xs(tt - 1, 2 * D + i_dim);
+        double f = forcing_terms(tt - 1, i_dim);
+        double dg = xs(tt, 2 * D + i_dim) - g;
+        double df = forcing_terms(tt, i_dim) - f;
+        double y_prev = y[i_dim];
+        double z_prev = z[i_dim];
+        y[i_dim] = Phi(0, 0) * y_prev + Phi(0, 1) * z_prev + Gamma0(0, 0) * g +
+                   Gamma0(0, 1) * f + Gamma1(0, 0) * dg + Gamma1(0, 1) * df;
+        z[i_dim] = Phi(1, 0) * y_prev + Phi(1, 1) * z_prev + Gamma0(1, 0) * g +
+                   Gamma0(1, 1) * f + Gamma1(1, 0) * dg + Gamma1(1, 1) * df;
+      }
+      if (write) {
+        for (int i_dim = 0; i_dim < D; i_dim++) {
+          double g = xs(tt, 2 * D + i_dim);
+          double f = forcing_terms(tt, i_dim);
+          xs(tt, i_dim) = y[i_dim];
+          xs(tt, D + i_dim) = z[i_dim];
+          xds(tt, i_dim) = z[i_dim] / tau();
+          xds(tt, D + i_dim) =
+              (-k * (y[i_dim] - g) - damping * z[i_dim]) / (m * tau()) +
+              f / tau();
+        }
+      }
+    }
+  };
+
+  // Initial state of each block
+  vector<VectorXd> y_init_blocks(n_blocks), z_init_blocks(n_blocks);
+  y_init_blocks[0] = xs.row(0).SPRING_Y.transpose();
+  z_init_blocks[0] = xs.row(0).SPRING_Z.transpose();
+
+  if (n_blocks > 1) {
+    // 1) Scan each block from a zero state
+    vector<VectorXd> y_end(n_blocks, VectorXd::Zero(D));
+    vector<VectorXd> z_end(n_blocks, VectorXd::Zero(D));
+    vector<Matrix2d> Phi_blocks(n_blocks);
+    thread_pool_->parallelFor(n_blocks, [&](int i_block) {
+      scan(block_begin[i_block], block_begin[i_block + 1], y_end[i_block],
+           z_end[i_block], false, Phi_blocks[i_block]);
+    });
+
+    // 2) Propagate the initial states over the blocks
+    for (int i_block = 1; i_block < n_blocks; i_block++) {
+      const Matrix2d& P = Phi_blocks[i_block - 1];
+      const VectorXd& y_prev = y_init_blocks[i_block - 1];
+      const VectorXd& z_prev = z_init_blocks[i_block - 1];
+      y_init_blocks[i_block] =
+          P(0, 0) * y_prev + P(0, 1) * z_prev + y_end[i_block - 1];
+      z_init_blocks[i_block] =
+          P(1, 0) * y_prev + P(1, 1) * z_prev + z_end[i_block - 1];
+    }
+  }
+
+  // 3) Scan each block from its initial state, and write the results
+  vector<Matrix2d> Phi_blocks(n_blocks);
+  if (n_blocks == 1) {
+    scan(block_begin[0], block_begin[1], y_init_blocks[0], z_init_blocks[0],
+         true, Phi_blocks[0]);
+  } else {
+    thread_pool_->parallelFor(n_blocks, [&](int i_block) {
+      scan(block_begin[i_block], block_begin[i_block + 1],
+           y_init_blocks[i_block], z_init_blocks[i_block], true,
+           Phi_blocks[i_block]);
+    });
+  }
+}
+
+void Dmp::set_analytical_solution_integration(std::string integration)
+{
+  if (integration != "EULER" && integration != "EXACT_ZOH" &&
+      integration != "EXACT_FOH") {
+    cerr << __FILE__ << ":" << __LINE__ << ":";
+    cerr << "Unknown integration '" << integration
+         << "'. Using 'EULER' instead." << endl;
+    integration = "EULER";
+  }
+  analytical_solution_integration_ = integration;
+  clearSeek();
+}
+
+void Dmp::set_analytical_solution_n_threads(int n_threads,
+                                            bool limit_to_hardware_threads)
+{
+  limit_to_hardware_threads_ = limit_to_hardware_threads;
+  thread_pool_.reset();
+  if (n_threads <= 0) n_threads = std::thread::hardware_concurrency();
+  if (n_threads > 1) thread_pool_ = make_shared<ThreadPool>(n_threads);
+}
+
+int Dmp::n_parallel_threads(void) const
+{
+#ifdef REALTIME_CHECKS
+  // Eigen's flag for checking memory allocation is global, so a thread in
+  // real-time critical code would make other threads that allocate fail.
+  return 1;
+#else
+  if (thread_pool_ == NULL) return 1;
+  // More threads than hardware threads only add the overhead of switching
+  // between them.
+  int n_threads = thread_pool_->n_threads();
+  int n_hardware = std::thread::hardware_concurrency();
+  if (limit_to_hardware_threads_ && n_hardware > 0)
+    n_threads = std::min(n_threads, n_hardware);
+  return n_threads;
+#endif
+}
+
+int Dmp::getLinearParameterVectorSize(void) const
+{
+  int size = 0;
+  for (int i_dim = 0; i_dim < dim_y(); i_dim++)
+    size += function_approximators_[i_dim]->getLinearParameterVectorSize();
+  return size;
+}
+
+void Dmp::getLinearParameterVector(Eigen::VectorXd& values) const
+{
+  values.resize(getLinearParameterVectorSize());
+  int offset = 0;
+  VectorXd values_one_dim;
+  for (int i_dim = 0; i_dim < dim_y(); i_dim++) {
+    function_approximators_[i_dim]->getLinearParameterVector(values_one_dim);
+    values.segment(offset, values_one_dim.size()) = values_one_dim;
+    offset += values_one_dim.size();
+  }
+}
+
+void Dmp::setLinearParameterVector(const Eigen::VectorXd& values)
+{
+  assert(values.size() == getLinearParameterVectorSize());
+  int offset = 0;
+  for (int i_dim = 0; i_dim < dim_y(); i_dim++) {
+    shared_ptr<FunctionApproximator>& fa = function_approximators_[i_dim];
+    // Copy the function approximator first if it is shared with a clone.
+    if (fa.use_count() > 1) fa.reset(fa->clone());
+    int size = fa->getLinearParameterVectorSize();
+    fa->setLinearParameterVector(values.segment(offset, size));
+    offset += size;
+  }
+  // Pack the parameters again if the packed forcing term is shared with a
+  // clone, or if they no longer fit into it.
+  if (packed_forcing_term_ != NULL &&
+      (packed_forcing_term_.use_count() > 1 ||
+       !packed_forcing_term_->update(function_approximators_)))
+    packForcingTerm(packed_forcing_term_->scalar_type());
+
+  // Invalidate cached results that depend on the function approximators
+  clearFunctionApproximatorKnots();
+  clearSeek();
+}
+
+void Dmp::unshareParameters(void)
+{
+  for (unsigned int i_dim = 0; i_dim < function_approximators_.size();
+       i_dim++) {
+    shared_ptr<FunctionApproximator>& fa = function_approximators_[i_dim];
+    if (fa.use_count() > 1) fa.reset(fa->clone());
+  }
+  if (packed_forcing_term_.use_count() > 1)
+    packed_forcing_term_.reset(new PackedForcingTerm(*packed_forcing_term_));
+}
+
+bool Dmp::copyParametersRealTime(const Dmp& other)
+{
+  ENTERING_REAL_TIME_CRITICAL_CODE
+
+  // Check the structure before changing anything. Objects that are shared
+  // with a clone cannot be changed without copying them (cf.
+  // unshareParameters()).
+  bool same_structure =
+      other.dim_y() == dim_y() &&
+      other.forcing_term_scaling_ == forcing_term_scaling_ &&
+      other.scaling_amplitudes_.size() == scaling_amplitudes_.size() &&
+      (other.goal_system_ == NULL) == (goal_system_ == NULL) &&
+      other.function_approximators_.size() == function_approximators_.size();
+  int n_fas = function_approximators_.size();
+  for (int ff = 0; same_structure && ff < n_fas; ff++) {
+    const FunctionApproximator* fa = function_approximators_[ff].get();
+    const FunctionApproximator* fa_other =
+        other.function_approximators_[ff].get();
+    if (fa == NULL || fa_other == NULL)
+      same_structure = (fa == fa_other);
+    else
+      same_structure = fa->hasSameStructure(*fa_other) &&
+                       function_approximators_[ff].use_count() == 1;
+  }
+  if (same_structure && packed_forcing_term_ != NULL)
+    same_structure =
+        packed_forcing_term_.use_count() == 1 &&
+        packed_forcing_term_->fits(other.function_approximators_);
+  if (!same_structure) {
+    EXITING_REAL_TIME_CRITICAL_CODE
+    return false;
+  }
+
+  set_tau(other.tau());
+  other.get_y_init(y_init_prealloc_);
+  set_y_init(y_init_prealloc_);
+  set_y_attr(other.y_attr_);
+  spring_system_->set_damping_coefficient(
+      other.spring_system_->damping_coefficient());
+  spring_system_->set_spring_constant(other.spring_system_->spring_constant());
+  scaling_amplitudes_ = other.scaling_amplitudes_;
+
+  for (int ff = 0; ff < n_fas; ff++) {
+    shared_ptr<FunctionApproximator>& fa = function_approximators_[ff];
+    if (fa != NULL)
+      fa->copyParametersRealTime(*other.function_approximators_[ff]);
+  }
+  if (packed_forcing_term_ != NULL)
+    packed_forcing_term_->update(function_approximators_);
+
+  // Invalidate cached results that depend on the function approximators
+  batch_tau_ = 0.0;
+  clearFunctionApproximatorKnots();
+
+  EXITING_REAL_TIME_CRITICAL_CODE
+  return true;
+}
+
+bool Dmp::copyFunctionApproximatorParametersRealTime(
+    int i_dim, const FunctionApproximator& fa)
+{
+  ENTERING_REAL_TIME_CRITICAL_CODE
+
+  // Objects that are shared with a clone cannot be changed without copying
+  // them (cf. unshareParameters()).
+  if (i_dim < 0 || i_dim >= (int)function_approximators_.size() ||
+      function_approximators_[i_dim] == NULL ||
+      function_approximators_[i_dim].use_count() > 1 ||
+      !function_approximators_[i_dim]->hasSameStructure(fa) ||
+      (packed_forcing_term_ != NULL &&
+       (packed_forcing_term_.use_count() > 1 ||
+        !packed_forcing_term_->fits(function_approximators_, i_dim, &fa)))) {
+    EXITING_REAL_TIME_CRITICAL_CODE
+    return false;
+  }
+
+  function_approximators_[i_dim]->copyParametersRealTime(fa);
+  if (packed_forcing_term_ != NULL)
+    packed_forcing_term_->update(function_approximators_);
+
+  // Invalidate cached results that depend on the function approximators
+  batch_tau_ = 0.0;
+  clearFunctionApproximatorKnots();
+  clearSeek();
+
+  EXITING_REAL_TIME_CRITICAL_CODE
+  return true;
+}
+
+void Dmp::updateBatchFeatures(const Eigen::VectorXd& ts) const
+{
+  // The features only depend on the phase and gating, i.e. on ts and tau.
+  bool same_ts = (batch_ts_.size() == ts.size() && batch_ts_ == ts);
+  if (same_ts && batch_tau_ == tau() && !batch_features_.empty()) return;
+
+  MatrixXd xs_phase, xds_phase, xs_gating, xds_gating;
+  phase_system_->analyticalSolution(ts, xs_phase, xds_phase);
+  gating_system_->analyticalSolution(ts, xs_gating, xds_gating);
+
+  // Features of each dimension, multiplied with the gating term
+  batch_features_.resize(dim_y());
+  for (int i_dim = 0; i_dim < dim_y(); i_dim++) {
+    function_approximators_[i_dim]->getLinearFeatures(xs_phase,
+                                                      batch_features_[i_dim]);
+    batch_features_[i_dim] = xs_gating.col(0).asDiagonal() *
+                             batch_features_[i_dim];
+  }
+
+  // If all dimensions have the same features (e.g. the same centers and widths
+  // for an RBFN), all forcing terms are computed with one matrix product.
+  batch_features_shared_ = true;
+  for (int i_dim = 1; i_dim < dim_y(); i_dim++) {
+    const MatrixXd& features = batch_features_[i_dim];
+    if (features.cols() != batch_features_[0].cols() ||
+        features != batch_features_[0])
+      batch_features_shared_ = false;
+  }
+
+  batch_ts_ = ts;
+  batch_tau_ = tau();
+}
 
-  if (caller_expects_transposed) {
-    xs.transposeInPlace();
-    xds.transposeInPlace();
+void Dmp::analyticalSolutionBatch(const Eigen::VectorXd& ts,
+                                  const Eigen::MatrixXd& parameter_vectors,
+                                  Eigen::MatrixXd& ys, Eigen::MatrixXd& yds,
+                                  Eigen::MatrixXd& ydds) const
+{
+  int n_time_steps = ts.size();
+  int n_samples = parameter_vectors.rows();
+  int D = dim_y();
+  assert(n_time_steps > 0);
+  assert(parameter_vectors.cols() == getLinearParameterVectorSize());
+
+  // Forcing terms for all samples (T x K*D)
+  MatrixXd forcing_terms(n_time_steps, n_samples * D);
+  {
+    std::lock_guard<std::mutex> lock(*batch_features_mutex_);
+    updateBatchFeatures(ts);
+
+    // P x K, i.e. each column is the parameter vector of one sample. Because
+    // the parameter vectors of the dimensions are concatenated, this matrix can
+    // be reinterpreted as P_d x (K*D) if all dimensions have P_d parameters.
+    MatrixXd parameters = parameter_vectors.transpose();
+
+    if (batch_features_shared_) {
+      int n_params = batch_features_[0].cols();
+      Map<const MatrixXd> weights(parameters.data(), n_params, n_samples * D);
+      forcing_terms.noalias() = batch_features_[0] * weights;
+    } else {
+      int offset = 0;
+      MatrixXd forcing_terms_one_dim;
+      for (int i_dim = 0; i_dim < D; i_dim++) {
+        int n_params = batch_features_[i_dim].cols();
+        forcing_terms_one_dim.noalias() =
+            batch_features_[i_dim] * parameters.middleRows(offset, n_params);
+        for (int i_sample = 0; i_sample < n_samples; i_sample++)
+          forcing_terms.col(i_sample * D + i_dim) =
+              forcing_terms_one_dim.col(i_sample);
+        offset += n_params;
+      }
+    }
   }
+
+  // Scale the forcing term, if necessary
+  VectorXd scaling = VectorXd::Ones(D);
+  if (forcing_term_scaling_ == "G_MINUS_Y0_SCALING")
+    scaling = y_attr_ - y_init();
+  else if (forcing_term_scaling_ == "AMPLITUDE_SCALING")
+    scaling = scaling_amplitudes_;
+  for (int i_sample = 0; i_sample < n_samples; i_sample++)
+    forcing_terms.middleCols(i_sample * D, D) *= scaling.asDiagonal();
+
+  // Delayed goal, the same for all samples
+  MatrixXd xs_goal, xds_goal;
+  if (goal_system_ == NULL)
+    xs_goal = y_attr_.transpose().replicate(n_time_steps, 1);
+  else
+    goal_system_->analyticalSolution(ts, xs_goal, xds_goal);
+
+  integrateSpringBatch(ts, xs_goal.replicate(1, n_samples),
+                       y_init().replicate(n_samples, 1), forcing_terms, ys,
+                       yds, ydds);
+}
+
+void Dmp::analyticalSolutionSweep(const Eigen::VectorXd& ts,
+                                  const Eigen::MatrixXd& y_inits,
+                                  const Eigen::MatrixXd& y_attrs,
+                                  Eigen::MatrixXd& ys, Eigen::MatrixXd& yds,
+                                  Eigen::MatrixXd& ydds) const
+{
+  int T = ts.size();
+  int n_candidates = y_inits.rows();
+  int D = dim_y();
+  assert(T > 0);
+  assert(y_inits.cols() == D);
+  assert(y_attrs.rows() == n_candidates && y_attrs.cols() == D);
+
+  // Phase, gating and function approximator outputs, shared by all candidates
+  MatrixXd xs(T, dim()), xds(T, dim()), forcing_terms, fa_outputs;
+  analyticalSolutionSubSystems(ts, stridedMap(xs, TIME_STEPS_IN_ROWS),
+                               stridedMap(xds, TIME_STEPS_IN_ROWS),
+                               forcing_terms, fa_outputs);
+  bool scale_per_candidate = (forcing_term_scaling_ == "G_MINUS_Y0_SCALING");
+  if (scale_per_candidate)
+    forcing_terms = fa_outputs.array() * xs.GATINGM(T).replicate(1, D).array();
+
+  MatrixXd goals(T, n_candidates * D);
+  MatrixXd forcing_terms_all(T, n_candidates * D);
+  MatrixXd xs_goal, xds_goal;
+  // Local copy of the goal system, so that this function does not change the
+  // state of the Dmp.
+  unique_ptr<ExponentialSystem> goal_system(
+      goal_system_ == NULL ? NULL : goal_system_->clone());
+  for (int i_cand = 0; i_cand < n_candidates; i_cand++) {
+    VectorXd y_init_cand = y_inits.row(i_cand).transpose();
+    VectorXd y_attr_cand = y_attrs.row(i_cand).transpose();
+
+    if (scale_per_candidate) {
+      VectorXd g_minus_y0 = y_attr_cand - y_init_cand;
+      forcing_terms_all.middleCols(i_cand * D, D) =
+          forcing_terms * g_minus_y0.asDiagonal();
+    } else {
+      forcing_terms_all.middleCols(i_cand * D, D) = forcing_terms;
+    }
+
+    if (goal_system == NULL) {
+      goals.middleCols(i_cand * D, D) = y_attr_cand.transpose().replicate(T, 1);
+    } else {
+      goal_system->set_x_init(y_init_cand);
+      goal_system->set_x_attr(y_attr_cand);
+      goal_system->analyticalSolution(ts, xs_goal, xds_goal);
+      goals.middleCols(i_cand * D, D) = xs_goal;
+    }
+  }
+
+  MatrixXd y_inits_transposed = y_inits.transpose();
+  Map<const VectorXd> y_inits_all(y_inits_transposed.data(), n_candidates * D);
+  integrateSpringBatch(ts, goals, y_inits_all, forcing_terms_all, ys, yds,
+                       ydds);
+}
+
+void Dmp::integrateSpringBatch(const Eigen::VectorXd& ts,
+                               const Eigen::MatrixXd& goals,
+                               const Eigen::VectorXd& y_inits,
+                               const Eigen::MatrixXd& forcing_terms,
+                               Eigen::MatrixXd& ys, Eigen::MatrixXd& yds,
+                               Eigen::MatrixXd& ydds) const
+{
+  int n_time_steps = ts.size();
+  int N = y_inits.size();
+  assert(goals.rows() == n_time_steps && goals.cols() == N);
+  assert(forcing_terms.rows() == n_time_steps && forcing_terms.cols() == N);
+
+  double damping = spring_system_->damping_coefficient();
+  SpringDamperSystem localspring_system_(tau(), y_init(), y_attr_, damping);
+  double k = localspring_system_.spring_constant();
+  double m = localspring_system_.mass();
+  double c = damping;
+
+  // Each column is one time step, so that the springs of all samples and
+  // dimensions are updated with contiguous vector operations.
+  MatrixXd G = goals.transpose();
+  MatrixXd F = forcing_terms.transpose();
+  MatrixXd Y(N, n_time_steps), Z(N, n_time_steps);
+  MatrixXd Yd(N, n_time_steps), Zd(N, n_time_steps);
+
+  // Same as integrateStart() of the spring-damper system, plus forcing term
+  Y.col(0) = y_inits;
+  Z.col(0).setZero();
+  Yd.col(0) = Z.col(0) / tau();
+  Zd.col(0) = (-k * (Y.col(0) - G.col(0)) - c * Z.col(0)) / (m * tau()) +
+              F.col(0) / tau();
+
+  bool exact = (analytical_solution_integration_ != "EULER");
+  bool first_order_hold = (analytical_solution_integration_ == "EXACT_FOH");
+  Matrix2d Phi, Gamma0, Gamma1;
+  double dt_cached = -1.0;
+
+  for (int tt = 1; tt < n_time_steps; tt++) {
+    double dt = ts[tt] - ts[tt - 1];
+    if (exact) {
+      if (dt != dt_cached) {
+        localspring_system_.discretizeExact(dt, Phi, Gamma0, Gamma1);
+        if (!first_order_hold) Gamma1.setZero();
+        dt_cached = dt;
+      }
+      Y.col(tt) = Phi(0, 0) * Y.col(tt - 1) + Phi(0, 1) * Z.col(tt - 1) +
+                  Gamma0(0, 0) * G.col(tt - 1) + Gamma0(0, 1) * F.col(tt - 1) +
+                  Gamma1(0, 0) * (G.col(tt) - G.col(tt - 1)) +
+                  Gamma1(0, 1) * (F.col(tt) - F.col(tt - 1));
+      Z.col(tt) = Phi(1, 0) * Y.col(tt - 1) + Phi(1, 1) * Z.col(tt - 1) +
+                  Gamma0(1, 0) * G.col(tt - 1) + Gamma0(1, 1) * F.col(tt - 1) +
+                  Gamma1(1, 0) * (G.col(tt) - G.col(tt - 1)) +
+                  Gamma1(1, 1) * (F.col(tt) - F.col(tt - 1));
+    } else {
+      // Euler integration
+      Y.col(tt) = Y.col(tt - 1) + dt * Yd.col(tt - 1);
+      Z.col(tt) = Z.col(tt - 1) + dt * Zd.col(tt - 1);
+    }
+    Yd.col(tt) = Z.col(tt) / tau();
+    Zd.col(tt) = (-k * (Y.col(tt) - G.col(tt)) - c * Z.col(tt)) / (m * tau()) +
+                 F.col(tt) / tau();
+  }
+
+  ys = Y.transpose();
+  yds = Yd.transpose();
+  ydds = Zd.transpose() / tau();
+}
+
+void Dmp::prepareSeek(const Eigen::VectorXd& ts, int checkpoint_interval)
+{
+  assert(ts.size() > 0);
+  assert(checkpoint_interval > 0);
+
+  MatrixXd xs, xds;
+  analyticalSolution(ts, xs, xds);
+
+  int n_checkpoints = (ts.size() - 1) / checkpoint_interval + 1;
+  seek_checkpoints_x_.resize(n_checkpoints, 2 * dim_y());
+  seek_checkpoints_xd_.resize(n_checkpoints, 2 * dim_y());
+  for (int i_cp = 0; i_cp < n_checkpoints; i_cp++) {
+    int tt = i_cp * checkpoint_interval;
+    seek_checkpoints_x_.row(i_cp) = xs.row(tt).SPRING;
+    seek_checkpoints_xd_.row(i_cp) = xds.row(tt).SPRING;
+  }
+  seek_ts_ = ts;
+  seek_checkpoint_interval_ = checkpoint_interval;
+
+  // Memory for seek(), so that it need not be allocated for each query
+  int n_block = std::min(checkpoint_interval, (int)ts.size());
+  seek_block_index_ = -1;
+  seek_block_ts_.resize(n_block);
+  seek_block_xs_.resize(n_block, dim());
+  seek_block_xds_.resize(n_block, dim());
+  seek_block_forcing_terms_.resize(n_block, dim_y());
+  seek_block_fa_outputs_.resize(n_block, dim_y());
+  seek_step_ts_.resize(2);
+  seek_step_xs_.resize(2, dim());
+  seek_step_xds_.resize(2, dim());
+  seek_step_forcing_terms_.resize(2, dim_y());
+  seek_step_fa_outputs_.resize(2, dim_y());
+}
+
+void Dmp::clearSeek(void)
+{
+  // Only mark the checkpoints as invalid. Freeing the memory here would make
+  // all setters non-real-time.
+  seek_checkpoint_interval_ = 0;
+  seek_block_index_ = -1;
+}
+
+void Dmp::seekBlock(int i_cp) const
+{
+  int i_start = i_cp * seek_checkpoint_interval_;
+  int n_steps =
+      std::min(seek_checkpoint_interval_, (int)seek_ts_.size() - i_start);
+
+  // Only the last block may be shorter, so the memory is only reallocated
+  // when switching between it and the other blocks.
+  seek_block_ts_ = seek_ts_.segment(i_start, n_steps);
+  typedef Stride<Dynamic, Dynamic> DynamicStride;
+  DynamicStride stride(seek_block_xs_.rows(), 1);
+  StridedMatrixMap xs(seek_block_xs_.data(), n_steps, dim(), stride);
+  StridedMatrixMap xds(seek_block_xds_.data(), n_steps, dim(), stride);
+
+  // The linear subsystems are evaluated in closed form at the times of the
+  // block. The spring is propagated from the checkpoint with the same steps as
+  // in analyticalSolution(), so that results on the grid are identical.
+  analyticalSolutionSubSystems(seek_block_ts_, xs, xds,
+                               seek_block_forcing_terms_,
+                               seek_block_fa_outputs_);
+  xs.row(0).SPRING = seek_checkpoints_x_.row(i_cp);
+  xds.row(0).SPRING = seek_checkpoints_xd_.row(i_cp);
+  integrateSpring(seek_block_ts_, seek_block_forcing_terms_, xs, xds);
+
+  seek_block_index_ = i_cp;
+}
+
+bool Dmp::seek(double t, Eigen::Ref<Eigen::VectorXd> x,
+               Eigen::Ref<Eigen::VectorXd> xd) const
+{
+  assert(x.size() == dim());
+  assert(xd.size() == dim());
+
+  if (!isSeekPrepared()) {
+    cerr << __FILE__ << ":" << __LINE__ << ":";
+    cerr << "Call prepareSeek() before calling seek()." << endl;
+    return false;
+  }
+
+  // Times outside of the range of ts are clamped
+  int n_time_steps = seek_ts_.size();
+  t = std::max(seek_ts_[0], std::min(t, seek_ts_[n_time_steps - 1]));
+
+  // Index of the last time step in the grid with ts[i_step] <= t
+  const double* ts_begin = seek_ts_.data();
+  int i_step = std::upper_bound(ts_begin, ts_begin + n_time_steps, t) -
+               ts_begin - 1;
+  i_step = std::max(0, i_step);
+
+  // Propagate the spring over the block that starts at the closest checkpoint
+  // that precedes t, unless that was already done by a previous query.
+  int i_cp = i_step / seek_checkpoint_interval_;
+  if (i_cp != seek_block_index_) seekBlock(i_cp);
+  int i_row = i_step - i_cp * seek_checkpoint_interval_;
+
+  if (t == seek_ts_[i_step]) {
+    x = seek_block_xs_.row(i_row);
+    xd = seek_block_xds_.row(i_row);
+    return true;
+  }
+
+  // t lies between two grid points, so make a last (shorter) step from
+  // ts[i_step] to t.
+  seek_step_ts_[0] = seek_ts_[i_step];
+  seek_step_ts_[1] = t;
+  StridedMatrixMap xs = stridedMap(seek_step_xs_, TIME_STEPS_IN_ROWS);
+  StridedMatrixMap xds = stridedMap(seek_step_xds_, TIME_STEPS_IN_ROWS);
+  analyticalSolutionSubSystems(seek_step_ts_, xs, xds, seek_step_forcing_terms_,
+                               seek_step_fa_outputs_);
+  xs.row(0).SPRING = seek_block_xs_.row(i_row).SPRING;
+  xds.row(0).SPRING = seek_block_xds_.row(i_row).SPRING;
+  integrateSpring(seek_step_ts_, seek_step_forcing_terms_, xs, xds);
+
+  x = seek_step_xs_.row(1);
+  xd = seek_step_xds_.row(1);
+  return true;
 }
 
 void Dmp::set_tau(double tau)
 {
   DynamicalSystem::set_tau(tau);
+  clearSeek();
 
   // Set value in all relevant subsystems also
   spring_system_->set_tau(tau);
@@ -525,6 +1692,7 @@ void Dmp::set_y_init(const Eigen::VectorXd& y_init)
 {
   assert(y_init.size() == dim_y());
   DynamicalSystem::set_y_init(y_init);
+  clearSeek();
 
   // Set value in all relevant subsystems also
   spring_system_->set_y_init(y_init);
@@ -534,6 +1702,7 @@ void Dmp::set_y_init(const Eigen::VectorXd& y_init)
 void Dmp::set_y_attr(const VectorXd& y_attr)
 {
   y_attr_ = y_attr;
+  clearSeek();
 
   // Set value in all relevant subsystems also
   if (goal_system_ != NULL) goal_system_->set_x_attr(y_attr);
@@ -555,7 +1724,9 @@ void from_json(const nlohmann::json& j, Dmp*& obj)
 
   ExponentialSystem* goal_system;
   DynamicalSystem *phase_system, *gating_system;
-  goal_system = j.at("_goal_system").get<ExponentialSystem*>();
+  goal_system = NULL;
+  if (!j.at("_goal_system").is_null())
+    goal_system = j.at("_goal_system").get<ExponentialSystem*>();
   phase_system = j.at("_phase_system").get<DynamicalSystem*>();
   gating_system = j.at("_gating_system").get<DynamicalSystem*>();
 
@@ -581,13 +1752,21 @@ void Dmp::to_json_helper(nlohmann::json& j) const
 {
   to_json_base(j);  // Get the json string from the base class
 
+  j["_y_attr"] = y_attr_;
+  j["_scaling_amplitudes"] = scaling_amplitudes_;
   j["_spring_system"]["damping_coefficient"] =
       spring_system_->damping_coefficient();
-  j["_goal_system"] = goal_system_;
+  if (goal_system_ == NULL)
+    j["_goal_system"] = nullptr;
+  else
+    j["_goal_system"] = goal_system_;
   j["_phase_system"] = phase_system_;
   j["_gating_system"] = gating_system_;
   j["_forcing_term_scaling"] = forcing_term_scaling_;
-  j["_function_approximators"] = function_approximators_;
+  vector<FunctionApproximator*> function_approximators;
+  for (unsigned int ff = 0; ff < function_approximators_.size(); ff++)
+    function_approximators.push_back(function_approximators_[ff].get());
+  j["_function_approximators"] = function_approximators;
   j["class"] = "Dmp";
 }
 
@@ -27,6 +27,8 @@
 #define EIGEN_RUNTIME_NO_MALLOC  // Enable runtime tests for allocations
 
 #include <eigen3/Eigen/Core>
+#include <memory>
+#include <mutex>
 #include <nlohmann/json_fwd.hpp>
 
 #include "dynamicalsystems/DynamicalSystem.hpp"
@@ -38,6 +40,8 @@ class FunctionApproximator;
 class ExponentialSystem;
 class SpringDamperSystem;
 class Trajectory;
+class ThreadPool;
+class PackedForcingTerm;
 
 /** \defgroup Dmps Dynamic Movement Primitives Module
  */
@@ -132,6 +136,87 @@ class Dmp : public DynamicalSystem {
   /** Destructor. */
   ~Dmp(void);
 
+  /** Create a copy of this Dmp that shares the function approximators with it.
+   *
+   * The subsystems and the state of the Dmp (tau, y_init, y_attr, etc.) are
+   * copied, so that the copy can be modified and integrated independently of
+   * the original. The function approximators, which contain most of the
+   * model parameters, are shared. They are only copied when the parameters of
+   * one of the Dmps sharing them are changed with setLinearParameterVector(),
+   * or when unshareParameters() is called.
+   * The same holds for the packed forcing term (cf. packForcingTerm()). The
+   * thread pool of analyticalSolution() is also shared. This makes it cheap to
+   * create many instances of the same Dmp, e.g. for different agents in a
+   * simulation.
+   *
+   * \return The copy. The caller is responsible for deleting it.
+   *
+   * \remarks The shared objects are not changed during integration, so Dmps
+   * that share them may be integrated in different threads at the same time.
+   * Calls of analyticalSolution() with more than one thread on Dmps that share
+   * the thread pool are executed one after the other.
+   *
+   * \remarks The cached features of analyticalSolutionBatch() and the
+   * checkpoints of prepareSeek() are not copied, so call prepareSeek() again
+   * on the copy before calling seek().
+   */
+  Dmp* clone(void) const;
+
+  /** Copy the function approximators and the packed forcing term if they are
+   * shared with a clone (cf. clone()).
+   *
+   * This function is not real-time. It prepares a clone for
+   * copyParametersRealTime() and copyFunctionApproximatorParametersRealTime(),
+   * which do not copy shared objects, because that would allocate memory.
+   */
+  void unshareParameters(void);
+
+  /** Copy the parameters of another Dmp with the same structure into this one.
+   *
+   * This function is real-time, i.e. it does not allocate memory. It makes it
+   * possible to construct or load a Dmp outside of the real-time thread (e.g.
+   * with from_json), and to switch to its parameters on the real-time thread.
+   *
+   * The time constant, initial and attractor state, the constants of the
+   * spring-damper system, the scaling amplitudes, and the model parameters of
+   * the function approximators are copied. The phase, gating and goal systems
+   * are assumed to be the same, apart from their time constant and their
+   * initial and attractor states.
+   *
+   * \param[in] other The Dmp to copy the parameters from
+   * \return false if the other Dmp does not have the same structure (number
+   * of dimensions, forcing term scaling, function approximators of the same
+   * type and size, and the same layout of the packed forcing term), or if
+   * the function approximators or the packed forcing term of this Dmp are
+   * shared with a clone. Nothing is copied in that case.
+   *
+   * \remarks Call unshareParameters() on a clone before integrating it, if
+   * its parameters are to be changed with this function.
+   */
+  bool copyParametersRealTime(const Dmp& other);
+
+  /** Copy the model parameters of a function approximator with the same
+   * structure into the function approximator of one dimension.
+   *
+   * This function is real-time, i.e. it does not allocate memory. It makes it
+   * possible to publish parameters that are adapted online, e.g. with
+   * RecursiveLeastSquares, to a Dmp that is being integrated. It should be
+   * called from the thread that integrates the Dmp, e.g. between two
+   * integration steps.
+   *
+   * \param[in] i_dim The dimension of the function approximator
+   * \param[in] fa The function approximator to copy the parameters from
+   * \return false if the function approximator does not have the same
+   * structure as the one of the Dmp, if it does not fit into the packed
+   * forcing term, or if the function approximator or the packed forcing term
+   * of the Dmp are shared with a clone. Nothing is copied in that case.
+   *
+   * \remarks Call unshareParameters() on a clone before integrating it, if
+   * its parameters are to be changed with this function.
+   */
+  bool copyFunctionApproximatorParametersRealTime(
+      int i_dim, const FunctionApproximator& fa);
+
   virtual void integrateStart(Eigen::Ref<Eigen::VectorXd> x,
                               Eigen::Ref<Eigen::VectorXd> xd) const;
 
@@ -194,6 +279,69 @@ class Dmp : public DynamicalSystem {
     analyticalSolution(ts, xs, xds, forcing_terms, fa_output);
   }
 
+  using DynamicalSystem::analyticalSolution;
+
+  /**
+   * Write the analytical solution of the system at certain times to memory
+   * provided by the caller (and return forcing terms).
+   *
+   * \param[in]  ts  A vector of times for which to compute the analytical
+   * solutions
+   * \param[out] xs  Sequence of state vectors. T x D view with arbitrary
+   * strides, cf. DynamicalSystem::stridedMap().
+   * \param[out] xds Sequence of state vectors (rates of change), T x D view
+   * \param[out] forcing_terms The forcing terms for each dimension, for
+   * debugging purposes only.
+   * \param[out] fa_output The output of the function approximators, for
+   * debugging purposes only.
+   */
+  void analyticalSolution(const Eigen::VectorXd& ts, StridedMatrixMap xs,
+                          StridedMatrixMap xds, Eigen::MatrixXd& forcing_terms,
+                          Eigen::MatrixXd& fa_output) const;
+
+  void analyticalSolution(const Eigen::VectorXd& ts, StridedMatrixMap xs,
+                          StridedMatrixMap xds) const;
+
+  /**
+   * Return only the positions, velocities and accelerations of the analytical
+   * solution, i.e. the channels of statesAsTrajectory(), rather than the whole
+   * state.
+   *
+   * \param[in]  ts   A vector of times for which to compute the analytical
+   * solutions
+   * \param[out] ys   Positions. T x dim_y() view with arbitrary strides, cf.
+   * DynamicalSystem::stridedMap().
+   * \param[out] yds  Velocities, T x dim_y() view
+   * \param[out] ydds Accelerations, T x dim_y() view
+   *
+   * \remarks The results are the same as those of analyticalSolution()
+   * followed by statesAsTrajectory().
+   *
+   * \remarks This is a convenience function, not a saving in memory
+   * bandwidth: the whole state is still integrated, in memory that is
+   * allocated in the first call and reused in later calls (unless ts has more
+   * time steps, or another thread is calling this function on the same Dmp).
+   * Only the copy to the output is restricted to y, yd and ydd.
+   */
+  void analyticalSolutionTrajectory(const Eigen::VectorXd& ts,
+                                    StridedMatrixMap ys, StridedMatrixMap yds,
+                                    StridedMatrixMap ydds) const;
+
+  /**
+   * Return only the positions, velocities and accelerations of the analytical
+   * solution, in a certain layout.
+   *
+   * \param[in]  ts   A vector of times for which to compute the analytical
+   * solutions
+   * \param[out] ys   Positions (T x dim_y() or dim_y() x T)
+   * \param[out] yds  Velocities
+   * \param[out] ydds Accelerations
+   * \param[in]  layout Layout of ys, yds and ydds
+   */
+  void analyticalSolutionTrajectory(
+      const Eigen::VectorXd& ts, Eigen::MatrixXd& ys, Eigen::MatrixXd& yds,
+      Eigen::MatrixXd& ydds, StateLayout layout = TIME_STEPS_IN_ROWS) const;
+
   /**
    * Return analytical solution of the system at certain times
    *
@@ -224,6 +372,187 @@ class Dmp : public DynamicalSystem {
     statesAsTrajectory(ts, xs, xds, trajectory);
   }
 
+  /**
+   * Choose how analyticalSolution() integrates the spring-damper system.
+   *
+   * "EULER" (the default) uses Euler integration, which is serial and
+   * inaccurate for large time steps. "EXACT_ZOH" uses the exact discretization
+   * of the spring-damper system (see SpringDamperSystem::discretizeExact()),
+   * with a zero-order hold on the goal and forcing term during each time step.
+   * This has no integration error for the spring-damper itself, but the error
+   * due to the hold is still O(dt). "EXACT_FOH" interpolates the goal and
+   * forcing term linearly during each time step instead, which makes the error
+   * O(dt^2). The resulting linear recurrence is evaluated with a parallel
+   * prefix scan (see set_analytical_solution_n_threads()), which pays off for
+   * long horizons (e.g. 10^5 time steps or more).
+   *
+   * \param[in] integration "EULER", "EXACT_ZOH" or "EXACT_FOH"
+   */
+  void set_analytical_solution_integration(std::string integration);
+
+  /**
+   * Set the number of threads used by analyticalSolution().
+   *
+   * With more than 1 thread, the phase, gating and goal systems are solved
+   * concurrently, the function approximators are evaluated in parallel over
+   * dimensions and blocks of time steps, and the "EXACT_ZOH"/"EXACT_FOH"
+   * integration of the spring-damper is done with a parallel prefix scan. The
+   * threads are kept in a pool that is owned by the Dmp. The work is divided
+   * statically, so the results are reproducible. They are also identical for
+   * any number of threads, except for the prefix scan, where the division into
+   * blocks changes the rounding errors (of the order of 1e-14). Short
+   * evaluations (less than 1024 time steps) are always done serially. By
+   * default, at most as many threads as there are hardware threads are used.
+   * The prefix scan processes each time step twice, so it is only used with 3
+   * threads or more, and the spring-damper is integrated serially otherwise.
+   *
+   * \param[in] n_threads Number of threads. 1 (the default) for serial
+   * execution, 0 for the number of hardware threads.
+   * \param[in] limit_to_hardware_threads Whether to use at most as many
+   * threads as there are hardware threads. Only set this to false to test the
+   * parallel code on machines with few hardware threads.
+   *
+   * \remarks If REALTIME_CHECKS is defined, execution is always serial,
+   * because Eigen's flag for checking memory allocation is shared by all
+   * threads.
+   */
+  void set_analytical_solution_n_threads(int n_threads,
+                                         bool limit_to_hardware_threads = true);
+
+  /** Get the number of parameters in which the forcing term is linear.
+   * \return Sum of FunctionApproximator::getLinearParameterVectorSize() over
+   * all dimensions
+   */
+  int getLinearParameterVectorSize(void) const;
+
+  /** Get the parameters in which the forcing term is linear, i.e. those of
+   * the function approximators of all dimensions, concatenated.
+   * \param[out] values The parameter vector
+   */
+  void getLinearParameterVector(Eigen::VectorXd& values) const;
+
+  /** Set the parameters in which the forcing term is linear.
+   * \param[in] values The parameter vector, cf. getLinearParameterVector()
+   */
+  void setLinearParameterVector(const Eigen::VectorXd& values);
+
+  /**
+   * Compute the analytical solution for many parameter vectors at once.
+   *
+   * This is useful in an optimization update, where all samples have the same
+   * basis functions, and differ only in the parameters in which the forcing
+   * term is linear (e.g. the weights of an RBFN). The features of the function
+   * approximators (multiplied with the gating term) are computed once, and
+   * cached for subsequent calls with the same ts and tau. The forcing terms
+   * of all samples are then computed with one matrix product (one per
+   * dimension if the dimensions have different basis functions). Finally, the
+   * spring-damper systems of all samples are integrated together with vector
+   * operations, as set with set_analytical_solution_integration().
+   *
+   * \param[in]  ts  A vector of times (size T)
+   * \param[in]  parameter_vectors One parameter vector per row (size K x P),
+   * cf. getLinearParameterVector()
+   * \param[out] ys   Positions (T x K*D). The D columns of sample k start at
+   * column k*D, i.e. ys.middleCols(k*D, D) is the trajectory of sample k.
+   * \param[out] yds  Velocities (T x K*D)
+   * \param[out] ydds Accelerations (T x K*D)
+   *
+   * \remarks The results are the same (up to rounding errors) as calling
+   * setLinearParameterVector() and analyticalSolution() for each sample.
+   *
+   * \remarks The cache of the features is protected by a mutex, so this
+   * function may be called from several threads at the same time. The
+   * features are then computed only once, but the matrix products of the
+   * different calls are done one after the other. Calls on different clones
+   * (see clone()) do not wait for each other.
+   */
+  void analyticalSolutionBatch(const Eigen::VectorXd& ts,
+                               const Eigen::MatrixXd& parameter_vectors,
+                               Eigen::MatrixXd& ys, Eigen::MatrixXd& yds,
+                               Eigen::MatrixXd& ydds) const;
+
+  /**
+   * Compute the analytical solution for many initial and attractor states at
+   * once, e.g. for candidate start/goal pairs in a motion planner.
+   *
+   * The phase, gating and function approximator outputs do not depend on the
+   * initial and attractor state, and are computed only once. With
+   * G_MINUS_Y0_SCALING, the forcing term is scaled for each candidate
+   * separately. The spring-damper systems of all candidates are then
+   * integrated together with vector operations, as in
+   * analyticalSolutionBatch().
+   *
+   * \param[in]  ts  A vector of times (size T)
+   * \param[in]  y_inits One initial state per row (size K x D)
+   * \param[in]  y_attrs One attractor state per row (size K x D)
+   * \param[out] ys   Positions (T x K*D). The D columns of candidate k start at
+   * column k*D.
+   * \param[out] yds  Velocities (T x K*D)
+   * \param[out] ydds Accelerations (T x K*D)
+   *
+   * \remarks The results are the same (up to rounding errors) as calling
+   * set_y_init(), set_y_attr() and analyticalSolution() for each candidate.
+   */
+  void analyticalSolutionSweep(const Eigen::VectorXd& ts,
+                               const Eigen::MatrixXd& y_inits,
+                               const Eigen::MatrixXd& y_attrs,
+                               Eigen::MatrixXd& ys, Eigen::MatrixXd& yds,
+                               Eigen::MatrixXd& ydds) const;
+
+  /**
+   * Prepare random-access evaluation of the Dmp state with seek().
+   *
+   * Computes the analytical solution over ts once, and stores the state of the
+   * spring-damper system every checkpoint_interval time steps. The phase,
+   * gating and goal systems need no checkpoints, as they are solved in closed
+   * form.
+   *
+   * \param[in] ts  A vector of times, as passed to analyticalSolution()
+   * \param[in] checkpoint_interval Number of time steps between checkpoints
+   *
+   * \remarks The checkpoints are cleared when tau, the initial state, the
+   * attractor state, the spring-damper parameters or the parameters of the
+   * function approximators change. prepareSeek() must then be called again.
+   */
+  void prepareSeek(const Eigen::VectorXd& ts, int checkpoint_interval = 10);
+
+  /** Remove the checkpoints stored by prepareSeek(). The memory is kept, so
+   * that this function is real-time. */
+  void clearSeek(void);
+
+  /** Whether prepareSeek() has been called since the last change of the Dmp.
+   * \return true if seek() may be called
+   */
+  inline bool isSeekPrepared(void) const
+  {
+    return seek_checkpoint_interval_ > 0;
+  }
+
+  /**
+   * Get the state of the Dmp at an arbitrary time.
+   *
+   * The spring-damper system is propagated over the block of time steps that
+   * starts at the nearest preceding checkpoint (see prepareSeek()), so a query
+   * costs O(checkpoint_interval) rather than O(t/dt). The states of the last
+   * block are kept, so further queries in the same block, e.g. when scrubbing,
+   * only cost one integration step. For times on the ts grid, the result is
+   * the same as the corresponding row of analyticalSolution(). For times in
+   * between, one last integration step is made from the preceding grid time
+   * to t.
+   *
+   * \param[in]  t  Time at which to evaluate the state. Clamped to the range of
+   * the ts passed to prepareSeek().
+   * \param[out] x  State vector at time t (size dim())
+   * \param[out] xd Rate of change of the state vector at time t (size dim())
+   * \return false if prepareSeek() has not been called, true otherwise
+   *
+   * \remarks seek() uses memory that is preallocated by prepareSeek(), so it
+   * must not be called for the same Dmp from different threads at the same
+   * time. Use clone() to seek in several threads.
+   */
+  bool seek(double t, Eigen::Ref<Eigen::VectorXd> x,
+            Eigen::Ref<Eigen::VectorXd> xd) const;
+
   /** Get the output of a DMP dynamical system as a trajectory.
    *  As a dynamical system, the state vector of a DMP contains the output of
    * the goal, spring, phase and gating system. What we are most interested in
@@ -303,6 +632,172 @@ class Dmp : public DynamicalSystem {
    */
   void set_spring_constant(double spring_constant);
 
+  /**
+   * Evaluate the function approximators at a lower rate than the integration.
+   *
+   * The function approximators are then only evaluated at phase knots, i.e.
+   * multiples of phase_interval, and their outputs are interpolated in
+   * between. The spring-damper, goal, phase and gating systems are still
+   * integrated at every step. Because the knot outputs are cached, the cost of
+   * evaluating the function approximators is reduced roughly by the ratio of
+   * the integration rate to the knot rate.
+   *
+   * For a TimeSystem phase (which goes from 0 to 1 in tau seconds), an update
+   * period of dt_update seconds corresponds to phase_interval = dt_update/tau.
+   *
+   * \param[in] phase_interval Distance between the phase knots. 0 to evaluate
+   * the function approximators at every call of differentialEquation().
+   * \param[in] interpolation "LINEAR" or "CUBIC" (Catmull-Rom spline)
+   *
+   * \remarks Only affects differentialEquation() (and thus integrateStep()),
+   * not analyticalSolution(). The knot cache is cleared by integrateStart(),
+   * and when the parameters of the function approximators are set.
+   */
+  void set_forcing_term_phase_interval(double phase_interval,
+                                       std::string interpolation = "LINEAR");
+
+  /** Get the distance between the phase knots for multi-rate execution.
+   * \return Distance between phase knots (0 if multi-rate execution is off)
+   */
+  inline double forcing_term_phase_interval(void) const
+  {
+    return forcing_term_phase_interval_;
+  }
+
+  /** Pack the parameters of the function approximators into one contiguous,
+   * cache-aligned block of memory, which is used in differentialEquation()
+   * instead of the function approximators, cf. PackedForcingTerm.
+   *
+   * The outputs are the same up to rounding errors. Changing the parameters
+   * with setLinearParameterVector() packs them again.
+   *
+   * With "FLOAT32", the forcing term is computed in single precision, which
+   * is faster for many basis functions. The rest of the Dmp is still
+   * integrated in double precision.
+   *
+   * \param[in] scalar_type "FLOAT64" (default) or "FLOAT32"
+   * \return true if the function approximators could be packed, false if
+   * they or the scalar type are not supported by PackedForcingTerm.
+   */
+  bool packForcingTerm(std::string scalar_type = "FLOAT64");
+
+  /** Use the function approximators again, instead of their packed
+   * parameters. */
+  void unpackForcingTerm(void);
+
+  /** Whether the parameters of the function approximators are packed.
+   * \return true if packForcingTerm() was successful
+   */
+  inline bool isForcingTermPacked(void) const
+  {
+    return packed_forcing_term_ != NULL;
+  }
+
+  /** Store the model parameters of the function approximators with fewer
+   * bits, cf. FunctionApproximatorRBFNQuantized.
+   *
+   * This reduces the memory that the function approximators require by a
+   * factor of 2 ("FLOAT32") or 4 ("FLOAT16", "INT16"), at the cost of a
+   * quantization error in their outputs. If the forcing term was packed, it
+   * is unpacked.
+   *
+   * \param[in] format "FLOAT32", "FLOAT16" or "INT16", cf. QuantizedArray
+   * \param[out] max_errors For each dimension, the maximum difference between
+   * the outputs of the original and the quantized function approximator, cf.
+   * FunctionApproximatorRBFNQuantized::maxError()
+   * \return false if not all function approximators are RBFNs. Nothing is
+   * quantized in that case.
+   */
+  bool quantizeFunctionApproximators(std::string format,
+                                     Eigen::VectorXd& max_errors);
+
+  /** Construct a Dmp and train it with a trajectory, as Dmp.from_traj() in
+   * Python.
+   *
+   * tau, y_init and y_attr are set to the duration, the first and the last
+   * state of the trajectory respectively.
+   *
+   * \param[in] trajectory The trajectory with which to train the Dmp
+   * \param[in] fa_meta_params Class and meta-parameters of the function
+   * approximators, cf. FunctionApproximator::train()
+   * \param[in] dmp_type  The type of DMP ("IJSPEERT_2002_MOVEMENT",
+   * "KULVICIUS_2012_JOINING", "COUNTDOWN_2013")
+   * \param[in] scaling Which method to use for scaling the forcing term
+   * ("NO_SCALING", "G_MINUS_Y0_SCALING", "AMPLITUDE_SCALING")
+   * \param[in] thread_pool Pool in which to train the function approximators
+   * of the different dimensions (NULL: train them in the calling thread)
+   * \return The trained Dmp, or NULL if training failed. The caller is
+   * responsible for deleting it.
+   */
+  static Dmp* fromTrajectory(const Trajectory& trajectory,
+                             const nlohmann::json& fa_meta_params,
+                             std::string dmp_type = "KULVICIUS_2012_JOINING",
+                             std::string scaling = "NO_SCALING",
+                             ThreadPool* thread_pool = NULL);
+
+  /** Train the Dmp with a trajectory, as Dmp.train() in Python.
+   *
+   * Sets tau, y_init, y_attr and the scaling amplitudes from the trajectory,
+   * and replaces the function approximators with newly trained ones. One
+   * function approximator is trained for each dimension, with the targets
+   * from computeTargets(). Function approximators shared with clones are not
+   * modified. If the forcing term was packed, it is unpacked.
+   *
+   * \param[in] trajectory The trajectory with which to train the Dmp
+   * \param[in] fa_meta_params Class and meta-parameters of the function
+   * approximators, cf. FunctionApproximator::train()
+   * \param[in] thread_pool Pool in which to train the function approximators
+   * of the different dimensions (NULL: train them in the calling thread)
+   * \return false if training failed. The Dmp is not changed in that case.
+   */
+  bool train(const Trajectory& trajectory, const nlohmann::json& fa_meta_params,
+             ThreadPool* thread_pool = NULL);
+
+  /** Compute the inputs and targets for the function approximators, as
+   * Dmp._compute_targets() in Python.
+   *
+   * The inputs are the phase over time, and the targets are the forcing terms
+   * required to reproduce the trajectory, with the gating term and scaling
+   * factored out. The phase, gating and goal are computed with the analytical
+   * solutions of their systems.
+   *
+   * \param[in] trajectory The trajectory, e.g. a demonstration
+   * \param[out] fa_inputs_phase The inputs for the function approximators
+   * (n_time_steps X 1)
+   * \param[out] f_targets The targets for the function approximators
+   * (n_time_steps X dim_dmp())
+   * \return false if the dimensionality of the trajectory does not match
+   */
+  bool computeTargets(const Trajectory& trajectory,
+                      Eigen::MatrixXd& fa_inputs_phase,
+                      Eigen::MatrixXd& f_targets) const;
+
+  /** Compute the input and targets for the function approximators for one
+   * demonstrated state, e.g. of a corrective demonstration during execution.
+   *
+   * This is the same computation as in computeTargets(), but the phase, gating
+   * and goal are taken from the current state of the Dmp, rather than from the
+   * analytical solutions of their systems. This function is real-time.
+   *
+   * \param[in] x The current state of the Dmp (size dim())
+   * \param[in] y The demonstrated position (size dim_dmp())
+   * \param[in] yd The demonstrated velocity (size dim_dmp())
+   * \param[in] ydd The demonstrated acceleration (size dim_dmp())
+   * \param[out] fa_input_phase The input for the function approximators
+   * (1 X 1)
+   * \param[out] f_targets The targets for the function approximators
+   * (size dim_dmp())
+   *
+   * \remarks The targets are divided by the gating term, so they become very
+   * large towards the end of the movement, when the gating term approaches 0.
+   */
+  void computeTargetsRealTime(const Eigen::Ref<const Eigen::VectorXd>& x,
+                              const Eigen::Ref<const Eigen::VectorXd>& y,
+                              const Eigen::Ref<const Eigen::VectorXd>& yd,
+                              const Eigen::Ref<const Eigen::VectorXd>& ydd,
+                              Eigen::Ref<Eigen::RowVectorXd> fa_input_phase,
+                              Eigen::Ref<Eigen::VectorXd> f_targets) const;
+
   /** Get a pointer to the function approximator for a certain dimension.
    * \param[in] i_dim Dimension for which to get the function approximator
    * \return Pointer to the function approximator.
@@ -310,7 +805,7 @@ class Dmp : public DynamicalSystem {
   inline FunctionApproximator* function_approximator(int i_dim) const
   {
     assert(i_dim < (int)function_approximators_.size());
-    return function_approximators_[i_dim];
+    return function_approximators_[i_dim].get();
   }
 
   /**
@@ -379,7 +874,19 @@ class Dmp : public DynamicalSystem {
     obj->to_json_helper(j);
   }
 
- private:
+ protected:
+  /** Copy constructor, used by clone(). Only performs a shallow copy of the
+   * subsystems, cf. cloneSubSystems(). The caches of analyticalSolutionBatch()
+   * and seek() are not copied, and the pre-allocated memory is allocated with
+   * the same sizes, but not copied. So copying does not read memory that may
+   * be written by the original in another thread at the same time. */
+  Dmp(const Dmp& other);
+
+  /** Replace the subsystems of this Dmp by copies, so that it can be
+   * integrated independently of the Dmp it was copied from with the copy
+   * constructor. The function approximators remain shared. */
+  void cloneSubSystems(void);
+
   /** Write this object to json.
    *  \param[out]  j json output
    *
@@ -389,6 +896,23 @@ class Dmp : public DynamicalSystem {
    */
   void to_json_helper(nlohmann::json& j) const;
 
+  /**
+   * Compute the outputs of the function approximators for one phase, with the
+   * packed parameters if available.
+   *
+   * This function is called by differentialEquation() for each evaluation of
+   * the forcing term. Subclasses may override it to compute further outputs
+   * for the same phase, cf. DmpWithSchedules.
+   *
+   * \param[in]  phase   Current phase
+   * \param[out] outputs Output for each dimension
+   */
+  virtual void predictFunctionApproximatorsRealTime(
+      const Eigen::Ref<const Eigen::VectorXd>& phase,
+      Eigen::Ref<Eigen::RowVectorXd, 0, Eigen::InnerStride<> > outputs) const;
+
+ private:
+
   /** The attractor state of the system, to which the system will converge. */
   Eigen::VectorXd y_attr_;
 
@@ -412,8 +936,9 @@ class Dmp : public DynamicalSystem {
   DynamicalSystem* gating_system_;
 
   /** The function approximators, one for each dimension, in the forcing term.
+   * They may be shared with copies made with clone().
    */
-  std::vector<FunctionApproximator*> function_approximators_;
+  std::vector<std::shared_ptr<FunctionApproximator> > function_approximators_;
 
   /** How is the forcing term scaled? */
   std::string forcing_term_scaling_;
@@ -439,6 +964,213 @@ class Dmp : public DynamicalSystem {
   /** Pre-allocated memory to avoid allocating run-time (for real-time). */
   mutable Eigen::VectorXd g_minus_y0_prealloc_;
 
+  /** Packed parameters of the function approximators (NULL if not packed).
+   * Shared with clones, and copied when one of them changes the parameters.
+   */
+  std::shared_ptr<PackedForcingTerm> packed_forcing_term_;
+
+  /** Distance between the phase knots at which the function approximators are
+   * evaluated. 0 means they are evaluated at every step. */
+  double forcing_term_phase_interval_;
+
+  /** How to interpolate between phase knots ("LINEAR" or "CUBIC"). */
+  std::string forcing_term_interpolation_;
+
+  /** Pre-allocated memory to avoid allocating run-time (for real-time). */
+  mutable Eigen::VectorXd phase_knot_prealloc_;
+
+  /** Outputs of the function approximators at the phase knots, stored in a
+   * ring buffer (4 x dim_y()). */
+  mutable Eigen::MatrixXd fa_knots_prealloc_;
+
+  /** Index of the phase knot stored in each slot of fa_knots_prealloc_. */
+  mutable Eigen::VectorXi fa_knot_indices_prealloc_;
+
+  /** Mark all phase knots as not computed. */
+  void clearFunctionApproximatorKnots(void) const;
+
+  /**
+   * Get the slot in fa_knots_prealloc_ that contains the outputs of the
+   * function approximators for a phase knot, computing them if necessary.
+   * \param[in] i_knot Index of the knot, i.e. phase = i_knot * phase_interval
+   * \return Row in fa_knots_prealloc_
+   */
+  int functionApproximatorKnot(int i_knot) const;
+
+  /**
+   * Interpolate the outputs of the function approximators between phase knots,
+   * and write them to fa_output_prealloc_.
+   * \param[in] phase Current phase
+   */
+  void interpolateFunctionApproximatorOutput(double phase) const;
+
+  /** Times for which batch_features_ were computed. */
+  mutable Eigen::VectorXd batch_ts_;
+
+  /** Time constant for which batch_features_ were computed. */
+  mutable double batch_tau_;
+
+  /** Linear features of the function approximators of each dimension,
+   * multiplied with the gating term (T x P_d), cf. analyticalSolutionBatch().
+   */
+  mutable std::vector<Eigen::MatrixXd> batch_features_;
+
+  /** Whether all dimensions have the same features. */
+  mutable bool batch_features_shared_;
+
+  /** Protects batch_ts_, batch_tau_, batch_features_ and
+   * batch_features_shared_ in analyticalSolutionBatch(). The copy constructor
+   * gives each copy its own mutex, and does not copy the cached features.
+   */
+  std::shared_ptr<std::mutex> batch_features_mutex_;
+
+  /** Compute batch_features_, unless they are cached for ts and tau.
+   * \param[in] ts A vector of times
+   * \remarks Must be called with batch_features_mutex_ locked.
+   */
+  void updateBatchFeatures(const Eigen::VectorXd& ts) const;
+
+  /** Pre-allocated memory for analyticalSolutionTrajectory(): the states of
+   * the last call with the most time steps. */
+  mutable Eigen::MatrixXd trajectory_xs_prealloc_;
+  /** Pre-allocated memory for analyticalSolutionTrajectory(). */
+  mutable Eigen::MatrixXd trajectory_xds_prealloc_;
+
+  /** Protects trajectory_xs_prealloc_ and trajectory_xds_prealloc_. The copy
+   * constructor gives each copy its own mutex and memory. */
+  std::shared_ptr<std::mutex> trajectory_prealloc_mutex_;
+
+  /**
+   * Integrate N spring-damper systems (for instance K samples with D
+   * dimensions each) with vector operations. Helper function for
+   * analyticalSolutionBatch().
+   *
+   * \param[in]  ts  A vector of times (size T)
+   * \param[in]  goals Attractor state of each spring over time (T x N)
+   * \param[in]  y_inits Initial state of each spring (size N)
+   * \param[in]  forcing_terms Forcing term of each spring over time (T x N)
+   * \param[out] ys   Positions (T x N)
+   * \param[out] yds  Velocities (T x N)
+   * \param[out] ydds Accelerations (T x N)
+   */
+  void integrateSpringBatch(const Eigen::VectorXd& ts,
+                            const Eigen::MatrixXd& goals,
+                            const Eigen::VectorXd& y_inits,
+                            const Eigen::MatrixXd& forcing_terms,
+                            Eigen::MatrixXd& ys, Eigen::MatrixXd& yds,
+                            Eigen::MatrixXd& ydds) const;
+
+  /** Times passed to prepareSeek(). */
+  Eigen::VectorXd seek_ts_;
+
+  /** Number of time steps between two checkpoints (0 if not prepared). */
+  int seek_checkpoint_interval_;
+
+  /** States of the spring-damper system at the checkpoints. */
+  Eigen::MatrixXd seek_checkpoints_x_;
+
+  /** Rates of change of the spring-damper system at the checkpoints. */
+  Eigen::MatrixXd seek_checkpoints_xd_;
+
+  /** Index of the checkpoint whose block is stored in seek_block_xs_ and
+   * seek_block_xds_ (-1 if none). */
+  mutable int seek_block_index_;
+
+  /** Pre-allocated memory for seek(): times, states and rates of change of
+   * one block of checkpoint_interval time steps. */
+  mutable Eigen::VectorXd seek_block_ts_;
+  /** Pre-allocated memory for seek(). */
+  mutable Eigen::MatrixXd seek_block_xs_;
+  /** Pre-allocated memory for seek(). */
+  mutable Eigen::MatrixXd seek_block_xds_;
+  /** Pre-allocated memory for seek(). */
+  mutable Eigen::MatrixXd seek_block_forcing_terms_;
+  /** Pre-allocated memory for seek(). */
+  mutable Eigen::MatrixXd seek_block_fa_outputs_;
+
+  /** Pre-allocated memory for seek(): the two times, states and rates of
+   * change of a step from a grid time to a time in between. */
+  mutable Eigen::VectorXd seek_step_ts_;
+  /** Pre-allocated memory for seek(). */
+  mutable Eigen::MatrixXd seek_step_xs_;
+  /** Pre-allocated memory for seek(). */
+  mutable Eigen::MatrixXd seek_step_xds_;
+  /** Pre-allocated memory for seek(). */
+  mutable Eigen::MatrixXd seek_step_forcing_terms_;
+  /** Pre-allocated memory for seek(). */
+  mutable Eigen::MatrixXd seek_step_fa_outputs_;
+
+  /**
+   * Propagate the spring-damper system over the block of time steps that
+   * starts at a checkpoint, and store the states in seek_block_xs_ and
+   * seek_block_xds_. Helper function for seek().
+   * \param[in] i_cp Index of the checkpoint
+   */
+  void seekBlock(int i_cp) const;
+
+  /** How analyticalSolution() integrates the spring-damper system. */
+  std::string analytical_solution_integration_;
+
+  /** Thread pool for analyticalSolution() (NULL for serial execution).
+   * Shared with clones. */
+  std::shared_ptr<ThreadPool> thread_pool_;
+
+  /** Whether analyticalSolution() uses at most as many threads as there are
+   * hardware threads. */
+  bool limit_to_hardware_threads_;
+
+  /** Number of threads that analyticalSolution() may use, i.e. those of the
+   * thread pool, but at most the number of hardware threads.
+   * \return Number of threads (1 for serial execution)
+   */
+  int n_parallel_threads(void) const;
+
+  /**
+   * Compute the states of the goal, phase and gating systems in closed form,
+   * as well as the forcing terms. Helper function for analyticalSolution() and
+   * seek().
+   *
+   * \param[in]  ts  A vector of times
+   * \param[out] xs  States (T x dim()). The SPRING part is not set.
+   * \param[out] xds Rates of change (T x dim()). The SPRING part is not set.
+   * \param[out] forcing_terms The forcing terms for each dimension
+   * \param[out] fa_outputs The output of the function approximators
+   */
+  void analyticalSolutionSubSystems(const Eigen::VectorXd& ts,
+                                    StridedMatrixMap xs, StridedMatrixMap xds,
+                                    Eigen::MatrixXd& forcing_terms,
+                                    Eigen::MatrixXd& fa_outputs) const;
+
+  /**
+   * Euler integration of the spring-damper system, starting from the SPRING
+   * part of the first row of xs and xds. Helper function for
+   * analyticalSolution() and seek().
+   *
+   * \param[in]  ts  A vector of times
+   * \param[in]  forcing_terms The forcing terms (T x dim_y())
+   * \param[in,out] xs  States (T x dim()). The GOAL part must be set.
+   * \param[in,out] xds Rates of change (T x dim())
+   */
+  void integrateSpringEuler(const Eigen::VectorXd& ts,
+                            const Eigen::MatrixXd& forcing_terms,
+                            StridedMatrixMap xs, StridedMatrixMap xds) const;
+
+  /**
+   * Exact integration of the spring-damper system with a zero-order hold on
+   * the goal and forcing term, evaluated as a parallel prefix scan. Arguments
+   * as in integrateSpringEuler().
+   */
+  void integrateSpringExact(const Eigen::VectorXd& ts,
+                            const Eigen::MatrixXd& forcing_terms,
+                            StridedMatrixMap xs, StridedMatrixMap xds) const;
+
+  /** Call integrateSpringEuler() or integrateSpringExact(), depending on
+   * analytical_solution_integration_. Arguments as in integrateSpringEuler().
+   */
+  void integrateSpring(const Eigen::VectorXd& ts,
+                       const Eigen::MatrixXd& forcing_terms,
+                       StridedMatrixMap xs, StridedMatrixMap xds) const;
+
   /**
    *  Helper function for constructor.
    *
@@ -0,0 +1,548 @@
+/**
+ * @file DmpCodeGenerator.cpp
+ * @brief  DmpCodeGenerator class source file.
+ *
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "dmp/DmpCodeGenerator.hpp"
+
+#include <cstdlib>
+#include <eigen3/Eigen/Core>
+#include <iostream>
+#include <limits>
+#include <nlohmann/json.hpp>
+#include <sstream>
+#include <vector>
+
+#include "eigenutils/eigen_json.hpp"
+
+using namespace std;
+using namespace Eigen;
+
+namespace DmpBbo {
+
+/** Convert a double to a literal that represents it exactly.
+ * \param[in] value The value
+ * \return The C++ literal
+ */
+static string literal(double value)
+{
+  // Use the shortest representation that is read back as the same value
+  string str;
+  for (int precision = numeric_limits<double>::digits10;
+       precision <= numeric_limits<double>::max_digits10; precision++) {
+    ostringstream s;
+    s.precision(precision);
+    s << value;
+    str = s.str();
+    if (strtod(str.c_str(), NULL) == value) break;
+  }
+  // Make sure that the literal is a double, not an int
+  if (str.find_first_of(".e") == string::npos) str += ".0";
+  return str;
+}
+
+/** Write a constexpr scalar.
+ * \param[in] name Name of the constant
+ * \param[in] value Its value
+ * \param[out] out Stream to write to
+ */
+static void writeConstant(const string& name, double value, ostream& out)
+{
+  out << "constexpr double " << name << " = " << literal(value) << ";" << endl;
+}
+
+/** Write a constexpr array, with line breaks after 80 characters.
+ * \param[in] name Name of the array
+ * \param[in] values Its values
+ * \param[out] out Stream to write to
+ */
+static void writeArray(const string& name, const VectorXd& values,
+                       ostream& out)
+{
+  out << "constexpr double " << name << "[" << values.size() << "] = {";
+  string line = "   ";
+  for (int i = 0; i < values.size(); i++) {
+    string value = " " + literal(values[i]);
+    if (i + 1 < values.size()) value += ",";
+    if (line.size() + value.size() > 80) {
+      out << endl << line;
+      line = "   ";
+    }
+    line += value;
+  }
+  out << endl << line << endl << "};" << endl;
+}
+
+/** Write the parameters of a phase or gating system.
+ * \param[in] j json representation of the system
+ * \param[in] prefix Prefix for the names of the constants, e.g. "kPhase"
+ * \param[out] x_init Initial state of the system
+ * \param[out] out Stream to write to
+ * \return false if the type of system is not supported
+ */
+static bool writeSubSystemParameters(const nlohmann::json& j,
+                                     const string& prefix, double& x_init,
+                                     ostream& out)
+{
+  string class_name = j.at("class");
+  double tau = j.at("_tau");
+  if (class_name == "TimeSystem") {
+    int count_down = j.at("_count_down");
+    x_init = (count_down > 0 ? 1.0 : 0.0);
+    writeConstant(prefix + "Tau", tau, out);
+
+  } else if (class_name == "ExponentialSystem") {
+    VectorXd x_inits = j.at("_x_init");
+    VectorXd x_attr = j.at("_x_attr");
+    x_init = x_inits[0];
+    writeConstant(prefix + "Tau", tau, out);
+    writeConstant(prefix + "Alpha", j.at("alpha"), out);
+    writeConstant(prefix + "XAttr", x_attr[0], out);
+
+  } else if (class_name == "SigmoidSystem") {
+    VectorXd x_inits = j.at("_x_init");
+    x_init = x_inits[0];
+    double r = j.at("_max_rate");
+    double inflection_ratio = j.at("_inflection_ratio");
+    // Same computation as in SigmoidSystem::computeKs()
+    double inflection_point_time = inflection_ratio * tau;
+    double Ks = x_init * (1 + (1 / exp(-r * inflection_point_time)));
+    writeConstant(prefix + "Tau", tau, out);
+    writeConstant(prefix + "MaxRate", r, out);
+    writeConstant(prefix + "Ks", Ks, out);
+
+  } else {
+    cerr << __FILE__ << ":" << __LINE__ << ":";
+    cerr << "Unsupported dynamical system '" << class_name << "'." << endl;
+    return false;
+  }
+  return true;
+}
+
+/** Write the differential equation of a phase or gating system.
+ * \param[in] j json representation of the system
+ * \param[in] prefix Prefix for the names of the constants, e.g. "kPhase"
+ * \param[in] index Index of the system in the state vector
+ * \param[out] out Stream to write to
+ */
+static void writeSubSystemEquation(const nlohmann::json& j,
+                                   const string& prefix, int index,
+                                   ostream& out)
+{
+  string class_name = j.at("class");
+  string x = "x[" + to_string(index) + "]";
+  string xd = "xd[" + to_string(index) + "]";
+  if (class_name == "TimeSystem") {
+    int count_down = j.at("_count_down");
+    if (count_down > 0)
+      out << "  " << xd << " = " << x << " > 0 ? -1.0 / " << prefix
+          << "Tau : 0.0;" << endl;
+    else
+      out << "  " << xd << " = " << x << " < 1 ? 1.0 / " << prefix
+          << "Tau : 0.0;" << endl;
+
+  } else if (class_name == "ExponentialSystem") {
+    out << "  " << xd << " = " << prefix << "Alpha * (" << prefix << "XAttr - "
+        << x << ") / " << prefix << "Tau;" << endl;
+
+  } else if (class_name == "SigmoidSystem") {
+    out << "  " << xd << " = " << prefix << "MaxRate * " << x << " * (1 - ("
+        << x << " / " << prefix << "Ks));" << endl;
+  }
+}
+
+/** Get the parameters of a function approximator.
+ * \param[in] j json representation of the function approximator
+ * \param[out] centers Centers of the basis functions
+ * \param[out] widths Widths of the basis functions
+ * \param[out] weights Weights (RBFN) or slopes (LWR)
+ * \param[out] offsets Offsets (LWR), empty for RBFN
+ * \return false if the function approximator is not supported
+ */
+static bool getFunctionApproximatorParameters(const nlohmann::json& j,
+                                              VectorXd& centers,
+                                              VectorXd& widths,
+                                              VectorXd& weights,
+                                              VectorXd& offsets)
+{
+  string class_name = j.at("class");
+  if (class_name != "FunctionApproximatorRBFN" &&
+      class_name != "FunctionApproximatorLWR") {
+    cerr << __FILE__ << ":" << __LINE__ << ":";
+    cerr << "Unsupported function approximator '" << class_name << "'."
+         << endl;
+    return false;
+  }
+
+  const nlohmann::json& jm = j.at("_model_params");
+  MatrixXd centers_matrix = jm.at("centers");
+  MatrixXd widths_matrix = jm.at("widths");
+  if (centers_matrix.cols() != 1) {
+    cerr << __FILE__ << ":" << __LINE__ << ":";
+    cerr << "Only function approximators with a 1D input are supported."
+         << endl;
+    return false;
+  }
+  centers = centers_matrix.col(0);
+  widths = widths_matrix.col(0);
+
+  MatrixXd matrix;
+  if (class_name == "FunctionApproximatorRBFN") {
+    matrix = jm.at("weights");
+    weights = matrix.col(0);
+    offsets.resize(0);
+  } else {
+    matrix = jm.at("slopes");
+    weights = matrix.col(0);
+    matrix = jm.at("offsets");
+    offsets = matrix.col(0);
+  }
+  return true;
+}
+
+/** Write the computation of the output of a function approximator.
+ * \param[in] i_dim Dimension of the Dmp
+ * \param[in] n_basis_functions Number of basis functions
+ * \param[in] lwr Whether the function approximator is an LWR (or an RBFN)
+ * \param[out] out Stream to write to
+ */
+static void writeFunctionApproximatorOutput(int i_dim, int n_basis_functions,
+                                            bool lwr, ostream& out)
+{
+  string d = to_string(i_dim);
+  string fa = "fa_" + d;
+  if (!lwr) {
+    // Same order as FunctionApproximatorRBFN::predictRealTime()
+    out << "  double " << fa << " = 0.0;" << endl;
+    for (int bb = 0; bb < n_basis_functions; bb++) {
+      string b = "[" + to_string(bb) + "]";
+      out << "  " << fa << " += gaussian(phase, kCenters" << d << b
+          << ", kWidths" << d << b << ") * kWeights" << d << b << ";" << endl;
+    }
+    return;
+  }
+
+  // Same order as FunctionApproximatorLWR::predictRealTime(), with normalized
+  // activations
+  string a = "a_" + d;
+  out << "  double " << a << "[" << n_basis_functions << "];" << endl;
+  if (n_basis_functions == 1) {
+    out << "  " << a << "[0] = 1.0;" << endl;
+  } else {
+    for (int bb = 0; bb < n_basis_functions; bb++) {
+      string b = "[" + to_string(bb) + "]";
+      out << "  " << a << b << " = gaussian(phase, kCenters" << d << b
+          << ", kWidths" << d << b << ");" << endl;
+    }
+    string sum = "sum_" + d;
+    out << "  double " << sum << " = 0.0;" << endl;
+    for (int bb = 0; bb < n_basis_functions; bb++)
+      out << "  " << sum << " += " << a << "[" << bb << "];" << endl;
+    out << "  if (" << sum << " == 0.0) {" << endl;
+    for (int bb = 0; bb < n_basis_functions; bb++)
+      out << "    " << a << "[" << bb << "] = 1.0 / " << n_basis_functions
+          << ";" << endl;
+    out << "  } else {" << endl;
+    for (int bb = 0; bb < n_basis_functions; bb++)
+      out << "    " << a << "[" << bb << "] /= " << sum << ";" << endl;
+    out << "  }" << endl;
+  }
+  out << "  double " << fa << " = 0.0;" << endl;
+  for (int bb = 0; bb < n_basis_functions; bb++) {
+    string b = "[" + to_string(bb) + "]";
+    out << "  " << fa << " += (phase * kSlopes" << d << b << " + kOffsets" << d
+        << b << ") * " << a << b << ";" << endl;
+  }
+}
+
+/** Write the assignments of an integration step.
+ * \param[in] dim_x Dimensionality of the state
+ * \param[in] target Left-hand side, e.g. "x_updated"
+ * \param[in] expression Right-hand side, in which "#" is the index
+ * \param[out] out Stream to write to
+ */
+static void writeUnrolled(int dim_x, const string& target,
+                          const string& expression, ostream& out)
+{
+  for (int i = 0; i < dim_x; i++) {
+    string rhs = expression;
+    string index = to_string(i);
+    for (size_t pos = rhs.find('#'); pos != string::npos; pos = rhs.find('#'))
+      rhs.replace(pos, 1, index);
+    out << "  " << target << "[" << i << "] = " << rhs << ";" << endl;
+  }
+}
+
+bool DmpCodeGenerator::generate(const nlohmann::json& j, const string& name,
+                                const string& integration, double dt,
+                                ostream& out)
+{
+  if (integration != "EULER" && integration != "RUNGE_KUTTA") {
+    cerr << __FILE__ << ":" << __LINE__ << ":";
+    cerr << "Unknown integration '" << integration << "'." << endl;
+    return false;
+  }
+  if (dt <= 0.0) {
+    cerr << __FILE__ << ":" << __LINE__ << ":";
+    cerr << "dt must be larger than 0." << endl;
+    return false;
+  }
+
+  double tau = j.at("_tau");
+  VectorXd y_init = j.at("_y_init");
+  VectorXd y_attr = j.at("_y_attr");
+  int dim_y = y_attr.size();
+  int dim_x = 3 * dim_y + 2;
+  int i_goal = 2 * dim_y;
+  int i_phase = 3 * dim_y;
+  int i_gating = 3 * dim_y + 1;
+
+  string scaling = j.at("_forcing_term_scaling");
+  if (scaling != "NO_SCALING" && scaling != "G_MINUS_Y0_SCALING" &&
+      scaling != "AMPLITUDE_SCALING") {
+    cerr << __FILE__ << ":" << __LINE__ << ":";
+    cerr << "Unknown forcing term scaling '" << scaling << "'." << endl;
+    return false;
+  }
+
+  const nlohmann::json& j_goal = j.at("_goal_system");
+  bool has_goal_system = !j_goal.is_null();
+  if (has_goal_system && j_goal.at("class") != "ExponentialSystem") {
+    cerr << __FILE__ << ":" << __LINE__ << ":";
+    cerr << "The goal system must be an ExponentialSystem." << endl;
+    return false;
+  }
+
+  const nlohmann::json& j_fas = j.at("_function_approximators");
+  if (!j_fas.is_array() || (int)j_fas.size() != dim_y) {
+    cerr << __FILE__ << ":" << __LINE__ << ":";
+    cerr << "The Dmp must have one function approximator per dimension."
+         << endl;
+    return false;
+  }
+
+  // Write the parameters into a separate stream first, as they determine
+  // whether the Dmp is supported.
+  ostringstream params;
+  params << "/** Dimensionality of the Dmp. */" << endl;
+  params << "constexpr int kDimY = " << dim_y << ";" << endl;
+  params << "/** Dimensionality of the state [y z goal phase gating]. */"
+         << endl;
+  params << "constexpr int kDimX = " << dim_x << ";" << endl;
+  params << "/** Time step of integrateStep(). */" << endl;
+  writeConstant("kDt", dt, params);
+  params << endl;
+
+  params << "// Dmp and spring-damper system" << endl;
+  writeConstant("kTau", tau, params);
+  writeArray("kYAttr", y_attr, params);
+  if (scaling == "G_MINUS_Y0_SCALING") writeArray("kYInit", y_init, params);
+  if (scaling == "AMPLITUDE_SCALING") {
+    VectorXd scaling_amplitudes = j.at("_scaling_amplitudes");
+    writeArray("kScalingAmplitudes", scaling_amplitudes, params);
+  }
+  // Same computation as in SpringDamperSystem for a critically damped system
+  double damping_coefficient = j.at("_spring_system").at("damping_coefficient");
+  double spring_constant = damping_coefficient * damping_coefficient / 4;
+  writeConstant("kDampingCoefficient", damping_coefficient, params);
+  writeConstant("kSpringConstant", spring_constant, params);
+  writeConstant("kMass", 1.0, params);
+
+  if (has_goal_system) {
+    params << endl << "// Goal system (ExponentialSystem)" << endl;
+    writeConstant("kGoalTau", j_goal.at("_tau"), params);
+    writeConstant("kGoalAlpha", j_goal.at("alpha"), params);
+  }
+
+  const nlohmann::json& j_phase = j.at("_phase_system");
+  const nlohmann::json& j_gating = j.at("_gating_system");
+  double phase_init, gating_init;
+  params << endl << "// Phase system (" << j_phase.at("class").get<string>()
+         << ")" << endl;
+  if (!writeSubSystemParameters(j_phase, "kPhase", phase_init, params))
+    return false;
+  params << endl << "// Gating system (" << j_gating.at("class").get<string>()
+         << ")" << endl;
+  if (!writeSubSystemParameters(j_gating, "kGating", gating_init, params))
+    return false;
+
+  vector<int> n_basis_functions(dim_y);
+  vector<bool> lwr(dim_y);
+  for (int i_dim = 0; i_dim < dim_y; i_dim++) {
+    VectorXd centers, widths, weights, offsets;
+    if (!getFunctionApproximatorParameters(j_fas[i_dim], centers, widths,
+                                           weights, offsets))
+      return false;
+    string d = to_string(i_dim);
+    n_basis_functions[i_dim] = centers.size();
+    lwr[i_dim] = offsets.size() > 0;
+    params << endl << "// Function approximator for dimension " << d << " ("
+           << (lwr[i_dim] ? "LWR" : "RBFN") << ")" << endl;
+    writeArray("kCenters" + d, centers, params);
+    writeArray("kWidths" + d, widths, params);
+    if (lwr[i_dim]) {
+      writeArray("kSlopes" + d, weights, params);
+      writeArray("kOffsets" + d, offsets, params);
+    } else {
+      writeArray("kWeights" + d, weights, params);
+    }
+  }
+
+  // Initial state, as in Dmp::integrateStart()
+  VectorXd x_init = VectorXd::Zero(dim_x);
+  x_init.head(dim_y) = y_init;
+  x_init.segment(i_goal, dim_y) = (has_goal_system ? y_init : y_attr);
+  x_init[i_phase] = phase_init;
+  x_init[i_gating] = gating_init;
+  params << endl << "/** Initial state. */" << endl;
+  writeArray("kXInit", x_init, params);
+
+  string guard = "_DMP_" + name + "_H_";
+  for (size_t i = 0; i < guard.size(); i++) guard[i] = toupper(guard[i]);
+
+  out << "// Generated by DmpBbo (DmpCodeGenerator), for " << integration
+      << " integration" << endl;
+  out << "// with dt=" << literal(dt) << "." << endl;
+  out << "// Do not edit; regenerate it from the json file of the Dmp instead."
+      << endl;
+  out << endl;
+  out << "#ifndef " << guard << endl;
+  out << "#define " << guard << endl;
+  out << endl;
+  out << "#include <cmath>" << endl;
+  out << endl;
+  out << "namespace " << name << " {" << endl;
+  out << endl;
+  out << params.str();
+  out << endl;
+
+  out << "/** Unnormalized Gaussian basis function. */" << endl;
+  out << "inline double gaussian(double x, double c, double w)" << endl;
+  out << "{" << endl;
+  out << "  return std::exp(-0.5 * ((x - c) * (x - c)) / (w * w));" << endl;
+  out << "}" << endl;
+  out << endl;
+
+  // Same order of operations as in Dmp::differentialEquation()
+  out << "/** Rates of change of the state, cf. Dmp::differentialEquation()."
+      << endl;
+  out << " * \\param[in]  x  State (size kDimX)" << endl;
+  out << " * \\param[out] xd Rates of change (size kDimX)" << endl;
+  out << " */" << endl;
+  out << "inline void differentialEquation(const double* x, double* xd)"
+      << endl;
+  out << "{" << endl;
+  out << "  // Goal system" << endl;
+  for (int i_dim = 0; i_dim < dim_y; i_dim++) {
+    int i = i_goal + i_dim;
+    if (has_goal_system)
+      out << "  xd[" << i << "] = kGoalAlpha * (kYAttr[" << i_dim << "] - x["
+          << i << "]) / kGoalTau;" << endl;
+    else
+      out << "  xd[" << i << "] = 0.0;" << endl;
+  }
+  out << "  // Spring-damper system" << endl;
+  for (int i_dim = 0; i_dim < dim_y; i_dim++)
+    out << "  xd[" << i_dim << "] = x[" << dim_y + i_dim << "] / kTau;"
+        << endl;
+  for (int i_dim = 0; i_dim < dim_y; i_dim++) {
+    string goal = (has_goal_system ? "x[" + to_string(i_goal + i_dim) + "]"
+                                   : "kYAttr[" + to_string(i_dim) + "]");
+    out << "  xd[" << dim_y + i_dim << "] = (-kSpringConstant * (x[" << i_dim
+        << "] - " << goal << ") - kDampingCoefficient * x[" << dim_y + i_dim
+        << "]) /" << endl;
+    out << "          (kMass * kTau);" << endl;
+  }
+  out << "  // Phase and gating systems" << endl;
+  writeSubSystemEquation(j_phase, "kPhase", i_phase, out);
+  writeSubSystemEquation(j_gating, "kGating", i_gating, out);
+  out << "  // Function approximators" << endl;
+  out << "  double phase = x[" << i_phase << "];" << endl;
+  for (int i_dim = 0; i_dim < dim_y; i_dim++)
+    writeFunctionApproximatorOutput(i_dim, n_basis_functions[i_dim],
+                                    lwr[i_dim], out);
+  out << "  // Gated and scaled forcing term" << endl;
+  for (int i_dim = 0; i_dim < dim_y; i_dim++) {
+    string d = to_string(i_dim);
+    string z = "xd[" + to_string(dim_y + i_dim) + "]";
+    out << "  " << z << " = " << z << " + x[" << i_gating << "] * fa_" << d;
+    if (scaling == "G_MINUS_Y0_SCALING")
+      out << " * (kYAttr[" << d << "] - kYInit[" << d << "])";
+    else if (scaling == "AMPLITUDE_SCALING")
+      out << " * kScalingAmplitudes[" << d << "]";
+    out << " / kTau;" << endl;
+  }
+  out << "}" << endl;
+  out << endl;
+
+  out << "/** Start integrating the Dmp, cf. Dmp::integrateStart()." << endl;
+  out << " * \\param[out] x  Initial state (size kDimX)" << endl;
+  out << " * \\param[out] xd Initial rates of change (size kDimX)" << endl;
+  out << " */" << endl;
+  out << "inline void integrateStart(double* x, double* xd)" << endl;
+  out << "{" << endl;
+  writeUnrolled(dim_x, "x", "kXInit[#]", out);
+  out << "  differentialEquation(x, xd);" << endl;
+  out << "}" << endl;
+  out << endl;
+
+  out << "/** Integrate the Dmp for one time step of kDt, with " << integration
+      << " integration." << endl;
+  out << " * \\param[in]  x          Current state (may be the same as "
+         "x_updated)"
+      << endl;
+  out << " * \\param[out] x_updated  State kDt later" << endl;
+  out << " * \\param[out] xd_updated Rates of change kDt later" << endl;
+  out << " */" << endl;
+  out << "inline void integrateStep(const double* x, double* x_updated,"
+      << endl;
+  out << "                          double* xd_updated)" << endl;
+  out << "{" << endl;
+  if (integration == "EULER") {
+    // Same as DynamicalSystem::integrateStepEuler()
+    out << "  differentialEquation(x, xd_updated);" << endl;
+    writeUnrolled(dim_x, "x_updated", "x[#] + kDt * xd_updated[#]", out);
+  } else {
+    // Same as DynamicalSystem::integrateStepRungeKutta()
+    out << "  double k1[kDimX], k2[kDimX], k3[kDimX], k4[kDimX], "
+           "input[kDimX];"
+        << endl;
+    out << "  differentialEquation(x, k1);" << endl;
+    writeUnrolled(dim_x, "input", "x[#] + kDt * 0.5 * k1[#]", out);
+    out << "  differentialEquation(input, k2);" << endl;
+    writeUnrolled(dim_x, "input", "x[#] + kDt * 0.5 * k2[#]", out);
+    out << "  differentialEquation(input, k3);" << endl;
+    writeUnrolled(dim_x, "input", "x[#] + kDt * k3[#]", out);
+    out << "  differentialEquation(input, k4);" << endl;
+    writeUnrolled(dim_x, "x_updated",
+                  "x[#] + kDt * (k1[#] + 2.0 * (k2[#] + k3[#]) + k4[#]) / 6.0",
+                  out);
+    out << "  differentialEquation(x_updated, xd_updated);" << endl;
+  }
+  out << "}" << endl;
+  out << endl;
+  out << "}  // namespace " << name << endl;
+  out << endl;
+  out << "#endif  // " << guard << endl;
+
+  return true;
+}
+
+}  // namespace DmpBbo
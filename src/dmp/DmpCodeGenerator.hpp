@@ -0,0 +1,83 @@
+/**
+ * @file DmpCodeGenerator.hpp
+ * @brief  DmpCodeGenerator class header file.
+ *
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef _DMP_CODE_GENERATOR_H_
+#define _DMP_CODE_GENERATOR_H_
+
+#include <nlohmann/json_fwd.hpp>
+#include <ostream>
+#include <string>
+
+namespace DmpBbo {
+
+/** \brief Export a trained Dmp as standalone C++ code.
+ *
+ * The generated header contains all the parameters of the Dmp as constexpr
+ * arrays, and the functions integrateStart() and integrateStep() for one
+ * integration method and a fixed time step. These functions are specialized
+ * for the subsystems and function approximators of the Dmp, and all loops over
+ * dimensions and basis functions are unrolled. The generated code uses no heap
+ * memory and no virtual functions, and only depends on <cmath>. This makes it
+ * suitable for low-level controllers on which Eigen, nlohmann/json and Boost
+ * are not available.
+ *
+ * The operations are performed in the same order as in Dmp, so the states are
+ * the same as those of Dmp::integrateStepEuler() or
+ * Dmp::integrateStepRungeKutta(), up to differences in rounding made by the
+ * compiler.
+ *
+ * Supported are Dmps with RBFN or LWR function approximators (with a 1D input),
+ * an ExponentialSystem goal system (or none), and phase and gating systems
+ * of type ExponentialSystem, SigmoidSystem or TimeSystem.
+ *
+ * Usage of the generated code, e.g. for a namespace "my_dmp":
+ * \code
+ * double x[my_dmp::kDimX], xd[my_dmp::kDimX];
+ * my_dmp::integrateStart(x, xd);
+ * for (int t = 1; t < n_time_steps; t++) {
+ *   my_dmp::integrateStep(x, x, xd);  // Advances by my_dmp::kDt
+ *   // y is in x[0] ... x[my_dmp::kDimY-1]
+ * }
+ * \endcode
+ */
+class DmpCodeGenerator {
+ public:
+  /** Generate a header with a standalone implementation of a Dmp.
+   * \param[in] j The json representation of the Dmp, as in the files
+   * "*_for_cpp.json" that are saved with dmpbbo.json_for_cpp
+   * \param[in] name Name of the namespace of the generated code. It must be a
+   * valid C++ identifier.
+   * \param[in] integration Integration method of integrateStep(): "EULER" or
+   * "RUNGE_KUTTA"
+   * \param[in] dt Time step of integrateStep()
+   * \param[out] out Stream to write the code to
+   * \return true if the code was generated, false if the Dmp is not supported
+   */
+  static bool generate(const nlohmann::json& j, const std::string& name,
+                       const std::string& integration, double dt,
+                       std::ostream& out);
+};
+
+}  // namespace DmpBbo
+
+#endif  // _DMP_CODE_GENERATOR_H_
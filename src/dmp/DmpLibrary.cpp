@@ -0,0 +1,359 @@
+/**
+ * @file DmpLibrary.cpp
+ * @brief  DmpLibrary class source file.
+ *
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "dmp/DmpLibrary.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <nlohmann/json.hpp>
+
+#include "dmp/Dmp.hpp"
+#include "eigenutils/eigen_json.hpp"
+
+using namespace std;
+using namespace Eigen;
+
+namespace DmpBbo {
+
+/** The header at the start of a library file. */
+struct DmpLibraryHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t n_dmps;
+  uint64_t index_offset;
+};
+
+static const char kMagic[8] = {'D', 'M', 'P', 'B', 'B', 'O', 'L', 'B'};
+static const uint32_t kVersion = 1;
+
+static uint64_t roundUpTo8(uint64_t n_bytes) { return 8 * ((n_bytes + 7) / 8); }
+
+bool DmpLibrary::write(const string& filename, const vector<string>& names,
+                       const vector<nlohmann::json>& dmps)
+{
+  string image;
+  if (!serialize(names, dmps, image)) return false;
+
+  ofstream file(filename, ios::out | ios::binary | ios::trunc);
+  if (file.fail()) {
+    cerr << __FILE__ << ":" << __LINE__ << ":";
+    cerr << "Could not open file '" << filename << "' for writing." << endl;
+    return false;
+  }
+  file.write(image.data(), image.size());
+  return !file.fail();
+}
+
+bool DmpLibrary::serialize(const vector<string>& names,
+                           const vector<nlohmann::json>& dmps, string& image)
+{
+  int n_dmps = dmps.size();
+  if ((int)names.size() != n_dmps) {
+    cerr << __FILE__ << ":" << __LINE__ << ":";
+    cerr << "Number of names and Dmps must be the same." << endl;
+    return false;
+  }
+
+  // Sort the entries by name, so that find() can do a binary search.
+  vector<int> order(n_dmps);
+  for (int i_dmp = 0; i_dmp < n_dmps; i_dmp++) order[i_dmp] = i_dmp;
+  sort(order.begin(), order.end(),
+       [&names](int a, int b) { return names[a] < names[b]; });
+  for (int i_dmp = 0; i_dmp < n_dmps; i_dmp++) {
+    const string& name = names[order[i_dmp]];
+    bool duplicate = i_dmp > 0 && name == names[order[i_dmp - 1]];
+    if (name.empty() || name.size() >= sizeof(IndexEntry().name) ||
+        duplicate) {
+      cerr << __FILE__ << ":" << __LINE__ << ":";
+      cerr << "Invalid or duplicate name '" << name << "'." << endl;
+      return false;
+    }
+  }
+
+  // Serialize the Dmps, and compute the layout of the file.
+  vector<string> jsons(n_dmps);
+  vector<vector<double> > descriptors(n_dmps);
+  vector<IndexEntry> index(n_dmps);
+  uint64_t index_offset = sizeof(DmpLibraryHeader);
+  uint64_t offset = index_offset + n_dmps * sizeof(IndexEntry);
+  for (int i_dmp = 0; i_dmp < n_dmps; i_dmp++) {
+    const nlohmann::json& j = dmps[order[i_dmp]];
+    VectorXd y_init, y_attr;
+    double tau;
+    try {
+      y_init = j.at("_y_init").get<VectorXd>();
+      y_attr = j.at("_y_attr").get<VectorXd>();
+      tau = j.at("_tau");
+    } catch (const nlohmann::json::exception& exception) {
+      cerr << __FILE__ << ":" << __LINE__ << ":";
+      cerr << "Dmp '" << names[order[i_dmp]]
+           << "' is not a valid Dmp: " << exception.what() << endl;
+      return false;
+    }
+    jsons[i_dmp] = j.dump();
+
+    vector<double>& descriptor = descriptors[i_dmp];
+    descriptor.push_back(tau);
+    descriptor.insert(descriptor.end(), y_init.data(),
+                      y_init.data() + y_init.size());
+    descriptor.insert(descriptor.end(), y_attr.data(),
+                      y_attr.data() + y_attr.size());
+
+    IndexEntry& entry = index[i_dmp];
+    memset(&entry, 0, sizeof(IndexEntry));
+    strncpy(entry.name, names[order[i_dmp]].c_str(), sizeof(entry.name) - 1);
+    entry.dim_y = y_attr.size();
+    entry.n_basis_functions = 0;
+    auto jfas = j.find("_function_approximators");
+    if (jfas != j.end() && jfas->is_array() && !jfas->empty() &&
+        (*jfas)[0].contains("_model_params"))
+      entry.n_basis_functions =
+          (*jfas)[0].at("_model_params").value("centers", nlohmann::json())
+              .size();
+    entry.descriptors_offset = offset;
+    offset += descriptor.size() * sizeof(double);
+  }
+  for (int i_dmp = 0; i_dmp < n_dmps; i_dmp++) {
+    index[i_dmp].json_offset = offset;
+    index[i_dmp].json_size = jsons[i_dmp].size();
+    offset = roundUpTo8(offset + jsons[i_dmp].size());
+  }
+
+  DmpLibraryHeader header;
+  memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.n_dmps = n_dmps;
+  header.index_offset = index_offset;
+
+  image.clear();
+  image.reserve(offset);
+  image.append((const char*)&header, sizeof(header));
+  if (n_dmps > 0)
+    image.append((const char*)index.data(), n_dmps * sizeof(IndexEntry));
+  for (int i_dmp = 0; i_dmp < n_dmps; i_dmp++)
+    image.append((const char*)descriptors[i_dmp].data(),
+                 descriptors[i_dmp].size() * sizeof(double));
+  for (int i_dmp = 0; i_dmp < n_dmps; i_dmp++) {
+    image.append(jsons[i_dmp]);
+    uint64_t size = jsons[i_dmp].size();
+    image.append(roundUpTo8(size) - size, '\0');
+  }
+
+  return true;
+}
+
+DmpLibrary* DmpLibrary::open(const string& filename, int max_cached_dmps)
+{
+  int fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd < 0) {
+    cerr << __FILE__ << ":" << __LINE__ << ":";
+    cerr << "Could not open file '" << filename << "'." << endl;
+    return NULL;
+  }
+  DmpLibrary* library = open(fd, filename, max_cached_dmps);
+  ::close(fd);  // The mapping remains valid after closing the file.
+  return library;
+}
+
+DmpLibrary* DmpLibrary::open(int fd, const string& filename,
+                             int max_cached_dmps)
+{
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0 ||
+      file_stat.st_size < (off_t)sizeof(DmpLibraryHeader)) {
+    cerr << __FILE__ << ":" << __LINE__ << ":";
+    cerr << "File '" << filename << "' is not a Dmp library." << endl;
+    return NULL;
+  }
+  size_t n_bytes = file_stat.st_size;
+
+  void* data = mmap(NULL, n_bytes, PROT_READ, MAP_SHARED, fd, 0);
+  if (data == MAP_FAILED) {
+    cerr << __FILE__ << ":" << __LINE__ << ":";
+    cerr << "Could not map file '" << filename << "'." << endl;
+    return NULL;
+  }
+
+  const DmpLibraryHeader* header = (const DmpLibraryHeader*)data;
+  bool valid = memcmp(header->magic, kMagic, sizeof(kMagic)) == 0 &&
+               header->version == kVersion &&
+               header->index_offset % 8 == 0 &&
+               header->index_offset <= n_bytes &&
+               header->n_dmps <=
+                   (n_bytes - header->index_offset) / sizeof(IndexEntry);
+  // The descriptors are mapped directly by tau(), y_init() and y_attr(), so
+  // they must lie inside the file for every entry.
+  const IndexEntry* index =
+      (const IndexEntry*)((const char*)data + header->index_offset);
+  for (uint32_t i_dmp = 0; valid && i_dmp < header->n_dmps; i_dmp++) {
+    const IndexEntry& e = index[i_dmp];
+    valid = e.descriptors_offset % 8 == 0 && e.descriptors_offset <= n_bytes &&
+            e.dim_y <= n_bytes / 16 &&
+            (1 + 2 * (uint64_t)e.dim_y) * sizeof(double) <=
+                n_bytes - e.descriptors_offset;
+  }
+  if (!valid) {
+    munmap(data, n_bytes);
+    cerr << __FILE__ << ":" << __LINE__ << ":";
+    cerr << "File '" << filename << "' is not a (valid) Dmp library." << endl;
+    return NULL;
+  }
+
+  return new DmpLibrary((const char*)data, n_bytes, max_cached_dmps);
+}
+
+DmpLibrary::DmpLibrary(const char* data, size_t n_bytes, int max_cached_dmps)
+    : data_(data), n_bytes_(n_bytes), max_cached_dmps_(max_cached_dmps)
+{
+  const DmpLibraryHeader* header = (const DmpLibraryHeader*)data_;
+  n_dmps_ = header->n_dmps;
+  index_ = (const IndexEntry*)(data_ + header->index_offset);
+}
+
+DmpLibrary::~DmpLibrary(void)
+{
+  // The cached Dmps do not refer to the mapped file, so they remain valid.
+  munmap((void*)data_, n_bytes_);
+}
+
+const DmpLibrary::IndexEntry& DmpLibrary::entry(int i_dmp) const
+{
+  assert(i_dmp >= 0 && i_dmp < n_dmps_);
+  return index_[i_dmp];
+}
+
+int DmpLibrary::find(const string& name) const
+{
+  int low = 0;
+  int high = n_dmps_;
+  while (low < high) {
+    int mid = low + (high - low) / 2;
+    int cmp = strncmp(index_[mid].name, name.c_str(), sizeof(index_[mid].name));
+    if (cmp == 0) return mid;
+    if (cmp < 0)
+      low = mid + 1;
+    else
+      high = mid;
+  }
+  return -1;
+}
+
+string DmpLibrary::name(int i_dmp) const
+{
+  const IndexEntry& e = entry(i_dmp);
+  return string(e.name, strnlen(e.name, sizeof(e.name)));
+}
+
+int DmpLibrary::dim_y(int i_dmp) const { return entry(i_dmp).dim_y; }
+
+int DmpLibrary::n_basis_functions(int i_dmp) const
+{
+  return entry(i_dmp).n_basis_functions;
+}
+
+double DmpLibrary::tau(int i_dmp) const
+{
+  return *(const double*)(data_ + entry(i_dmp).descriptors_offset);
+}
+
+Map<const VectorXd> DmpLibrary::y_init(int i_dmp) const
+{
+  const IndexEntry& e = entry(i_dmp);
+  const double* descriptors = (const double*)(data_ + e.descriptors_offset);
+  return Map<const VectorXd>(descriptors + 1, e.dim_y);
+}
+
+Map<const VectorXd> DmpLibrary::y_attr(int i_dmp) const
+{
+  const IndexEntry& e = entry(i_dmp);
+  const double* descriptors = (const double*)(data_ + e.descriptors_offset);
+  return Map<const VectorXd>(descriptors + 1 + e.dim_y, e.dim_y);
+}
+
+shared_ptr<Dmp> DmpLibrary::get(int i_dmp)
+{
+  if (i_dmp < 0 || i_dmp >= n_dmps_) return shared_ptr<Dmp>();
+
+  lock_guard<mutex> lock(cache_mutex_);
+
+  // Each caller gets its own clone of the cached Dmp, because integrating a
+  // Dmp changes its state.
+  auto position = cache_positions_.find(i_dmp);
+  if (position != cache_positions_.end()) {
+    // Move to the front, i.e. make it the most recently requested one.
+    cache_.splice(cache_.begin(), cache_, position->second);
+    return shared_ptr<Dmp>(cache_.front().second->clone());
+  }
+
+  const IndexEntry& e = entry(i_dmp);
+  if (e.json_offset > n_bytes_ || e.json_size > n_bytes_ - e.json_offset) {
+    cerr << __FILE__ << ":" << __LINE__ << ":";
+    cerr << "Entry '" << name(i_dmp) << "' lies outside the file." << endl;
+    return shared_ptr<Dmp>();
+  }
+
+  shared_ptr<Dmp> dmp;
+  try {
+    const char* begin = data_ + e.json_offset;
+    nlohmann::json j = nlohmann::json::parse(begin, begin + e.json_size);
+    dmp = shared_ptr<Dmp>(j.get<Dmp*>());
+  } catch (const nlohmann::json::exception& exception) {
+    cerr << __FILE__ << ":" << __LINE__ << ":";
+    cerr << "Could not load Dmp '" << name(i_dmp) << "': " << exception.what()
+         << endl;
+    return shared_ptr<Dmp>();
+  }
+
+  if (max_cached_dmps_ > 0) {
+    if ((int)cache_.size() >= max_cached_dmps_) {
+      // Evict the least recently requested Dmp.
+      cache_positions_.erase(cache_.back().first);
+      cache_.pop_back();
+    }
+    cache_.push_front(CacheItem(i_dmp, dmp));
+    cache_positions_[i_dmp] = cache_.begin();
+    return shared_ptr<Dmp>(dmp->clone());
+  }
+
+  return dmp;
+}
+
+shared_ptr<Dmp> DmpLibrary::get(const string& name)
+{
+  return get(find(name));
+}
+
+int DmpLibrary::n_cached_dmps(void) const
+{
+  lock_guard<mutex> lock(cache_mutex_);
+  return cache_.size();
+}
+
+}  // namespace DmpBbo
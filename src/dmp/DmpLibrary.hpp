@@ -0,0 +1,246 @@
+/**
+ * @file DmpLibrary.hpp
+ * @brief  DmpLibrary class header file.
+ *
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef _DMP_LIBRARY_H_
+#define _DMP_LIBRARY_H_
+
+#include <cstdint>
+#include <eigen3/Eigen/Core>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <nlohmann/json_fwd.hpp>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace DmpBbo {
+
+// forward declaration
+class Dmp;
+
+/** \brief A library of many Dmps stored in one file, which is memory-mapped
+ * and from which Dmps are loaded only when they are needed.
+ *
+ * The file starts with an index, which contains for each Dmp its name, its
+ * dimensionality, its number of basis functions, its descriptors (tau, y_init
+ * and y_attr) and the location of its json representation in the file. The
+ * entries in the index are sorted by name.
+ *
+ * Opening a library only maps the file into memory, and checks the header and
+ * the index; no Dmp is parsed. A Dmp is parsed from its json the first time
+ * it is requested with get(), and kept in a cache of limited size. If the
+ * cache is full, the Dmp that was least recently requested is evicted from it.
+ * Thus, the memory a library requires does not depend on the number of Dmps in
+ * the library.
+ *
+ * The file is stored in the byte order of the machine that wrote it.
+ */
+class DmpLibrary {
+ public:
+  /** Write Dmps to a library file.
+   * \param[in] filename Name of the file to write
+   * \param[in] names    A unique name for each Dmp (at most 63 characters)
+   * \param[in] dmps     The json representation of each Dmp, i.e. the
+   * contents of the "_for_cpp.json" files exported from Python.
+   * \return true if the file was written, false otherwise
+   */
+  static bool write(const std::string& filename,
+                    const std::vector<std::string>& names,
+                    const std::vector<nlohmann::json>& dmps);
+
+  /** Serialize Dmps to the contents of a library file.
+   * \param[in]  names A unique name for each Dmp (at most 63 characters)
+   * \param[in]  dmps  The json representation of each Dmp
+   * \param[out] image The contents of the library file
+   * \return true if the Dmps could be serialized, false otherwise
+   *
+   * The image contains no pointers, only offsets, so it may be mapped at any
+   * address, e.g. in shared memory (see DmpSharedRegistry).
+   */
+  static bool serialize(const std::vector<std::string>& names,
+                        const std::vector<nlohmann::json>& dmps,
+                        std::string& image);
+
+  /** Open a library file.
+   * \param[in] filename Name of the file to open
+   * \param[in] max_cached_dmps Maximum number of Dmps kept in the cache
+   * \return The library, or NULL if the file could not be opened, or is not a
+   * library file. The caller is responsible for deleting it.
+   */
+  static DmpLibrary* open(const std::string& filename,
+                          int max_cached_dmps = 16);
+
+  /** Open a library from a file descriptor, e.g. of a POSIX shared memory
+   * object. The descriptor may be closed after this call.
+   * \param[in] fd File descriptor, opened for reading
+   * \param[in] description Name of the file, for error messages
+   * \param[in] max_cached_dmps Maximum number of Dmps kept in the cache
+   * \return The library, or NULL if the file is not a library file, or if the
+   * descriptors of one of its entries lie outside the file. The caller is
+   * responsible for deleting it.
+   */
+  static DmpLibrary* open(int fd, const std::string& description,
+                          int max_cached_dmps = 16);
+
+  /** Destructor. Unmaps the file.
+   * Dmps returned by get() remain valid after the library has been deleted.
+   */
+  ~DmpLibrary(void);
+
+  /** Get the number of Dmps in the library.
+   * \return Number of Dmps
+   */
+  inline int n_dmps(void) const { return n_dmps_; }
+
+  /** Get the index of a Dmp in the library.
+   * \param[in] name Name of the Dmp
+   * \return Index of the Dmp, or -1 if there is no Dmp with this name.
+   */
+  int find(const std::string& name) const;
+
+  /** Get the name of a Dmp.
+   * \param[in] i_dmp Index of the Dmp
+   * \return Name of the Dmp
+   */
+  std::string name(int i_dmp) const;
+
+  /** Get the dimensionality of a Dmp.
+   * \param[in] i_dmp Index of the Dmp
+   * \return Dimensionality of the Dmp, i.e. Dmp::dim_y()
+   */
+  int dim_y(int i_dmp) const;
+
+  /** Get the number of basis functions of a Dmp.
+   * \param[in] i_dmp Index of the Dmp
+   * \return Number of basis functions of the first function approximator
+   */
+  int n_basis_functions(int i_dmp) const;
+
+  /** Get the time constant of a Dmp.
+   * \param[in] i_dmp Index of the Dmp
+   * \return Time constant
+   */
+  double tau(int i_dmp) const;
+
+  /** Get the initial state of a Dmp, without loading the Dmp.
+   * \param[in] i_dmp Index of the Dmp
+   * \return Initial state (size dim_y()), which maps the memory of the file.
+   */
+  Eigen::Map<const Eigen::VectorXd> y_init(int i_dmp) const;
+
+  /** Get the attractor state of a Dmp, without loading the Dmp.
+   * \param[in] i_dmp Index of the Dmp
+   * \return Attractor state (size dim_y()), which maps the memory of the file.
+   */
+  Eigen::Map<const Eigen::VectorXd> y_attr(int i_dmp) const;
+
+  /** Get a Dmp, loading it if it is not in the cache.
+   * \param[in] i_dmp Index of the Dmp
+   * \return A clone of the cached Dmp (cf. Dmp::clone()), or an empty pointer
+   * if it could not be loaded.
+   *
+   * This function is thread-safe. It is not real-time, because loading and
+   * cloning a Dmp allocate memory. Each call returns a different clone, which
+   * shares the function approximators with the cached Dmp, so the Dmps that
+   * are returned may be integrated in different threads at the same time.
+   */
+  std::shared_ptr<Dmp> get(int i_dmp);
+
+  /** Get a Dmp by its name, loading it if it is not in the cache.
+   * \param[in] name Name of the Dmp
+   * \return The Dmp, or an empty pointer if there is no Dmp with this name.
+   */
+  std::shared_ptr<Dmp> get(const std::string& name);
+
+  /** Get the number of Dmps that are currently in the cache.
+   * \return Number of cached Dmps
+   */
+  int n_cached_dmps(void) const;
+
+  /** Get the size of the library file.
+   * \return Size in bytes
+   */
+  inline std::size_t n_bytes(void) const { return n_bytes_; }
+
+ private:
+  /** Constructor.
+   * \param[in] data The mapped file
+   * \param[in] n_bytes Size of the mapped file
+   * \param[in] max_cached_dmps Maximum number of Dmps kept in the cache
+   */
+  DmpLibrary(const char* data, std::size_t n_bytes, int max_cached_dmps);
+
+  /** Not implemented. */
+  DmpLibrary(const DmpLibrary& other);
+
+  /** Not implemented. */
+  DmpLibrary& operator=(const DmpLibrary& other);
+
+  /** An entry in the index of the file. */
+  struct IndexEntry {
+    char name[64];
+    uint32_t dim_y;
+    uint32_t n_basis_functions;
+    uint64_t descriptors_offset;  // tau, y_init, y_attr
+    uint64_t json_offset;
+    uint64_t json_size;
+  };
+
+  /** Get an entry of the index.
+   * \param[in] i_dmp Index of the Dmp
+   * \return The entry
+   */
+  const IndexEntry& entry(int i_dmp) const;
+
+  /** The mapped file. */
+  const char* data_;
+
+  /** Size of the mapped file. */
+  std::size_t n_bytes_;
+
+  /** Number of Dmps in the library. */
+  int n_dmps_;
+
+  /** The index, which is part of the mapped file. */
+  const IndexEntry* index_;
+
+  /** Maximum number of Dmps kept in the cache. */
+  int max_cached_dmps_;
+
+  /** A cached Dmp and its index in the library. */
+  typedef std::pair<int, std::shared_ptr<Dmp> > CacheItem;
+
+  /** The cached Dmps, the most recently requested one first. */
+  std::list<CacheItem> cache_;
+
+  /** For each cached Dmp, its position in cache_. */
+  std::unordered_map<int, std::list<CacheItem>::iterator> cache_positions_;
+
+  /** Protects cache_ and cache_positions_. */
+  mutable std::mutex cache_mutex_;
+};
+
+}  // namespace DmpBbo
+
+#endif  // _DMP_LIBRARY_H_
@@ -0,0 +1,232 @@
+/**
+ * @file DmpLibraryIndex.cpp
+ * @brief  DmpLibraryIndex class source file.
+ *
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "dmp/DmpLibraryIndex.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+#include "dmp/DmpLibrary.hpp"
+
+using namespace std;
+using namespace Eigen;
+
+namespace DmpBbo {
+
+DmpLibraryIndex::DmpLibraryIndex(const DmpLibrary* library,
+                                 const MatrixXd& contexts,
+                                 const VectorXd& weights)
+{
+  int n_dmps_library = library->n_dmps();
+  dim_y_ = (n_dmps_library > 0 ? library->dim_y(0) : 0);
+
+  int n_context = contexts.cols();
+  if (contexts.size() > 0 && contexts.rows() != n_dmps_library) {
+    cerr << __FILE__ << ":" << __LINE__ << ":";
+    cerr << "contexts must have one row per Dmp in the library. Ignoring them."
+         << endl;
+    n_context = 0;
+  }
+
+  int dim_descriptor = 2 * dim_y_ + 1 + n_context;
+  weights_ = VectorXd::Ones(dim_descriptor);
+  if (weights.size() == dim_descriptor) {
+    weights_ = weights;
+  } else if (weights.size() > 0) {
+    cerr << __FILE__ << ":" << __LINE__ << ":";
+    cerr << "weights must have size " << dim_descriptor
+         << ". Using weights of 1." << endl;
+  }
+
+  // Get the descriptors from the index of the library.
+  for (int i_dmp = 0; i_dmp < n_dmps_library; i_dmp++)
+    if (library->dim_y(i_dmp) == dim_y_) i_dmps_.push_back(i_dmp);
+  if ((int)i_dmps_.size() < n_dmps_library) {
+    cerr << __FILE__ << ":" << __LINE__ << ":";
+    cerr << "Not indexing " << n_dmps_library - i_dmps_.size()
+         << " Dmps whose dim_y is not " << dim_y_ << "." << endl;
+  }
+
+  int n_points = i_dmps_.size();
+  points_.resize(dim_descriptor, n_points);
+  for (int i_point = 0; i_point < n_points; i_point++) {
+    int i_dmp = i_dmps_[i_point];
+    VectorXd context = VectorXd::Zero(0);
+    if (n_context > 0) context = contexts.row(i_dmp).transpose();
+    points_.col(i_point) = descriptor(library->y_init(i_dmp),
+                                      library->y_attr(i_dmp),
+                                      library->tau(i_dmp), context);
+  }
+
+  if (n_points == 0) return;
+
+  // Build the tree, and then store the points in the order of the tree, so
+  // that the points in a leaf are contiguous in memory.
+  vector<int> order(n_points);
+  for (int i_point = 0; i_point < n_points; i_point++) order[i_point] = i_point;
+  nodes_.reserve(2 * n_points / kMaxLeafSize + 1);
+  build(order, 0, n_points);
+
+  MatrixXd points_unordered = points_;
+  vector<int> i_dmps_unordered = i_dmps_;
+  for (int i_point = 0; i_point < n_points; i_point++) {
+    points_.col(i_point) = points_unordered.col(order[i_point]);
+    i_dmps_[i_point] = i_dmps_unordered[order[i_point]];
+  }
+}
+
+int DmpLibraryIndex::build(vector<int>& order, int begin, int end)
+{
+  int i_node = nodes_.size();
+  Node node;
+  node.begin = begin;
+  node.end = end;
+  node.left = -1;
+  node.right = -1;
+  node.split_dim = 0;
+  node.split_value = 0.0;
+  nodes_.push_back(node);
+  if (end - begin <= kMaxLeafSize) return i_node;
+
+  // Split along the dimension in which the points are most spread out.
+  int dim_descriptor = points_.rows();
+  VectorXd min_values = points_.col(order[begin]);
+  VectorXd max_values = min_values;
+  for (int i = begin + 1; i < end; i++) {
+    min_values = min_values.cwiseMin(points_.col(order[i]));
+    max_values = max_values.cwiseMax(points_.col(order[i]));
+  }
+  int split_dim = 0;
+  (max_values - min_values).maxCoeff(&split_dim);
+  if (dim_descriptor == 0 || max_values(split_dim) == min_values(split_dim))
+    return i_node;  // All points are the same; keep them in one leaf.
+
+  // Split at the median.
+  int mid = begin + (end - begin) / 2;
+  nth_element(order.begin() + begin, order.begin() + mid,
+              order.begin() + end, [this, split_dim](int a, int b) {
+                return points_(split_dim, a) < points_(split_dim, b);
+              });
+
+  double split_value = points_(split_dim, order[mid]);
+  int left = build(order, begin, mid);
+  int right = build(order, mid, end);
+
+  // nodes_ may have been reallocated by the recursive calls.
+  nodes_[i_node].split_dim = split_dim;
+  nodes_[i_node].split_value = split_value;
+  nodes_[i_node].left = left;
+  nodes_[i_node].right = right;
+  return i_node;
+}
+
+VectorXd DmpLibraryIndex::descriptor(const VectorXd& y_init,
+                                     const VectorXd& y_attr, double tau,
+                                     const VectorXd& context) const
+{
+  assert(y_init.size() == dim_y_);
+  assert(y_attr.size() == dim_y_);
+  assert(2 * dim_y_ + 1 + context.size() == weights_.size());
+  VectorXd descriptor(weights_.size());
+  descriptor << y_init, y_attr, tau, context;
+  return descriptor.cwiseProduct(weights_);
+}
+
+void DmpLibraryIndex::search(int i_node, const VectorXd& query, int k,
+                             double& max_sq_dist,
+                             vector<pair<double, int> >& found) const
+{
+  const Node& node = nodes_[i_node];
+
+  if (node.left < 0) {
+    for (int i_point = node.begin; i_point < node.end; i_point++) {
+      double sq_dist = (points_.col(i_point) - query).squaredNorm();
+      if (sq_dist > max_sq_dist) continue;
+      if (k == 0) {
+        found.push_back(pair<double, int>(sq_dist, i_point));
+      } else if ((int)found.size() < k) {
+        found.push_back(pair<double, int>(sq_dist, i_point));
+        push_heap(found.begin(), found.end());
+        if ((int)found.size() == k) max_sq_dist = found.front().first;
+      } else if (sq_dist < found.front().first) {
+        pop_heap(found.begin(), found.end());
+        found.back() = pair<double, int>(sq_dist, i_point);
+        push_heap(found.begin(), found.end());
+        max_sq_dist = found.front().first;
+      }
+    }
+    return;
+  }
+
+  // First search the side of the split the query is on, then the other side
+  // if it may contain points that are close enough.
+  double diff = query(node.split_dim) - node.split_value;
+  int near = (diff < 0.0 ? node.left : node.right);
+  int far = (diff < 0.0 ? node.right : node.left);
+  search(near, query, k, max_sq_dist, found);
+  if (diff * diff <= max_sq_dist) search(far, query, k, max_sq_dist, found);
+}
+
+void DmpLibraryIndex::output(vector<pair<double, int> >& found,
+                             vector<int>& i_dmps,
+                             vector<double>& distances) const
+{
+  sort(found.begin(), found.end());
+  i_dmps.resize(found.size());
+  distances.resize(found.size());
+  for (unsigned int i = 0; i < found.size(); i++) {
+    distances[i] = sqrt(found[i].first);
+    i_dmps[i] = i_dmps_[found[i].second];
+  }
+}
+
+void DmpLibraryIndex::nearest(const VectorXd& query, int k,
+                              vector<int>& i_dmps,
+                              vector<double>& distances) const
+{
+  assert(query.size() == dim_descriptor());
+  vector<pair<double, int> > found;
+  if (k > 0 && !nodes_.empty()) {
+    found.reserve(k);
+    double max_sq_dist = numeric_limits<double>::infinity();
+    search(0, query, k, max_sq_dist, found);
+  }
+  output(found, i_dmps, distances);
+}
+
+void DmpLibraryIndex::withinRadius(const VectorXd& query, double radius,
+                                   vector<int>& i_dmps,
+                                   vector<double>& distances) const
+{
+  assert(query.size() == dim_descriptor());
+  vector<pair<double, int> > found;
+  if (radius >= 0.0 && !nodes_.empty()) {
+    double max_sq_dist = radius * radius;
+    search(0, query, 0, max_sq_dist, found);
+  }
+  output(found, i_dmps, distances);
+}
+
+}  // namespace DmpBbo
@@ -0,0 +1,163 @@
+/**
+ * @file DmpLibraryIndex.hpp
+ * @brief  DmpLibraryIndex class header file.
+ *
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef _DMP_LIBRARY_INDEX_H_
+#define _DMP_LIBRARY_INDEX_H_
+
+#include <eigen3/Eigen/Core>
+#include <vector>
+
+namespace DmpBbo {
+
+// forward declaration
+class DmpLibrary;
+
+/** \brief A k-d tree over the descriptors of the Dmps in a DmpLibrary, for
+ * retrieving the Dmps that are most similar to a new task.
+ *
+ * The descriptor of a Dmp is [y_init y_attr tau context], where context
+ * contains optional task features that are provided by the user. The
+ * descriptors are read from the index of the library, so building the tree
+ * does not load any Dmp. Queries return indices into the library, which can
+ * be passed to DmpLibrary::get().
+ *
+ * Distances are Euclidean distances between descriptors, after multiplying
+ * each element with a weight. The weights determine the relative importance of
+ * positions, durations and context features.
+ */
+class DmpLibraryIndex {
+ public:
+  /** Constructor, which builds the tree.
+   * \param[in] library  The library whose Dmps are indexed
+   * \param[in] contexts Context features of the Dmps (size: n_dmps X
+   * n_context), or an empty matrix if there are none.
+   * \param[in] weights Weight for each element of the descriptor (size:
+   * 2*dim_y+1+n_context), or an empty vector to weigh all elements with 1.
+   *
+   * Only Dmps with the same dim_y as the first Dmp in the library are indexed.
+   */
+  DmpLibraryIndex(const DmpLibrary* library,
+                  const Eigen::MatrixXd& contexts = Eigen::MatrixXd(0, 0),
+                  const Eigen::VectorXd& weights = Eigen::VectorXd(0));
+
+  /** Get the number of indexed Dmps.
+   * \return Number of indexed Dmps
+   */
+  inline int n_dmps(void) const { return i_dmps_.size(); }
+
+  /** Get the size of the descriptors.
+   * \return Size of the descriptors, i.e. 2*dim_y+1+n_context
+   */
+  inline int dim_descriptor(void) const { return points_.rows(); }
+
+  /** Make a query descriptor.
+   * \param[in] y_init  Initial state (size dim_y)
+   * \param[in] y_attr  Attractor state (size dim_y)
+   * \param[in] tau     Time constant
+   * \param[in] context Context features (size n_context)
+   * \return The descriptor (size dim_descriptor())
+   */
+  Eigen::VectorXd descriptor(
+      const Eigen::VectorXd& y_init, const Eigen::VectorXd& y_attr,
+      double tau, const Eigen::VectorXd& context = Eigen::VectorXd(0)) const;
+
+  /** Find the k Dmps with the descriptors closest to a query.
+   * \param[in]  query     Query descriptor (size dim_descriptor())
+   * \param[in]  k         Number of Dmps to find
+   * \param[out] i_dmps    Indices of the Dmps in the library, closest first
+   * \param[out] distances Weighted distances of the Dmps to the query
+   */
+  void nearest(const Eigen::VectorXd& query, int k, std::vector<int>& i_dmps,
+               std::vector<double>& distances) const;
+
+  /** Find all Dmps with descriptors within a radius of a query.
+   * \param[in]  query     Query descriptor (size dim_descriptor())
+   * \param[in]  radius    Maximum weighted distance to the query
+   * \param[out] i_dmps    Indices of the Dmps in the library, closest first
+   * \param[out] distances Weighted distances of the Dmps to the query
+   */
+  void withinRadius(const Eigen::VectorXd& query, double radius,
+                    std::vector<int>& i_dmps,
+                    std::vector<double>& distances) const;
+
+ private:
+  /** A node in the tree. Leaves have left == -1. */
+  struct Node {
+    int split_dim;
+    double split_value;
+    int begin, end;  // Range of points in the subtree
+    int left, right;
+  };
+
+  /** Build the subtree for the points in [begin, end).
+   * \param[in,out] order Columns of points_, in the order of the tree
+   * \param[in] begin First point of the subtree
+   * \param[in] end One after the last point of the subtree
+   * \return Index of the root of the subtree in nodes_
+   */
+  int build(std::vector<int>& order, int begin, int end);
+
+  /** Search a subtree for the points closest to a query.
+   * \param[in] i_node Root of the subtree
+   * \param[in] query The weighted query
+   * \param[in] k Number of points to find (k>0), or 0 to find all points
+   * within max_sq_dist
+   * \param[in,out] max_sq_dist Largest squared distance to consider. For k>0,
+   * it is reduced to that of the kth closest point once k points are found.
+   * \param[in,out] found Squared distances and indices of the points found.
+   * For k>0, this is a max-heap.
+   */
+  void search(int i_node, const Eigen::VectorXd& query, int k,
+              double& max_sq_dist,
+              std::vector<std::pair<double, int> >& found) const;
+
+  /** Sort the points found, and convert them to outputs.
+   * \param[in] found Squared distances and indices of the points found
+   * \param[out] i_dmps    Indices of the Dmps in the library, closest first
+   * \param[out] distances Weighted distances of the Dmps to the query
+   */
+  void output(std::vector<std::pair<double, int> >& found,
+              std::vector<int>& i_dmps, std::vector<double>& distances) const;
+
+  /** Maximum number of points in a leaf. */
+  static const int kMaxLeafSize = 8;
+
+  /** Dimensionality of the indexed Dmps. */
+  int dim_y_;
+
+  /** Weight for each element of the descriptor. */
+  Eigen::VectorXd weights_;
+
+  /** Weighted descriptors, one per column, in the order of the tree. */
+  Eigen::MatrixXd points_;
+
+  /** For each column in points_, the index of the Dmp in the library. */
+  std::vector<int> i_dmps_;
+
+  /** The nodes of the tree, the root first. */
+  std::vector<Node> nodes_;
+};
+
+}  // namespace DmpBbo
+
+#endif  // _DMP_LIBRARY_INDEX_H_
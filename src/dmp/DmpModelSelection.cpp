@@ -0,0 +1,203 @@
+/**
+ * @file DmpModelSelection.cpp
+ * @brief  DmpModelSelection class source file.
+ *
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "dmp/DmpModelSelection.hpp"
+
+#include <eigen3/Eigen/Core>
+#include <iostream>
+#include <nlohmann/json.hpp>
+
+#include "dmp/Dmp.hpp"
+#include "dmp/Trajectory.hpp"
+#include "functionapproximators/FunctionApproximator.hpp"
+#include "threadutils/ThreadPool.hpp"
+
+using namespace std;
+using namespace Eigen;
+
+namespace DmpBbo {
+
+bool DmpModelSelection::evaluate(
+    const Trajectory& trajectory, const std::string& fa_class,
+    const std::vector<int>& n_basis_functions,
+    const std::vector<double>& intersection_heights,
+    const std::vector<double>& regularizations,
+    std::vector<Candidate>& candidates, std::string dmp_type,
+    std::string scaling, std::string integration, ThreadPool* thread_pool)
+{
+  candidates.clear();
+  if (fa_class != "FunctionApproximatorRBFN" &&
+      fa_class != "FunctionApproximatorLWR") {
+    cerr << __FILE__ << ":" << __LINE__ << ":";
+    cerr << "Model selection is only possible for FunctionApproximatorRBFN "
+         << "and FunctionApproximatorLWR, not for " << fa_class << endl;
+    return false;
+  }
+  if (trajectory.length() < 2) {
+    cerr << __FILE__ << ":" << __LINE__ << ":";
+    cerr << "Trajectory must have at least 2 time steps." << endl;
+    return false;
+  }
+
+  // Relevant variables from trajectory
+  double tau = trajectory.duration();
+  VectorXd y_init = trajectory.initial_y();
+  VectorXd y_attr = trajectory.final_y();
+  VectorXd scaling_amplitudes = trajectory.getRangePerDim();
+  const VectorXd& ts = trajectory.ts();
+  int D = trajectory.dim();
+
+  // The targets of the function approximators do not depend on the
+  // meta-parameters, so they are computed once for the entire grid.
+  vector<FunctionApproximator*> no_function_approximators;
+  Dmp dmp_untrained(tau, y_init, y_attr, no_function_approximators, dmp_type,
+                    scaling, scaling_amplitudes);
+  MatrixXd fa_inputs_phase, f_targets;
+  if (!dmp_untrained.computeTargets(trajectory, fa_inputs_phase, f_targets))
+    return false;
+
+  // The grid is divided into groups with the same basis functions.
+  int n_heights = intersection_heights.size();
+  int n_regs = regularizations.size();
+  int n_groups = n_basis_functions.size() * n_heights;
+  candidates.resize(n_groups * n_regs);
+  for (int i_group = 0; i_group < n_groups; i_group++) {
+    for (int i_reg = 0; i_reg < n_regs; i_reg++) {
+      Candidate& candidate = candidates[i_group * n_regs + i_reg];
+      candidate.fa_class = fa_class;
+      candidate.n_basis_functions = n_basis_functions[i_group / n_heights];
+      candidate.intersection_height = intersection_heights[i_group % n_heights];
+      candidate.regularization = regularizations[i_reg];
+      candidate.n_parameters = 0;
+      candidate.mean_absolute_error = -1.0;
+      candidate.max_absolute_error = -1.0;
+    }
+  }
+
+  vector<char> success(n_groups, 0);
+  auto evaluate_group = [&](int i_group) {
+    Candidate* group = &candidates[i_group * n_regs];
+
+    // Train the function approximators for all regularizations
+    vector<vector<FunctionApproximator*>> fas(
+        n_regs, vector<FunctionApproximator*>(D, NULL));
+    bool trained = true;
+    for (int i_reg = 0; i_reg < n_regs; i_reg++) {
+      nlohmann::json meta_params = toMetaParams(group[i_reg]);
+      for (int i_dim = 0; i_dim < D && trained; i_dim++) {
+        fas[i_reg][i_dim] = FunctionApproximator::train(
+            meta_params, fa_inputs_phase, f_targets.col(i_dim));
+        trained = (fas[i_reg][i_dim] != NULL);
+      }
+    }
+    if (!trained) {
+      for (int i_reg = 0; i_reg < n_regs; i_reg++)
+        for (int i_dim = 0; i_dim < D; i_dim++) delete fas[i_reg][i_dim];
+      return;
+    }
+
+    // The parameter vectors of all regularizations, in the order of
+    // Dmp::getLinearParameterVector()
+    int n_params = 0;
+    for (int i_dim = 0; i_dim < D; i_dim++)
+      n_params += fas[0][i_dim]->getLinearParameterVectorSize();
+    MatrixXd parameter_vectors(n_regs, n_params);
+    VectorXd values_one_dim;
+    for (int i_reg = 0; i_reg < n_regs; i_reg++) {
+      int offset = 0;
+      for (int i_dim = 0; i_dim < D; i_dim++) {
+        fas[i_reg][i_dim]->getLinearParameterVector(values_one_dim);
+        parameter_vectors.row(i_reg).segment(offset, values_one_dim.size()) =
+            values_one_dim;
+        offset += values_one_dim.size();
+      }
+    }
+
+    // One Dmp reproduces the trajectories of all regularizations. It takes
+    // ownership of the function approximators of the first one.
+    Dmp dmp(tau, y_init, y_attr, fas[0], dmp_type, scaling,
+            scaling_amplitudes);
+    for (int i_reg = 1; i_reg < n_regs; i_reg++)
+      for (int i_dim = 0; i_dim < D; i_dim++) delete fas[i_reg][i_dim];
+    dmp.set_analytical_solution_integration(integration);
+    MatrixXd ys, yds, ydds;
+    dmp.analyticalSolutionBatch(ts, parameter_vectors, ys, yds, ydds);
+
+    for (int i_reg = 0; i_reg < n_regs; i_reg++) {
+      ArrayXXd errors =
+          (ys.middleCols(i_reg * D, D) - trajectory.ys()).array().abs();
+      group[i_reg].n_parameters = n_params;
+      group[i_reg].mean_absolute_error = errors.mean();
+      group[i_reg].max_absolute_error = errors.maxCoeff();
+    }
+    success[i_group] = 1;
+  };
+
+  if (thread_pool == NULL)
+    for (int i_group = 0; i_group < n_groups; i_group++)
+      evaluate_group(i_group);
+  else
+    thread_pool->parallelFor(n_groups, evaluate_group);
+
+  for (int i_group = 0; i_group < n_groups; i_group++)
+    if (!success[i_group]) return false;
+  return true;
+}
+
+int DmpModelSelection::selectBest(const std::vector<Candidate>& candidates,
+                                  double max_error)
+{
+  int i_best = -1;
+  for (unsigned int i = 0; i < candidates.size(); i++) {
+    const Candidate& candidate = candidates[i];
+    if (candidate.mean_absolute_error < 0.0) continue;  // Not evaluated
+    if (i_best < 0) {
+      i_best = i;
+      continue;
+    }
+    const Candidate& best = candidates[i_best];
+    bool acceptable = (candidate.mean_absolute_error <= max_error);
+    bool best_acceptable = (best.mean_absolute_error <= max_error);
+    if (acceptable && best_acceptable &&
+        candidate.n_parameters != best.n_parameters) {
+      if (candidate.n_parameters < best.n_parameters) i_best = i;
+    } else if (acceptable != best_acceptable) {
+      if (acceptable) i_best = i;
+    } else if (candidate.mean_absolute_error < best.mean_absolute_error) {
+      i_best = i;
+    }
+  }
+  return i_best;
+}
+
+nlohmann::json DmpModelSelection::toMetaParams(const Candidate& candidate)
+{
+  nlohmann::json j;
+  j["class"] = candidate.fa_class;
+  j["_meta_params"]["n_basis_functions_per_dim"] = {
+      candidate.n_basis_functions};
+  j["_meta_params"]["intersection_height"] = candidate.intersection_height;
+  j["_meta_params"]["regularization"] = candidate.regularization;
+  return j;
+}
+
+}  // namespace DmpBbo
@@ -0,0 +1,119 @@
+/**
+ * @file DmpModelSelection.hpp
+ * @brief  DmpModelSelection class header file.
+ *
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _DMP_MODEL_SELECTION_H_
+#define _DMP_MODEL_SELECTION_H_
+
+#include <nlohmann/json_fwd.hpp>
+#include <string>
+#include <vector>
+
+namespace DmpBbo {
+
+// forward declaration
+class Trajectory;
+class ThreadPool;
+
+/** \brief Select the meta-parameters of the function approximators of a Dmp.
+ *
+ * A Dmp is trained with a trajectory for each point on a grid of numbers of
+ * basis functions, intersection heights and regularization parameters, and
+ * the trajectory is reproduced with the analytical solution of each Dmp. The
+ * reconstruction errors help choosing the simplest model that reproduces the
+ * trajectory accurately enough, cf. step1_train_dmp_from_trajectory_file.py.
+ *
+ * The phase, gating and targets of the function approximators are the same
+ * for all points on the grid, and are computed only once. Points that differ
+ * only in the regularization have the same basis functions, and are reproduced
+ * together with Dmp::analyticalSolutionBatch(). Points with different basis
+ * functions are trained and reproduced in parallel.
+ */
+class DmpModelSelection {
+ public:
+  /** Meta-parameters and reconstruction error of one point on the grid. */
+  struct Candidate {
+    /** Class of the function approximators, e.g. "FunctionApproximatorRBFN" */
+    std::string fa_class;
+    /** Number of basis functions of each function approximator */
+    int n_basis_functions;
+    /** Height at which neighbouring basis functions intersect */
+    double intersection_height;
+    /** Regularization parameter of the least squares */
+    double regularization;
+    /** Number of parameters of the forcing term (for all dimensions) */
+    int n_parameters;
+    /** Mean absolute difference between the demonstrated and reproduced y */
+    double mean_absolute_error;
+    /** Maximum absolute difference between the demonstrated and reproduced y */
+    double max_absolute_error;
+  };
+
+  /** Train and evaluate a Dmp for each point on a grid of meta-parameters.
+   * \param[in] trajectory The trajectory to train the Dmps with
+   * \param[in] fa_class "FunctionApproximatorRBFN" or "FunctionApproximatorLWR"
+   * \param[in] n_basis_functions Numbers of basis functions on the grid
+   * \param[in] intersection_heights Intersection heights on the grid
+   * \param[in] regularizations Regularization parameters on the grid
+   * \param[out] candidates One candidate for each point on the grid. The
+   * regularization varies fastest, the number of basis functions slowest.
+   * \param[in] dmp_type Type of the Dmps, cf. Dmp::Dmp()
+   * \param[in] scaling Scaling of the forcing term, cf. Dmp::Dmp()
+   * \param[in] integration Integration of the analytical solution, cf.
+   * Dmp::set_analytical_solution_integration()
+   * \param[in] thread_pool Pool for training the Dmps in parallel (optional)
+   * \return true if all Dmps could be trained, false otherwise
+   */
+  static bool evaluate(const Trajectory& trajectory,
+                       const std::string& fa_class,
+                       const std::vector<int>& n_basis_functions,
+                       const std::vector<double>& intersection_heights,
+                       const std::vector<double>& regularizations,
+                       std::vector<Candidate>& candidates,
+                       std::string dmp_type = "KULVICIUS_2012_JOINING",
+                       std::string scaling = "NO_SCALING",
+                       std::string integration = "EULER",
+                       ThreadPool* thread_pool = NULL);
+
+  /** Select the best candidate.
+   *
+   * This is the candidate with the fewest parameters whose mean absolute error
+   * is at most max_error, or the candidate with the lowest mean absolute error
+   * if there is no such candidate. Ties are broken by the lower error.
+   *
+   * \param[in] candidates The candidates, cf. evaluate()
+   * \param[in] max_error Largest acceptable mean absolute error. If 0, the
+   * candidate with the lowest error is selected.
+   * \return Index of the best candidate, or -1 if candidates is empty
+   */
+  static int selectBest(const std::vector<Candidate>& candidates,
+                        double max_error = 0.0);
+
+  /** Get the meta-parameters of a candidate.
+   * \param[in] candidate The candidate
+   * \return Meta-parameters in the format of FunctionApproximator::train()
+   */
+  static nlohmann::json toMetaParams(const Candidate& candidate);
+};
+
+}  // namespace DmpBbo
+
+#endif  // _DMP_MODEL_SELECTION_H_
@@ -0,0 +1,257 @@
+/**
+ * @file DmpModelWatcher.cpp
+ * @brief  DmpModelWatcher class source file.
+ *
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "dmp/DmpModelWatcher.hpp"
+
+#include <poll.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <nlohmann/json.hpp>
+
+#include "dmp/Dmp.hpp"
+#include "eigenutils/eigen_realtime_check.hpp"
+
+using namespace std;
+
+namespace DmpBbo {
+
+/** Time after which the background thread checks whether it should stop. */
+static const int kPollTimeoutMs = 100;
+
+DmpModelWatcher::DmpModelWatcher(const string& path)
+    : inotify_fd_(-1), statistics_(), stop_(false)
+{
+  // Watch the directory of a file rather than the file itself, so that
+  // changes are also detected if the file is replaced, e.g. by moving a new
+  // file into place.
+  struct stat path_stat;
+  if (stat(path.c_str(), &path_stat) != 0) {
+    cerr << __FILE__ << ":" << __LINE__ << ":";
+    cerr << "Path '" << path << "' does not exist." << endl;
+    return;
+  }
+  if (S_ISDIR(path_stat.st_mode)) {
+    directory_ = path;
+  } else {
+    size_t slash = path.find_last_of('/');
+    if (slash == string::npos)
+      directory_ = ".";
+    else
+      directory_ = (slash == 0 ? "/" : path.substr(0, slash));
+    watched_filename_ = path.substr(slash == string::npos ? 0 : slash + 1);
+  }
+
+  inotify_fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (inotify_fd_ < 0 ||
+      inotify_add_watch(inotify_fd_, directory_.c_str(),
+                        IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+    cerr << __FILE__ << ":" << __LINE__ << ":";
+    cerr << "Could not watch '" << directory_ << "': " << strerror(errno)
+         << endl;
+    if (inotify_fd_ >= 0) close(inotify_fd_);
+    inotify_fd_ = -1;
+    return;
+  }
+
+  thread_ = thread(&DmpModelWatcher::watchLoop, this);
+}
+
+DmpModelWatcher::~DmpModelWatcher(void)
+{
+  stop_ = true;
+  if (thread_.joinable()) thread_.join();
+  if (inotify_fd_ >= 0) close(inotify_fd_);
+  for (unsigned int i = 0; i < consumers_.size(); i++) {
+    delete consumers_[i].pending;
+    delete consumers_[i].retired;
+  }
+}
+
+void DmpModelWatcher::addConsumer(Dmp* dmp, const string& filename)
+{
+  Consumer consumer;
+  consumer.dmp = dmp;
+  consumer.filename = (filename.empty() ? watched_filename_ : filename);
+  consumer.pending = NULL;
+  consumer.retired = NULL;
+  // copyParametersRealTime() does not change parameters shared with a clone.
+  dmp->unshareParameters();
+
+  lock_guard<mutex> lock(mutex_);
+  consumers_.push_back(consumer);
+}
+
+void DmpModelWatcher::removeConsumer(Dmp* dmp)
+{
+  lock_guard<mutex> lock(mutex_);
+  for (unsigned int i = 0; i < consumers_.size(); i++) {
+    if (consumers_[i].dmp == dmp) {
+      delete consumers_[i].pending;
+      delete consumers_[i].retired;
+      consumers_.erase(consumers_.begin() + i);
+      return;
+    }
+  }
+}
+
+int DmpModelWatcher::swapIfUpdated(void)
+{
+  ENTERING_REAL_TIME_CRITICAL_CODE
+
+  // Never wait for the background thread.
+  unique_lock<mutex> lock(mutex_, try_to_lock);
+  if (!lock.owns_lock()) return 0;
+
+  int n_swapped = 0;
+  for (unsigned int i = 0; i < consumers_.size(); i++) {
+    Consumer& consumer = consumers_[i];
+    // Wait until the previous model has been deleted, so that deleting it
+    // need not happen here.
+    if (consumer.pending == NULL || consumer.retired != NULL) continue;
+
+    if (consumer.dmp->copyParametersRealTime(*consumer.pending)) {
+      double latency = chrono::duration<double>(chrono::steady_clock::now() -
+                                                consumer.detected)
+                           .count();
+      statistics_.n_reloads++;
+      statistics_.last_reload_latency = latency;
+      if (latency > statistics_.max_reload_latency)
+        statistics_.max_reload_latency = latency;
+      n_swapped++;
+    } else {
+      statistics_.n_rejected++;
+    }
+    consumer.retired = consumer.pending;
+    consumer.pending = NULL;
+  }
+
+  EXITING_REAL_TIME_CRITICAL_CODE
+  return n_swapped;
+}
+
+DmpModelWatcher::Statistics DmpModelWatcher::statistics(void) const
+{
+  lock_guard<mutex> lock(mutex_);
+  return statistics_;
+}
+
+void DmpModelWatcher::watchLoop(void)
+{
+  // Buffer for inotify events, aligned as required by inotify(7)
+  char buffer[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+
+  struct pollfd poll_fd;
+  poll_fd.fd = inotify_fd_;
+  poll_fd.events = POLLIN;
+  while (!stop_) {
+    {
+      lock_guard<mutex> lock(mutex_);
+      deleteRetired();
+    }
+
+    if (poll(&poll_fd, 1, kPollTimeoutMs) <= 0) continue;
+    ssize_t n_bytes = read(inotify_fd_, buffer, sizeof(buffer));
+    auto detected = chrono::steady_clock::now();
+
+    // Collect the changed files; a file may be reported several times.
+    vector<string> filenames;
+    for (char* ptr = buffer; n_bytes > 0 && ptr < buffer + n_bytes;) {
+      const struct inotify_event* event = (const struct inotify_event*)ptr;
+      ptr += sizeof(struct inotify_event) + event->len;
+      if (event->len == 0) continue;
+      string filename(event->name);
+      if (!watched_filename_.empty() && filename != watched_filename_)
+        continue;
+      if (find(filenames.begin(), filenames.end(), filename) == filenames.end())
+        filenames.push_back(filename);
+    }
+
+    for (unsigned int i = 0; i < filenames.size(); i++)
+      reload(filenames[i], detected);
+  }
+}
+
+void DmpModelWatcher::reload(const string& filename,
+                             chrono::steady_clock::time_point detected)
+{
+  {
+    // Only parse files that have consumers.
+    lock_guard<mutex> lock(mutex_);
+    bool has_consumer = false;
+    for (unsigned int i = 0; i < consumers_.size(); i++)
+      if (consumers_[i].filename == filename) has_consumer = true;
+    if (!has_consumer) return;
+  }
+
+  auto start = chrono::steady_clock::now();
+  Dmp* dmp = NULL;
+  string path = directory_ + "/" + filename;
+  string parse_error;
+  try {
+    ifstream file(path);
+    dmp = nlohmann::json::parse(file).get<Dmp*>();
+  } catch (const exception& error) {
+    // Reported in the statistics rather than printed, because the library
+    // should not write to the console of the controller.
+    parse_error = "Could not load Dmp from '" + path + "': " + error.what();
+  }
+  double parse_duration =
+      chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+  lock_guard<mutex> lock(mutex_);
+  if (dmp == NULL) {
+    statistics_.n_failed_parses++;
+    statistics_.last_parse_error = parse_error;
+    return;
+  }
+  statistics_.last_parse_duration = parse_duration;
+
+  // Each consumer gets its own copy, and a newer model replaces a pending one
+  // that has not been swapped yet.
+  bool used = false;
+  for (unsigned int i = 0; i < consumers_.size(); i++) {
+    Consumer& consumer = consumers_[i];
+    if (consumer.filename != filename) continue;
+    delete consumer.pending;
+    consumer.pending = (used ? dmp->clone() : dmp);
+    consumer.detected = detected;
+    used = true;
+  }
+  if (!used) delete dmp;  // The consumers were removed while parsing.
+}
+
+void DmpModelWatcher::deleteRetired(void)
+{
+  for (unsigned int i = 0; i < consumers_.size(); i++) {
+    delete consumers_[i].retired;
+    consumers_[i].retired = NULL;
+  }
+}
+
+}  // namespace DmpBbo
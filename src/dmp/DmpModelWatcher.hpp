@@ -0,0 +1,186 @@
+/**
+ * @file DmpModelWatcher.hpp
+ * @brief  DmpModelWatcher class header file.
+ *
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef _DMP_MODEL_WATCHER_H_
+#define _DMP_MODEL_WATCHER_H_
+
+#define EIGEN_RUNTIME_NO_MALLOC  // Enable runtime tests for allocations
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace DmpBbo {
+
+// forward declaration
+class Dmp;
+
+/** \brief Watches a Dmp model file (or a directory of model files), and
+ * reloads the model into registered Dmps when the file changes.
+ *
+ * A background thread waits for changes with inotify. When a model file has
+ * been written or moved into place, it is parsed on the background thread.
+ * The parameters of the new model are copied into the registered Dmps (the
+ * consumers) only when swapIfUpdated() is called, which the controller does
+ * at a safe point, e.g. between two integration steps. swapIfUpdated() is
+ * real-time, and uses Dmp::copyParametersRealTime().
+ *
+ * If a file cannot be parsed, or its Dmp does not have the same structure as
+ * the consumer, the consumer keeps running with its current parameters. This
+ * is counted in the statistics, which also contain the error of the last file
+ * that could not be parsed.
+ *
+ * Parsing allocates memory on the background thread. The checks of
+ * REALTIME_CHECKS are not specific to a thread, so they fail if a model is
+ * parsed while the controller is in a real-time section. Do not combine
+ * REALTIME_CHECKS with a watcher that may parse models during the real-time
+ * loop.
+ *
+ * This class requires Linux, because it uses inotify.
+ */
+class DmpModelWatcher {
+ public:
+  /** Statistics of the reloads. */
+  struct Statistics {
+    /** Number of reloads that were swapped into a consumer. */
+    int n_reloads;
+    /** Number of model files that could not be parsed. */
+    int n_failed_parses;
+    /** Why the last model file that could not be parsed failed, or empty. */
+    std::string last_parse_error;
+    /** Number of models that did not have the structure of the consumer. */
+    int n_rejected;
+    /** Time to parse the last model file (seconds). */
+    double last_parse_duration;
+    /** Time between detecting the last change and swapping it (seconds). */
+    double last_reload_latency;
+    /** Maximum time between detecting a change and swapping it (seconds). */
+    double max_reload_latency;
+  };
+
+  /** Constructor, which starts watching.
+   * \param[in] path A model file, or a directory with model files
+   */
+  explicit DmpModelWatcher(const std::string& path);
+
+  /** Destructor, which stops watching. */
+  ~DmpModelWatcher(void);
+
+  /** Whether the path is being watched.
+   * \return false if the path does not exist, or cannot be watched.
+   */
+  inline bool isWatching(void) const { return inotify_fd_ >= 0; }
+
+  /** Register a Dmp that is reloaded when its model file changes.
+   * \param[in] dmp The Dmp, which must remain valid during the lifetime of the
+   * watcher, or until removeConsumer() is called. Its parameters are unshared
+   * from its clones (cf. Dmp::unshareParameters()), so this function should
+   * be called before the Dmp is integrated.
+   * \param[in] filename Name of the model file in the watched directory
+   * (without the directory). If the watcher watches a file, this may be
+   * empty.
+   */
+  void addConsumer(Dmp* dmp, const std::string& filename = "");
+
+  /** Unregister a Dmp.
+   * \param[in] dmp The Dmp
+   */
+  void removeConsumer(Dmp* dmp);
+
+  /** Copy reloaded models into their consumers.
+   *
+   * This function is real-time. If the background thread is busy with the
+   * models, it returns immediately, and the swap happens on a later call.
+   *
+   * \return The number of consumers whose parameters were updated.
+   */
+  int swapIfUpdated(void);
+
+  /** Get the statistics of the reloads.
+   * \return The statistics
+   */
+  Statistics statistics(void) const;
+
+ private:
+  /** Not implemented. */
+  DmpModelWatcher(const DmpModelWatcher& other);
+
+  /** Not implemented. */
+  DmpModelWatcher& operator=(const DmpModelWatcher& other);
+
+  /** A registered Dmp, and its reloaded model. */
+  struct Consumer {
+    Dmp* dmp;
+    std::string filename;
+    /** Reloaded model that has not been swapped yet, or NULL. */
+    Dmp* pending;
+    /** When the change of the pending model was detected. */
+    std::chrono::steady_clock::time_point detected;
+    /** Swapped model, which is deleted on the background thread. */
+    Dmp* retired;
+  };
+
+  /** Function executed by the background thread. */
+  void watchLoop(void);
+
+  /** Parse a model file, and make it the pending model of its consumers.
+   * \param[in] filename Name of the model file in the watched directory
+   * \param[in] detected When the change was detected
+   */
+  void reload(const std::string& filename,
+              std::chrono::steady_clock::time_point detected);
+
+  /** Delete the retired models. mutex_ must be locked. */
+  void deleteRetired(void);
+
+  /** The watched directory. */
+  std::string directory_;
+
+  /** The watched file in directory_, or empty if the directory is watched. */
+  std::string watched_filename_;
+
+  /** The inotify file descriptor, or -1 if not watching. */
+  int inotify_fd_;
+
+  /** The registered Dmps. */
+  std::vector<Consumer> consumers_;
+
+  /** The statistics of the reloads. */
+  Statistics statistics_;
+
+  /** Protects consumers_ and statistics_. */
+  mutable std::mutex mutex_;
+
+  /** Whether the background thread should stop. */
+  std::atomic<bool> stop_;
+
+  /** The background thread. */
+  std::thread thread_;
+};
+
+}  // namespace DmpBbo
+
+#endif  // _DMP_MODEL_WATCHER_H_
@@ -0,0 +1,216 @@
+/**
+ * @file DmpSharedRegistry.cpp
+ * @brief  DmpSharedRegistry class source file.
+ *
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "dmp/DmpSharedRegistry.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <nlohmann/json.hpp>
+
+#include "dmp/DmpLibrary.hpp"
+
+using namespace std;
+
+namespace DmpBbo {
+
+/** The control block of a registry entry, in shared memory. The atomics are
+ * lock-free, and thus can be used by several processes. */
+struct DmpSharedRegistryControl {
+  std::atomic<uint64_t> current_version;
+  std::atomic<uint64_t> last_version;
+};
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2,
+              "DmpSharedRegistry requires lock-free 64-bit atomics.");
+
+/** Map the control block of a registry entry.
+ * \param[in] control_name Name of the shared memory object
+ * \param[in] create Whether to create the control block if it does not exist,
+ * and map it for writing.
+ * \return The control block, or NULL if it could not be mapped
+ */
+static DmpSharedRegistryControl* mapControl(const string& control_name,
+                                            bool create)
+{
+  int fd = shm_open(control_name.c_str(), create ? O_CREAT | O_RDWR : O_RDONLY,
+                    0644);
+  if (fd < 0) return NULL;
+
+  size_t n_bytes = sizeof(DmpSharedRegistryControl);
+  struct stat control_stat;
+  bool valid = fstat(fd, &control_stat) == 0;
+  if (valid && create && control_stat.st_size == 0)
+    valid = ftruncate(fd, n_bytes) == 0;  // Zero-initialized
+  else if (valid)
+    valid = control_stat.st_size == (off_t)n_bytes;
+
+  void* data = MAP_FAILED;
+  if (valid)
+    data = mmap(NULL, n_bytes, create ? PROT_READ | PROT_WRITE : PROT_READ,
+                MAP_SHARED, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED) return NULL;
+  return (DmpSharedRegistryControl*)data;
+}
+
+string DmpSharedRegistry::controlName(const string& name)
+{
+  return "/dmpbbo." + name;
+}
+
+string DmpSharedRegistry::versionName(const string& name, uint64_t version)
+{
+  return "/dmpbbo." + name + ".v" + to_string(version);
+}
+
+bool DmpSharedRegistry::publish(const string& name, const vector<string>& names,
+                                const vector<nlohmann::json>& dmps,
+                                uint64_t* version)
+{
+  if (name.empty() || name.find('/') != string::npos) {
+    cerr << __FILE__ << ":" << __LINE__ << ":";
+    cerr << "Invalid registry name '" << name << "'." << endl;
+    return false;
+  }
+
+  string image;
+  if (!DmpLibrary::serialize(names, dmps, image)) return false;
+
+  DmpSharedRegistryControl* control = mapControl(controlName(name), true);
+  if (control == NULL) {
+    cerr << __FILE__ << ":" << __LINE__ << ":";
+    cerr << "Could not map control block of '" << name
+         << "': " << strerror(errno) << endl;
+    return false;
+  }
+  uint64_t new_version = control->last_version.fetch_add(1) + 1;
+
+  // Write the new version into its own shared memory object.
+  string version_name = versionName(name, new_version);
+  int fd = shm_open(version_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+  bool written = fd >= 0 && ftruncate(fd, image.size()) == 0;
+  if (written) {
+    void* data = mmap(NULL, image.size(), PROT_WRITE, MAP_SHARED, fd, 0);
+    written = data != MAP_FAILED;
+    if (written) {
+      memcpy(data, image.data(), image.size());
+      munmap(data, image.size());
+    }
+    // Make the block read-only for other processes.
+    written = written && fchmod(fd, 0444) == 0;
+  }
+  if (fd >= 0) close(fd);
+  if (!written) {
+    cerr << __FILE__ << ":" << __LINE__ << ":";
+    cerr << "Could not write '" << version_name << "': " << strerror(errno)
+         << endl;
+    shm_unlink(version_name.c_str());
+    munmap(control, sizeof(DmpSharedRegistryControl));
+    return false;
+  }
+
+  // Make the new version the current one, unless an even newer version has
+  // been published in the meantime.
+  uint64_t old_version = control->current_version.load();
+  while (old_version < new_version &&
+         !control->current_version.compare_exchange_weak(old_version,
+                                                         new_version)) {
+  }
+  munmap(control, sizeof(DmpSharedRegistryControl));
+
+  // Processes that attached to the old version keep their mapping.
+  if (old_version > 0) {
+    if (old_version < new_version)
+      shm_unlink(versionName(name, old_version).c_str());
+    else
+      shm_unlink(version_name.c_str());  // Superseded already
+  }
+
+  if (version != NULL) *version = new_version;
+  return true;
+}
+
+DmpLibrary* DmpSharedRegistry::attach(const string& name, int max_cached_dmps,
+                                      uint64_t* version)
+{
+  DmpSharedRegistryControl* control = mapControl(controlName(name), false);
+  if (control == NULL) {
+    cerr << __FILE__ << ":" << __LINE__ << ":";
+    cerr << "Nothing was published under '" << name << "'." << endl;
+    return NULL;
+  }
+
+  // If a new version is published between reading the current version and
+  // opening it, the old version may have been unlinked. Then try again.
+  DmpLibrary* library = NULL;
+  uint64_t current_version = 0;
+  for (int attempt = 0; attempt < 10 && library == NULL; attempt++) {
+    current_version = control->current_version.load();
+    if (current_version == 0) break;
+
+    string version_name = versionName(name, current_version);
+    int fd = shm_open(version_name.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+      if (errno == ENOENT) continue;
+      break;
+    }
+    library = DmpLibrary::open(fd, version_name, max_cached_dmps);
+    close(fd);
+    if (library == NULL) break;
+  }
+  munmap(control, sizeof(DmpSharedRegistryControl));
+
+  if (library == NULL) {
+    cerr << __FILE__ << ":" << __LINE__ << ":";
+    cerr << "Could not attach to '" << name << "'." << endl;
+    return NULL;
+  }
+  if (version != NULL) *version = current_version;
+  return library;
+}
+
+uint64_t DmpSharedRegistry::version(const string& name)
+{
+  DmpSharedRegistryControl* control = mapControl(controlName(name), false);
+  if (control == NULL) return 0;
+  uint64_t current_version = control->current_version.load();
+  munmap(control, sizeof(DmpSharedRegistryControl));
+  return current_version;
+}
+
+bool DmpSharedRegistry::remove(const string& name)
+{
+  uint64_t current_version = version(name);
+  if (current_version > 0)
+    shm_unlink(versionName(name, current_version).c_str());
+  return shm_unlink(controlName(name).c_str()) == 0;
+}
+
+}  // namespace DmpBbo
@@ -0,0 +1,114 @@
+/**
+ * @file DmpSharedRegistry.hpp
+ * @brief  DmpSharedRegistry class header file.
+ *
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef _DMP_SHARED_REGISTRY_H_
+#define _DMP_SHARED_REGISTRY_H_
+
+#include <cstdint>
+#include <nlohmann/json_fwd.hpp>
+#include <string>
+#include <vector>
+
+namespace DmpBbo {
+
+// forward declaration
+class DmpLibrary;
+
+/** \brief A registry of Dmp libraries in POSIX shared memory, so that several
+ * processes on one machine can use the same Dmps without each storing a copy.
+ *
+ * A loader process publishes a set of Dmps under a name. This serializes them
+ * into the format of a DmpLibrary file, and copies it into a new shared memory
+ * object. Other processes attach to the name, which maps the shared memory
+ * object read-only into their address space. Because the library format
+ * contains only offsets, it may be mapped at any address. The index and the
+ * descriptors are thus shared between all processes; only the Dmps that a
+ * process requests with DmpLibrary::get() are parsed into its own memory.
+ *
+ * Each publication gets a new version number. A small control object in shared
+ * memory contains the current version, which is updated atomically once the
+ * new version has been written completely. The shared memory object of the
+ * previous version is then unlinked, but processes that have attached to it
+ * keep using it until they delete their DmpLibrary. To switch to a new
+ * version, a process compares version() to the version it attached to, and
+ * attaches again.
+ *
+ * Only one process should publish under a given name at a time.
+ */
+class DmpSharedRegistry {
+ public:
+  /** Publish Dmps under a name, replacing the previous version.
+   * \param[in] name  Name of the registry entry (without '/')
+   * \param[in] names A unique name for each Dmp (at most 63 characters)
+   * \param[in] dmps  The json representation of each Dmp
+   * \param[out] version The version number of the publication (optional)
+   * \return true if the Dmps were published, false otherwise
+   */
+  static bool publish(const std::string& name,
+                      const std::vector<std::string>& names,
+                      const std::vector<nlohmann::json>& dmps,
+                      uint64_t* version = NULL);
+
+  /** Attach to the current version of a registry entry.
+   * \param[in] name Name of the registry entry
+   * \param[in] max_cached_dmps Maximum number of Dmps kept in the cache
+   * \param[out] version The version attached to (optional)
+   * \return The library, or NULL if nothing was published under this name.
+   * The caller is responsible for deleting it, which releases the version.
+   */
+  static DmpLibrary* attach(const std::string& name, int max_cached_dmps = 16,
+                            uint64_t* version = NULL);
+
+  /** Get the current version of a registry entry.
+   * This function maps the control block, and is thus not real-time.
+   * \param[in] name Name of the registry entry
+   * \return The current version, or 0 if nothing was published under this
+   * name.
+   */
+  static uint64_t version(const std::string& name);
+
+  /** Remove a registry entry. Processes that have attached to it can continue
+   * to use it until they delete their DmpLibrary.
+   * \param[in] name Name of the registry entry
+   * \return true if the entry existed, false otherwise
+   */
+  static bool remove(const std::string& name);
+
+ private:
+  /** Get the name of the shared memory object with the control block.
+   * \param[in] name Name of the registry entry
+   * \return Name of the shared memory object
+   */
+  static std::string controlName(const std::string& name);
+
+  /** Get the name of the shared memory object of a version.
+   * \param[in] name Name of the registry entry
+   * \param[in] version The version
+   * \return Name of the shared memory object
+   */
+  static std::string versionName(const std::string& name, uint64_t version);
+};
+
+}  // namespace DmpBbo
+
+#endif  // _DMP_SHARED_REGISTRY_H_
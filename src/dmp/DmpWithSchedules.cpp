@@ -0,0 +1,317 @@
+/**
+ * @file DmpWithSchedules.cpp
+ * @brief  DmpWithSchedules class source file.
+ *
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "dmp/DmpWithSchedules.hpp"
+
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <nlohmann/json.hpp>
+
+#include "eigenutils/eigen_json.hpp"
+#include "eigenutils/eigen_realtime_check.hpp"
+#include "functionapproximators/BasisFunction.hpp"
+#include "functionapproximators/FunctionApproximator.hpp"
+#include "functionapproximators/FunctionApproximatorRBFN.hpp"
+
+using namespace std;
+using namespace Eigen;
+
+/** Extracts the phase variable (1-D) from a state vector, as in Dmp.cpp */
+#define PHASE segment(3 * dim_y() + 0, 1)
+
+namespace DmpBbo {
+
+DmpWithSchedules::DmpWithSchedules(
+    const Dmp& dmp,
+    vector<FunctionApproximator*> function_approximators_schedules,
+    const VectorXd& min_schedules, const VectorXd& max_schedules)
+    : Dmp(dmp)
+{
+  cloneSubSystems();
+
+  for (unsigned int ff = 0; ff < function_approximators_schedules.size(); ff++)
+    function_approximators_schedules_.push_back(
+        shared_ptr<FunctionApproximator>(function_approximators_schedules[ff]));
+
+  int n_dims = dim_schedules();
+  double inf = numeric_limits<double>::infinity();
+  min_schedules_ = VectorXd::Constant(n_dims, -inf);
+  max_schedules_ = VectorXd::Constant(n_dims, inf);
+  if (min_schedules.size() > 0) {
+    assert(min_schedules.size() == n_dims);
+    min_schedules_ = min_schedules;
+  }
+  if (max_schedules.size() > 0) {
+    assert(max_schedules.size() == n_dims);
+    max_schedules_ = max_schedules;
+  }
+
+  schedules_prealloc_ = VectorXd::Zero(n_dims);
+  fa_output_one_prealloc_ = VectorXd::Zero(1);
+  if (n_dims > 0) {
+    const FunctionApproximatorRBFN* rbfn =
+        dynamic_cast<const FunctionApproximatorRBFN*>(
+            function_approximators_schedules_[0].get());
+    if (rbfn != NULL)
+      activations_prealloc_ = MatrixXd(1, rbfn->weights().size());
+  }
+}
+
+DmpWithSchedules* DmpWithSchedules::clone(void) const
+{
+  DmpWithSchedules* dmp = new DmpWithSchedules(*this);
+  dmp->cloneSubSystems();
+  return dmp;
+}
+
+const FunctionApproximatorRBFN* DmpWithSchedules::sharedBasisFunctions(
+    bool include_forcing_term) const
+{
+  if (function_approximators_schedules_.empty()) return NULL;
+  const FunctionApproximatorRBFN* rbfn =
+      dynamic_cast<const FunctionApproximatorRBFN*>(
+          function_approximators_schedules_[0].get());
+  if (rbfn == NULL || rbfn->centers().cols() != 1) return NULL;
+
+  // The comparisons are much cheaper than computing the activations again.
+  int n_schedules = dim_schedules();
+  int n_fas = n_schedules + (include_forcing_term ? dim_y() : 0);
+  for (int ff = 1; ff < n_fas; ff++) {
+    const FunctionApproximator* fa =
+        ff < n_schedules ? function_approximators_schedules_[ff].get()
+                         : function_approximator(ff - n_schedules);
+    const FunctionApproximatorRBFN* other =
+        dynamic_cast<const FunctionApproximatorRBFN*>(fa);
+    if (other == NULL || other->centers().rows() != rbfn->centers().rows() ||
+        other->centers().cols() != 1 || other->centers() != rbfn->centers() ||
+        other->widths() != rbfn->widths())
+      return NULL;
+  }
+  return rbfn;
+}
+
+void DmpWithSchedules::predictSchedulesRealTime(
+    const Ref<const VectorXd>& phase) const
+{
+  const FunctionApproximatorRBFN* rbfn = sharedBasisFunctions(false);
+  if (rbfn != NULL) {
+    // One activation computation for all schedules
+    BasisFunction::Gaussian::activations(rbfn->centers(), rbfn->widths(), phase,
+                                         activations_prealloc_, false, false);
+    for (int i_dim = 0; i_dim < dim_schedules(); i_dim++) {
+      const FunctionApproximatorRBFN* fa =
+          static_cast<const FunctionApproximatorRBFN*>(
+              function_approximators_schedules_[i_dim].get());
+      schedules_prealloc_[i_dim] =
+          activations_prealloc_.row(0).dot(fa->weights().transpose());
+    }
+  } else {
+    for (int i_dim = 0; i_dim < dim_schedules(); i_dim++) {
+      function_approximators_schedules_[i_dim]->predictRealTime(
+          phase, fa_output_one_prealloc_);
+      schedules_prealloc_[i_dim] = fa_output_one_prealloc_[0];
+    }
+  }
+}
+
+void DmpWithSchedules::predictFunctionApproximatorsRealTime(
+    const Ref<const VectorXd>& phase,
+    Ref<RowVectorXd, 0, InnerStride<> > outputs) const
+{
+  // A packed forcing term is faster than the shared activations
+  const FunctionApproximatorRBFN* rbfn =
+      isForcingTermPacked() ? NULL : sharedBasisFunctions(true);
+  if (rbfn == NULL) {
+    Dmp::predictFunctionApproximatorsRealTime(phase, outputs);
+    return;
+  }
+
+  // One activation computation for all dimensions of the forcing term
+  BasisFunction::Gaussian::activations(rbfn->centers(), rbfn->widths(), phase,
+                                       activations_prealloc_, false, false);
+  for (int i_dim = 0; i_dim < dim_y(); i_dim++) {
+    const FunctionApproximatorRBFN* fa =
+        static_cast<const FunctionApproximatorRBFN*>(
+            function_approximator(i_dim));
+    outputs[i_dim] =
+        activations_prealloc_.row(0).dot(fa->weights().transpose());
+  }
+}
+
+void DmpWithSchedules::computeSchedulesRealTime(
+    const Ref<const VectorXd>& x, Ref<VectorXd> schedules) const
+{
+  ENTERING_REAL_TIME_CRITICAL_CODE
+
+  assert(schedules.size() == dim_schedules());
+
+  predictSchedulesRealTime(x.PHASE);
+
+  schedules =
+      schedules_prealloc_.cwiseMax(min_schedules_).cwiseMin(max_schedules_);
+
+  EXITING_REAL_TIME_CRITICAL_CODE
+}
+
+void DmpWithSchedules::integrateStartSched(Ref<VectorXd> x, Ref<VectorXd> xd,
+                                           Ref<VectorXd> schedules) const
+{
+  integrateStart(x, xd);
+  computeSchedulesRealTime(x, schedules);
+}
+
+void DmpWithSchedules::integrateStepSched(double dt,
+                                          const Ref<const VectorXd> x,
+                                          Ref<VectorXd> x_updated,
+                                          Ref<VectorXd> xd_updated,
+                                          Ref<VectorXd> schedules) const
+{
+  ENTERING_REAL_TIME_CRITICAL_CODE
+
+  integrateStep(dt, x, x_updated, xd_updated);
+  computeSchedulesRealTime(x_updated, schedules);
+
+  EXITING_REAL_TIME_CRITICAL_CODE
+}
+
+void DmpWithSchedules::analyticalSolutionSched(
+    const VectorXd& ts, MatrixXd& xs, MatrixXd& xds, MatrixXd& schedules,
+    MatrixXd& forcing_terms, MatrixXd& fa_output) const
+{
+  int n_time_steps = ts.size();
+  bool caller_expects_transposed =
+      (xs.rows() == dim() && xs.cols() == n_time_steps);
+  analyticalSolution(ts, xs, xds, forcing_terms, fa_output);
+
+  VectorXd phases(n_time_steps);
+  if (caller_expects_transposed)
+    phases = xs.row(3 * dim_y()).transpose();
+  else
+    phases = xs.col(3 * dim_y());
+
+  schedules.resize(n_time_steps, dim_schedules());
+  const FunctionApproximatorRBFN* rbfn = sharedBasisFunctions(false);
+  if (rbfn != NULL) {
+    // One activation computation for all schedules
+    MatrixXd activations;
+    BasisFunction::Gaussian::activations(rbfn->centers(), rbfn->widths(),
+                                         phases, activations, false, false);
+    for (int i_dim = 0; i_dim < dim_schedules(); i_dim++) {
+      const FunctionApproximatorRBFN* fa =
+          static_cast<const FunctionApproximatorRBFN*>(
+              function_approximators_schedules_[i_dim].get());
+      schedules.col(i_dim) = activations * fa->weights();
+    }
+  } else {
+    MatrixXd output;
+    for (int i_dim = 0; i_dim < dim_schedules(); i_dim++) {
+      function_approximators_schedules_[i_dim]->predict(phases, output);
+      schedules.col(i_dim) = output.col(0);
+    }
+  }
+
+  for (int i_dim = 0; i_dim < dim_schedules(); i_dim++)
+    schedules.col(i_dim) = schedules.col(i_dim)
+                               .cwiseMax(min_schedules_[i_dim])
+                               .cwiseMin(max_schedules_[i_dim]);
+}
+
+/** Read bounds of schedules from json.
+ * \param[in] j json input: null, a number, or an array of numbers and nulls
+ * \param[in] n_dims Number of schedules
+ * \param[in] no_bound Value for schedules without a bound
+ * \return The bounds
+ */
+static VectorXd boundsFromJson(const nlohmann::json& j, int n_dims,
+                               double no_bound)
+{
+  VectorXd bounds = VectorXd::Constant(n_dims, no_bound);
+  if (j.is_number()) {
+    bounds.fill(j.get<double>());
+  } else if (j.is_array()) {
+    if ((int)j.size() != n_dims) {
+      cerr << __FILE__ << ":" << __LINE__ << ":";
+      cerr << "Expected " << n_dims << " bounds for the schedules, but got ";
+      cerr << j.size() << "." << endl;
+    }
+    for (int i_dim = 0; i_dim < n_dims && i_dim < (int)j.size(); i_dim++)
+      if (!j.at(i_dim).is_null()) bounds[i_dim] = j.at(i_dim).get<double>();
+  }
+  return bounds;
+}
+
+/** Write bounds of schedules to json, as in Python.
+ * \param[in] bounds The bounds (infinite if a schedule has no bound)
+ * \return null if no schedule has a bound, otherwise an array with null for
+ * the schedules without a bound
+ */
+static nlohmann::json boundsToJson(const VectorXd& bounds)
+{
+  nlohmann::json j = nullptr;
+  if (bounds.array().isFinite().any()) {
+    for (int i_dim = 0; i_dim < bounds.size(); i_dim++)
+      if (std::isfinite(bounds[i_dim]))
+        j[i_dim] = bounds[i_dim];
+      else
+        j[i_dim] = nullptr;
+  }
+  return j;
+}
+
+void from_json(const nlohmann::json& j, DmpWithSchedules*& obj)
+{
+  Dmp* dmp = j.get<Dmp*>();
+
+  vector<FunctionApproximator*> function_approximators_schedules;
+  for (const auto& jfa : j.at("_func_apps_schedules"))
+    function_approximators_schedules.push_back(
+        jfa.get<FunctionApproximator*>());
+
+  int n_dims = function_approximators_schedules.size();
+  double inf = numeric_limits<double>::infinity();
+  VectorXd min_schedules(0), max_schedules(0);
+  if (j.contains("min_schedules"))
+    min_schedules = boundsFromJson(j.at("min_schedules"), n_dims, -inf);
+  if (j.contains("max_schedules"))
+    max_schedules = boundsFromJson(j.at("max_schedules"), n_dims, inf);
+
+  obj = new DmpWithSchedules(*dmp, function_approximators_schedules,
+                             min_schedules, max_schedules);
+  delete dmp;
+}
+
+void DmpWithSchedules::to_json_helper(nlohmann::json& j) const
+{
+  Dmp::to_json_helper(j);
+
+  vector<FunctionApproximator*> function_approximators;
+  for (int i_dim = 0; i_dim < dim_schedules(); i_dim++)
+    function_approximators.push_back(function_approximator_schedules(i_dim));
+  j["_func_apps_schedules"] = function_approximators;
+
+  j["min_schedules"] = boundsToJson(min_schedules_);
+  j["max_schedules"] = boundsToJson(max_schedules_);
+  j["class"] = "DmpWithSchedules";
+}
+
+}  // namespace DmpBbo
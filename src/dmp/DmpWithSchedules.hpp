@@ -0,0 +1,272 @@
+/**
+ * @file DmpWithSchedules.hpp
+ * @brief  DmpWithSchedules class header file.
+ *
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _DMP_WITH_SCHEDULES_H_
+#define _DMP_WITH_SCHEDULES_H_
+
+#define EIGEN_RUNTIME_NO_MALLOC  // Enable runtime tests for allocations
+
+#include <eigen3/Eigen/Core>
+#include <memory>
+#include <nlohmann/json_fwd.hpp>
+#include <vector>
+
+#include "dmp/Dmp.hpp"
+
+namespace DmpBbo {
+
+// forward declaration
+class FunctionApproximator;
+class FunctionApproximatorRBFN;
+
+/**
+ * \brief Dmp that also outputs schedules, e.g. for gains or forces.
+ * \ingroup Dmps
+ *
+ * The schedules are the outputs of additional function approximators, which
+ * have the phase of the Dmp as their input, as in the Python class
+ * dmpbbo.dmps.DmpWithSchedules. The schedules are clipped to optional lower
+ * and upper bounds.
+ *
+ * If the function approximators of the schedules are RBFNs with the same basis
+ * functions, their activations are computed only once per phase. If the
+ * function approximators of the forcing term also have these basis functions
+ * (and the forcing term has not been packed, cf. Dmp::packForcingTerm()), the
+ * activations are shared with the forcing term as well. Since the last
+ * evaluation of the forcing term in a Runge-Kutta step is for the updated
+ * state, integrateStepSched() then gets the schedules without computing any
+ * activations.
+ */
+class DmpWithSchedules : public Dmp {
+ public:
+  /**
+   * Constructor that adds schedules to a Dmp.
+   *
+   * \param[in] dmp The Dmp, which is copied. Its function approximators are
+   * shared with the copy, cf. Dmp::clone().
+   * \param[in] function_approximators_schedules Function approximators for the
+   * schedules, one for each dimension of the schedules. The DmpWithSchedules
+   * takes ownership of them.
+   * \param[in] min_schedules Lower bounds of the schedules. An empty vector
+   * means no lower bounds.
+   * \param[in] max_schedules Upper bounds of the schedules. An empty vector
+   * means no upper bounds.
+   */
+  DmpWithSchedules(
+      const Dmp& dmp,
+      std::vector<FunctionApproximator*> function_approximators_schedules,
+      const Eigen::VectorXd& min_schedules = Eigen::VectorXd::Zero(0),
+      const Eigen::VectorXd& max_schedules = Eigen::VectorXd::Zero(0));
+
+  /** Create a copy of this DmpWithSchedules that shares the function
+   * approximators with it, cf. Dmp::clone().
+   * \return The copy. The caller is responsible for deleting it.
+   */
+  DmpWithSchedules* clone(void) const;
+
+  /** Get the dimensionality of the schedules.
+   * \return Number of schedules
+   */
+  inline int dim_schedules(void) const
+  {
+    return function_approximators_schedules_.size();
+  }
+
+  /** Get a pointer to the function approximator for a certain schedule.
+   * \param[in] i_dim Schedule for which to get the function approximator
+   * \return Pointer to the function approximator.
+   */
+  inline FunctionApproximator* function_approximator_schedules(int i_dim) const
+  {
+    assert(i_dim < dim_schedules());
+    return function_approximators_schedules_[i_dim].get();
+  }
+
+  /** Get the lower bounds of the schedules.
+   * \return Lower bounds (-infinity if a schedule has no lower bound)
+   */
+  inline const Eigen::VectorXd& min_schedules(void) const
+  {
+    return min_schedules_;
+  }
+
+  /** Get the upper bounds of the schedules.
+   * \return Upper bounds (+infinity if a schedule has no upper bound)
+   */
+  inline const Eigen::VectorXd& max_schedules(void) const
+  {
+    return max_schedules_;
+  }
+
+  /**
+   * Start integrating the Dmp, and get the first schedules.
+   *
+   * \param[out] x  The first vector of state variables
+   * \param[out] xd The first vector of rates of change of the state variables
+   * \param[out] schedules The first schedules (size dim_schedules())
+   */
+  void integrateStartSched(Eigen::Ref<Eigen::VectorXd> x,
+                           Eigen::Ref<Eigen::VectorXd> xd,
+                           Eigen::Ref<Eigen::VectorXd> schedules) const;
+
+  /**
+   * Integrate the Dmp one time step, and get the schedules for the updated
+   * state.
+   *
+   * \param[in]  dt         Duration of the time step
+   * \param[in]  x          Current state
+   * \param[out] x_updated  Updated state, dt time later.
+   * \param[out] xd_updated Updated rates of change of state, dt time later.
+   * \param[out] schedules  Schedules, dt time later (size dim_schedules())
+   *
+   * \remarks If the arguments are of the correct size, this function will not
+   * allocate memory.
+   */
+  void integrateStepSched(double dt, const Eigen::Ref<const Eigen::VectorXd> x,
+                          Eigen::Ref<Eigen::VectorXd> x_updated,
+                          Eigen::Ref<Eigen::VectorXd> xd_updated,
+                          Eigen::Ref<Eigen::VectorXd> schedules) const;
+
+  /**
+   * Compute the schedules for a state, clipped to their bounds.
+   *
+   * This function is real-time, i.e. it does not allocate memory. Use it to
+   * get the schedules after integrating with another method than
+   * integrateStepSched(), e.g. Dmp::integrateStepEuler().
+   *
+   * \param[in]  x         State of the Dmp
+   * \param[out] schedules Schedules (size dim_schedules())
+   */
+  void computeSchedulesRealTime(const Eigen::Ref<const Eigen::VectorXd>& x,
+                                Eigen::Ref<Eigen::VectorXd> schedules) const;
+
+  /**
+   * Return the analytical solution of the Dmp and the schedules at certain
+   * times.
+   *
+   * \param[in]  ts  A vector of times for which to compute the analytical
+   * solutions
+   * \param[out] xs  Sequence of state vectors, cf. Dmp::analyticalSolution()
+   * \param[out] xds Sequence of rates of change of the state vectors
+   * \param[out] schedules The schedules (T x dim_schedules())
+   * \param[out] forcing_terms The forcing terms for each dimension
+   * \param[out] fa_output The output of the function approximators of the
+   * forcing term
+   */
+  void analyticalSolutionSched(const Eigen::VectorXd& ts, Eigen::MatrixXd& xs,
+                               Eigen::MatrixXd& xds, Eigen::MatrixXd& schedules,
+                               Eigen::MatrixXd& forcing_terms,
+                               Eigen::MatrixXd& fa_output) const;
+
+  /**
+   * Return the analytical solution of the Dmp and the schedules at certain
+   * times.
+   *
+   * \param[in]  ts  A vector of times for which to compute the analytical
+   * solutions
+   * \param[out] xs  Sequence of state vectors, cf. Dmp::analyticalSolution()
+   * \param[out] xds Sequence of rates of change of the state vectors
+   * \param[out] schedules The schedules (T x dim_schedules())
+   */
+  inline void analyticalSolutionSched(const Eigen::VectorXd& ts,
+                                      Eigen::MatrixXd& xs, Eigen::MatrixXd& xds,
+                                      Eigen::MatrixXd& schedules) const
+  {
+    Eigen::MatrixXd forcing_terms, fa_output;
+    analyticalSolutionSched(ts, xs, xds, schedules, forcing_terms, fa_output);
+  }
+
+  /** Read an object from json.
+   *  \param[in]  j   json input
+   *  \param[out] obj The object read from json
+   *
+   * The format is that of the Python class dmpbbo.dmps.DmpWithSchedules, as
+   * saved with dmpbbo.json_for_cpp.savejson_for_cpp().
+   */
+  friend void from_json(const nlohmann::json& j, DmpWithSchedules*& obj);
+
+ protected:
+  /** Copy constructor, used by clone(). */
+  DmpWithSchedules(const DmpWithSchedules& other) = default;
+
+  /** Write this object to json.
+   *  \param[out]  j json output
+   */
+  void to_json_helper(nlohmann::json& j) const;
+
+  /**
+   * Compute the outputs of the function approximators of the forcing term
+   * for one phase. If the forcing term and the schedules have the same basis
+   * functions, their activations are computed only once for all dimensions.
+   *
+   * \param[in]  phase   Current phase
+   * \param[out] outputs Output for each dimension
+   */
+  void predictFunctionApproximatorsRealTime(
+      const Eigen::Ref<const Eigen::VectorXd>& phase,
+      Eigen::Ref<Eigen::RowVectorXd, 0, Eigen::InnerStride<> > outputs) const;
+
+ private:
+  /**
+   * Get the RBFN whose basis functions are shared by all function
+   * approximators of the schedules, and optionally of the forcing term.
+   * \param[in] include_forcing_term Whether the function approximators of the
+   * forcing term should also have these basis functions
+   * \return The first RBFN of the schedules, or NULL if the basis functions
+   * are not shared.
+   */
+  const FunctionApproximatorRBFN* sharedBasisFunctions(
+      bool include_forcing_term) const;
+
+  /**
+   * Compute the schedules (without bounds) for one phase in
+   * schedules_prealloc_.
+   * \param[in] phase The phase
+   */
+  void predictSchedulesRealTime(
+      const Eigen::Ref<const Eigen::VectorXd>& phase) const;
+
+  /** The function approximators of the schedules, one for each dimension.
+   * They may be shared with copies made with clone().
+   */
+  std::vector<std::shared_ptr<FunctionApproximator> >
+      function_approximators_schedules_;
+
+  /** Lower bounds of the schedules. */
+  Eigen::VectorXd min_schedules_;
+
+  /** Upper bounds of the schedules. */
+  Eigen::VectorXd max_schedules_;
+
+  /** Pre-allocated memory to avoid allocating run-time (for real-time). */
+  mutable Eigen::VectorXd schedules_prealloc_;
+
+  /** Pre-allocated memory to avoid allocating run-time (for real-time). */
+  mutable Eigen::MatrixXd activations_prealloc_;
+
+  /** Pre-allocated memory to avoid allocating run-time (for real-time). */
+  mutable Eigen::VectorXd fa_output_one_prealloc_;
+};
+
+}  // namespace DmpBbo
+
+#endif  // _DMP_WITH_SCHEDULES_H_
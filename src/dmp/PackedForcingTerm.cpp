@@ -0,0 +1,314 @@
+/**
+ * @file PackedForcingTerm.cpp
+ * @brief  PackedForcingTerm class source file.
+ *
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "dmp/PackedForcingTerm.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+
+#include "eigenutils/eigen_realtime_check.hpp"
+#include "functionapproximators/FunctionApproximatorRBFN.hpp"
+
+using namespace std;
+using namespace Eigen;
+
+namespace DmpBbo {
+
+// Size of a cache line in bytes
+static const int kCacheLineSize = 64;
+
+// Number of basis functions whose activations are computed at once on the
+// stack in predictRealTime(). A multiple of the number of scalars in a cache
+// line, so that the blocks remain aligned.
+static const int kChunkSize = 64;
+
+static int roundUpToCacheLine(int n_scalars, int scalar_size)
+{
+  int n_per_cache_line = kCacheLineSize / scalar_size;
+  return n_per_cache_line *
+         ((n_scalars + n_per_cache_line - 1) / n_per_cache_line);
+}
+
+/** Get a function approximator as an RBFN with a 1D input.
+ * \param[in] fa The function approximator
+ * \return The RBFN, or NULL if fa is not such an RBFN.
+ */
+static const FunctionApproximatorRBFN* getRBFN(const FunctionApproximator* fa)
+{
+  const FunctionApproximatorRBFN* rbfn =
+      dynamic_cast<const FunctionApproximatorRBFN*>(fa);
+  if (rbfn == NULL || rbfn->centers().cols() != 1) return NULL;
+  return rbfn;
+}
+
+/** Determine whether function approximators can be packed.
+ * \param[in] function_approximators One function approximator per dimension
+ * \param[in] i_dim Dimension whose function approximator is replaced by fa,
+ * or -1 if none is replaced
+ * \param[in] fa The function approximator that replaces the one of i_dim
+ * \param[out] n_basis_functions Number of basis functions per dimension
+ * \param[out] shared Whether all dimensions have the same basis functions
+ * \return true if they can be packed
+ */
+static bool analyzeFunctionApproximators(
+    const std::vector<std::shared_ptr<FunctionApproximator> >&
+        function_approximators,
+    int i_dim, const FunctionApproximator* fa, int& n_basis_functions,
+    bool& shared)
+{
+  int n_dims = function_approximators.size();
+  if (n_dims == 0) return false;
+  const FunctionApproximatorRBFN* first =
+      getRBFN(i_dim == 0 ? fa : function_approximators[0].get());
+  if (first == NULL) return false;
+
+  n_basis_functions = first->centers().rows();
+  shared = true;
+  for (int dd = 1; dd < n_dims; dd++) {
+    const FunctionApproximatorRBFN* rbfn =
+        getRBFN(i_dim == dd ? fa : function_approximators[dd].get());
+    if (rbfn == NULL || rbfn->centers().rows() != n_basis_functions)
+      return false;
+    if (rbfn->centers() != first->centers() ||
+        rbfn->widths() != first->widths())
+      shared = false;
+  }
+  return true;
+}
+
+PackedForcingTerm* PackedForcingTerm::create(
+    const std::vector<std::shared_ptr<FunctionApproximator> >&
+        function_approximators,
+    string scalar_type)
+{
+  int scalar_size;
+  if (scalar_type == "FLOAT64") {
+    scalar_size = sizeof(double);
+  } else if (scalar_type == "FLOAT32") {
+    scalar_size = sizeof(float);
+  } else {
+    cerr << __FILE__ << ":" << __LINE__ << ":";
+    cerr << "Unknown scalar type '" << scalar_type << "'." << endl;
+    return NULL;
+  }
+
+  int n_basis_functions;
+  bool shared;
+  if (!analyzeFunctionApproximators(function_approximators, -1, NULL,
+                                    n_basis_functions, shared))
+    return NULL;
+
+  int n_dims = function_approximators.size();
+  PackedForcingTerm* packed =
+      new PackedForcingTerm(n_dims, n_basis_functions, shared, scalar_size);
+  packed->update(function_approximators);
+  return packed;
+}
+
+bool PackedForcingTerm::fits(
+    const std::vector<std::shared_ptr<FunctionApproximator> >&
+        function_approximators,
+    int i_dim, const FunctionApproximator* fa) const
+{
+  int n_basis_functions;
+  bool shared;
+  if (!analyzeFunctionApproximators(function_approximators, i_dim, fa,
+                                    n_basis_functions, shared))
+    return false;
+  return (int)function_approximators.size() == n_dims_ &&
+         n_basis_functions == n_basis_functions_ &&
+         shared == shared_basis_functions_;
+}
+
+bool PackedForcingTerm::update(
+    const std::vector<std::shared_ptr<FunctionApproximator> >&
+        function_approximators)
+{
+  if (!fits(function_approximators)) return false;
+
+  if (scalar_size_ == sizeof(float))
+    updateTemplated<float>(function_approximators);
+  else
+    updateTemplated<double>(function_approximators);
+  return true;
+}
+
+template <typename Scalar>
+void PackedForcingTerm::updateTemplated(
+    const std::vector<std::shared_ptr<FunctionApproximator> >&
+        function_approximators)
+{
+  ENTERING_REAL_TIME_CRITICAL_CODE
+
+  // The padding at the end of each block is zero, so that it does not
+  // contribute to the outputs.
+  Scalar* arena = reinterpret_cast<Scalar*>(arena_);
+  memset(arena_, 0, n_scalars_ * scalar_size_);
+  for (int i_dim = 0; i_dim < n_dims_; i_dim++) {
+    const FunctionApproximatorRBFN* rbfn =
+        getRBFN(function_approximators[i_dim].get());
+    Scalar* centers;
+    Scalar* scales;
+    Scalar* weights;
+    if (shared_basis_functions_) {
+      centers = arena + offset_centers_;
+      scales = arena + offset_scales_;
+      weights = arena + offset_weights_ + i_dim * stride_;
+    } else {
+      Scalar* block = arena + 3 * stride_ * i_dim;
+      centers = block + offset_centers_;
+      scales = block + offset_scales_;
+      weights = block + offset_weights_;
+    }
+    for (int bb = 0; bb < n_basis_functions_; bb++) {
+      double w = rbfn->widths()(bb, 0);
+      centers[bb] = (Scalar)rbfn->centers()(bb, 0);
+      scales[bb] = (Scalar)(-0.5 / (w * w));
+      weights[bb] = (Scalar)rbfn->weights()(bb);
+    }
+  }
+
+  EXITING_REAL_TIME_CRITICAL_CODE
+}
+
+PackedForcingTerm::PackedForcingTerm(int n_dims, int n_basis_functions,
+                                     bool shared_basis_functions,
+                                     int scalar_size)
+    : n_dims_(n_dims),
+      n_basis_functions_(n_basis_functions),
+      shared_basis_functions_(shared_basis_functions),
+      scalar_size_(scalar_size)
+{
+  // Blocks in the order in which they are accessed in predictRealTime(). Each
+  // block starts at a new cache line.
+  stride_ = roundUpToCacheLine(n_basis_functions, scalar_size_);
+  if (shared_basis_functions_) {
+    // centers | scales | weights dim 0 | ... | weights dim D-1
+    offset_centers_ = 0;
+    offset_scales_ = stride_;
+    offset_weights_ = 2 * stride_;
+    n_scalars_ = offset_weights_ + n_dims_ * stride_;
+  } else {
+    // centers dim 0 | scales dim 0 | weights dim 0 | centers dim 1 | ...
+    offset_centers_ = 0;
+    offset_scales_ = stride_;
+    offset_weights_ = 2 * stride_;
+    n_scalars_ = 3 * n_dims_ * stride_;
+  }
+  allocate();
+}
+
+PackedForcingTerm::PackedForcingTerm(const PackedForcingTerm& other)
+    : n_dims_(other.n_dims_),
+      n_basis_functions_(other.n_basis_functions_),
+      shared_basis_functions_(other.shared_basis_functions_),
+      stride_(other.stride_),
+      scalar_size_(other.scalar_size_),
+      offset_centers_(other.offset_centers_),
+      offset_scales_(other.offset_scales_),
+      offset_weights_(other.offset_weights_),
+      n_scalars_(other.n_scalars_)
+{
+  allocate();
+  memcpy(arena_, other.arena_, n_scalars_ * scalar_size_);
+}
+
+PackedForcingTerm::~PackedForcingTerm(void) { delete[] memory_; }
+
+void PackedForcingTerm::allocate(void)
+{
+  // Allocate one more cache line than needed, so that the start of the arena
+  // can be aligned.
+  memory_ = new char[n_scalars_ * scalar_size_ + kCacheLineSize];
+  uintptr_t address = reinterpret_cast<uintptr_t>(memory_);
+  uintptr_t misalignment = address % kCacheLineSize;
+  arena_ = memory_;
+  if (misalignment > 0) arena_ += kCacheLineSize - misalignment;
+}
+
+void PackedForcingTerm::predictRealTime(
+    double phase,
+    Eigen::Ref<Eigen::RowVectorXd, 0, Eigen::InnerStride<> > outputs) const
+{
+  if (scalar_size_ == sizeof(float))
+    predictTemplated<float>(phase, outputs);
+  else
+    predictTemplated<double>(phase, outputs);
+}
+
+template <typename Scalar>
+void PackedForcingTerm::predictTemplated(
+    double phase,
+    Eigen::Ref<Eigen::RowVectorXd, 0, Eigen::InnerStride<> > outputs) const
+{
+  typedef Array<Scalar, Dynamic, 1> ArrayXs;
+  typedef Matrix<Scalar, Dynamic, 1> VectorXs;
+
+  ENTERING_REAL_TIME_CRITICAL_CODE
+
+  assert(outputs.size() == n_dims_);
+  const Scalar* arena = reinterpret_cast<const Scalar*>(arena_);
+  Scalar p = (Scalar)phase;
+
+  // Activations of kChunkSize basis functions, on the stack so that this
+  // function does not change the object.
+  alignas(kCacheLineSize) Scalar chunk[kChunkSize];
+
+  // Activations far from the centers underflow to denormal numbers, which are
+  // very slow to compute with, especially for floats. Activations smaller than
+  // epsilon^2 do not contribute to the outputs at this precision anyway.
+  const Scalar min_exponent = 2 * std::log(NumTraits<Scalar>::epsilon());
+
+  // The padding is zero, so all of the stride can be processed. Because both
+  // the stride and kChunkSize are multiples of a cache line, so is the size of
+  // each chunk.
+  outputs.setZero();
+  int n_blocks = (shared_basis_functions_ ? 1 : n_dims_);
+  for (int i_block = 0; i_block < n_blocks; i_block++) {
+    const Scalar* block =
+        (shared_basis_functions_ ? arena : arena + 3 * stride_ * i_block);
+    for (int b0 = 0; b0 < stride_; b0 += kChunkSize) {
+      int n = std::min(kChunkSize, stride_ - b0);
+      Map<ArrayXs, Aligned64> activations(chunk, n);
+      Map<const ArrayXs, Aligned64> centers(block + offset_centers_ + b0, n);
+      Map<const ArrayXs, Aligned64> scales(block + offset_scales_ + b0, n);
+      activations = (scales * (p - centers).square()).max(min_exponent).exp();
+      if (shared_basis_functions_) {
+        for (int i_dim = 0; i_dim < n_dims_; i_dim++) {
+          Map<const VectorXs, Aligned64> weights(
+              block + offset_weights_ + i_dim * stride_ + b0, n);
+          outputs[i_dim] += weights.dot(activations.matrix());
+        }
+      } else {
+        Map<const VectorXs, Aligned64> weights(block + offset_weights_ + b0, n);
+        outputs[i_block] += weights.dot(activations.matrix());
+      }
+    }
+  }
+
+  EXITING_REAL_TIME_CRITICAL_CODE
+}
+
+}  // namespace DmpBbo
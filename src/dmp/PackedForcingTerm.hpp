@@ -0,0 +1,207 @@
+/**
+ * @file PackedForcingTerm.hpp
+ * @brief  PackedForcingTerm class header file.
+ *
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _PACKED_FORCING_TERM_H_
+#define _PACKED_FORCING_TERM_H_
+
+#define EIGEN_RUNTIME_NO_MALLOC  // Enable runtime tests for allocations
+
+#include <eigen3/Eigen/Core>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace DmpBbo {
+
+// forward declaration
+class FunctionApproximator;
+
+/** \brief The function approximators of the forcing term of a Dmp, packed into
+ * one contiguous block of memory.
+ *
+ * In a Dmp, each dimension has its own function approximator, each of which
+ * stores its parameters and preallocated memory in several separately
+ * allocated Eigen matrices. This class copies the parameters of all function
+ * approximators into one 64-byte aligned block of memory, in the order in which
+ * they are accessed when computing the forcing term. Intermediate results are
+ * stored on the stack, so predictRealTime() does not change the object, and
+ * several Dmps may share one PackedForcingTerm (cf. Dmp::clone()), also if they
+ * are integrated in different threads.
+ *
+ * If all function approximators have the same basis functions, their
+ * activations are computed only once, and the outputs for all dimensions are
+ * computed with one matrix-vector product.
+ *
+ * The parameters may be stored in single precision ("FLOAT32"). This halves
+ * the memory that is required, and doubles the number of basis functions that
+ * are processed per SIMD instruction. The state of the Dmp is still integrated
+ * in double precision; only the outputs of the forcing term are computed with
+ * floats.
+ *
+ * Currently, only RBFNs with a one-dimensional input (the phase) and the same
+ * number of basis functions for each dimension are supported.
+ */
+class PackedForcingTerm {
+ public:
+  /** Pack the parameters of function approximators.
+   * \param[in] function_approximators One function approximator per dimension
+   * \param[in] scalar_type Precision with which the parameters are stored and
+   * the outputs are computed: "FLOAT64" (double) or "FLOAT32" (float)
+   * \return The packed function approximators, or NULL if they or the scalar
+   * type are not supported. The caller is responsible for deleting it.
+   */
+  static PackedForcingTerm* create(
+      const std::vector<std::shared_ptr<FunctionApproximator> >&
+          function_approximators,
+      std::string scalar_type = "FLOAT64");
+
+  /** Determine whether function approximators have the same structure
+   * (number of dimensions and basis functions, shared basis functions or not)
+   * as the packed ones, i.e. whether update() would succeed.
+   * This function is real-time, i.e. it does not allocate memory.
+   *
+   * \param[in] function_approximators One function approximator per dimension
+   * \param[in] i_dim Dimension whose function approximator is replaced by fa,
+   * or -1 (default) if none is replaced
+   * \param[in] fa The function approximator that replaces the one of i_dim
+   * \return true if the function approximators fit into the packed memory
+   */
+  bool fits(const std::vector<std::shared_ptr<FunctionApproximator> >&
+                function_approximators,
+            int i_dim = -1, const FunctionApproximator* fa = NULL) const;
+
+  /** Copy the parameters of function approximators into the packed memory.
+   * This function is real-time, i.e. it does not allocate memory.
+   *
+   * \param[in] function_approximators One function approximator per dimension
+   * \return false if the function approximators do not have the same
+   * structure as the packed ones (cf. fits()). Nothing is copied in that
+   * case.
+   */
+  bool update(const std::vector<std::shared_ptr<FunctionApproximator> >&
+                  function_approximators);
+
+  /** Copy constructor.
+   * \param[in] other Object to copy
+   */
+  PackedForcingTerm(const PackedForcingTerm& other);
+
+  /** Destructor. */
+  ~PackedForcingTerm(void);
+
+  /** Compute the outputs of the function approximators for one phase.
+   * This function is real-time, i.e. it does not allocate memory. It may be
+   * called from several threads at the same time.
+   *
+   * \param[in]  phase   The phase
+   * \param[out] outputs Output for each dimension (size n_dims)
+   */
+  void predictRealTime(
+      double phase,
+      Eigen::Ref<Eigen::RowVectorXd, 0, Eigen::InnerStride<> > outputs) const;
+
+  /** Get the size of the packed memory.
+   * \return Size in bytes
+   */
+  inline int n_bytes(void) const { return n_scalars_ * scalar_size_; }
+
+  /** Get the precision with which the parameters are stored.
+   * \return "FLOAT64" or "FLOAT32"
+   */
+  inline std::string scalar_type(void) const
+  {
+    return scalar_size_ == sizeof(float) ? "FLOAT32" : "FLOAT64";
+  }
+
+  /** Whether all dimensions have the same basis functions.
+   * \return true if all dimensions have the same basis functions
+   */
+  inline bool shared_basis_functions(void) const
+  {
+    return shared_basis_functions_;
+  }
+
+ private:
+  /** Constructor, which computes the layout but does not fill in the values.
+   * \param[in] n_dims Number of dimensions
+   * \param[in] n_basis_functions Number of basis functions per dimension
+   * \param[in] shared_basis_functions Whether all dimensions have the same
+   * basis functions
+   * \param[in] scalar_size Size of the scalars in bytes (8 or 4)
+   */
+  PackedForcingTerm(int n_dims, int n_basis_functions,
+                    bool shared_basis_functions, int scalar_size);
+
+  /** Not implemented. */
+  PackedForcingTerm& operator=(const PackedForcingTerm& other);
+
+  /** Allocate memory_, and align arena_. */
+  void allocate(void);
+
+  /** Implementation of update() for one scalar type.
+   * \param[in] function_approximators One function approximator per dimension
+   */
+  template <typename Scalar>
+  void updateTemplated(
+      const std::vector<std::shared_ptr<FunctionApproximator> >&
+          function_approximators);
+
+  /** Implementation of predictRealTime() for one scalar type.
+   * \param[in]  phase   The phase
+   * \param[out] outputs Output for each dimension (size n_dims)
+   */
+  template <typename Scalar>
+  void predictTemplated(
+      double phase,
+      Eigen::Ref<Eigen::RowVectorXd, 0, Eigen::InnerStride<> > outputs) const;
+
+  /** Number of output dimensions. */
+  int n_dims_;
+
+  /** Number of basis functions per dimension. */
+  int n_basis_functions_;
+
+  /** Whether all dimensions have the same basis functions. */
+  bool shared_basis_functions_;
+
+  /** Number of basis functions, rounded up to fill complete cache lines. */
+  int stride_;
+
+  /** Size of the scalars in the arena in bytes (8 for double, 4 for float) */
+  int scalar_size_;
+
+  /** Offsets (in scalars) of the blocks in arena_ */
+  int offset_centers_, offset_scales_, offset_weights_;
+
+  /** Size of the arena (in scalars). */
+  int n_scalars_;
+
+  /** Allocated memory, which is larger than the arena for alignment. */
+  char* memory_;
+
+  /** Start of the packed memory, aligned to 64 bytes. */
+  char* arena_;
+};
+
+}  // namespace DmpBbo
+
+#endif  // _PACKED_FORCING_TERM_H_
@@ -23,6 +23,8 @@
 
 #include "dynamicalsystems/DynamicalSystem.hpp"
 
+#include <algorithm>
+#include <cmath>
 #include <eigen3/Eigen/Core>
 #include <nlohmann/json.hpp>
 
@@ -65,6 +67,12 @@ void DynamicalSystem::preallocateMemory()
   input_k2_ = VectorXd(dim_x_);
   input_k3_ = VectorXd(dim_x_);
   input_k4_ = VectorXd(dim_x_);
+
+  // Pre-allocate memory for dense output
+  dense_x_prev_ = VectorXd(dim_x_);
+  dense_x_next_ = VectorXd(dim_x_);
+  dense_xd_next_ = VectorXd(dim_x_);
+  dense_dt_ = 0.0;
 }
 
 DynamicalSystem::~DynamicalSystem(void) {}
@@ -93,6 +101,50 @@ void DynamicalSystem::set_y_init(
   }
 }
 
+void DynamicalSystem::analyticalSolution(const Eigen::VectorXd& ts,
+                                         Eigen::MatrixXd& xs,
+                                         Eigen::MatrixXd& xds) const
+{
+  // Usually, we expect xs and xds to be of size n_time_steps X dim(). However,
+  // if the input matrices were of size dim() X n_time_steps, we return the
+  // matrices of that size. That way, the user can also request dim() X
+  // n_time_steps sized matrices.
+  bool caller_expects_transposed =
+      (xs.rows() == dim() && xs.cols() == ts.size());
+  analyticalSolution(
+      ts, xs, xds,
+      caller_expects_transposed ? TIME_STEPS_IN_COLUMNS : TIME_STEPS_IN_ROWS);
+}
+
+void DynamicalSystem::analyticalSolution(const Eigen::VectorXd& ts,
+                                         Eigen::MatrixXd& xs,
+                                         Eigen::MatrixXd& xds,
+                                         StateLayout layout) const
+{
+  // Prepare output arguments to be of right size (Eigen does nothing if already
+  // the right size)
+  if (layout == TIME_STEPS_IN_COLUMNS) {
+    xs.resize(dim(), ts.size());
+    xds.resize(dim(), ts.size());
+  } else {
+    xs.resize(ts.size(), dim());
+    xds.resize(ts.size(), dim());
+  }
+  analyticalSolution(ts, stridedMap(xs, layout), stridedMap(xds, layout));
+}
+
+StridedMatrixMap DynamicalSystem::stridedMap(Eigen::MatrixXd& matrix,
+                                             StateLayout layout)
+{
+  typedef Stride<Dynamic, Dynamic> DynamicStride;
+  if (layout == TIME_STEPS_IN_COLUMNS)
+    // Element (t,d) of the view is element (d,t) of the matrix
+    return StridedMatrixMap(matrix.data(), matrix.cols(), matrix.rows(),
+                            DynamicStride(1, matrix.rows()));
+  return StridedMatrixMap(matrix.data(), matrix.rows(), matrix.cols(),
+                          DynamicStride(matrix.rows(), 1));
+}
+
 void DynamicalSystem::integrateStart(const Eigen::VectorXd& y_init,
                                      Eigen::Ref<Eigen::VectorXd> x,
                                      Eigen::Ref<Eigen::VectorXd> xd)
@@ -131,6 +183,10 @@ void DynamicalSystem::integrateStepRungeKutta(double dt,
 
   ENTERING_REAL_TIME_CRITICAL_CODE
 
+  // Store the state before the step for dense output (before computing
+  // x_updated, which may refer to the same memory as x)
+  dense_x_prev_ = x;
+
   // 4th order Runge-Kutta for a 1st order system
   // http://en.wikipedia.org/wiki/Runge-Kutta_method#The_Runge.E2.80.93Kutta_method
   differentialEquation(x, k1_);
@@ -144,9 +200,70 @@ void DynamicalSystem::integrateStepRungeKutta(double dt,
   x_updated = x + dt * (k1_ + 2.0 * (k2_ + k3_) + k4_) / 6.0;
   differentialEquation(x_updated, xd_updated);
 
+  dense_x_next_ = x_updated;
+  dense_xd_next_ = xd_updated;
+  dense_dt_ = dt;
+
   EXITING_REAL_TIME_CRITICAL_CODE
 }
 
+void DynamicalSystem::interpolateStep(double t_since_step, Ref<VectorXd> x,
+                                      Ref<VectorXd> xd) const
+{
+  assert(dense_dt_ > 0.0);  // integrateStepRungeKutta must have been called
+  assert(t_since_step >= 0.0 && t_since_step <= dense_dt_);
+  assert(x.size() == dim_x_);
+  assert(xd.size() == dim_x_);
+
+  ENTERING_REAL_TIME_CRITICAL_CODE
+
+  // Cubic Hermite interpolation, see
+  // https://en.wikipedia.org/wiki/Cubic_Hermite_spline
+  // k1_ contains the rate of change at the start of the step.
+  double h = dense_dt_;
+  double s = t_since_step / h;
+  double s2 = s * s;
+  double s3 = s2 * s;
+
+  double h00 = 2.0 * s3 - 3.0 * s2 + 1.0;
+  double h10 = s3 - 2.0 * s2 + s;
+  double h01 = -2.0 * s3 + 3.0 * s2;
+  double h11 = s3 - s2;
+  x = h00 * dense_x_prev_ + (h10 * h) * k1_ + h01 * dense_x_next_ +
+      (h11 * h) * dense_xd_next_;
+
+  // Derivatives of the basis functions w.r.t. time
+  double dh00 = (6.0 * s2 - 6.0 * s) / h;
+  double dh10 = 3.0 * s2 - 4.0 * s + 1.0;
+  double dh01 = (-6.0 * s2 + 6.0 * s) / h;
+  double dh11 = 3.0 * s2 - 2.0 * s;
+  xd = dh00 * dense_x_prev_ + dh10 * k1_ + dh01 * dense_x_next_ +
+       dh11 * dense_xd_next_;
+
+  EXITING_REAL_TIME_CRITICAL_CODE
+}
+
+double DynamicalSystem::interpolateStepErrorEstimate(void) const
+{
+  assert(dense_dt_ > 0.0);  // integrateStepRungeKutta must have been called
+  double h = dense_dt_;
+  double max_error = 0.0;
+  for (int i_dim = 0; i_dim < dim_x_; i_dim++) {
+    // Cubic Hermite interpolant at s = 0.5
+    double x_hermite =
+        0.5 * (dense_x_prev_[i_dim] + dense_x_next_[i_dim]) +
+        0.125 * h * (k1_[i_dim] - dense_xd_next_[i_dim]);
+    // Continuous extension of 4th order Runge-Kutta at s = 0.5, i.e.
+    // b1 = 5/24, b2 = b3 = 1/6, b4 = -1/24
+    double x_rk = dense_x_prev_[i_dim] +
+                  h * (5.0 * k1_[i_dim] + 4.0 * (k2_[i_dim] + k3_[i_dim]) -
+                       k4_[i_dim]) /
+                      24.0;
+    max_error = std::max(max_error, std::abs(x_hermite - x_rk));
+  }
+  return max_error;
+}
+
 void from_json(const nlohmann::json& j, DynamicalSystem*& obj)
 {
   string class_name = j.at("class").get<string>();
@@ -176,6 +293,7 @@ void DynamicalSystem::to_json_base(nlohmann::json& j) const
   j["_dim_y"] = dim_y_;
   j["_tau"] = tau_;
   j["_y_init"] = x_init_.segment(0, dim_y_);
+  j["_x_init"] = x_init_;
   j["class"] = "DynamicalSystem";
 }
 
@@ -34,6 +34,16 @@ namespace DmpBbo {
 /** \defgroup DynamicalSystems Dynamical Systems Module
  */
 
+/**
+ * Matrix with arbitrary strides, to which analyticalSolution() writes its
+ * output. With the strides, it may for instance refer to a T x D matrix of
+ * which the rows are contiguous (as in a row-major array), to a block of a
+ * larger matrix, or to memory owned by the caller, such as a numpy array.
+ */
+typedef Eigen::Map<Eigen::MatrixXd, 0,
+                   Eigen::Stride<Eigen::Dynamic, Eigen::Dynamic> >
+    StridedMatrixMap;
+
 /** \brief Interface for implementing dynamical systems. Other dynamical systems
  * should inherit from this class.
  *
@@ -86,6 +96,11 @@ class DynamicalSystem {
   /** Destructor */
   virtual ~DynamicalSystem(void);
 
+  /** Create a copy of this dynamical system.
+   * \return The copy. The caller is responsible for deleting it.
+   */
+  virtual DynamicalSystem* clone(void) const = 0;
+
   /** @} */
 
   /** @name Main DynamicalSystem functions
@@ -106,6 +121,15 @@ class DynamicalSystem {
   virtual void differentialEquation(const Eigen::Ref<const Eigen::VectorXd>& x,
                                     Eigen::Ref<Eigen::VectorXd> xd) const = 0;
 
+  /** Layout of the output of analyticalSolution(). */
+  enum StateLayout {
+    /** T x D matrix, i.e. the values of one state variable are contiguous. */
+    TIME_STEPS_IN_ROWS,
+    /** D x T matrix, i.e. the state at one time step is contiguous (as in a
+       row-major T x D array). */
+    TIME_STEPS_IN_COLUMNS
+  };
+
   /**
    * Return analytical solution of the system at certain times.
    *
@@ -121,11 +145,52 @@ class DynamicalSystem {
    * \remarks The output xs and xds will be of size D x T \em only if the matrix
    * x you pass as an argument of size D x T. In all other cases (i.e. including
    * passing an empty matrix) the size of x will be T x D. This feature has been
-   * added so that you may pass matrices of either size.
+   * added so that you may pass matrices of either size. Use the overload with
+   * a StateLayout to choose the layout explicitly.
    */
   virtual void analyticalSolution(const Eigen::VectorXd& ts,
                                   Eigen::MatrixXd& xs,
-                                  Eigen::MatrixXd& xds) const = 0;
+                                  Eigen::MatrixXd& xds) const;
+
+  /**
+   * Return analytical solution of the system at certain times, with an
+   * explicit layout.
+   *
+   * \param[in]  ts  A vector of times for which to compute the analytical
+   * solutions
+   * \param[out] xs  Sequence of state vectors (T x D or D x T, depending on
+   * the layout)
+   * \param[out] xds Sequence of state vectors (rates of change)
+   * \param[in]  layout Layout of xs and xds
+   *
+   * \remarks The solution is written directly in the requested layout, i.e.
+   * D x T matrices are not transposed afterwards.
+   */
+  void analyticalSolution(const Eigen::VectorXd& ts, Eigen::MatrixXd& xs,
+                          Eigen::MatrixXd& xds, StateLayout layout) const;
+
+  /**
+   * Write the analytical solution of the system at certain times to memory
+   * provided by the caller.
+   *
+   * \param[in]  ts  A vector of times for which to compute the analytical
+   * solutions
+   * \param[out] xs  Sequence of state vectors. T x D view with arbitrary
+   * strides, cf. stridedMap().
+   * \param[out] xds Sequence of state vectors (rates of change), T x D view
+   */
+  virtual void analyticalSolution(const Eigen::VectorXd& ts,
+                                  StridedMatrixMap xs,
+                                  StridedMatrixMap xds) const = 0;
+
+  /**
+   * Get a T x D view on a matrix that has a certain layout.
+   * \param[in] matrix The matrix, of size T x D or D x T
+   * \param[in] layout The layout of the matrix
+   * \return View on the matrix of size T x D
+   */
+  static StridedMatrixMap stridedMap(Eigen::MatrixXd& matrix,
+                                     StateLayout layout);
 
   /** Start integrating the system with a new initial state
    *
@@ -207,6 +272,39 @@ class DynamicalSystem {
                                const Eigen::Ref<const Eigen::VectorXd> x,
                                Eigen::Ref<Eigen::VectorXd> x_updated,
                                Eigen::Ref<Eigen::VectorXd> xd_updated) const;
+
+  /**
+   * Interpolate the state within the last step of integrateStepRungeKutta()
+   * (dense output).
+   *
+   * Uses cubic Hermite interpolation between the states at the start and end
+   * of the step, and the rates of change at these states, which were already
+   * computed during the Runge-Kutta step. This makes it possible to integrate
+   * with a large dt, and to output states at a higher rate.
+   *
+   * \param[in]  t_since_step Time since the start of the last step (between 0
+   * and dt)
+   * \param[out] x  Interpolated state
+   * \param[out] xd Interpolated rates of change of state
+   *
+   * \remarks If x and xd are of the correct size (i.e. dim_x), then this
+   * function will not allocate memory. The rates of change are the derivative
+   * of the interpolating polynomial; differentialEquation() is not called.
+   */
+  void interpolateStep(double t_since_step, Eigen::Ref<Eigen::VectorXd> x,
+                       Eigen::Ref<Eigen::VectorXd> xd) const;
+
+  /**
+   * Estimate the error of interpolateStep() for the last step.
+   *
+   * The estimate is the largest difference (over all state variables) at the
+   * middle of the step between the cubic Hermite interpolant and the
+   * continuous extension of the Runge-Kutta method, which uses the four stage
+   * derivatives. It does not allocate memory.
+   *
+   * \return Estimate of the interpolation error (in state units)
+   */
+  double interpolateStepErrorEstimate(void) const;
   /** @} */
 
   /** @name Input/Output
@@ -264,7 +362,7 @@ class DynamicalSystem {
    * Get the initial state of the dynamical system.
    * \return Initial state of the dynamical system.
    */
-  inline Eigen::VectorXd x_init(void) const { return x_init_; }
+  inline const Eigen::VectorXd& x_init(void) const { return x_init_; }
 
   /**
    * Get the initial state of the dynamical system.
@@ -364,6 +462,11 @@ class DynamicalSystem {
 
   /** Members for caching in Runge-Kutta integration. */
   mutable Eigen::VectorXd k1_, k2_, k3_, k4_, input_k2_, input_k3_, input_k4_;
+
+  /** Members for caching the last Runge-Kutta step, for dense output. */
+  mutable Eigen::VectorXd dense_x_prev_, dense_x_next_, dense_xd_next_;
+  /** Duration of the last Runge-Kutta step (0 if there was none). */
+  mutable double dense_dt_;
 };
 
 }  // namespace DmpBbo
@@ -51,23 +51,12 @@ void ExponentialSystem::differentialEquation(
   EXITING_REAL_TIME_CRITICAL_CODE
 }
 
-void ExponentialSystem::analyticalSolution(const VectorXd& ts, MatrixXd& xs,
-                                           MatrixXd& xds) const
+void ExponentialSystem::analyticalSolution(const VectorXd& ts,
+                                           StridedMatrixMap xs,
+                                           StridedMatrixMap xds) const
 {
-  int n_time_steps = ts.size();
-
-  // Usually, we expect xs and xds to be of size n_time_steps X dim(), so we
-  // resize to that. However, if the input matrices were of size dim() X
-  // n_time_steps, we return the matrices of that size by doing a
-  // transposeInPlace at the end. That way, the user can also request dim() X
-  // n_time_steps sized matrices.
-  bool caller_expects_transposed =
-      (xs.rows() == dim() && xs.cols() == n_time_steps);
-
-  // Prepare output arguments to be of right size (Eigen does nothing if already
-  // the right size)
-  xs.resize(n_time_steps, dim());
-  xds.resize(n_time_steps, dim());
+  assert(xs.rows() == ts.size() && xs.cols() == dim());
+  assert(xds.rows() == ts.size() && xds.cols() == dim());
 
   VectorXd val_range = x_init() - x_attr_;
 
@@ -76,15 +65,11 @@ void ExponentialSystem::analyticalSolution(const VectorXd& ts, MatrixXd& xs,
   VectorXd pos_scale = exp_term;
   VectorXd vel_scale = -(alpha_ / tau()) * exp_term;
 
-  xs = val_range.transpose().replicate(n_time_steps, 1).array() *
-       pos_scale.replicate(1, dim()).array();
-  xs += x_attr_.transpose().replicate(n_time_steps, 1);
-  xds = val_range.transpose().replicate(n_time_steps, 1).array() *
-        vel_scale.replicate(1, dim()).array();
-
-  if (caller_expects_transposed) {
-    xs.transposeInPlace();
-    xds.transposeInPlace();
+  // Write each column directly, rather than replicating vectors to T x D
+  // matrices first.
+  for (int i_dim = 0; i_dim < dim(); i_dim++) {
+    xs.col(i_dim) = (val_range[i_dim] * pos_scale).array() + x_attr_[i_dim];
+    xds.col(i_dim) = val_range[i_dim] * vel_scale;
   }
 }
 
@@ -102,6 +87,7 @@ void ExponentialSystem::to_json_helper(nlohmann::json& j) const
 {
   to_json_base(j);  // Get the json string from the base class
   j["alpha"] = alpha_;
+  j["_x_attr"] = x_attr_;
   j["_y_attr"] = x_attr_;
   j["class"] = "ExponentialSystem";
 }
@@ -57,11 +57,15 @@ class ExponentialSystem : public DynamicalSystem {
   /** Destructor. */
   ~ExponentialSystem(void);
 
+  ExponentialSystem* clone(void) const { return new ExponentialSystem(*this); }
+
   void differentialEquation(const Eigen::Ref<const Eigen::VectorXd>& x,
                             Eigen::Ref<Eigen::VectorXd> xd) const;
 
-  void analyticalSolution(const Eigen::VectorXd& ts, Eigen::MatrixXd& xs,
-                          Eigen::MatrixXd& xds) const;
+  using DynamicalSystem::analyticalSolution;
+
+  void analyticalSolution(const Eigen::VectorXd& ts, StridedMatrixMap xs,
+                          StridedMatrixMap xds) const;
 
   /** Accessor function for decay constant.
    * \return Decay constant
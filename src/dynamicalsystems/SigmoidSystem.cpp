@@ -23,6 +23,7 @@
 
 #include "dynamicalsystems/SigmoidSystem.hpp"
 
+#include <cmath>
 #include <eigen3/Eigen/Core>
 #include <nlohmann/json.hpp>
 
@@ -41,7 +42,7 @@ SigmoidSystem::SigmoidSystem(double tau, const Eigen::VectorXd& x_init,
       inflection_ratio_(inflection_ratio)
 {
   double inflection_point_time = inflection_ratio_ * tau;
-  Ks_ = SigmoidSystem::computeKs(x_init, max_rate_, inflection_point_time);
+  SigmoidSystem::computeKs(x_init, max_rate_, inflection_point_time, Ks_);
 }
 
 SigmoidSystem::~SigmoidSystem(void) {}
@@ -51,7 +52,7 @@ void SigmoidSystem::set_tau(double new_tau)
   // Get previous tau from superclass with tau() and set it with set_tau()
   DynamicalSystem::set_tau(new_tau);
   double inflection_point_time = inflection_ratio_ * tau();
-  Ks_ = SigmoidSystem::computeKs(x_init(), max_rate_, inflection_point_time);
+  SigmoidSystem::computeKs(x_init(), max_rate_, inflection_point_time, Ks_);
 }
 
 void SigmoidSystem::set_x_init(const VectorXd& x_init)
@@ -59,12 +60,14 @@ void SigmoidSystem::set_x_init(const VectorXd& x_init)
   assert(x_init.size() == dim());
   DynamicalSystem::set_x_init(x_init);
   double inflection_point_time = inflection_ratio_ * tau();
-  Ks_ = SigmoidSystem::computeKs(x_init, max_rate_, inflection_point_time);
+  SigmoidSystem::computeKs(x_init, max_rate_, inflection_point_time, Ks_);
 }
 
-VectorXd SigmoidSystem::computeKs(const VectorXd& N_0s, double r,
-                                  double inflection_point_time_time)
+void SigmoidSystem::computeKs(const VectorXd& N_0s, double r,
+                              double inflection_point_time_time, VectorXd& Ks)
 {
+  // This function does not allocate memory if Ks already has the right size,
+  // so that set_tau() and set_x_init() may be called in real-time code.
   // The idea here is that the initial state (called N_0s above), max_rate (r
   // above) and the inflection_point_time are set by the user. The only
   // parameter that we have left to tune is the "carrying capacity" K.
@@ -80,7 +83,7 @@ VectorXd SigmoidSystem::computeKs(const VectorXd& N_0s, double r,
   //              (K/N_0 - 1)*exp(-r*t_infl) = 1
   //                             (K/N_0 - 1) = 1/exp(-r*t_infl)
   //                                       K = N_0*(1+(1/exp(-r*t_infl)))
-  VectorXd Ks = N_0s;
+  Ks.resize(N_0s.size());
   for (int dd = 0; dd < Ks.size(); dd++)
     Ks[dd] = N_0s[dd] * (1 + (1 / exp(-r * inflection_point_time_time)));
 
@@ -96,9 +99,11 @@ VectorXd SigmoidSystem::computeKs(const VectorXd& N_0s, double r,
   //   xd = 0;
   // And integration fails, especially for Euler integration.
   // So we now give a warning if this is likely to happen.
-  VectorXd div = N_0s.array() / Ks.array() - 1;
-  if ((div.array().abs() < 10e-9).any())  // 10e-9 determined empirically
-  {
+  bool too_close = false;
+  for (int dd = 0; dd < Ks.size(); dd++)
+    if (fabs(N_0s[dd] / Ks[dd] - 1) < 10e-9)  // 10e-9 determined empirically
+      too_close = true;
+  if (too_close) {
     cerr << endl << __FILE__ << ":" << __LINE__ << ":";
     cerr << "In function SigmoidSystem::computeKs(), Ks is too close to N_0s. "
             "This may lead to errors during numerical integration. Recommended "
@@ -106,8 +111,6 @@ VectorXd SigmoidSystem::computeKs(const VectorXd& N_0s, double r,
             "(currently it is "
          << r << ")" << endl;
   }
-
-  return Ks;
 }
 
 void SigmoidSystem::differentialEquation(
@@ -121,23 +124,13 @@ void SigmoidSystem::differentialEquation(
   EXITING_REAL_TIME_CRITICAL_CODE
 }
 
-void SigmoidSystem::analyticalSolution(const VectorXd& ts, MatrixXd& xs,
-                                       MatrixXd& xds) const
+void SigmoidSystem::analyticalSolution(const VectorXd& ts, StridedMatrixMap xs,
+                                       StridedMatrixMap xds) const
 {
   int n_time_steps = ts.size();
 
-  // Usually, we expect xs and xds to be of size n_time_steps X dim(), so we
-  // resize to that. However, if the input matrices were of size dim() X
-  // n_time_steps, we return the matrices of that size by doing a
-  // transposeInPlace at the end. That way, the user can also request dim() X
-  // n_time_steps sized matrices.
-  bool caller_expects_transposed =
-      (xs.rows() == dim() && xs.cols() == n_time_steps);
-
-  // Prepare output arguments to be of right size (Eigen does nothing if already
-  // the right size)
-  xs.resize(n_time_steps, dim());
-  xds.resize(n_time_steps, dim());
+  assert(xs.rows() == n_time_steps && xs.cols() == dim());
+  assert(xds.rows() == n_time_steps && xds.cols() == dim());
 
   // Auxillary variables to improve legibility
   double r = max_rate_;
@@ -155,11 +148,6 @@ void SigmoidSystem::analyticalSolution(const VectorXd& ts, MatrixXd& xs,
         K * r * b * ((1 + b * exp_rt.array()).square().inverse().array()) *
         exp_rt.array();
   }
-
-  if (caller_expects_transposed) {
-    xs.transposeInPlace();
-    xds.transposeInPlace();
-  }
 }
 
 void from_json(const nlohmann::json& j, SigmoidSystem*& obj)
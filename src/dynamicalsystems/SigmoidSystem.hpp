@@ -55,11 +55,15 @@ class SigmoidSystem : public DynamicalSystem {
   /** Destructor. */
   ~SigmoidSystem(void);
 
+  SigmoidSystem* clone(void) const { return new SigmoidSystem(*this); }
+
   void differentialEquation(const Eigen::Ref<const Eigen::VectorXd>& x,
                             Eigen::Ref<Eigen::VectorXd> xd) const;
 
-  void analyticalSolution(const Eigen::VectorXd& ts, Eigen::MatrixXd& xs,
-                          Eigen::MatrixXd& xds) const;
+  using DynamicalSystem::analyticalSolution;
+
+  void analyticalSolution(const Eigen::VectorXd& ts, StridedMatrixMap xs,
+                          StridedMatrixMap xds) const;
 
   void set_tau(double tau);
   void set_x_init(const Eigen::VectorXd& x_init);
@@ -95,8 +99,8 @@ class SigmoidSystem : public DynamicalSystem {
    */
   void to_json_helper(nlohmann::json& j) const;
 
-  static Eigen::VectorXd computeKs(const Eigen::VectorXd& N_0s, double r,
-                                   double inflection_point_time);
+  static void computeKs(const Eigen::VectorXd& N_0s, double r,
+                        double inflection_point_time, Eigen::VectorXd& Ks);
 
   double max_rate_;
   double inflection_ratio_;
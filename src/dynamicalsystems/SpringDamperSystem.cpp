@@ -23,6 +23,7 @@
 
 #include "dynamicalsystems/SpringDamperSystem.hpp"
 
+#include <cmath>
 #include <eigen3/Eigen/Core>
 #include <nlohmann/json.hpp>
 
@@ -90,23 +91,62 @@ void SpringDamperSystem::differentialEquation(
   EXITING_REAL_TIME_CRITICAL_CODE
 }
 
-void SpringDamperSystem::analyticalSolution(const VectorXd& ts, MatrixXd& xs,
-                                            MatrixXd& xds) const
+void SpringDamperSystem::discretizeExact(double dt, Matrix2d& Phi,
+                                         Matrix2d& Gamma0,
+                                         Matrix2d& Gamma1) const
 {
-  int n_time_steps = ts.size();
-
-  // Usually, we expect xs and xds to be of size n_time_steps X dim, so we
-  // resize to that. However, if the input matrices were of size dim() X
-  // n_time_steps, we return the matrices of that size by doing a
-  // transposeInPlace at the end. That way, the user can also request dim() X
-  // n_time_steps sized matrices.
-  bool caller_expects_transposed =
-      (xs.rows() == dim() && xs.cols() == n_time_steps);
+  // The system for one dimension is x' = A x + B u, with x = [y z], u = [g f]
+  //   A = [ 0      1/tau   ]   B = [ 0       0     ]
+  //       [ -k/mt  -c/mt   ]       [ k/mt    1/tau ]    (mt = m*tau)
+  double a = 1.0 / tau();
+  double b = spring_constant_ / (mass_ * tau());
+  double d = damping_coefficient_ / (mass_ * tau());
+  Matrix2d A;
+  A << 0.0, a, -b, -d;
+  Matrix2d B;
+  B << 0.0, 0.0, b, a;
+
+  // Closed-form matrix exponential of a 2x2 matrix (Cayley-Hamilton).
+  // Eigenvalues are mu +/- sqrt(disc), with mu = trace/2.
+  double mu = -0.5 * d;
+  double disc = mu * mu - a * b;
+  double q = disc * dt * dt;
+  double c0, c1;  // exp(A*dt) = exp(mu*dt) * (c0*I + c1*(A - mu*I))
+  if (std::abs(q) < 1e-8) {
+    // Repeated eigenvalues (e.g. critical damping); Taylor expansion
+    c0 = 1.0 + 0.5 * q;
+    c1 = dt * (1.0 + q / 6.0);
+  } else if (q > 0.0) {
+    // Real eigenvalues (over-damped)
+    double s = sqrt(disc);
+    c0 = cosh(s * dt);
+    c1 = sinh(s * dt) / s;
+  } else {
+    // Complex eigenvalues (under-damped)
+    double w = sqrt(-disc);
+    c0 = cos(w * dt);
+    c1 = sin(w * dt) / w;
+  }
+  Phi = exp(mu * dt) * (c0 * Matrix2d::Identity() +
+                        c1 * (A - mu * Matrix2d::Identity()));
+
+  // M = int_0^dt exp(A*r) dr = A^-1 (Phi - I). A is invertible because k > 0.
+  Matrix2d A_inv;
+  A_inv << -d, -a, b, 0.0;
+  A_inv /= a * b;
+  Matrix2d M = A_inv * (Phi - Matrix2d::Identity());
+  Gamma0 = M * B;
+
+  // Gamma1 = 1/dt int_0^dt exp(A*(dt-r)) r dr B = (M - A^-1 Phi + A^-1 M/dt) B
+  Gamma1 = (M - A_inv * Phi + A_inv * M / dt) * B;
+}
 
-  // Prepare output arguments to be of right size (Eigen does nothing if already
-  // the right size)
-  xs.resize(n_time_steps, dim());
-  xds.resize(n_time_steps, dim());
+void SpringDamperSystem::analyticalSolution(const VectorXd& ts,
+                                            StridedMatrixMap xs,
+                                            StridedMatrixMap xds) const
+{
+  assert(xs.rows() == ts.size() && xs.cols() == dim());
+  assert(xds.rows() == ts.size() && xds.cols() == dim());
 
   VectorXd x_ini = x_init();
 
@@ -154,11 +194,6 @@ void SpringDamperSystem::analyticalSolution(const VectorXd& ts, MatrixXd& xs,
     xs.col(Z) = xds.col(Y) * tau();
     xds.col(Z) = ydds * tau();
   }
-
-  if (caller_expects_transposed) {
-    xs.transposeInPlace();
-    xds.transposeInPlace();
-  }
 }
 
 void from_json(const nlohmann::json& j, SpringDamperSystem*& obj)
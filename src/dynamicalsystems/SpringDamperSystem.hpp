@@ -65,11 +65,41 @@ class SpringDamperSystem : public DynamicalSystem {
   /** Destructor. */
   ~SpringDamperSystem(void);
 
+  SpringDamperSystem* clone(void) const
+  {
+    return new SpringDamperSystem(*this);
+  }
+
   void differentialEquation(const Eigen::Ref<const Eigen::VectorXd>& x,
                             Eigen::Ref<Eigen::VectorXd> xd) const;
 
-  void analyticalSolution(const Eigen::VectorXd& ts, Eigen::MatrixXd& xs,
-                          Eigen::MatrixXd& xds) const;
+  using DynamicalSystem::analyticalSolution;
+
+  void analyticalSolution(const Eigen::VectorXd& ts, StridedMatrixMap xs,
+                          StridedMatrixMap xds) const;
+
+  /**
+   * Exact discretization of the system, for inputs that are held constant or
+   * interpolated linearly during a time step.
+   *
+   * For each dimension, the state [y z] after a time step dt is
+   * [y z]' = Phi * [y z] + Gamma0 * u + Gamma1 * (u' - u), where u = [g f] are
+   * the inputs at the start of the step and u' those at the end. g is the
+   * attractor state and f an external force added to the rate of change of z
+   * (as zd += f/tau). With a zero-order hold on the inputs, the last term is
+   * dropped. With a first-order hold (inputs linear during the step), it is
+   * included. Because the system is linear, there is no integration error for
+   * the spring-damper itself, for any dt. The matrices are the same for all
+   * dimensions.
+   *
+   * \param[in]  dt     Duration of the time step
+   * \param[out] Phi    State transition matrix, i.e. exp(A*dt)
+   * \param[out] Gamma0 Input matrix for the zero-order hold,
+   * i.e. A^-1 (Phi - I) B
+   * \param[out] Gamma1 Input matrix for the first-order hold
+   */
+  void discretizeExact(double dt, Eigen::Matrix2d& Phi, Eigen::Matrix2d& Gamma0,
+                       Eigen::Matrix2d& Gamma1) const;
 
   /**
    * Accessor function for damping coefficient.
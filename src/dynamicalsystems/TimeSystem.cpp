@@ -66,23 +66,11 @@ void TimeSystem::differentialEquation(
   EXITING_REAL_TIME_CRITICAL_CODE
 }
 
-void TimeSystem::analyticalSolution(const VectorXd& ts, MatrixXd& xs,
-                                    MatrixXd& xds) const
+void TimeSystem::analyticalSolution(const VectorXd& ts, StridedMatrixMap xs,
+                                    StridedMatrixMap xds) const
 {
-  int n_time_steps = ts.size();
-
-  // Usually, we expect xs and xds to be of size n_time_steps X dim(), so we
-  // resize to that. However, if the input matrices were of size dim() X
-  // n_time_steps, we return the matrices of that size by doing a
-  // transposeInPlace at the end. That way, the user can also request dim() X
-  // n_time_steps sized matrices.
-  bool caller_expects_transposed =
-      (xs.rows() == dim() && xs.cols() == n_time_steps);
-
-  // Prepare output arguments to be of right size (Eigen does nothing if already
-  // the right size)
-  xs.resize(n_time_steps, dim());
-  xds.resize(n_time_steps, dim());
+  assert(xs.rows() == ts.size() && xs.cols() == dim());
+  assert(xds.rows() == ts.size() && xds.cols() == dim());
 
   // Find first index at which the time is larger than tau. Then velocities
   // should be set to zero.
@@ -108,11 +96,6 @@ void TimeSystem::analyticalSolution(const VectorXd& ts, MatrixXd& xs,
     xds.topRows(velocity_stop_index).fill(1.0 / tau());
     xds.bottomRows(xds.size() - velocity_stop_index).fill(0.0);
   }
-
-  if (caller_expects_transposed) {
-    xs.transposeInPlace();
-    xds.transposeInPlace();
-  }
 }
 
 void from_json(const nlohmann::json& j, TimeSystem*& obj)
@@ -56,11 +56,15 @@ class TimeSystem : public DynamicalSystem {
   /** Destructor. */
   ~TimeSystem(void);
 
+  TimeSystem* clone(void) const { return new TimeSystem(*this); }
+
   void differentialEquation(const Eigen::Ref<const Eigen::VectorXd>& x,
                             Eigen::Ref<Eigen::VectorXd> xd) const;
 
-  void analyticalSolution(const Eigen::VectorXd& ts, Eigen::MatrixXd& xs,
-                          Eigen::MatrixXd& xds) const;
+  using DynamicalSystem::analyticalSolution;
+
+  void analyticalSolution(const Eigen::VectorXd& ts, StridedMatrixMap xs,
+                          StridedMatrixMap xds) const;
 
   /** Accessor function for count_down.
    * \return Whether timer increases (false) or decreases (true)
@@ -23,6 +23,7 @@
 
 #include "BasisFunction.hpp"
 
+#include <cmath>
 #include <eigen3/Eigen/LU>
 #include <eigen3/Eigen/SVD>
 #include <iostream>
@@ -187,6 +188,98 @@ void Gaussian::activations(const Eigen::MatrixXd& centers,
   EXITING_REAL_TIME_CRITICAL_CODE
 }
 
+double Gaussian::activation(const Eigen::MatrixXd& centers,
+                           const Eigen::MatrixXd& widths,
+                           const Eigen::Ref<const Eigen::RowVectorXd>& input,
+                           int i_basis, bool asymmetric_kernels)
+{
+  // Same computation as in activations() above, for one sample
+  double activation = 1.0;
+  for (int i_dim = 0; i_dim < centers.cols(); i_dim++) {
+    double c = centers(i_basis, i_dim);
+    double x = input(i_dim);
+    double w = widths(i_basis, i_dim);
+    if (asymmetric_kernels && x < c && i_basis > 0)
+      w = widths(i_basis - 1, i_dim);
+    activation *= exp(-0.5 * pow(x - c, 2) / (w * w));
+  }
+  return activation;
+}
+
+bool Gaussian::getCentersAndWidths(
+    const Eigen::Ref<const Eigen::MatrixXd>& inputs,
+    const Eigen::VectorXi& n_bfs_per_dim_in, double intersection_height,
+    Eigen::MatrixXd& centers, Eigen::MatrixXd& widths)
+{
+  int n_dims = inputs.cols();
+  VectorXi n_bfs_per_dim = n_bfs_per_dim_in;
+  if (n_bfs_per_dim.size() == 1 && n_dims > 1)
+    n_bfs_per_dim = VectorXi::Constant(n_dims, n_bfs_per_dim[0]);
+  if (n_bfs_per_dim.size() != n_dims || n_bfs_per_dim.minCoeff() < 1) {
+    cerr << __FILE__ << ":" << __LINE__ << ":";
+    cerr << "n_bfs_per_dim should be of size " << n_dims << endl;
+    return false;
+  }
+
+  VectorXd min_vals = inputs.colwise().minCoeff();
+  VectorXd max_vals = inputs.colwise().maxCoeff();
+
+  vector<VectorXd> centers_per_dim(n_dims);
+  vector<VectorXd> widths_per_dim(n_dims);
+  for (int i_dim = 0; i_dim < n_dims; i_dim++) {
+    int n_bfs = n_bfs_per_dim[i_dim];
+
+    // Same values as numpy.linspace, which differs slightly from
+    // VectorXd::LinSpaced in the last digits.
+    VectorXd& cur_centers = centers_per_dim[i_dim];
+    cur_centers.resize(n_bfs);
+    if (n_bfs == 1) {
+      cur_centers[0] = min_vals[i_dim];
+    } else {
+      double step = (max_vals[i_dim] - min_vals[i_dim]) / (n_bfs - 1);
+      for (int i_bf = 0; i_bf < n_bfs - 1; i_bf++)
+        cur_centers[i_bf] = i_bf * step + min_vals[i_dim];
+      cur_centers[n_bfs - 1] = max_vals[i_dim];
+    }
+
+    // Determine the widths from the centers. Two neighbouring basis functions
+    // with the same width w intersect at x = 0.5(c0+c1), with the value
+    //   h = exp(-0.125((c1-c0)^2/w^2))
+    // which yields w = sqrt((c1-c0)^2/-8*ln(h))
+    VectorXd& cur_widths = widths_per_dim[i_dim];
+    cur_widths = VectorXd::Ones(n_bfs);
+    if (n_bfs > 1) {
+      for (int cc = 0; cc < n_bfs - 1; cc++) {
+        double diff = cur_centers[cc + 1] - cur_centers[cc];
+        cur_widths[cc] = sqrt((diff * diff) / (-8 * log(intersection_height)));
+      }
+      cur_widths[n_bfs - 1] = cur_widths[n_bfs - 2];
+    }
+  }
+
+  // Combine the centers and widths of all dimensions into a grid, in which the
+  // last dimension changes fastest.
+  int n_centers = n_bfs_per_dim.prod();
+  centers.resize(n_centers, n_dims);
+  widths.resize(n_centers, n_dims);
+  VectorXi digit = VectorXi::Zero(n_dims);
+  for (int i_center = 0; i_center < n_centers; i_center++) {
+    for (int i_dim = 0; i_dim < n_dims; i_dim++) {
+      centers(i_center, i_dim) = centers_per_dim[i_dim][digit[i_dim]];
+      widths(i_center, i_dim) = widths_per_dim[i_dim][digit[i_dim]];
+    }
+    // Increment last digit by one
+    digit[n_dims - 1]++;
+    for (int i_dim = n_dims - 1; i_dim > 0; i_dim--) {
+      if (digit[i_dim] >= n_bfs_per_dim[i_dim]) {
+        digit[i_dim] = 0;
+        digit[i_dim - 1]++;
+      }
+    }
+  }
+  return true;
+}
+
 void Cosine::activations(
     const std::vector<Eigen::MatrixXd>& angular_frequencies,
     const std::vector<Eigen::VectorXd>& phases,
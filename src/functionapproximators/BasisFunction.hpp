@@ -72,6 +72,39 @@ void activations(const Eigen::MatrixXd& mus, const Eigen::MatrixXd& sigmas,
                  Eigen::MatrixXd& kernel_activations,
                  bool normalized_basis_functions, bool asymmetric_kernels);
 
+/** Get the (unnormalized) activation of one basis function for one input.
+ * This function is real-time, and does not use any memory besides the stack.
+ * \param[in] mus The center of the basis function (size: n_basis_functions X
+ * n_dims)
+ * \param[in] sigmas The width of the basis function (size: n_basis_functions X
+ * n_dims)
+ * \param[in] input The input (size: 1 X n_dims)
+ * \param[in] i_basis Index of the basis function
+ * \param[in] asymmetric_kernels Whether to use asymmetric kernels or not, cf
+ * MetaParametersLWR::asymmetric_kernels()
+ * \return The activation, which is the same as that computed by activations()
+ * with normalized_basis_functions=false.
+ */
+double activation(const Eigen::MatrixXd& mus, const Eigen::MatrixXd& sigmas,
+                  const Eigen::Ref<const Eigen::RowVectorXd>& input,
+                  int i_basis, bool asymmetric_kernels);
+
+/** Get the centers and widths of basis functions that are spread evenly over
+ * the range of the input data, as get_centers_and_widths() in Python.
+ * \param[in] inputs The input data (size: n_samples X n_dims)
+ * \param[in] n_bfs_per_dim Number of basis functions per input dimension. If
+ * it has size 1, the same number is used for all dimensions.
+ * \param[in] intersection_height The relative value at which two neighbouring
+ * basis functions intersect
+ * \param[out] centers The centers (size: n_basis_functions X n_dims)
+ * \param[out] widths The widths (size: n_basis_functions X n_dims)
+ * \return false if the size of n_bfs_per_dim does not match the inputs
+ */
+bool getCentersAndWidths(const Eigen::Ref<const Eigen::MatrixXd>& inputs,
+                         const Eigen::VectorXi& n_bfs_per_dim,
+                         double intersection_height, Eigen::MatrixXd& centers,
+                         Eigen::MatrixXd& widths);
+
 }  // namespace Gaussian
 
 namespace Cosine {
@@ -29,6 +29,8 @@
 
 #include "functionapproximators/FunctionApproximatorLWR.hpp"
 #include "functionapproximators/FunctionApproximatorRBFN.hpp"
+#include "functionapproximators/FunctionApproximatorRBFNQuantized.hpp"
+#include "functionapproximators/FunctionApproximatorWLS.hpp"
 
 using namespace Eigen;
 using namespace std;
@@ -45,6 +47,12 @@ void from_json(const nlohmann::json& j, FunctionApproximator*& obj)
   } else if (class_name == "FunctionApproximatorLWR") {
     obj = j.get<FunctionApproximatorLWR*>();
 
+  } else if (class_name == "FunctionApproximatorRBFNQuantized") {
+    obj = j.get<FunctionApproximatorRBFNQuantized*>();
+
+  } else if (class_name == "FunctionApproximatorWLS") {
+    obj = j.get<FunctionApproximatorWLS*>();
+
   } else {
     cerr << __FILE__ << ":" << __LINE__ << ":";
     cerr << "Unknown FunctionApproximator: " << class_name << endl;
@@ -52,6 +60,54 @@ void from_json(const nlohmann::json& j, FunctionApproximator*& obj)
   }
 }
 
+FunctionApproximator* FunctionApproximator::train(
+    const nlohmann::json& meta_params,
+    const Eigen::Ref<const Eigen::MatrixXd>& inputs,
+    const Eigen::Ref<const Eigen::VectorXd>& targets, ThreadPool* thread_pool)
+{
+  string class_name = meta_params.at("class").get<string>();
+  nlohmann::json jm = nlohmann::json::object();
+  if (meta_params.contains("_meta_params")) jm = meta_params["_meta_params"];
+
+  double regularization = jm.value("regularization", 0.0);
+
+  if (class_name == "FunctionApproximatorWLS") {
+    bool use_offset = jm.value("use_offset", true);
+    return FunctionApproximatorWLS::train(inputs, targets, use_offset,
+                                          regularization);
+  }
+
+  if (class_name != "FunctionApproximatorRBFN" &&
+      class_name != "FunctionApproximatorLWR") {
+    cerr << __FILE__ << ":" << __LINE__ << ":";
+    cerr << "Cannot train FunctionApproximator: " << class_name << endl;
+    return NULL;
+  }
+
+  // Python stores the number of basis functions with np.atleast_1d, but also
+  // accept a plain number.
+  if (!jm.contains("n_basis_functions_per_dim")) {
+    cerr << __FILE__ << ":" << __LINE__ << ":";
+    cerr << "n_basis_functions_per_dim must be specified" << endl;
+    return NULL;
+  }
+  vector<int> n_bfs;
+  if (jm["n_basis_functions_per_dim"].is_array())
+    n_bfs = jm["n_basis_functions_per_dim"].get<vector<int> >();
+  else
+    n_bfs.push_back(jm["n_basis_functions_per_dim"].get<int>());
+  VectorXi n_bfs_per_dim = Map<VectorXi>(n_bfs.data(), n_bfs.size());
+
+  if (class_name == "FunctionApproximatorRBFN") {
+    double height = jm.value("intersection_height", 0.7);
+    return FunctionApproximatorRBFN::train(inputs, targets, n_bfs_per_dim,
+                                           height, regularization);
+  }
+  double height = jm.value("intersection_height", 0.5);
+  return FunctionApproximatorLWR::train(inputs, targets, n_bfs_per_dim, height,
+                                        regularization, thread_pool);
+}
+
 std::ostream& operator<<(std::ostream& output,
                          const FunctionApproximator& function_approximator)
 {
@@ -36,6 +36,9 @@
 
 namespace DmpBbo {
 
+// forward declaration
+class ThreadPool;
+
 /** \brief Pure abstract class for all function approximators.
  *  \ingroup FunctionApproximators
  */
@@ -46,6 +49,55 @@ class FunctionApproximator {
 
   virtual ~FunctionApproximator(void){};
 
+  /** Train a function approximator, given its class and meta-parameters.
+   *
+   * The meta-parameters have the same json format as an untrained function
+   * approximator in Python, e.g.
+   * \code
+   * {"class": "FunctionApproximatorLWR",
+   *  "_meta_params": {"n_basis_functions_per_dim": [9],
+   *                   "intersection_height": 0.5, "regularization": 0.0}}
+   * \endcode
+   * Meta-parameters that are not specified get the same default values as in
+   * Python. Supported are FunctionApproximatorRBFN, FunctionApproximatorLWR
+   * and FunctionApproximatorWLS.
+   *
+   *  \param[in] meta_params Class and meta-parameters of the function
+   * approximator
+   *  \param[in] inputs  Input values (n_samples X n_input_dims)
+   *  \param[in] targets Target values (n_samples)
+   *  \param[in] thread_pool Pool for parallel training (may be NULL)
+   *  \return The trained function approximator, or NULL if training failed.
+   * The caller is responsible for deleting it.
+   */
+  static FunctionApproximator* train(
+      const nlohmann::json& meta_params,
+      const Eigen::Ref<const Eigen::MatrixXd>& inputs,
+      const Eigen::Ref<const Eigen::VectorXd>& targets,
+      ThreadPool* thread_pool = NULL);
+
+  /** Create a copy of this function approximator.
+   * \return The copy. The caller is responsible for deleting it.
+   */
+  virtual FunctionApproximator* clone(void) const = 0;
+
+  /** Whether another function approximator is of the same type, and has
+   * model parameters of the same sizes, cf. copyParametersRealTime().
+   * \param[in] other The other function approximator
+   * \return true if the model parameters of other can be copied in real-time
+   */
+  virtual bool hasSameStructure(const FunctionApproximator& other) const
+  {
+    return false;
+  }
+
+  /** Copy the model parameters of another function approximator. This
+   * function is real-time, i.e. it does not allocate memory.
+   * \param[in] other The other function approximator, for which
+   * hasSameStructure() must be true.
+   */
+  virtual void copyParametersRealTime(const FunctionApproximator& other) {}
+
   /** Query the function approximator to make a prediction
    *  \param[in]  inputs   Input values of the query (n_samples X n_input_dims)
    *  \param[out] outputs  Predicted output values (n_samples X n_output_dims)
@@ -68,6 +120,49 @@ class FunctionApproximator {
       const Eigen::Ref<const Eigen::RowVectorXd>& input,
       Eigen::VectorXd& output) const = 0;
 
+  /** @name Linear parameterization
+   *  Many function approximators are linear in (some of) their model
+   * parameters, i.e. predict(inputs) = features(inputs) * parameters. This
+   * makes it possible to compute the outputs for many parameter vectors at
+   * once with one matrix multiplication.
+   *  @{
+   */
+
+  /** Get the number of parameters in which the function approximator is
+   * linear.
+   * \return Size of the linear parameter vector (0 if not supported)
+   */
+  virtual int getLinearParameterVectorSize(void) const { return 0; }
+
+  /** Get the parameters in which the function approximator is linear.
+   *  \param[out] values The parameter vector
+   */
+  virtual void getLinearParameterVector(Eigen::VectorXd& values) const
+  {
+    values.resize(0);
+  }
+
+  /** Set the parameters in which the function approximator is linear.
+   *  \param[in] values The parameter vector
+   */
+  virtual void setLinearParameterVector(
+      const Eigen::Ref<const Eigen::VectorXd>& values) {}
+
+  /** Get the features for which predict(inputs) = features *
+   * getLinearParameterVector()
+   *
+   *  \param[in]  inputs   Input values (n_samples X n_input_dims)
+   *  \param[out] features Features (n_samples X getLinearParameterVectorSize())
+   */
+  virtual void getLinearFeatures(
+      const Eigen::Ref<const Eigen::MatrixXd>& inputs,
+      Eigen::MatrixXd& features) const
+  {
+    features.resize(inputs.rows(), 0);
+  }
+
+  /** @} */
+
   /** Print to output stream.
    *
    *  \param[in] output  Output stream to which to write to
@@ -141,9 +236,19 @@ n_samples x n_input_dims matrix), and provides one prediction for each sample
 used in for instance Dmp::analyticalSolution().
 
 In version 1.* of dmpbbo, the training of function approximators was also
-possible in C++. To reduce duplicated code in version 2.*, all training is done
-in Python. The C++ code is only there to enable real-time prediction (i.e.
-without memory allocations).
+possible in C++. To reduce duplicated code in version 2.*, training is mainly
+done in Python, and the C++ code is mainly there to enable real-time prediction
+(i.e. without memory allocations).
+
+For applications that train many models, FunctionApproximatorRBFN::train(),
+FunctionApproximatorLWR::train() and FunctionApproximatorWLS::train() provide
+C++ implementations of the Python training algorithms, with the same
+meta-parameters. The resulting json files can be read by Python and C++ alike.
+
+The parameters of a trained RBFN or LWR can also be adapted online, e.g. on the
+robot, with RecursiveLeastSquares. Its updates are real-time, and the adapted
+parameters can be published to an executing Dmp with
+Dmp::copyFunctionApproximatorParametersRealTime().
 
  */
 
@@ -32,6 +32,7 @@
 #include "eigenutils/eigen_realtime_check.hpp"
 #include "functionapproximators/BasisFunction.hpp"
 #include "functionapproximators/FunctionApproximatorLWR.hpp"
+#include "functionapproximators/FunctionApproximatorWLS.hpp"
 
 using namespace std;
 using namespace Eigen;
@@ -48,7 +49,9 @@ FunctionApproximatorLWR::FunctionApproximatorLWR(const Eigen::MatrixXd& centers,
       widths_(widths),
       slopes_(slopes),
       offsets_(offsets),
-      asymmetric_kernels_(asymmetric_kernels)
+      asymmetric_kernels_(asymmetric_kernels),
+      intersection_height_(0.0),
+      regularization_(0.0)
 {
 #ifndef NDEBUG  // Variables below are only required for asserts; check for
                 // NDEBUG to avoid warnings.
@@ -60,31 +63,74 @@ FunctionApproximatorLWR::FunctionApproximatorLWR(const Eigen::MatrixXd& centers,
   assert(n_dims == slopes_.cols());
   assert(n_basis_functions_ == offsets_.rows());
   assert(1 == offsets_.cols());
-
-  lines_one_prealloc_ = MatrixXd(1, n_basis_functions_);
-  activations_one_prealloc_ = MatrixXd(1, n_basis_functions_);
 };
 
+FunctionApproximatorLWR* FunctionApproximatorLWR::train(
+    const Eigen::Ref<const Eigen::MatrixXd>& inputs,
+    const Eigen::Ref<const Eigen::VectorXd>& targets,
+    const Eigen::VectorXi& n_bfs_per_dim, double intersection_height,
+    double regularization, ThreadPool* thread_pool)
+{
+  // Determine the centers and widths of the basis functions, given the input
+  // data range
+  MatrixXd centers, widths;
+  if (!BasisFunction::Gaussian::getCentersAndWidths(
+          inputs, n_bfs_per_dim, intersection_height, centers, widths))
+    return NULL;
+
+  // Get the activations of the basis functions
+  // true, false => normalized_basis_functions, asymmetric_kernels;
+  MatrixXd activations(inputs.rows(), centers.rows());
+  BasisFunction::Gaussian::activations(centers, widths, inputs, activations,
+                                       true, false);
+
+  // Perform one weighted least squares regression for each basis function, with
+  // its activations as weights.
+  MatrixXd betas;
+  if (!FunctionApproximatorWLS::solveBatch(inputs, targets, activations, true,
+                                           regularization, betas, thread_pool))
+    return NULL;
+
+  int n_dims = inputs.cols();
+  MatrixXd slopes = betas.leftCols(n_dims);
+  MatrixXd offsets = betas.col(n_dims);
+  FunctionApproximatorLWR* fa =
+      new FunctionApproximatorLWR(centers, widths, slopes, offsets);
+  fa->n_bfs_per_dim_ = n_bfs_per_dim;
+  fa->intersection_height_ = intersection_height;
+  fa->regularization_ = regularization;
+  return fa;
+}
+
 void FunctionApproximatorLWR::predictRealTime(
     const Eigen::Ref<const Eigen::RowVectorXd>& input,
     Eigen::VectorXd& output) const
 {
   ENTERING_REAL_TIME_CRITICAL_CODE
 
-  // Only 1 sample, so real-time execution is possible. No need to allocate
-  // memory.
-  getLines(input, lines_one_prealloc_);
-
   // Weight the values for each line with the normalized basis function
-  // activations
-  bool normalize_activations = true;
-  BasisFunction::Gaussian::activations(
-      centers_, widths_, input, activations_one_prealloc_,
-      normalize_activations, asymmetric_kernels_);
+  // activations. Only 1 sample, so the sums can be computed one basis function
+  // at a time. No memory is needed besides the stack, so several threads may
+  // call this function at the same time.
+  double sum_activations = 0.0;
+  double sum_weighted_lines = 0.0;
+  double sum_lines = 0.0;
+  for (int bb = 0; bb < n_basis_functions_; bb++) {
+    double line = input.dot(slopes_.row(bb)) + offsets_(bb);
+    double activation = BasisFunction::Gaussian::activation(
+        centers_, widths_, input, bb, asymmetric_kernels_);
+    sum_activations += activation;
+    sum_weighted_lines += activation * line;
+    sum_lines += line;
+  }
 
-  output = (lines_one_prealloc_.array() * activations_one_prealloc_.array())
-               .rowwise()
-               .sum();
+  // Same special cases as in BasisFunction::Gaussian::activations()
+  if (n_basis_functions_ == 1)
+    output(0) = sum_lines;
+  else if (sum_activations == 0.0)
+    output(0) = sum_lines / n_basis_functions_;
+  else
+    output(0) = sum_weighted_lines / sum_activations;
 
   EXITING_REAL_TIME_CRITICAL_CODE
 }
@@ -108,6 +154,53 @@ void FunctionApproximatorLWR::predict(
   outputs = (lines.array() * activations.array()).rowwise().sum();
 }
 
+int FunctionApproximatorLWR::getLinearParameterVectorSize(void) const
+{
+  return slopes_.size() + offsets_.size();
+}
+
+void FunctionApproximatorLWR::getLinearParameterVector(VectorXd& values) const
+{
+  int n_dims = slopes_.cols();
+  values.resize(getLinearParameterVectorSize());
+  for (int i_line = 0; i_line < n_basis_functions_; i_line++)
+    values.segment(i_line * n_dims, n_dims) = slopes_.row(i_line).transpose();
+  values.tail(n_basis_functions_) = offsets_;
+}
+
+void FunctionApproximatorLWR::setLinearParameterVector(
+    const Eigen::Ref<const Eigen::VectorXd>& values)
+{
+  assert(values.size() == getLinearParameterVectorSize());
+  int n_dims = slopes_.cols();
+  for (int i_line = 0; i_line < n_basis_functions_; i_line++)
+    slopes_.row(i_line) = values.segment(i_line * n_dims, n_dims).transpose();
+  offsets_ = values.tail(n_basis_functions_);
+}
+
+void FunctionApproximatorLWR::getLinearFeatures(
+    const Eigen::Ref<const Eigen::MatrixXd>& inputs, MatrixXd& features) const
+{
+  int n_samples = inputs.rows();
+  int n_dims = slopes_.cols();
+  MatrixXd activations(n_samples, n_basis_functions_);
+  bool normalize_activations = true;
+  BasisFunction::Gaussian::activations(centers_, widths_, inputs, activations,
+                                       normalize_activations,
+                                       asymmetric_kernels_);
+
+  // Line representation is "y = ax + b", so the output is
+  // sum_i act_i * (a_i x + b_i)
+  features.resize(n_samples, getLinearParameterVectorSize());
+  for (int i_line = 0; i_line < n_basis_functions_; i_line++) {
+    for (int i_dim = 0; i_dim < n_dims; i_dim++)
+      features.col(i_line * n_dims + i_dim) =
+          activations.col(i_line).array() * inputs.col(i_dim).array();
+    features.col(n_basis_functions_ * n_dims + i_line) =
+        activations.col(i_line);
+  }
+}
+
 /*
 void FunctionApproximatorLWR::set_lines_pivot_at_max_activation(
     bool lines_pivot_at_max_activation)
@@ -211,6 +304,40 @@ exp(-0.5*pow(inputs.col(i_dim).array()-center[i_dim],2)/(width[i_dim]*width[i_di
 }
 */
 
+bool FunctionApproximatorLWR::hasSameStructure(
+    const FunctionApproximator& other) const
+{
+  const FunctionApproximatorLWR* fa =
+      dynamic_cast<const FunctionApproximatorLWR*>(&other);
+  if (fa == NULL) return false;
+  return centers_.rows() == fa->centers_.rows() &&
+         centers_.cols() == fa->centers_.cols() &&
+         widths_.rows() == fa->widths_.rows() &&
+         widths_.cols() == fa->widths_.cols() &&
+         slopes_.rows() == fa->slopes_.rows() &&
+         slopes_.cols() == fa->slopes_.cols() &&
+         offsets_.rows() == fa->offsets_.rows() &&
+         offsets_.cols() == fa->offsets_.cols();
+}
+
+void FunctionApproximatorLWR::copyParametersRealTime(
+    const FunctionApproximator& other)
+{
+  ENTERING_REAL_TIME_CRITICAL_CODE
+
+  assert(hasSameStructure(other));
+  const FunctionApproximatorLWR& fa =
+      static_cast<const FunctionApproximatorLWR&>(other);
+  // All matrices have the same size, so no memory is allocated.
+  centers_ = fa.centers_;
+  widths_ = fa.widths_;
+  slopes_ = fa.slopes_;
+  offsets_ = fa.offsets_;
+  asymmetric_kernels_ = fa.asymmetric_kernels_;
+
+  EXITING_REAL_TIME_CRITICAL_CODE
+}
+
 void from_json(const nlohmann::json& j, FunctionApproximatorLWR*& obj)
 {
   nlohmann::json jm = j.at("_model_params");
@@ -219,6 +346,15 @@ void from_json(const nlohmann::json& j, FunctionApproximatorLWR*& obj)
   MatrixXd slopes = jm.at("slopes");
   MatrixXd offsets = jm.at("offsets");
   obj = new FunctionApproximatorLWR(centers, widths, slopes, offsets);
+
+  if (j.contains("_meta_params")) {
+    nlohmann::json jmeta = j.at("_meta_params");
+    vector<int> n_bfs_per_dim = jmeta.at("n_basis_functions_per_dim");
+    obj->n_bfs_per_dim_ =
+        Map<VectorXi>(n_bfs_per_dim.data(), n_bfs_per_dim.size());
+    obj->intersection_height_ = jmeta.at("intersection_height");
+    obj->regularization_ = jmeta.at("regularization");
+  }
 }
 
 void FunctionApproximatorLWR::to_json_helper(nlohmann::json& j) const
@@ -227,6 +363,14 @@ void FunctionApproximatorLWR::to_json_helper(nlohmann::json& j) const
   j["_model_params"]["widths"] = widths_;
   j["_model_params"]["offsets"] = offsets_;
   j["_model_params"]["slopes"] = slopes_;
+  if (n_bfs_per_dim_.size() > 0) {
+    j["_meta_params"]["n_basis_functions_per_dim"] = vector<int>(
+        n_bfs_per_dim_.data(), n_bfs_per_dim_.data() + n_bfs_per_dim_.size());
+    j["_meta_params"]["intersection_height"] = intersection_height_;
+    j["_meta_params"]["regularization"] = regularization_;
+  }
+  j["_dim_input"] = centers_.cols();
+  j["_selected_param_names"] = nullptr;
   j["class"] = "FunctionApproximatorLWR";
 }
 
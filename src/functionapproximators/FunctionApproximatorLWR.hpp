@@ -34,6 +34,9 @@
 
 namespace DmpBbo {
 
+// forward declaration
+class ThreadPool;
+
 /** \brief LWR (Locally Weighted Regression) function approximator
  * \ingroup FunctionApproximators
  * \ingroup LWR
@@ -57,6 +60,41 @@ class FunctionApproximatorLWR : public FunctionApproximator {
                           const Eigen::MatrixXd& offsets,
                           bool asymmetric_kernels = false);
 
+  /** Train an LWR function approximator, as FunctionApproximatorLWR._train()
+   * in Python.
+   *
+   * The basis functions are spread evenly over the range of the inputs. The
+   * line of each basis function is determined with a weighted least squares
+   * regression, weighted by the normalized activations of the basis function.
+   * These regressions are solved with FunctionApproximatorWLS::solveBatch().
+   *
+   *  \param[in] inputs  Input values (n_samples X n_input_dims)
+   *  \param[in] targets Target values (n_samples)
+   *  \param[in] n_bfs_per_dim Number of basis functions per input dimension
+   *  \param[in] intersection_height The relative value at which two
+   * neighbouring basis functions intersect
+   *  \param[in] regularization Regularization term for regularized least
+   * squares
+   *  \param[in] thread_pool Pool in which to solve the regressions of the
+   * basis functions (NULL: solve them in the calling thread)
+   *  \return The trained function approximator, or NULL if training failed.
+   * The caller is responsible for deleting it.
+   */
+  static FunctionApproximatorLWR* train(
+      const Eigen::Ref<const Eigen::MatrixXd>& inputs,
+      const Eigen::Ref<const Eigen::VectorXd>& targets,
+      const Eigen::VectorXi& n_bfs_per_dim, double intersection_height = 0.5,
+      double regularization = 0.0, ThreadPool* thread_pool = NULL);
+
+  FunctionApproximatorLWR* clone(void) const
+  {
+    return new FunctionApproximatorLWR(*this);
+  }
+
+  bool hasSameStructure(const FunctionApproximator& other) const;
+
+  void copyParametersRealTime(const FunctionApproximator& other);
+
   /** Query the function approximator to make a prediction
    *  \param[in]  inputs   Input values of the query (n_samples X n_input_dims)
    *  \param[out] outputs  Predicted output values (n_samples X n_output_dims)
@@ -92,6 +130,60 @@ class FunctionApproximatorLWR : public FunctionApproximator {
   void set_slopes_as_angles(bool slopes_as_angles);
    */
 
+  /** Get the number of parameters in which the function approximator is
+   * linear, i.e. the slopes and offsets of the lines.
+   * \return Size of the linear parameter vector
+   */
+  int getLinearParameterVectorSize(void) const;
+
+  /** Get the slopes and offsets of the lines.
+   *  \param[out] values The slopes (row by row) followed by the offsets, i.e.
+   * the same order as get_param_vector() in Python with the selected
+   * parameters "slopes" and "offsets".
+   */
+  void getLinearParameterVector(Eigen::VectorXd& values) const;
+
+  /** Set the slopes and offsets of the lines.
+   *  \param[in] values The slopes (row by row) followed by the offsets
+   */
+  void setLinearParameterVector(
+      const Eigen::Ref<const Eigen::VectorXd>& values);
+
+  /** Get the features for which predict(inputs) = features * [slopes
+   * offsets], i.e. the normalized activations times the inputs (for the
+   * slopes), and the normalized activations (for the offsets).
+   *
+   *  \param[in]  inputs   Input values (n_samples X n_input_dims)
+   *  \param[out] features Features (n_samples X getLinearParameterVectorSize())
+   */
+  void getLinearFeatures(const Eigen::Ref<const Eigen::MatrixXd>& inputs,
+                         Eigen::MatrixXd& features) const;
+
+  /** Get the centers of the basis functions.
+   * \return Centers (n_basis_functions X n_dims)
+   */
+  inline const Eigen::MatrixXd& centers(void) const { return centers_; }
+
+  /** Get the widths of the basis functions.
+   * \return Widths (n_basis_functions X n_dims)
+   */
+  inline const Eigen::MatrixXd& widths(void) const { return widths_; }
+
+  /** Get the slopes of the line segments.
+   * \return Slopes (n_basis_functions X n_dims)
+   */
+  inline const Eigen::MatrixXd& slopes(void) const { return slopes_; }
+
+  /** Get the offsets of the line segments.
+   * \return Offsets (n_basis_functions X 1)
+   */
+  inline const Eigen::VectorXd& offsets(void) const { return offsets_; }
+
+  /** Whether the kernels are asymmetric.
+   * \return true if the kernels are asymmetric
+   */
+  inline bool asymmetric_kernels(void) const { return asymmetric_kernels_; }
+
   /** Read an object from json.
    *  \param[in]  j   json input
    *  \param[out] obj The object read from json
@@ -134,13 +226,12 @@ class FunctionApproximatorLWR : public FunctionApproximator {
 
   bool asymmetric_kernels_;
 
-  /** Preallocated memory for one time step, required to make the predict()
-   * function real-time. */
-  mutable Eigen::MatrixXd lines_one_prealloc_;
-
-  /** Preallocated memory for one time step, required to make the predict()
-   * function real-time. */
-  mutable Eigen::MatrixXd activations_one_prealloc_;
+  /** The meta-parameters with which the function approximator was trained.
+   * n_bfs_per_dim_ is empty if they are not known.
+   */
+  Eigen::VectorXi n_bfs_per_dim_;
+  double intersection_height_;
+  double regularization_;
 
   /** Get the output of each linear model (unweighted) for the given inputs.
    * \param[in] inputs The inputs for which to compute the output of the lines
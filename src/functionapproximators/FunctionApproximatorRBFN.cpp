@@ -31,6 +31,7 @@
 #include "eigenutils/eigen_json.hpp"
 #include "eigenutils/eigen_realtime_check.hpp"
 #include "functionapproximators/BasisFunction.hpp"
+#include "functionapproximators/FunctionApproximatorWLS.hpp"
 
 using namespace std;
 using namespace Eigen;
@@ -43,34 +44,66 @@ FunctionApproximatorRBFN::FunctionApproximatorRBFN(
     : n_basis_functions_(centers.rows()),
       centers_(centers),
       widths_(widths),
-      weights_(weights)
+      weights_(weights),
+      intersection_height_(0.0),
+      regularization_(0.0)
 {
   assert(n_basis_functions_ == widths_.rows());
   assert(n_basis_functions_ == weights_.rows());
   assert(centers.cols() ==
          widths_.cols());  // # number of dimensions should match
   assert(weights_.cols() == 1);
-
-  activations_one_prealloc_ = MatrixXd(1, n_basis_functions_);
 };
 
+FunctionApproximatorRBFN* FunctionApproximatorRBFN::train(
+    const Eigen::Ref<const Eigen::MatrixXd>& inputs,
+    const Eigen::Ref<const Eigen::VectorXd>& targets,
+    const Eigen::VectorXi& n_bfs_per_dim, double intersection_height,
+    double regularization)
+{
+  // Determine the centers and widths of the basis functions, given the input
+  // data range
+  MatrixXd centers, widths;
+  if (!BasisFunction::Gaussian::getCentersAndWidths(
+          inputs, n_bfs_per_dim, intersection_height, centers, widths))
+    return NULL;
+
+  // Get the activations of the basis functions
+  // false, false => normalized_basis_functions, asymmetric_kernels;
+  MatrixXd activations(inputs.rows(), centers.rows());
+  BasisFunction::Gaussian::activations(centers, widths, inputs, activations,
+                                       false, false);
+
+  // The weights are the slope of a least squares regression without offset
+  VectorXd weights;
+  VectorXd no_weights;
+  if (!FunctionApproximatorWLS::solve(activations, targets, no_weights, false,
+                                      regularization, weights))
+    return NULL;
+
+  FunctionApproximatorRBFN* fa =
+      new FunctionApproximatorRBFN(centers, widths, weights);
+  fa->n_bfs_per_dim_ = n_bfs_per_dim;
+  fa->intersection_height_ = intersection_height;
+  fa->regularization_ = regularization;
+  return fa;
+}
+
 void FunctionApproximatorRBFN::predictRealTime(
     const Eigen::Ref<const Eigen::RowVectorXd>& input,
     Eigen::VectorXd& output) const
 {
   ENTERING_REAL_TIME_CRITICAL_CODE
 
-  // Get the basis function activations
-  // false, false => normalized_basis_functions, asymmetric_kernels;
-  BasisFunction::Gaussian::activations(centers_, widths_, input,
-                                       activations_one_prealloc_, false, false);
-
-  // Weight the basis function activations
+  // Sum over the weighted basis function activations. The activations are
+  // computed one by one, so that no preallocated memory is needed, and several
+  // threads may call this function at the same time.
+  // false => asymmetric_kernels
+  double sum = 0.0;
   for (int b = 0; b < n_basis_functions_; b++)
-    activations_one_prealloc_.col(b).array() *= weights_(b);
-
-  // Sum over weighed basis functions
-  output = activations_one_prealloc_.rowwise().sum();
+    sum += weights_(b) * BasisFunction::Gaussian::activation(
+                             centers_, widths_, input, b, false);
+  output(0) = sum;
 
   EXITING_REAL_TIME_CRITICAL_CODE
 }
@@ -95,6 +128,61 @@ void FunctionApproximatorRBFN::predict(
   outputs = activations.rowwise().sum();
 }
 
+int FunctionApproximatorRBFN::getLinearParameterVectorSize(void) const
+{
+  return n_basis_functions_;
+}
+
+void FunctionApproximatorRBFN::getLinearParameterVector(VectorXd& values) const
+{
+  values = weights_;
+}
+
+void FunctionApproximatorRBFN::setLinearParameterVector(
+    const Eigen::Ref<const Eigen::VectorXd>& values)
+{
+  assert(values.size() == n_basis_functions_);
+  weights_ = values;
+}
+
+void FunctionApproximatorRBFN::getLinearFeatures(
+    const Eigen::Ref<const Eigen::MatrixXd>& inputs, MatrixXd& features) const
+{
+  // false, false => normalized_basis_functions, asymmetric_kernels;
+  BasisFunction::Gaussian::activations(centers_, widths_, inputs, features,
+                                       false, false);
+}
+
+bool FunctionApproximatorRBFN::hasSameStructure(
+    const FunctionApproximator& other) const
+{
+  const FunctionApproximatorRBFN* fa =
+      dynamic_cast<const FunctionApproximatorRBFN*>(&other);
+  if (fa == NULL) return false;
+  return centers_.rows() == fa->centers_.rows() &&
+         centers_.cols() == fa->centers_.cols() &&
+         widths_.rows() == fa->widths_.rows() &&
+         widths_.cols() == fa->widths_.cols() &&
+         weights_.rows() == fa->weights_.rows() &&
+         weights_.cols() == fa->weights_.cols();
+}
+
+void FunctionApproximatorRBFN::copyParametersRealTime(
+    const FunctionApproximator& other)
+{
+  ENTERING_REAL_TIME_CRITICAL_CODE
+
+  assert(hasSameStructure(other));
+  const FunctionApproximatorRBFN& fa =
+      static_cast<const FunctionApproximatorRBFN&>(other);
+  // All matrices have the same size, so no memory is allocated.
+  centers_ = fa.centers_;
+  widths_ = fa.widths_;
+  weights_ = fa.weights_;
+
+  EXITING_REAL_TIME_CRITICAL_CODE
+}
+
 void from_json(const nlohmann::json& j, FunctionApproximatorRBFN*& obj)
 {
   nlohmann::json jm = j.at("_model_params");
@@ -102,6 +190,15 @@ void from_json(const nlohmann::json& j, FunctionApproximatorRBFN*& obj)
   MatrixXd widths = jm.at("widths");
   MatrixXd weights = jm.at("weights");
   obj = new FunctionApproximatorRBFN(centers, widths, weights);
+
+  if (j.contains("_meta_params")) {
+    nlohmann::json jmeta = j.at("_meta_params");
+    vector<int> n_bfs_per_dim = jmeta.at("n_basis_functions_per_dim");
+    obj->n_bfs_per_dim_ =
+        Map<VectorXi>(n_bfs_per_dim.data(), n_bfs_per_dim.size());
+    obj->intersection_height_ = jmeta.at("intersection_height");
+    obj->regularization_ = jmeta.at("regularization");
+  }
 }
 
 void FunctionApproximatorRBFN::to_json_helper(nlohmann::json& j) const
@@ -109,6 +206,14 @@ void FunctionApproximatorRBFN::to_json_helper(nlohmann::json& j) const
   j["_model_params"]["centers"] = centers_;
   j["_model_params"]["widths"] = widths_;
   j["_model_params"]["weights"] = weights_;
+  if (n_bfs_per_dim_.size() > 0) {
+    j["_meta_params"]["n_basis_functions_per_dim"] = vector<int>(
+        n_bfs_per_dim_.data(), n_bfs_per_dim_.data() + n_bfs_per_dim_.size());
+    j["_meta_params"]["intersection_height"] = intersection_height_;
+    j["_meta_params"]["regularization"] = regularization_;
+  }
+  j["_dim_input"] = centers_.cols();
+  j["_selected_param_names"] = nullptr;
   j["class"] = "FunctionApproximatorRBFN";
 }
 
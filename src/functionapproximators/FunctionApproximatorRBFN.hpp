@@ -49,6 +49,37 @@ class FunctionApproximatorRBFN : public FunctionApproximator {
                            const Eigen::MatrixXd& widths,
                            const Eigen::MatrixXd& weights);
 
+  /** Train an RBFN function approximator, as FunctionApproximatorRBFN._train()
+   * in Python.
+   *
+   * The basis functions are spread evenly over the range of the inputs, and
+   * their weights are determined with one least squares regression.
+   *
+   *  \param[in] inputs  Input values (n_samples X n_input_dims)
+   *  \param[in] targets Target values (n_samples)
+   *  \param[in] n_bfs_per_dim Number of basis functions per input dimension
+   *  \param[in] intersection_height The relative value at which two
+   * neighbouring basis functions intersect
+   *  \param[in] regularization Regularization term for regularized least
+   * squares
+   *  \return The trained function approximator, or NULL if training failed.
+   * The caller is responsible for deleting it.
+   */
+  static FunctionApproximatorRBFN* train(
+      const Eigen::Ref<const Eigen::MatrixXd>& inputs,
+      const Eigen::Ref<const Eigen::VectorXd>& targets,
+      const Eigen::VectorXi& n_bfs_per_dim, double intersection_height = 0.7,
+      double regularization = 0.0);
+
+  FunctionApproximatorRBFN* clone(void) const
+  {
+    return new FunctionApproximatorRBFN(*this);
+  }
+
+  bool hasSameStructure(const FunctionApproximator& other) const;
+
+  void copyParametersRealTime(const FunctionApproximator& other);
+
   /** Query the function approximator to make a prediction
    *  \param[in]  inputs   Input values of the query (n_samples X n_input_dims)
    *  \param[out] outputs  Predicted output values (n_samples X n_output_dims)
@@ -70,6 +101,47 @@ class FunctionApproximatorRBFN : public FunctionApproximator {
   void predictRealTime(const Eigen::Ref<const Eigen::RowVectorXd>& input,
                        Eigen::VectorXd& output) const;
 
+  /** Get the number of parameters in which the function approximator is
+   * linear, i.e. the number of weights.
+   * \return Size of the linear parameter vector
+   */
+  int getLinearParameterVectorSize(void) const;
+
+  /** Get the weights of the basis functions.
+   *  \param[out] values The weights (n_basis_functions)
+   */
+  void getLinearParameterVector(Eigen::VectorXd& values) const;
+
+  /** Set the weights of the basis functions.
+   *  \param[in] values The weights (n_basis_functions)
+   */
+  void setLinearParameterVector(
+      const Eigen::Ref<const Eigen::VectorXd>& values);
+
+  /** Get the features for which predict(inputs) = features * weights, i.e.
+   * the (unnormalized) basis function activations.
+   *
+   *  \param[in]  inputs   Input values (n_samples X n_input_dims)
+   *  \param[out] features Features (n_samples X n_basis_functions)
+   */
+  void getLinearFeatures(const Eigen::Ref<const Eigen::MatrixXd>& inputs,
+                         Eigen::MatrixXd& features) const;
+
+  /** Get the centers of the basis functions.
+   * \return Centers (n_basis_functions X n_dims)
+   */
+  inline const Eigen::MatrixXd& centers(void) const { return centers_; }
+
+  /** Get the widths of the basis functions.
+   * \return Widths (n_basis_functions X n_dims)
+   */
+  inline const Eigen::MatrixXd& widths(void) const { return widths_; }
+
+  /** Get the weights of the basis functions.
+   * \return Weights (n_basis_functions X 1)
+   */
+  inline const Eigen::VectorXd& weights(void) const { return weights_; }
+
   /** Read an object from json.
    *  \param[in]  j   json input
    *  \param[out] obj The object read from json
@@ -108,9 +180,12 @@ class FunctionApproximatorRBFN : public FunctionApproximator {
   Eigen::MatrixXd widths_;   // n_basis_functions_ X n_dims
   Eigen::VectorXd weights_;  //                  1 X n_dims
 
-  /** Preallocated memory for one time step, required to make the predict()
-   * function real-time. */
-  mutable Eigen::MatrixXd activations_one_prealloc_;
+  /** The meta-parameters with which the function approximator was trained.
+   * n_bfs_per_dim_ is empty if they are not known.
+   */
+  Eigen::VectorXi n_bfs_per_dim_;
+  double intersection_height_;
+  double regularization_;
 };
 
 }  // namespace DmpBbo
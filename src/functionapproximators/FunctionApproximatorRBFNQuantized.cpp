@@ -0,0 +1,278 @@
+/**
+ * @file   FunctionApproximatorRBFNQuantized.cpp
+ * @brief  FunctionApproximatorRBFNQuantized class source file.
+ *
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "functionapproximators/FunctionApproximatorRBFNQuantized.hpp"
+
+#include <cmath>
+#include <iostream>
+#include <nlohmann/json.hpp>
+
+#include "eigenutils/eigen_realtime_check.hpp"
+#include "functionapproximators/FunctionApproximatorRBFN.hpp"
+
+using namespace std;
+using namespace Eigen;
+
+namespace DmpBbo {
+
+/** Get the elements of a matrix row by row.
+ * \param[in] matrix The matrix
+ * \return The elements of the matrix, row by row
+ */
+static VectorXd rowByRow(const MatrixXd& matrix)
+{
+  Matrix<double, Dynamic, Dynamic, RowMajor> row_major = matrix;
+  return Map<const VectorXd>(row_major.data(), row_major.size());
+}
+
+/** Get the scales -0.5/width^2 of the basis functions of an RBFN.
+ * \param[in] rbfn The RBFN
+ * \return The scales, row by row
+ */
+static VectorXd getScales(const FunctionApproximatorRBFN& rbfn)
+{
+  return rowByRow(-0.5 * rbfn.widths().array().square().inverse());
+}
+
+/** Get the format in which the model parameters of an RBFN can be stored.
+ * \param[in] rbfn The RBFN
+ * \param[in] format The requested format
+ * \return "INT16" if the format is "FLOAT16", but the model parameters exceed
+ * its range, and the requested format otherwise.
+ */
+static string getFormat(const FunctionApproximatorRBFN& rbfn, string format)
+{
+  // All arrays must have the same format, because predictRealTime() only
+  // dispatches on the format of the weights.
+  if (format == "FLOAT16" &&
+      (!QuantizedArray::isInFloat16Range(rowByRow(rbfn.centers())) ||
+       !QuantizedArray::isInFloat16Range(getScales(rbfn)) ||
+       !QuantizedArray::isInFloat16Range(rbfn.weights())))
+    return "INT16";
+  return format;
+}
+
+FunctionApproximatorRBFNQuantized::FunctionApproximatorRBFNQuantized(
+    const FunctionApproximatorRBFN& rbfn, std::string format)
+    : n_basis_functions_(rbfn.centers().rows()),
+      n_dims_(rbfn.centers().cols()),
+      centers_(rowByRow(rbfn.centers()), getFormat(rbfn, format)),
+      scales_(getScales(rbfn), getFormat(rbfn, format)),
+      weights_(rbfn.weights(), getFormat(rbfn, format))
+{
+  if (weights_.format() != format && format == "FLOAT16") {
+    cerr << __FILE__ << ":" << __LINE__ << ":";
+    cerr << "Model parameters exceed the range of FLOAT16 ("
+         << QuantizedArray::kMaxFloat16 << "). Using INT16." << endl;
+  }
+}
+
+FunctionApproximatorRBFNQuantized::FunctionApproximatorRBFNQuantized(
+    int n_dims, const QuantizedArray& centers, const QuantizedArray& scales,
+    const QuantizedArray& weights)
+    : n_basis_functions_(weights.size()),
+      n_dims_(n_dims),
+      centers_(centers),
+      scales_(scales),
+      weights_(weights)
+{
+  assert(centers_.size() == n_basis_functions_ * n_dims_);
+  assert(scales_.size() == n_basis_functions_ * n_dims_);
+}
+
+template <int FORMAT>
+inline double FunctionApproximatorRBFNQuantized::activation(
+    const Eigen::Ref<const Eigen::RowVectorXd>& input, int i_basis) const
+{
+  // activation = exp(\sum_d -0.5*(x_d-c_d)^2/w_d^2), cf. BasisFunction
+  double exponent = 0.0;
+  int i = i_basis * n_dims_;
+  for (int i_dim = 0; i_dim < n_dims_; i_dim++, i++) {
+    double diff = input[i_dim] - centers_.get<FORMAT>(i);
+    exponent += scales_.get<FORMAT>(i) * diff * diff;
+  }
+  return exp(exponent);
+}
+
+template <int FORMAT>
+double FunctionApproximatorRBFNQuantized::predictOne(
+    const Eigen::Ref<const Eigen::RowVectorXd>& input) const
+{
+  double output = 0.0;
+  for (int i_basis = 0; i_basis < n_basis_functions_; i_basis++)
+    output +=
+        weights_.get<FORMAT>(i_basis) * activation<FORMAT>(input, i_basis);
+  return output;
+}
+
+void FunctionApproximatorRBFNQuantized::predictRealTime(
+    const Eigen::Ref<const Eigen::RowVectorXd>& input,
+    Eigen::VectorXd& output) const
+{
+  ENTERING_REAL_TIME_CRITICAL_CODE
+
+  assert(input.size() == n_dims_);
+  output.resize(1);
+  switch (weights_.format_id()) {
+    case QuantizedArray::FLOAT32:
+      output[0] = predictOne<QuantizedArray::FLOAT32>(input);
+      break;
+    case QuantizedArray::FLOAT16:
+      output[0] = predictOne<QuantizedArray::FLOAT16>(input);
+      break;
+    default:
+      output[0] = predictOne<QuantizedArray::INT16>(input);
+  }
+
+  EXITING_REAL_TIME_CRITICAL_CODE
+}
+
+void FunctionApproximatorRBFNQuantized::predict(
+    const Eigen::Ref<const Eigen::MatrixXd>& inputs, MatrixXd& outputs) const
+{
+  outputs.resize(inputs.rows(), 1);
+  VectorXd output(1);
+  for (int i_sample = 0; i_sample < inputs.rows(); i_sample++) {
+    predictRealTime(inputs.row(i_sample), output);
+    outputs(i_sample, 0) = output[0];
+  }
+}
+
+int FunctionApproximatorRBFNQuantized::getLinearParameterVectorSize(void) const
+{
+  return n_basis_functions_;
+}
+
+void FunctionApproximatorRBFNQuantized::getLinearParameterVector(
+    VectorXd& values) const
+{
+  weights_.get(values);
+}
+
+void FunctionApproximatorRBFNQuantized::setLinearParameterVector(
+    const Eigen::Ref<const Eigen::VectorXd>& values)
+{
+  assert(values.size() == n_basis_functions_);
+  weights_.set(values);
+}
+
+void FunctionApproximatorRBFNQuantized::getLinearFeatures(
+    const Eigen::Ref<const Eigen::MatrixXd>& inputs, MatrixXd& features) const
+{
+  features.resize(inputs.rows(), n_basis_functions_);
+  RowVectorXd input(n_dims_);
+  for (int i_sample = 0; i_sample < inputs.rows(); i_sample++) {
+    input = inputs.row(i_sample);
+    for (int i_basis = 0; i_basis < n_basis_functions_; i_basis++) {
+      double a;
+      switch (weights_.format_id()) {
+        case QuantizedArray::FLOAT32:
+          a = activation<QuantizedArray::FLOAT32>(input, i_basis);
+          break;
+        case QuantizedArray::FLOAT16:
+          a = activation<QuantizedArray::FLOAT16>(input, i_basis);
+          break;
+        default:
+          a = activation<QuantizedArray::INT16>(input, i_basis);
+      }
+      features(i_sample, i_basis) = a;
+    }
+  }
+}
+
+double FunctionApproximatorRBFNQuantized::maxError(
+    const FunctionApproximatorRBFN& rbfn, int n_samples) const
+{
+  // The region in which the basis functions are active
+  ArrayXXd lower = rbfn.centers().array() - 3.0 * rbfn.widths().array();
+  ArrayXXd upper = rbfn.centers().array() + 3.0 * rbfn.widths().array();
+  RowVectorXd min_inputs = lower.colwise().minCoeff();
+  RowVectorXd max_inputs = upper.colwise().maxCoeff();
+
+  MatrixXd inputs;
+  if (n_dims_ == 1) {
+    inputs = VectorXd::LinSpaced(n_samples, min_inputs[0], max_inputs[0]);
+  } else {
+    srand(0);  // Reproducible errors
+    ArrayXXd random = 0.5 * (ArrayXXd::Random(n_samples, n_dims_) + 1.0);
+    inputs = (random.rowwise() * (max_inputs - min_inputs).array()).rowwise() +
+             min_inputs.array();
+  }
+
+  MatrixXd outputs, outputs_rbfn;
+  predict(inputs, outputs);
+  rbfn.predict(inputs, outputs_rbfn);
+  return (outputs - outputs_rbfn).cwiseAbs().maxCoeff();
+}
+
+bool FunctionApproximatorRBFNQuantized::hasSameStructure(
+    const FunctionApproximator& other) const
+{
+  const FunctionApproximatorRBFNQuantized* fa =
+      dynamic_cast<const FunctionApproximatorRBFNQuantized*>(&other);
+  if (fa == NULL) return false;
+  return n_dims_ == fa->n_dims_ && centers_.hasSameStructure(fa->centers_) &&
+         scales_.hasSameStructure(fa->scales_) &&
+         weights_.hasSameStructure(fa->weights_);
+}
+
+void FunctionApproximatorRBFNQuantized::copyParametersRealTime(
+    const FunctionApproximator& other)
+{
+  ENTERING_REAL_TIME_CRITICAL_CODE
+
+  assert(hasSameStructure(other));
+  const FunctionApproximatorRBFNQuantized& fa =
+      static_cast<const FunctionApproximatorRBFNQuantized&>(other);
+  // All arrays have the same size, so no memory is allocated.
+  centers_ = fa.centers_;
+  scales_ = fa.scales_;
+  weights_ = fa.weights_;
+
+  EXITING_REAL_TIME_CRITICAL_CODE
+}
+
+void from_json(const nlohmann::json& j, FunctionApproximatorRBFNQuantized*& obj)
+{
+  const nlohmann::json& jm = j.at("_model_params");
+  int n_dims = jm.at("n_dims");
+  QuantizedArray* centers = jm.at("centers").get<QuantizedArray*>();
+  QuantizedArray* scales = jm.at("scales").get<QuantizedArray*>();
+  QuantizedArray* weights = jm.at("weights").get<QuantizedArray*>();
+  obj = new FunctionApproximatorRBFNQuantized(n_dims, *centers, *scales,
+                                              *weights);
+  delete centers;
+  delete scales;
+  delete weights;
+}
+
+void FunctionApproximatorRBFNQuantized::to_json_helper(nlohmann::json& j) const
+{
+  j["_model_params"]["n_dims"] = n_dims_;
+  j["_model_params"]["centers"] = centers_;
+  j["_model_params"]["scales"] = scales_;
+  j["_model_params"]["weights"] = weights_;
+  j["class"] = "FunctionApproximatorRBFNQuantized";
+}
+
+}  // namespace DmpBbo
@@ -0,0 +1,197 @@
+/**
+ * @file   FunctionApproximatorRBFNQuantized.hpp
+ * @brief  FunctionApproximatorRBFNQuantized class header file.
+ *
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef _FUNCTION_APPROXIMATOR_RBFN_QUANTIZED_H_
+#define _FUNCTION_APPROXIMATOR_RBFN_QUANTIZED_H_
+
+#include <nlohmann/json_fwd.hpp>
+#include <string>
+
+#include "functionapproximators/FunctionApproximator.hpp"
+#include "functionapproximators/QuantizedArray.hpp"
+
+namespace DmpBbo {
+
+// forward declaration
+class FunctionApproximatorRBFN;
+
+/** \brief RBFN function approximator whose model parameters are stored with
+ * fewer bits, to reduce memory and bandwidth for large libraries of Dmps.
+ *
+ * The centers, the weights, and the scales -0.5/width^2 of the basis functions
+ * are stored in a QuantizedArray. They are dequantized on the fly while the
+ * activations are computed, so no double precision copy of the model
+ * parameters is kept. The predictions differ from those of the RBFN from
+ * which it was constructed by the quantization error only; use maxError() to
+ * determine how large it is.
+ *
+ * \ingroup FunctionApproximators
+ * \ingroup RBFN
+ */
+class FunctionApproximatorRBFNQuantized : public FunctionApproximator {
+ public:
+  /** Constructor, which quantizes the model parameters of an RBFN.
+   *  \param[in] rbfn   The RBFN to quantize
+   *  \param[in] format "FLOAT32", "FLOAT16" or "INT16", cf. QuantizedArray
+   */
+  FunctionApproximatorRBFNQuantized(const FunctionApproximatorRBFN& rbfn,
+                                    std::string format);
+
+  FunctionApproximatorRBFNQuantized* clone(void) const
+  {
+    return new FunctionApproximatorRBFNQuantized(*this);
+  }
+
+  bool hasSameStructure(const FunctionApproximator& other) const;
+
+  void copyParametersRealTime(const FunctionApproximator& other);
+
+  /** Query the function approximator to make a prediction
+   *  \param[in]  inputs   Input values of the query (n_samples X n_input_dims)
+   *  \param[out] outputs  Predicted output values (n_samples X 1)
+   */
+  void predict(const Eigen::Ref<const Eigen::MatrixXd>& inputs,
+               Eigen::MatrixXd& outputs) const;
+
+  /** Query the function approximator to make a prediction.
+   *
+   *  \param[in]  input   Input value of the query (1 x n_input_dims)
+   *  \param[out] output  Predicted output values (1 x 1)
+   *
+   * This function is real-time; there will be no memory allocation.
+   */
+  void predictRealTime(const Eigen::Ref<const Eigen::RowVectorXd>& input,
+                       Eigen::VectorXd& output) const;
+
+  /** Get the number of weights.
+   * \return Size of the linear parameter vector
+   */
+  int getLinearParameterVectorSize(void) const;
+
+  /** Get the (dequantized) weights of the basis functions.
+   *  \param[out] values The weights (n_basis_functions)
+   */
+  void getLinearParameterVector(Eigen::VectorXd& values) const;
+
+  /** Quantize and set the weights of the basis functions.
+   *  \param[in] values The weights (n_basis_functions)
+   */
+  void setLinearParameterVector(
+      const Eigen::Ref<const Eigen::VectorXd>& values);
+
+  /** Get the basis function activations, for which predict(inputs) = features
+   * * weights.
+   *  \param[in]  inputs   Input values (n_samples X n_input_dims)
+   *  \param[out] features Features (n_samples X n_basis_functions)
+   */
+  void getLinearFeatures(const Eigen::Ref<const Eigen::MatrixXd>& inputs,
+                         Eigen::MatrixXd& features) const;
+
+  /** Get the maximum difference between the predictions of this function
+   * approximator and an RBFN, e.g. the one from which it was quantized.
+   *
+   * The predictions are compared on a grid (1D inputs) or at random inputs
+   * (higher dimensional inputs) in the region where the basis functions of the
+   * RBFN are active, i.e. within 3 widths of the centers.
+   *
+   * \param[in] rbfn The RBFN to compare to
+   * \param[in] n_samples Number of inputs at which to compare
+   * \return The maximum absolute difference between the predictions
+   */
+  double maxError(const FunctionApproximatorRBFN& rbfn,
+                  int n_samples = 1001) const;
+
+  /** Get the format in which the model parameters are stored.
+   * \return "FLOAT32", "FLOAT16" or "INT16"
+   */
+  inline std::string format(void) const { return weights_.format(); }
+
+  /** Get the memory required for the model parameters.
+   * \return Size in bytes
+   */
+  inline int n_bytes(void) const
+  {
+    return centers_.n_bytes() + scales_.n_bytes() + weights_.n_bytes();
+  }
+
+  /** Read an object from json.
+   *  \param[in]  j   json input
+   *  \param[out] obj The object read from json
+   */
+  friend void from_json(const nlohmann::json& j,
+                        FunctionApproximatorRBFNQuantized*& obj);
+
+  /** Write an object to json.
+   *  \param[in] obj The object to write to json
+   *  \param[out]  j json output
+   */
+  inline friend void to_json(
+      nlohmann::json& j, const FunctionApproximatorRBFNQuantized* const& obj)
+  {
+    obj->to_json_helper(j);
+  }
+
+ private:
+  /** Constructor for already quantized model parameters.
+   * \param[in] n_dims  Dimensionality of the input
+   * \param[in] centers Centers, row by row (n_basis_functions X n_dims)
+   * \param[in] scales  -0.5/width^2, row by row (n_basis_functions X n_dims)
+   * \param[in] weights Weights (n_basis_functions)
+   */
+  FunctionApproximatorRBFNQuantized(int n_dims, const QuantizedArray& centers,
+                                    const QuantizedArray& scales,
+                                    const QuantizedArray& weights);
+
+  /** Write this object to json.
+   *  \param[out]  j json output
+   */
+  void to_json_helper(nlohmann::json& j) const;
+
+  /** Compute the activation of one basis function.
+   * \tparam FORMAT The format of the model parameters
+   * \param[in] input The input (n_dims)
+   * \param[in] i_basis Index of the basis function
+   * \return The activation
+   */
+  template <int FORMAT>
+  double activation(const Eigen::Ref<const Eigen::RowVectorXd>& input,
+                    int i_basis) const;
+
+  /** Compute the prediction for one input.
+   * \tparam FORMAT The format of the model parameters
+   * \param[in] input The input (n_dims)
+   * \return The prediction
+   */
+  template <int FORMAT>
+  double predictOne(const Eigen::Ref<const Eigen::RowVectorXd>& input) const;
+
+  int n_basis_functions_;
+  int n_dims_;
+  QuantizedArray centers_;  // n_basis_functions_ X n_dims_, row by row
+  QuantizedArray scales_;   // n_basis_functions_ X n_dims_, row by row
+  QuantizedArray weights_;  // n_basis_functions_
+};
+
+}  // namespace DmpBbo
+
+#endif  // _FUNCTION_APPROXIMATOR_RBFN_QUANTIZED_H_
@@ -0,0 +1,293 @@
+/**
+ * @file   FunctionApproximatorWLS.cpp
+ * @brief  FunctionApproximatorWLS class source file.
+ *
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "functionapproximators/FunctionApproximatorWLS.hpp"
+
+#include <eigen3/Eigen/Cholesky>
+#include <iostream>
+#include <nlohmann/json.hpp>
+
+#include "eigenutils/eigen_json.hpp"
+#include "eigenutils/eigen_realtime_check.hpp"
+#include "threadutils/ThreadPool.hpp"
+
+using namespace std;
+using namespace Eigen;
+
+namespace DmpBbo {
+
+FunctionApproximatorWLS::FunctionApproximatorWLS(const Eigen::VectorXd& slope,
+                                                 double offset,
+                                                 bool use_offset,
+                                                 double regularization)
+    : slope_(slope),
+      offset_(offset),
+      use_offset_(use_offset),
+      regularization_(regularization)
+{
+  assert(use_offset_ || offset_ == 0.0);
+}
+
+FunctionApproximatorWLS* FunctionApproximatorWLS::train(
+    const Eigen::Ref<const Eigen::MatrixXd>& inputs,
+    const Eigen::Ref<const Eigen::VectorXd>& targets, bool use_offset,
+    double regularization, const Eigen::VectorXd& weights)
+{
+  VectorXd beta;
+  if (!solve(inputs, targets, weights, use_offset, regularization, beta))
+    return NULL;
+
+  int n_dims = inputs.cols();
+  double offset = (use_offset ? beta[n_dims] : 0.0);
+  return new FunctionApproximatorWLS(beta.head(n_dims), offset, use_offset,
+                                     regularization);
+}
+
+/** Solve (A + regularization*I) * beta = b with a Cholesky decomposition, or
+ * with a more robust LDLT decomposition if A is not positive definite.
+ */
+static bool solveNormalEquations(MatrixXd& A, const VectorXd& b,
+                                 double regularization, VectorXd& beta)
+{
+  A.diagonal().array() += regularization;
+  LLT<MatrixXd> llt(A);
+  if (llt.info() == Success) {
+    beta = llt.solve(b);
+    return true;
+  }
+  LDLT<MatrixXd> ldlt(A);
+  if (ldlt.info() != Success) return false;
+  beta = ldlt.solve(b);
+  return beta.allFinite();
+}
+
+bool FunctionApproximatorWLS::solve(
+    const Eigen::Ref<const Eigen::MatrixXd>& inputs,
+    const Eigen::Ref<const Eigen::VectorXd>& targets,
+    const Eigen::VectorXd& weights, bool use_offset, double regularization,
+    Eigen::VectorXd& beta)
+{
+  int n_samples = inputs.rows();
+  if (targets.size() != n_samples ||
+      (weights.size() > 0 && weights.size() != n_samples)) {
+    cerr << __FILE__ << ":" << __LINE__ << ":";
+    cerr << "Number of samples in inputs, targets and weights do not match."
+         << endl;
+    return false;
+  }
+
+  // Make the design matrix, with a column of ones for the offset.
+  int n_dims = inputs.cols();
+  int n_betas = n_dims + (use_offset ? 1 : 0);
+  MatrixXd X(n_samples, n_betas);
+  X.leftCols(n_dims) = inputs;
+  if (use_offset) X.col(n_dims).setOnes();
+
+  // X^T*W, without constructing the n_samples X n_samples matrix W
+  MatrixXd XtW = X.transpose();
+  if (weights.size() > 0) XtW *= weights.asDiagonal();
+
+  MatrixXd A = XtW * X;
+  VectorXd b = XtW * targets;
+  if (!solveNormalEquations(A, b, regularization, beta)) {
+    cerr << __FILE__ << ":" << __LINE__ << ":";
+    cerr << "Could not solve the least squares problem." << endl;
+    return false;
+  }
+  return true;
+}
+
+bool FunctionApproximatorWLS::solveBatch(
+    const Eigen::Ref<const Eigen::MatrixXd>& inputs,
+    const Eigen::Ref<const Eigen::VectorXd>& targets,
+    const Eigen::Ref<const Eigen::MatrixXd>& weights, bool use_offset,
+    double regularization, Eigen::MatrixXd& betas, ThreadPool* thread_pool)
+{
+  int n_samples = inputs.rows();
+  int n_problems = weights.cols();
+  if (targets.size() != n_samples || weights.rows() != n_samples) {
+    cerr << __FILE__ << ":" << __LINE__ << ":";
+    cerr << "Number of samples in inputs, targets and weights do not match."
+         << endl;
+    return false;
+  }
+
+  int n_dims = inputs.cols();
+  int n_betas = n_dims + (use_offset ? 1 : 0);
+  MatrixXd X(n_samples, n_betas);
+  X.leftCols(n_dims) = inputs;
+  if (use_offset) X.col(n_dims).setOnes();
+
+  // For problem p, A_p = X^T*W_p*X, with A_p(a,b) = sum_s w(s,p)*X(s,a)*X(s,b)
+  // Storing the products X(s,a)*X(s,b) of the upper triangle as the columns of
+  // Z, the entries of all A_p are computed with one matrix product W^T*Z.
+  // Similarly, the entries of all b_p = X^T*W_p*targets are in W^T*(X.*y).
+  int n_products = (n_betas * (n_betas + 1)) / 2;
+  MatrixXd Z(n_samples, n_products + n_betas);
+  int i_product = 0;
+  for (int a = 0; a < n_betas; a++)
+    for (int b = a; b < n_betas; b++)
+      Z.col(i_product++) = X.col(a).cwiseProduct(X.col(b));
+  for (int a = 0; a < n_betas; a++)
+    Z.col(n_products + a) = X.col(a).cwiseProduct(targets);
+
+  MatrixXd WtZ = weights.transpose() * Z;  // n_problems X n_products+n_betas
+
+  betas.resize(n_problems, n_betas);
+  vector<char> success(n_problems, 0);
+  auto solve_problem = [&](int i_problem) {
+    MatrixXd A(n_betas, n_betas);
+    int i_product = 0;
+    for (int a = 0; a < n_betas; a++) {
+      for (int b = a; b < n_betas; b++) {
+        A(a, b) = WtZ(i_problem, i_product);
+        A(b, a) = WtZ(i_problem, i_product);
+        i_product++;
+      }
+    }
+    VectorXd b = WtZ.row(i_problem).tail(n_betas).transpose();
+    VectorXd beta;
+    if (solveNormalEquations(A, b, regularization, beta)) {
+      betas.row(i_problem) = beta.transpose();
+      success[i_problem] = 1;
+    }
+  };
+
+  if (thread_pool == NULL || n_problems == 1) {
+    for (int i_problem = 0; i_problem < n_problems; i_problem++)
+      solve_problem(i_problem);
+  } else {
+    // The problems are small, so give each thread a contiguous block of
+    // problems, rather than one task per problem.
+    int n_tasks = min(n_problems, thread_pool->n_threads());
+    thread_pool->parallelFor(n_tasks, [&](int i_task) {
+      int begin = (i_task * n_problems) / n_tasks;
+      int end = ((i_task + 1) * n_problems) / n_tasks;
+      for (int i_problem = begin; i_problem < end; i_problem++)
+        solve_problem(i_problem);
+    });
+  }
+
+  for (int i_problem = 0; i_problem < n_problems; i_problem++) {
+    if (!success[i_problem]) {
+      cerr << __FILE__ << ":" << __LINE__ << ":";
+      cerr << "Could not solve least squares problem " << i_problem << endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+void FunctionApproximatorWLS::predictRealTime(
+    const Eigen::Ref<const Eigen::RowVectorXd>& input,
+    Eigen::VectorXd& output) const
+{
+  ENTERING_REAL_TIME_CRITICAL_CODE
+  output(0) = input.dot(slope_) + offset_;
+  EXITING_REAL_TIME_CRITICAL_CODE
+}
+
+void FunctionApproximatorWLS::predict(
+    const Eigen::Ref<const Eigen::MatrixXd>& inputs, MatrixXd& outputs) const
+{
+  outputs = inputs * slope_;
+  outputs.array() += offset_;
+}
+
+int FunctionApproximatorWLS::getLinearParameterVectorSize(void) const
+{
+  return slope_.size() + (use_offset_ ? 1 : 0);
+}
+
+void FunctionApproximatorWLS::getLinearParameterVector(VectorXd& values) const
+{
+  values.resize(getLinearParameterVectorSize());
+  values.head(slope_.size()) = slope_;
+  if (use_offset_) values[slope_.size()] = offset_;
+}
+
+void FunctionApproximatorWLS::setLinearParameterVector(
+    const Eigen::Ref<const Eigen::VectorXd>& values)
+{
+  assert(values.size() == getLinearParameterVectorSize());
+  slope_ = values.head(slope_.size());
+  if (use_offset_) offset_ = values[slope_.size()];
+}
+
+void FunctionApproximatorWLS::getLinearFeatures(
+    const Eigen::Ref<const Eigen::MatrixXd>& inputs, MatrixXd& features) const
+{
+  int n_dims = inputs.cols();
+  features.resize(inputs.rows(), getLinearParameterVectorSize());
+  features.leftCols(n_dims) = inputs;
+  if (use_offset_) features.col(n_dims).setOnes();
+}
+
+bool FunctionApproximatorWLS::hasSameStructure(
+    const FunctionApproximator& other) const
+{
+  const FunctionApproximatorWLS* fa =
+      dynamic_cast<const FunctionApproximatorWLS*>(&other);
+  if (fa == NULL) return false;
+  return slope_.size() == fa->slope_.size() && use_offset_ == fa->use_offset_;
+}
+
+void FunctionApproximatorWLS::copyParametersRealTime(
+    const FunctionApproximator& other)
+{
+  ENTERING_REAL_TIME_CRITICAL_CODE
+
+  assert(hasSameStructure(other));
+  const FunctionApproximatorWLS& fa =
+      static_cast<const FunctionApproximatorWLS&>(other);
+  slope_ = fa.slope_;
+  offset_ = fa.offset_;
+
+  EXITING_REAL_TIME_CRITICAL_CODE
+}
+
+void from_json(const nlohmann::json& j, FunctionApproximatorWLS*& obj)
+{
+  nlohmann::json jm = j.at("_model_params");
+  VectorXd slope = jm.at("slope");
+  bool use_offset = jm.contains("offset");
+  double offset = (use_offset ? jm.at("offset").get<double>() : 0.0);
+  double regularization = 0.0;
+  if (j.contains("_meta_params"))
+    regularization = j.at("_meta_params").value("regularization", 0.0);
+  obj = new FunctionApproximatorWLS(slope, offset, use_offset, regularization);
+}
+
+void FunctionApproximatorWLS::to_json_helper(nlohmann::json& j) const
+{
+  j["_meta_params"]["use_offset"] = use_offset_;
+  j["_meta_params"]["regularization"] = regularization_;
+  // Python stores the slope as a 1D array, i.e. a flat list
+  j["_model_params"]["slope"] =
+      vector<double>(slope_.data(), slope_.data() + slope_.size());
+  if (use_offset_) j["_model_params"]["offset"] = offset_;
+  j["_dim_input"] = slope_.size();
+  j["_selected_param_names"] = nullptr;
+  j["class"] = "FunctionApproximatorWLS";
+}
+
+}  // namespace DmpBbo
@@ -0,0 +1,230 @@
+/**
+ * @file   FunctionApproximatorWLS.hpp
+ * @brief  FunctionApproximatorWLS class header file.
+ *
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _FUNCTION_APPROXIMATOR_WLS_H_
+#define _FUNCTION_APPROXIMATOR_WLS_H_
+
+#include <nlohmann/json_fwd.hpp>
+
+#include "functionapproximators/FunctionApproximator.hpp"
+
+/** @defgroup WLS Weighted Least Squares (WLS)
+ *  @ingroup FunctionApproximators
+ */
+
+namespace DmpBbo {
+
+// forward declaration
+class ThreadPool;
+
+/** \brief WLS (Weighted Least Squares) function approximator, i.e. the linear
+ * model y = slope * x + offset.
+ *
+ * Besides being a function approximator, this class provides the weighted
+ * least squares solvers with which FunctionApproximatorRBFN and
+ * FunctionApproximatorLWR are trained.
+ *
+ * \ingroup FunctionApproximators
+ * \ingroup WLS
+ */
+class FunctionApproximatorWLS : public FunctionApproximator {
+ public:
+  /** Constructor for the model parameters of the function approximator.
+   *  \param[in] slope  Slope for each input dimension
+   *  \param[in] offset Offset of the line, i.e. the output for input 0
+   *  \param[in] use_offset Whether the model has an offset (if not, offset
+   * must be 0)
+   *  \param[in] regularization The regularization with which it was trained
+   */
+  FunctionApproximatorWLS(const Eigen::VectorXd& slope, double offset = 0.0,
+                          bool use_offset = true, double regularization = 0.0);
+
+  /** Train a WLS function approximator, as FunctionApproximatorWLS._train()
+   * in Python.
+   *  \param[in] inputs  Input values (n_samples X n_input_dims)
+   *  \param[in] targets Target values (n_samples)
+   *  \param[in] use_offset Use the model "y = a*x + offset" instead of
+   * "y = a*x"
+   *  \param[in] regularization Regularization term for regularized least
+   * squares
+   *  \param[in] weights Weight of each sample (n_samples), or an empty vector
+   * for unweighted least squares
+   *  \return The trained function approximator, or NULL if the problem could
+   * not be solved. The caller is responsible for deleting it.
+   */
+  static FunctionApproximatorWLS* train(
+      const Eigen::Ref<const Eigen::MatrixXd>& inputs,
+      const Eigen::Ref<const Eigen::VectorXd>& targets, bool use_offset = true,
+      double regularization = 0.0,
+      const Eigen::VectorXd& weights = Eigen::VectorXd());
+
+  /** Solve one (weighted) least squares problem, i.e.
+   * beta = (X^T*W*X + regularization*I)^-1 * X^T*W*targets
+   * with a Cholesky decomposition.
+   *  \param[in] inputs  Input values X (n_samples X n_input_dims)
+   *  \param[in] targets Target values (n_samples)
+   *  \param[in] weights Diagonal of W (n_samples), or an empty vector for W=I
+   *  \param[in] use_offset Whether to add a column of ones to X
+   *  \param[in] regularization Regularization term
+   *  \param[out] beta The slopes, followed by the offset if use_offset
+   *  \return false if the problem could not be solved
+   */
+  static bool solve(const Eigen::Ref<const Eigen::MatrixXd>& inputs,
+                    const Eigen::Ref<const Eigen::VectorXd>& targets,
+                    const Eigen::VectorXd& weights, bool use_offset,
+                    double regularization, Eigen::VectorXd& beta);
+
+  /** Solve several weighted least squares problems with the same inputs and
+   * targets, but different weights, e.g. one for each basis function of LWR.
+   *
+   * The matrices X^T*W*X and X^T*W*targets of all problems are computed with
+   * one matrix product. The small systems of equations are then solved with
+   * Cholesky decompositions, in parallel if a thread pool is given. As these
+   * systems are small (n_input_dims+1 equations), the thread pool only pays
+   * off for many problems; to train many models, it is more efficient to
+   * train the models in parallel instead.
+   *
+   *  \param[in] inputs  Input values X (n_samples X n_input_dims)
+   *  \param[in] targets Target values (n_samples)
+   *  \param[in] weights The weights of each problem (n_samples X n_problems)
+   *  \param[in] use_offset Whether to add a column of ones to X
+   *  \param[in] regularization Regularization term
+   *  \param[out] betas The solution of each problem, i.e. the slopes followed
+   * by the offset if use_offset (n_problems X n_betas)
+   *  \param[in] thread_pool Pool in which to solve the problems (NULL: solve
+   * them in the calling thread)
+   *  \return false if one of the problems could not be solved
+   */
+  static bool solveBatch(const Eigen::Ref<const Eigen::MatrixXd>& inputs,
+                         const Eigen::Ref<const Eigen::VectorXd>& targets,
+                         const Eigen::Ref<const Eigen::MatrixXd>& weights,
+                         bool use_offset, double regularization,
+                         Eigen::MatrixXd& betas,
+                         ThreadPool* thread_pool = NULL);
+
+  FunctionApproximatorWLS* clone(void) const
+  {
+    return new FunctionApproximatorWLS(*this);
+  }
+
+  bool hasSameStructure(const FunctionApproximator& other) const;
+
+  void copyParametersRealTime(const FunctionApproximator& other);
+
+  /** Query the function approximator to make a prediction
+   *  \param[in]  inputs   Input values of the query (n_samples X n_input_dims)
+   *  \param[out] outputs  Predicted output values (n_samples X n_output_dims)
+   *
+   * This function does one prediction for each row in inputs. This function
+   * is not real-time, due to memory allocation.
+   */
+  void predict(const Eigen::Ref<const Eigen::MatrixXd>& inputs,
+               Eigen::MatrixXd& outputs) const;
+
+  /** Query the function approximator to make a prediction.
+   *
+   *  \param[in]  input   Input value of the query (1 x n_input_dims)
+   *  \param[out] output  Predicted output values (n_output_dims x 1)
+   *
+   * This function is real-time; there will be no memory allocation. In
+   * constrast to predict(), this function make a prediction for one input only.
+   */
+  void predictRealTime(const Eigen::Ref<const Eigen::RowVectorXd>& input,
+                       Eigen::VectorXd& output) const;
+
+  /** Get the number of parameters in which the function approximator is
+   * linear, i.e. the slope and the offset (if used).
+   * \return Size of the linear parameter vector
+   */
+  int getLinearParameterVectorSize(void) const;
+
+  /** Get the slope, followed by the offset (if used).
+   *  \param[out] values The parameter vector
+   */
+  void getLinearParameterVector(Eigen::VectorXd& values) const;
+
+  /** Set the slope, followed by the offset (if used).
+   *  \param[in] values The parameter vector
+   */
+  void setLinearParameterVector(
+      const Eigen::Ref<const Eigen::VectorXd>& values);
+
+  /** Get the features for which predict(inputs) = features * [slope offset],
+   * i.e. the inputs, followed by a column of ones (if the offset is used).
+   *
+   *  \param[in]  inputs   Input values (n_samples X n_input_dims)
+   *  \param[out] features Features (n_samples X getLinearParameterVectorSize())
+   */
+  void getLinearFeatures(const Eigen::Ref<const Eigen::MatrixXd>& inputs,
+                         Eigen::MatrixXd& features) const;
+
+  /** Get the slope of the line.
+   * \return Slope (n_dims)
+   */
+  inline const Eigen::VectorXd& slope(void) const { return slope_; }
+
+  /** Get the offset of the line.
+   * \return Offset
+   */
+  inline double offset(void) const { return offset_; }
+
+  /** Read an object from json.
+   *  \param[in]  j   json input
+   *  \param[out] obj The object read from json
+   *
+   * See also: https://github.com/nlohmann/json/issues/1324
+   */
+  friend void from_json(const nlohmann::json& j, FunctionApproximatorWLS*& obj);
+
+  /** Write an object to json.
+   *  \param[in] obj The object to write to json
+   *  \param[out]  j json output
+   *
+   * See also:
+   *   https://github.com/nlohmann/json/issues/1324
+   *   https://github.com/nlohmann/json/issues/716
+   */
+  inline friend void to_json(nlohmann::json& j,
+                             const FunctionApproximatorWLS* const& obj)
+  {
+    obj->to_json_helper(j);
+  }
+
+ private:
+  /** Write this object to json.
+   *  \param[out]  j json output
+   *
+   * See also:
+   *   https://github.com/nlohmann/json/issues/1324
+   *   https://github.com/nlohmann/json/issues/716
+   */
+  void to_json_helper(nlohmann::json& j) const;
+
+  Eigen::VectorXd slope_;  // n_dims
+  double offset_;
+  bool use_offset_;
+  double regularization_;
+};
+
+}  // namespace DmpBbo
+
+#endif  // _FUNCTION_APPROXIMATOR_WLS_H_
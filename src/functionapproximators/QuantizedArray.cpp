@@ -0,0 +1,184 @@
+/**
+ * @file   QuantizedArray.cpp
+ * @brief  QuantizedArray class source file.
+ *
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "functionapproximators/QuantizedArray.hpp"
+
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <nlohmann/json.hpp>
+
+#include "eigenutils/eigen_realtime_check.hpp"
+
+using namespace std;
+using namespace Eigen;
+
+namespace DmpBbo {
+
+constexpr double QuantizedArray::kMaxFloat16;
+
+QuantizedArray::QuantizedArray(const Eigen::Ref<const Eigen::VectorXd>& values,
+                               string format)
+    : size_(values.size()), offset_(0.0), scale_(1.0)
+{
+  if (format == "FLOAT32") {
+    format_ = FLOAT32;
+    data32_.resize(size_);
+  } else {
+    if (format != "FLOAT16" && format != "INT16") {
+      cerr << __FILE__ << ":" << __LINE__ << ":";
+      cerr << "Unknown format '" << format << "'. Using FLOAT16." << endl;
+      format = "FLOAT16";
+    }
+    if (format == "FLOAT16" && !isInFloat16Range(values)) {
+      cerr << __FILE__ << ":" << __LINE__ << ":";
+      cerr << "Values exceed the range of FLOAT16 (" << kMaxFloat16
+           << "). Using INT16." << endl;
+      format = "INT16";
+    }
+    format_ = (format == "FLOAT16" ? FLOAT16 : INT16);
+    data16_.resize(size_);
+  }
+  set(values);
+}
+
+void QuantizedArray::set(const Eigen::Ref<const Eigen::VectorXd>& values)
+{
+  ENTERING_REAL_TIME_CRITICAL_CODE
+
+  assert(values.size() == size_);
+
+  if (format_ == FLOAT32) {
+    for (int i = 0; i < size_; i++) data32_[i] = values[i];
+
+  } else if (format_ == FLOAT16) {
+    for (int i = 0; i < size_; i++) data16_[i] = floatToHalf(values[i]);
+
+  } else if (size_ > 0) {
+    // Map [min, max] onto [-32767, 32767]
+    double min_value = values.minCoeff();
+    double max_value = values.maxCoeff();
+    offset_ = 0.5 * (min_value + max_value);
+    scale_ = (max_value - min_value) / 65534.0;
+    if (scale_ == 0.0) scale_ = 1.0;  // All values are the same.
+    for (int i = 0; i < size_; i++) {
+      double q = round((values[i] - offset_) / scale_);
+      data16_[i] = (uint16_t)(int16_t)max(-32767.0, min(32767.0, q));
+    }
+  }
+
+  EXITING_REAL_TIME_CRITICAL_CODE
+}
+
+void QuantizedArray::get(Eigen::VectorXd& values) const
+{
+  values.resize(size_);
+  for (int i = 0; i < size_; i++) {
+    if (format_ == FLOAT32)
+      values[i] = get<FLOAT32>(i);
+    else if (format_ == FLOAT16)
+      values[i] = get<FLOAT16>(i);
+    else
+      values[i] = get<INT16>(i);
+  }
+}
+
+string QuantizedArray::format(void) const
+{
+  if (format_ == FLOAT32) return "FLOAT32";
+  if (format_ == FLOAT16) return "FLOAT16";
+  return "INT16";
+}
+
+bool QuantizedArray::isInFloat16Range(
+    const Eigen::Ref<const Eigen::VectorXd>& values)
+{
+  return values.size() == 0 || values.cwiseAbs().maxCoeff() <= kMaxFloat16;
+}
+
+uint16_t QuantizedArray::floatToHalf(float value)
+{
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  uint16_t sign = (bits >> 16) & 0x8000;
+  int exponent = (int)((bits >> 23) & 0xff) - 127 + 15;
+  uint32_t mantissa = bits & 0x7fffff;
+
+  if ((bits & 0x7fffffff) > 0x7f800000) return sign | 0x7e00;  // NaN
+  if ((bits & 0x7fffffff) == 0x7f800000) return sign | 0x7c00;  // Infinity
+  if (exponent >= 31) return sign | 0x7bff;  // Too large: saturate
+
+  if (exponent <= 0) {
+    // Subnormal, or too small
+    if (exponent < -10) return sign;
+    mantissa |= 0x800000;  // Make the implicit leading bit explicit
+    int shift = 14 - exponent;
+    uint16_t half = sign | (mantissa >> shift);
+    uint32_t remainder = mantissa & ((1u << shift) - 1);
+    uint32_t halfway = 1u << (shift - 1);
+    if (remainder > halfway || (remainder == halfway && (half & 1))) half++;
+    return half;
+  }
+
+  uint16_t half = sign | (exponent << 10) | (mantissa >> 13);
+  uint32_t remainder = mantissa & 0x1fff;
+  // A carry from the mantissa correctly increments the exponent, but must not
+  // round the largest finite value up to infinity.
+  if ((remainder > 0x1000 || (remainder == 0x1000 && (half & 1))) &&
+      (half & 0x7fff) != 0x7bff)
+    half++;
+  return half;
+}
+
+void from_json(const nlohmann::json& j, QuantizedArray*& obj)
+{
+  string format = j.at("format");
+  const nlohmann::json& data = j.at("data");
+  obj = new QuantizedArray(VectorXd::Zero(data.size()), format);
+  if (obj->format_ == QuantizedArray::FLOAT32) {
+    for (int i = 0; i < obj->size_; i++) obj->data32_[i] = data[i];
+  } else {
+    for (int i = 0; i < obj->size_; i++)
+      obj->data16_[i] = (uint16_t)data[i].get<int>();
+    obj->offset_ = j.value("offset", 0.0);
+    obj->scale_ = j.value("scale", 1.0);
+  }
+}
+
+void to_json(nlohmann::json& j, const QuantizedArray& obj)
+{
+  j["format"] = obj.format();
+  if (obj.format_ == QuantizedArray::FLOAT32) {
+    j["data"] = obj.data32_;
+  } else if (obj.format_ == QuantizedArray::FLOAT16) {
+    j["data"] = obj.data16_;  // The bits of the half precision floats
+  } else {
+    vector<int> data(obj.size_);
+    for (int i = 0; i < obj.size_; i++) data[i] = (int16_t)obj.data16_[i];
+    j["data"] = data;
+    j["offset"] = obj.offset_;
+    j["scale"] = obj.scale_;
+  }
+}
+
+}  // namespace DmpBbo
@@ -0,0 +1,193 @@
+/**
+ * @file   QuantizedArray.hpp
+ * @brief  QuantizedArray class header file.
+ *
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef _QUANTIZED_ARRAY_H_
+#define _QUANTIZED_ARRAY_H_
+
+#define EIGEN_RUNTIME_NO_MALLOC  // Enable runtime tests for allocations
+
+#include <cstdint>
+#include <cstring>
+#include <eigen3/Eigen/Core>
+#include <nlohmann/json_fwd.hpp>
+#include <string>
+#include <vector>
+
+namespace DmpBbo {
+
+/** \brief An array of doubles that is stored with fewer bits per value.
+ *
+ * The supported formats are:
+ * \li "FLOAT32": single precision floating point (4 bytes per value)
+ * \li "FLOAT16": half precision floating point (2 bytes per value). Its largest
+ * value is 65504; if the values exceed this range, "INT16" is used instead.
+ * \li "INT16": 16-bit integers q, with value = offset + scale * q, where offset
+ * and scale are chosen such that the range of the values is covered (2 bytes
+ * per value)
+ *
+ * The values are dequantized with get<FORMAT>(), which is inlined so that
+ * dequantization can be fused into the loops that use the values.
+ */
+class QuantizedArray {
+ public:
+  /** The formats, as template arguments for get(). */
+  static const int FLOAT32 = 0;
+  static const int FLOAT16 = 1;
+  static const int INT16 = 2;
+
+  /** Constructor.
+   * \param[in] values The values to quantize
+   * \param[in] format "FLOAT32", "FLOAT16" or "INT16"
+   */
+  QuantizedArray(const Eigen::Ref<const Eigen::VectorXd>& values,
+                 std::string format);
+
+  /** Quantize new values.
+   * This function is real-time. With FLOAT16, values that exceed its range are
+   * saturated to +/-65504.
+   * \param[in] values The values to quantize (same size as the array)
+   */
+  void set(const Eigen::Ref<const Eigen::VectorXd>& values);
+
+  /** Get all values.
+   * \param[out] values The dequantized values
+   */
+  void get(Eigen::VectorXd& values) const;
+
+  /** Get one value.
+   * \tparam FORMAT FLOAT32, FLOAT16 or INT16, which must be format_id()
+   * \param[in] i Index of the value
+   * \return The dequantized value
+   */
+  template <int FORMAT>
+  inline double get(int i) const
+  {
+    if (FORMAT == FLOAT32) return data32_[i];
+    if (FORMAT == FLOAT16) return halfToFloat(data16_[i]);
+    return offset_ + scale_ * (int16_t)data16_[i];
+  }
+
+  /** Get the number of values.
+   * \return Number of values
+   */
+  inline int size(void) const { return size_; }
+
+  /** Get the format.
+   * \return "FLOAT32", "FLOAT16" or "INT16"
+   */
+  std::string format(void) const;
+
+  /** Get the format, as a template argument for get().
+   * \return FLOAT32, FLOAT16 or INT16
+   */
+  inline int format_id(void) const { return format_; }
+
+  /** Get the memory required for the values.
+   * \return Size in bytes
+   */
+  inline int n_bytes(void) const
+  {
+    return data32_.size() * sizeof(float) + data16_.size() * sizeof(uint16_t);
+  }
+
+  /** Whether an array has the same size and format.
+   * \param[in] other The other array
+   * \return true if the size and format are the same
+   */
+  inline bool hasSameStructure(const QuantizedArray& other) const
+  {
+    return size_ == other.size_ && format_ == other.format_;
+  }
+
+  /** Convert a half precision float to a float.
+   * \param[in] half The bits of the half precision float
+   * \return The float
+   */
+  static inline float halfToFloat(uint16_t half)
+  {
+    uint32_t sign = (uint32_t)(half & 0x8000) << 16;
+    uint32_t exponent = (half >> 10) & 0x1f;
+    uint32_t mantissa = half & 0x3ff;
+    uint32_t bits;
+    if (exponent == 0) {
+      // Zero or subnormal
+      float value = mantissa * (1.0f / 16777216.0f);  // mantissa * 2^-24
+      return (sign ? -value : value);
+    } else if (exponent == 31) {
+      bits = sign | 0x7f800000 | (mantissa << 13);  // Infinity or NaN
+    } else {
+      bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+    }
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+  }
+
+  /** Convert a float to a half precision float, rounding to nearest even.
+   * Finite values that exceed the range of FLOAT16 are saturated to +/-65504.
+   * \param[in] value The float
+   * \return The bits of the half precision float
+   */
+  static uint16_t floatToHalf(float value);
+
+  /** The largest finite value of a half precision float. */
+  static constexpr double kMaxFloat16 = 65504.0;
+
+  /** Whether values can be stored as FLOAT16.
+   * \param[in] values The values
+   * \return true if the absolute values do not exceed kMaxFloat16
+   */
+  static bool isInFloat16Range(const Eigen::Ref<const Eigen::VectorXd>& values);
+
+  /** Read an object from json.
+   *  \param[in]  j   json input
+   *  \param[out] obj The object read from json
+   */
+  friend void from_json(const nlohmann::json& j, QuantizedArray*& obj);
+
+  /** Write an object to json.
+   *  \param[in] obj The object to write to json
+   *  \param[out]  j json output
+   */
+  friend void to_json(nlohmann::json& j, const QuantizedArray& obj);
+
+ private:
+  /** Number of values. */
+  int size_;
+
+  /** FLOAT32, FLOAT16 or INT16. */
+  int format_;
+
+  /** The values for FLOAT32 (empty otherwise). */
+  std::vector<float> data32_;
+
+  /** The values for FLOAT16 and INT16 (empty otherwise). */
+  std::vector<uint16_t> data16_;
+
+  /** Offset and scale for INT16. */
+  double offset_, scale_;
+};
+
+}  // namespace DmpBbo
+
+#endif  // _QUANTIZED_ARRAY_H_
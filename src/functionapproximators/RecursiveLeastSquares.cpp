@@ -0,0 +1,320 @@
+/**
+ * @file RecursiveLeastSquares.cpp
+ * @brief  RecursiveLeastSquares class source file.
+ *
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "functionapproximators/RecursiveLeastSquares.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+#include "eigenutils/eigen_realtime_check.hpp"
+#include "functionapproximators/BasisFunction.hpp"
+#include "functionapproximators/FunctionApproximatorLWR.hpp"
+#include "functionapproximators/FunctionApproximatorRBFN.hpp"
+
+using namespace std;
+using namespace Eigen;
+
+namespace DmpBbo {
+
+RecursiveLeastSquares* RecursiveLeastSquares::create(
+    const FunctionApproximator& fa, double forgetting_factor,
+    double initial_covariance, double activation_threshold)
+{
+  if (forgetting_factor <= 0.0 || forgetting_factor > 1.0) {
+    cerr << __FILE__ << ":" << __LINE__ << ":";
+    cerr << "Forgetting factor must be in (0, 1], but is " << forgetting_factor
+         << endl;
+    return NULL;
+  }
+  if (initial_covariance <= 0.0) {
+    cerr << __FILE__ << ":" << __LINE__ << ":";
+    cerr << "Initial covariance must be positive, but is "
+         << initial_covariance << endl;
+    return NULL;
+  }
+
+  const FunctionApproximatorRBFN* rbfn =
+      dynamic_cast<const FunctionApproximatorRBFN*>(&fa);
+  if (rbfn != NULL) {
+    FunctionApproximatorRBFN* copy = rbfn->clone();
+    return new RecursiveLeastSquares(copy, copy, NULL, forgetting_factor,
+                                     initial_covariance, activation_threshold);
+  }
+  const FunctionApproximatorLWR* lwr =
+      dynamic_cast<const FunctionApproximatorLWR*>(&fa);
+  if (lwr != NULL) {
+    FunctionApproximatorLWR* copy = lwr->clone();
+    return new RecursiveLeastSquares(copy, NULL, copy, forgetting_factor,
+                                     initial_covariance, activation_threshold);
+  }
+
+  cerr << __FILE__ << ":" << __LINE__ << ":";
+  cerr << "Recursive least squares is only possible for "
+       << "FunctionApproximatorRBFN and FunctionApproximatorLWR." << endl;
+  return NULL;
+}
+
+RecursiveLeastSquares::RecursiveLeastSquares(
+    FunctionApproximator* fa, FunctionApproximatorRBFN* rbfn,
+    FunctionApproximatorLWR* lwr, double forgetting_factor,
+    double initial_covariance, double activation_threshold)
+    : fa_(fa),
+      rbfn_(rbfn),
+      lwr_(lwr),
+      forgetting_factor_(forgetting_factor),
+      initial_covariance_(initial_covariance),
+      activation_threshold_(std::max(0.0, activation_threshold)),
+      parameters_changed_(false),
+      n_updates_(0),
+      n_active_basis_functions_(0),
+      window_begin_(0),
+      window_end_(0)
+{
+  if (rbfn_ != NULL) {
+    centers_ = &rbfn_->centers();
+    widths_ = &rbfn_->widths();
+    asymmetric_kernels_ = false;
+  } else {
+    centers_ = &lwr_->centers();
+    widths_ = &lwr_->widths();
+    asymmetric_kernels_ = lwr_->asymmetric_kernels();
+  }
+  n_basis_functions_ = centers_->rows();
+  n_input_dims_ = centers_->cols();
+
+  // The parameters of each basis function are in one column
+  if (rbfn_ != NULL) {
+    n_params_per_basis_ = 1;
+    parameters_ = rbfn_->weights().transpose();
+  } else {
+    n_params_per_basis_ = n_input_dims_ + 1;
+    parameters_.resize(n_params_per_basis_, n_basis_functions_);
+    parameters_.topRows(n_input_dims_) = lwr_->slopes().transpose();
+    parameters_.row(n_input_dims_) = lwr_->offsets().transpose();
+  }
+  if (rbfn_ != NULL)
+    covariances_.resize(n_basis_functions_, n_basis_functions_);
+  else
+    covariances_.resize(n_params_per_basis_,
+                        n_params_per_basis_ * n_basis_functions_);
+  resetCovariances();
+
+  // A window around the input requires the centers to be sorted
+  windowed_ = (n_input_dims_ == 1);
+  for (int bb = 1; windowed_ && bb < n_basis_functions_; bb++)
+    windowed_ = ((*centers_)(bb - 1, 0) <= (*centers_)(bb, 0));
+
+  activations_prealloc_ = MatrixXd::Zero(1, n_basis_functions_);
+  // For RBFN, these are also used for the basis functions in the window
+  int n_prealloc = std::max(n_params_per_basis_, n_basis_functions_);
+  features_prealloc_ = VectorXd::Zero(n_prealloc);
+  covariance_features_prealloc_ = VectorXd::Zero(n_prealloc);
+  parameter_vector_prealloc_ =
+      VectorXd::Zero(fa_->getLinearParameterVectorSize());
+}
+
+RecursiveLeastSquares::~RecursiveLeastSquares(void) { delete fa_; }
+
+void RecursiveLeastSquares::resetCovariances(void)
+{
+  if (rbfn_ != NULL) {
+    covariances_.setIdentity();
+  } else {
+    int m = n_params_per_basis_;
+    for (int bb = 0; bb < n_basis_functions_; bb++)
+      covariances_.block(0, bb * m, m, m).setIdentity();
+  }
+  covariances_ *= initial_covariance_;
+}
+
+double RecursiveLeastSquares::activation1D(int i_basis, double x) const
+{
+  double c = (*centers_)(i_basis, 0);
+  double w = (*widths_)(i_basis, 0);
+  if (asymmetric_kernels_ && x < c && i_basis > 0)
+    w = (*widths_)(i_basis - 1, 0);
+  return exp(-0.5 * pow(x - c, 2) / (w * w));
+}
+
+void RecursiveLeastSquares::computeActivations(
+    const Eigen::Ref<const Eigen::RowVectorXd>& input)
+{
+  if (windowed_) {
+    // Start at the center closest to the input, and extend the window to both
+    // sides until the activations drop below the threshold.
+    double x = input[0];
+    const double* centers = centers_->data();
+    int bb = std::lower_bound(centers, centers + n_basis_functions_, x) -
+             centers;
+    if (bb == n_basis_functions_ ||
+        (bb > 0 && x - centers[bb - 1] < centers[bb] - x))
+      bb--;
+    window_begin_ = bb;
+    window_end_ = bb;
+    double activation = activation1D(bb, x);
+    if (activation >= activation_threshold_) {
+      activations_prealloc_(0, bb) = activation;
+      window_end_ = bb + 1;
+      while (window_begin_ > 0) {
+        activation = activation1D(window_begin_ - 1, x);
+        if (activation < activation_threshold_) break;
+        activations_prealloc_(0, --window_begin_) = activation;
+      }
+      while (window_end_ < n_basis_functions_) {
+        activation = activation1D(window_end_, x);
+        if (activation < activation_threshold_) break;
+        activations_prealloc_(0, window_end_++) = activation;
+      }
+    }
+  } else {
+    // false, false => normalized_basis_functions, asymmetric_kernels
+    BasisFunction::Gaussian::activations(*centers_, *widths_, input,
+                                         activations_prealloc_, false,
+                                         asymmetric_kernels_);
+    for (int bb = 0; bb < n_basis_functions_; bb++)
+      if (activations_prealloc_(0, bb) < activation_threshold_)
+        activations_prealloc_(0, bb) = 0.0;
+    window_begin_ = 0;
+    window_end_ = n_basis_functions_;
+  }
+
+  if (lwr_ != NULL && window_end_ > window_begin_) {
+    // Normalize the activations, as in BasisFunction::Gaussian::activations()
+    int n_window = window_end_ - window_begin_;
+    auto activations =
+        activations_prealloc_.block(0, window_begin_, 1, n_window);
+    double sum_activations = activations.sum();
+    if (n_basis_functions_ == 1)
+      activations.fill(1.0);
+    else if (sum_activations == 0.0)
+      activations.fill(1.0 / n_basis_functions_);
+    else
+      activations /= sum_activations;
+  }
+}
+
+void RecursiveLeastSquares::updateRealTime(
+    const Eigen::Ref<const Eigen::RowVectorXd>& input, double target)
+{
+  ENTERING_REAL_TIME_CRITICAL_CODE
+
+  assert(input.size() == n_input_dims_);
+  computeActivations(input);
+
+  n_active_basis_functions_ = 0;
+  if (rbfn_ != NULL) {
+    // Recursive least squares for the weights of the basis functions in the
+    // window. Forgetting is applied to their covariances first.
+    int n_window = window_end_ - window_begin_;
+    auto activations = activations_prealloc_.row(0)
+                           .segment(window_begin_, n_window)
+                           .transpose();
+    auto weights =
+        parameters_.row(0).segment(window_begin_, n_window).transpose();
+    auto covariance =
+        covariances_.block(window_begin_, window_begin_, n_window, n_window);
+    auto scales = covariance_features_prealloc_.head(n_window);
+    for (int bb = 0; bb < n_window; bb++)
+      scales[bb] = pow(forgetting_factor_, -0.5 * activations[bb]);
+    for (int ii = 0; ii < n_window; ii++)
+      for (int jj = 0; jj < n_window; jj++)
+        covariance(ii, jj) *= scales[ii] * scales[jj];
+
+    auto gains = features_prealloc_.head(n_window);
+    gains.noalias() = covariance * activations;
+    double variance = 1.0 + activations.dot(gains);
+    double error = target - activations.dot(weights);
+    weights += (error / variance) * gains;
+    covariance.noalias() -= (1.0 / variance) * gains * gains.transpose();
+
+    // The covariances between the weights in and outside the window are not
+    // updated. Setting them to 0 keeps the covariance matrix positive
+    // semi-definite, i.e. the weights outside the window are considered to be
+    // independent of those in the window.
+    if (n_window < n_basis_functions_) {
+      covariances_.block(window_begin_, 0, n_window, window_begin_).setZero();
+      covariances_.block(0, window_begin_, window_begin_, n_window).setZero();
+      int n_after = n_basis_functions_ - window_end_;
+      covariances_.block(window_begin_, window_end_, n_window, n_after)
+          .setZero();
+      covariances_.block(window_end_, window_begin_, n_after, n_window)
+          .setZero();
+    }
+
+    for (int bb = 0; bb < n_window; bb++)
+      if (activations[bb] > 0.0) n_active_basis_functions_++;
+  } else {
+    // Weighted recursive least squares for the line of each basis function,
+    // with features [x 1]
+    int m = n_params_per_basis_;
+    auto features = features_prealloc_.head(m);
+    auto covariance_features = covariance_features_prealloc_.head(m);
+    features.head(n_input_dims_) = input.transpose();
+    features[n_input_dims_] = 1.0;
+    for (int bb = window_begin_; bb < window_end_; bb++) {
+      double a = activations_prealloc_(0, bb);
+      if (a <= 0.0) continue;
+      double lambda = pow(forgetting_factor_, a);
+      auto covariance = covariances_.block(0, bb * m, m, m);
+      covariance_features.noalias() = covariance * features;
+      double denominator = lambda + a * features.dot(covariance_features);
+      double error = target - features.dot(parameters_.col(bb));
+      parameters_.col(bb) += (a * error / denominator) * covariance_features;
+      covariance.noalias() -= (a / denominator) * covariance_features *
+                              covariance_features.transpose();
+      covariance /= lambda;
+      n_active_basis_functions_++;
+    }
+  }
+
+  if (n_active_basis_functions_ > 0) parameters_changed_ = true;
+  n_updates_++;
+
+  EXITING_REAL_TIME_CRITICAL_CODE
+}
+
+const FunctionApproximator& RecursiveLeastSquares::function_approximator(
+    void) const
+{
+  ENTERING_REAL_TIME_CRITICAL_CODE
+
+  if (parameters_changed_) {
+    // Same order as getLinearParameterVector()
+    if (rbfn_ != NULL) {
+      parameter_vector_prealloc_ = parameters_.row(0).transpose();
+    } else {
+      for (int bb = 0; bb < n_basis_functions_; bb++)
+        parameter_vector_prealloc_.segment(bb * n_input_dims_, n_input_dims_) =
+            parameters_.col(bb).head(n_input_dims_);
+      parameter_vector_prealloc_.tail(n_basis_functions_) =
+          parameters_.row(n_input_dims_).transpose();
+    }
+    fa_->setLinearParameterVector(parameter_vector_prealloc_);
+    parameters_changed_ = false;
+  }
+
+  EXITING_REAL_TIME_CRITICAL_CODE
+  return *fa_;
+}
+
+}  // namespace DmpBbo
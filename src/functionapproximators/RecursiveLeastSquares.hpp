@@ -0,0 +1,212 @@
+/**
+ * @file RecursiveLeastSquares.hpp
+ * @brief  RecursiveLeastSquares class header file.
+ *
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _RECURSIVE_LEAST_SQUARES_H_
+#define _RECURSIVE_LEAST_SQUARES_H_
+
+#define EIGEN_RUNTIME_NO_MALLOC  // Enable runtime tests for allocations
+
+#include <eigen3/Eigen/Core>
+
+namespace DmpBbo {
+
+// forward declaration
+class FunctionApproximator;
+class FunctionApproximatorRBFN;
+class FunctionApproximatorLWR;
+
+/** \brief Online adaptation of the parameters of an RBFN or LWR with
+ * recursive weighted least squares.
+ * \ingroup FunctionApproximators
+ *
+ * The learner works on its own copy of the function approximator, whose basis
+ * functions remain fixed. Each call to updateRealTime() adapts the parameters
+ * of the active basis functions with one step of recursive least squares.
+ *
+ * \li For LWR, each basis function has its own line, which is fitted to the
+ * targets with a weighted least squares regression, as in
+ * FunctionApproximatorLWR::train(). The recursive updates are therefore exact:
+ * without forgetting, the lines converge to those of a batch regression
+ * (regularized towards the initial lines by the initial covariance).
+ * \li For RBFN, the weights are fitted jointly, because the output is the sum
+ * of the weighted basis functions. The weights of the active basis functions
+ * are updated together with recursive least squares. The covariances between
+ * active and inactive basis functions are not updated, so the update is only
+ * exact if all basis functions are active, i.e. with an activation threshold
+ * of 0. Its cost is quadratic in the number of active basis functions.
+ *
+ * With a forgetting factor lambda < 1, older samples are discounted, so that
+ * the parameters keep tracking a changing target function. The forgetting is
+ * weighted with the activation of a basis function (lambda^activation), so
+ * that the covariances of basis functions that are not active do not grow.
+ *
+ * Basis functions with an (unnormalized) activation below the activation
+ * threshold are ignored, i.e. not updated, and not taken into account when
+ * normalizing the activations of LWR. For one-dimensional inputs, the
+ * activations are only computed in a window around the input, so that the
+ * cost of an update depends on the number of active basis functions, rather
+ * than on the total number of basis functions. The window assumes that
+ * activations decrease with the distance between the input and the centers,
+ * which holds for the basis functions of FunctionApproximatorRBFN::train()
+ * and FunctionApproximatorLWR::train(). With a threshold of 0, all basis
+ * functions are taken into account.
+ *
+ * All statistics are preallocated by create(), so updateRealTime() does not
+ * allocate memory. The updated parameters can be published to an executing
+ * Dmp with Dmp::copyFunctionApproximatorParametersRealTime().
+ */
+class RecursiveLeastSquares {
+ public:
+  /** Create a learner for a function approximator.
+   * \param[in] fa The function approximator with the initial parameters. It
+   * is copied, so it is not modified by the learner.
+   * \param[in] forgetting_factor Forgetting factor lambda (0 < lambda <= 1).
+   * 1 means that all samples are weighted equally.
+   * \param[in] initial_covariance Initial covariance of the parameters of each
+   * basis function. Smaller values keep the parameters closer to their
+   * initial values.
+   * \param[in] activation_threshold Basis functions with a lower
+   * (unnormalized) activation are ignored.
+   * \return The learner, or NULL if the function approximator is not an RBFN
+   * or LWR. The caller is responsible for deleting it.
+   */
+  static RecursiveLeastSquares* create(const FunctionApproximator& fa,
+                                       double forgetting_factor = 1.0,
+                                       double initial_covariance = 1000.0,
+                                       double activation_threshold = 0.0);
+
+  /** Destructor. */
+  ~RecursiveLeastSquares(void);
+
+  /** Update the parameters with one sample.
+   *
+   * This function is real-time; there will be no memory allocation.
+   *
+   * \param[in] input  Input value of the sample (1 x n_input_dims)
+   * \param[in] target Target value of the sample
+   */
+  void updateRealTime(const Eigen::Ref<const Eigen::RowVectorXd>& input,
+                      double target);
+
+  /** Reset the covariances to the initial covariance, so that subsequent
+   * samples have as much influence as the first ones. The parameters are not
+   * changed.
+   */
+  void resetCovariances(void);
+
+  /** Get the function approximator with the updated parameters.
+   *
+   * This function is real-time. It copies the parameters into the function
+   * approximator if they have changed since the last call, so its cost is
+   * linear in the total number of basis functions.
+   *
+   * \return The function approximator, which is owned by the learner.
+   */
+  const FunctionApproximator& function_approximator(void) const;
+
+  /** Get the number of updates since create().
+   * \return Number of calls to updateRealTime()
+   */
+  inline long n_updates(void) const { return n_updates_; }
+
+  /** Get the number of basis functions that were updated in the last update.
+   * \return Number of active basis functions
+   */
+  inline int n_active_basis_functions(void) const
+  {
+    return n_active_basis_functions_;
+  }
+
+ private:
+  /** Constructor, see create(). */
+  RecursiveLeastSquares(FunctionApproximator* fa,
+                        FunctionApproximatorRBFN* rbfn,
+                        FunctionApproximatorLWR* lwr, double forgetting_factor,
+                        double initial_covariance,
+                        double activation_threshold);
+
+  /** Not implemented. */
+  RecursiveLeastSquares(const RecursiveLeastSquares& other);
+
+  /** Not implemented. */
+  RecursiveLeastSquares& operator=(const RecursiveLeastSquares& other);
+
+  /** Compute the activations of the basis functions in [window_begin_,
+   * window_end_), normalized for LWR. Activations below the threshold are set
+   * to 0. Real-time.
+   * \param[in] input Input value (1 x n_input_dims)
+   */
+  void computeActivations(const Eigen::Ref<const Eigen::RowVectorXd>& input);
+
+  /** Compute the unnormalized activation of one basis function for a 1D
+   * input, as in BasisFunction::Gaussian::activations().
+   * \param[in] i_basis Index of the basis function
+   * \param[in] x The input
+   * \return The activation
+   */
+  double activation1D(int i_basis, double x) const;
+
+  /** The copy of the function approximator, owned by the learner. */
+  mutable FunctionApproximator* fa_;
+  /** fa_ if it is an RBFN, NULL otherwise. */
+  const FunctionApproximatorRBFN* rbfn_;
+  /** fa_ if it is an LWR, NULL otherwise. */
+  const FunctionApproximatorLWR* lwr_;
+  /** The centers and widths of the basis functions of fa_. */
+  const Eigen::MatrixXd* centers_;
+  const Eigen::MatrixXd* widths_;
+  bool asymmetric_kernels_;
+
+  int n_basis_functions_;
+  int n_input_dims_;
+  /** 1 for RBFN (the weight), n_input_dims_+1 for LWR (slopes and offset) */
+  int n_params_per_basis_;
+  double forgetting_factor_;
+  double initial_covariance_;
+  double activation_threshold_;
+  /** Whether the activations can be computed in a window around the input. */
+  bool windowed_;
+
+  /** Parameters of each basis function (n_params_per_basis_ X n_basis) */
+  Eigen::MatrixXd parameters_;
+  /** For LWR, the covariance matrix of each basis function, side by side
+   * (n_params_per_basis_ X n_params_per_basis_ * n_basis). For RBFN, the
+   * covariance matrix of all weights (n_basis X n_basis). */
+  Eigen::MatrixXd covariances_;
+  /** Whether parameters_ has changed since it was copied into fa_. */
+  mutable bool parameters_changed_;
+  long n_updates_;
+  int n_active_basis_functions_;
+
+  /** Preallocated memory for one update, required to make updateRealTime()
+   * real-time. */
+  Eigen::MatrixXd activations_prealloc_;
+  Eigen::VectorXd features_prealloc_;
+  Eigen::VectorXd covariance_features_prealloc_;
+  mutable Eigen::VectorXd parameter_vector_prealloc_;
+  int window_begin_;
+  int window_end_;
+};
+
+}  // namespace DmpBbo
+
+#endif  // _RECURSIVE_LEAST_SQUARES_H_
@@ -0,0 +1,153 @@
+/**
+ * @file ThreadPool.hpp
+ * @brief  ThreadPool class header file.
+ *
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _THREAD_POOL_H_
+#define _THREAD_POOL_H_
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace DmpBbo {
+
+/** \brief A persistent pool of worker threads.
+ *
+ * The threads are created once, and wait for work in between calls of
+ * parallelFor(). This avoids the cost of creating threads for each parallel
+ * computation.
+ *
+ * Results are deterministic if each task writes to its own part of the output,
+ * and the division of the work into tasks does not depend on the number of
+ * threads, or on which thread executes which task.
+ */
+class ThreadPool {
+ public:
+  /** Constructor.
+   * \param[in] n_threads Number of worker threads. If 0 or smaller, the number
+   * of hardware threads is used.
+   */
+  explicit ThreadPool(int n_threads = 0) : stop_(false), task_(NULL)
+  {
+    if (n_threads <= 0) n_threads = std::thread::hardware_concurrency();
+    if (n_threads <= 0) n_threads = 1;
+    for (int i_thread = 0; i_thread < n_threads; i_thread++)
+      threads_.push_back(std::thread(&ThreadPool::workerLoop, this));
+  }
+
+  /** Destructor. Waits for the worker threads to finish. */
+  ~ThreadPool(void)
+  {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    work_available_.notify_all();
+    for (unsigned int i_thread = 0; i_thread < threads_.size(); i_thread++)
+      threads_[i_thread].join();
+  }
+
+  /** Get the number of worker threads.
+   * \return Number of worker threads
+   */
+  inline int n_threads(void) const { return threads_.size(); }
+
+  /** Execute task(i_task) for all i_task in [0, n_tasks) on the worker
+   * threads, and wait until all of them have finished.
+   *
+   * \param[in] n_tasks Number of tasks
+   * \param[in] task Function to call for each task
+   *
+   * \remarks Calls from different threads are serialized. Calling parallelFor()
+   * from within a task leads to a deadlock.
+   */
+  void parallelFor(int n_tasks, const std::function<void(int)>& task)
+  {
+    if (n_tasks <= 0) return;
+
+    std::unique_lock<std::mutex> call_lock(call_mutex_);
+    std::unique_lock<std::mutex> lock(mutex_);
+    task_ = &task;
+    n_tasks_ = n_tasks;
+    next_task_ = 0;
+    n_tasks_done_ = 0;
+    work_available_.notify_all();
+    work_done_.wait(lock, [this] { return n_tasks_done_ == n_tasks_; });
+    task_ = NULL;
+  }
+
+ private:
+  /** Function executed by each worker thread. */
+  void workerLoop(void)
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+      work_available_.wait(lock, [this] {
+        return stop_ || (task_ != NULL && next_task_ < n_tasks_);
+      });
+      if (stop_) return;
+
+      int i_task = next_task_++;
+      const std::function<void(int)>* task = task_;
+      lock.unlock();
+      (*task)(i_task);
+      lock.lock();
+
+      if (++n_tasks_done_ == n_tasks_) work_done_.notify_all();
+    }
+  }
+
+  /** The worker threads. */
+  std::vector<std::thread> threads_;
+
+  /** Protects all members below. */
+  std::mutex mutex_;
+
+  /** Serializes calls to parallelFor(). */
+  std::mutex call_mutex_;
+
+  /** Signals the workers that there are tasks, or that they should stop. */
+  std::condition_variable work_available_;
+
+  /** Signals parallelFor() that all tasks are done. */
+  std::condition_variable work_done_;
+
+  /** Whether the workers should stop. */
+  bool stop_;
+
+  /** Function to execute for each task (NULL if there is no work). */
+  const std::function<void(int)>* task_;
+
+  /** Number of tasks in the current call of parallelFor(). */
+  int n_tasks_;
+
+  /** Index of the next task to execute. */
+  int next_task_;
+
+  /** Number of tasks that have finished. */
+  int n_tasks_done_;
+};
+
+}  // namespace DmpBbo
+
+#endif  // _THREAD_POOL_H_
@@ -79,6 +79,25 @@ int main(int n_args, char** args)
   saveMatrix(directory, "forcing_terms_ana.txt", forcing_terms, overwrite);
   saveMatrix(directory, "fa_outputs_ana.txt", fa_outputs, overwrite);
 
+  if (verbose) cout << "===============" << endl << "C++ Seek";
+
+  // Query the states in reverse order, to exercise random access
+  int checkpoint_interval = 10;
+  dmp->prepareSeek(ts, checkpoint_interval);
+  MatrixXd xs_seek(ts.size(), dmp->dim());
+  MatrixXd xds_seek(ts.size(), dmp->dim());
+  VectorXd x_seek(dmp->dim());
+  VectorXd xd_seek(dmp->dim());
+  for (int t = ts.size() - 1; t >= 0; t--) {
+    dmp->seek(ts[t], x_seek, xd_seek);
+    xs_seek.row(t) = x_seek;
+    xds_seek.row(t) = xd_seek;
+  }
+
+  if (verbose) cout << " (saving)" << endl;
+  saveMatrix(directory, "xs_seek.txt", xs_seek, overwrite);
+  saveMatrix(directory, "xds_seek.txt", xds_seek, overwrite);
+
   if (verbose) cout << "===============" << endl << "C++ Numerical integration";
 
   VectorXd x(dmp->dim(), 1);
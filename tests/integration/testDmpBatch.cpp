@@ -0,0 +1,119 @@
+/**
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <fstream>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "dmp/Dmp.hpp"
+
+using namespace std;
+using namespace Eigen;
+using namespace DmpBbo;
+using namespace nlohmann;
+
+int main(int n_args, char** args)
+{
+  if (n_args != 2) {
+    cout << "Usage: " << args[0] << " <dmp filename.json>" << endl;
+    return -1;
+  }
+
+  ifstream file(args[1]);
+  if (file.fail()) {
+    cerr << "Could not find: " << args[1] << endl;
+    return -1;
+  }
+  Dmp* dmp = json::parse(file).get<Dmp*>();
+  int D = dmp->dim_y();
+  bool all_ok = true;
+
+  int n_samples = 20;
+  int n_time_steps = 500;
+  VectorXd ts = VectorXd::LinSpaced(n_time_steps, 0.0, 1.2 * dmp->tau());
+  VectorXd mean;
+  dmp->getLinearParameterVector(mean);
+  MatrixXd samples = mean.transpose().replicate(n_samples, 1);
+  samples += 10.0 * MatrixXd::Random(n_samples, mean.size());
+
+  double tolerance = 10e-10;
+  for (string integration : {"EULER", "EXACT_ZOH", "EXACT_FOH"}) {
+    dmp->set_analytical_solution_integration(integration);
+
+    // One analytical solution per sample
+    Dmp* dmp_loop = dmp->clone();
+    MatrixXd ys_loop(n_time_steps, n_samples * D);
+    MatrixXd xs, xds;
+    for (int i_sample = 0; i_sample < n_samples; i_sample++) {
+      dmp_loop->setLinearParameterVector(samples.row(i_sample));
+      dmp_loop->analyticalSolution(ts, xs, xds);
+      ys_loop.middleCols(i_sample * D, D) = xs.leftCols(D);
+    }
+    delete dmp_loop;
+
+    // All samples at once
+    MatrixXd ys, yds, ydds;
+    dmp->analyticalSolutionBatch(ts, samples, ys, yds, ydds);
+    double max_diff = (ys - ys_loop).cwiseAbs().maxCoeff();
+    cout << integration << ": max |y_batch - y_loop| = " << max_diff << endl;
+    if (max_diff > tolerance) {
+      cerr << "analyticalSolutionBatch() differs by more than " << tolerance
+           << " from analyticalSolution()" << endl;
+      all_ok = false;
+    }
+  }
+
+  // Concurrent calls with different times, which replace each other's cached
+  // features, must give the same results as serial calls.
+  int n_threads = 4;
+  vector<VectorXd> ts_threads(n_threads);
+  vector<MatrixXd> ys_serial(n_threads), ys_threads(n_threads);
+  MatrixXd yds, ydds;
+  for (int i_thread = 0; i_thread < n_threads; i_thread++) {
+    int n = n_time_steps + 10 * i_thread;
+    ts_threads[i_thread] = VectorXd::LinSpaced(n, 0.0, 1.2 * dmp->tau());
+    dmp->analyticalSolutionBatch(ts_threads[i_thread], samples,
+                                 ys_serial[i_thread], yds, ydds);
+  }
+  vector<thread> threads;
+  for (int i_thread = 0; i_thread < n_threads; i_thread++) {
+    threads.push_back(thread([&, i_thread] {
+      MatrixXd yds_thread, ydds_thread;
+      for (int i_repeat = 0; i_repeat < 20; i_repeat++)
+        dmp->analyticalSolutionBatch(ts_threads[i_thread], samples,
+                                     ys_threads[i_thread], yds_thread,
+                                     ydds_thread);
+    }));
+  }
+  for (int i_thread = 0; i_thread < n_threads; i_thread++) {
+    threads[i_thread].join();
+    if (ys_threads[i_thread] != ys_serial[i_thread]) {
+      cerr << "Concurrent calls of analyticalSolutionBatch() differ from "
+           << "serial calls" << endl;
+      all_ok = false;
+    }
+  }
+
+  delete dmp;
+
+  return all_ok ? 0 : -1;
+}
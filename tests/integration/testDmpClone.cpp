@@ -0,0 +1,184 @@
+/**
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <fstream>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "dmp/Dmp.hpp"
+
+using namespace std;
+using namespace Eigen;
+using namespace DmpBbo;
+using namespace nlohmann;
+
+/** Integrate a Dmp with integrateStep(), and return the states over time.
+ * \param[in] dmp The Dmp to integrate
+ * \param[in] n_steps Number of time steps
+ * \param[out] xs States over time (n_steps x dim)
+ */
+void integrate(const Dmp* dmp, int n_steps, MatrixXd& xs)
+{
+  double dt = 0.001;
+  VectorXd x(dmp->dim()), xd(dmp->dim());
+  xs.resize(n_steps, dmp->dim());
+  dmp->integrateStart(x, xd);
+  for (int i_step = 0; i_step < n_steps; i_step++) {
+    dmp->integrateStep(dt, x, x, xd);
+    xs.row(i_step) = x;
+  }
+}
+
+int main(int n_args, char** args)
+{
+  if (n_args != 2) {
+    cout << "Usage: " << args[0] << " <dmp filename.json>" << endl;
+    return -1;
+  }
+
+  ifstream file(args[1]);
+  if (file.fail()) {
+    cerr << "Could not find: " << args[1] << endl;
+    return -1;
+  }
+  json j = json::parse(file);
+  bool all_ok = true;
+
+  int n_clones = 4;
+  int n_steps = 2000;
+  for (bool packed : {false, true}) {
+    Dmp* dmp = j.get<Dmp*>();
+    if (packed && !dmp->packForcingTerm()) {
+      cerr << "Could not pack the forcing term" << endl;
+      all_ok = false;
+    }
+
+    // Clones with different goals, and different parameters for one of them
+    vector<Dmp*> clones(n_clones);
+    for (int i_clone = 0; i_clone < n_clones; i_clone++) {
+      clones[i_clone] = dmp->clone();
+      clones[i_clone]->set_y_attr(VectorXd::Constant(dmp->dim_y(), i_clone));
+    }
+    VectorXd weights;
+    dmp->getLinearParameterVector(weights);
+    clones[0]->setLinearParameterVector(2.0 * weights);
+
+    vector<MatrixXd> xs_serial(n_clones), xs_threads(n_clones);
+    for (int i_clone = 0; i_clone < n_clones; i_clone++)
+      integrate(clones[i_clone], n_steps, xs_serial[i_clone]);
+
+    // Integrate all clones at the same time
+    vector<thread> threads;
+    for (int i_clone = 0; i_clone < n_clones; i_clone++)
+      threads.push_back(thread(integrate, clones[i_clone], n_steps,
+                               std::ref(xs_threads[i_clone])));
+    for (int i_clone = 0; i_clone < n_clones; i_clone++) {
+      threads[i_clone].join();
+      if (xs_threads[i_clone] != xs_serial[i_clone]) {
+        cerr << "Clone " << i_clone << " (packed: " << packed
+             << ") differs when the clones are integrated concurrently" << endl;
+        all_ok = false;
+      }
+    }
+
+    // Changing the parameters of clone 0 must not change the original
+    MatrixXd xs_original, xs_reference;
+    integrate(dmp, n_steps, xs_original);
+    Dmp* dmp_reference = j.get<Dmp*>();
+    integrate(dmp_reference, n_steps, xs_reference);
+    double max_diff = (xs_original - xs_reference).cwiseAbs().maxCoeff();
+    if (max_diff > 10e-12) {
+      cerr << "Changing the parameters of a clone changed the original Dmp"
+           << endl;
+      all_ok = false;
+    }
+
+    // The real-time copies must not change parameters shared with a clone
+    Dmp* target = dmp->clone();
+    if (target->copyParametersRealTime(*clones[0]) ||
+        target->copyFunctionApproximatorParametersRealTime(
+            0, *clones[0]->function_approximator(0))) {
+      cerr << "Copied parameters into a Dmp that shares them (packed: "
+           << packed << ")" << endl;
+      all_ok = false;
+    }
+    target->unshareParameters();
+    MatrixXd xs_target;
+    if (!target->copyParametersRealTime(*clones[0])) {
+      cerr << "Could not copy parameters into an unshared Dmp (packed: "
+           << packed << ")" << endl;
+      all_ok = false;
+    } else {
+      target->set_y_attr(VectorXd::Constant(dmp->dim_y(), 0.0));
+      integrate(target, n_steps, xs_target);
+      if (xs_target != xs_serial[0]) {
+        cerr << "The copied parameters differ from those of the clone"
+             << endl;
+        all_ok = false;
+      }
+    }
+    integrate(dmp, n_steps, xs_original);
+    if ((xs_original - xs_reference).cwiseAbs().maxCoeff() > 10e-12) {
+      cerr << "Copying parameters into a clone changed the original Dmp"
+           << endl;
+      all_ok = false;
+    }
+    delete target;
+
+    // Clones do not copy the caches of analyticalSolutionBatch() and seek(),
+    // but give the same results once these are computed again.
+    VectorXd ts = VectorXd::LinSpaced(n_steps, 0.0, 1.2 * dmp->tau());
+    MatrixXd samples = weights.transpose().replicate(3, 1);
+    samples.row(1) *= 2.0;
+    MatrixXd ys, yds, ydds, ys_clone, yds_clone, ydds_clone;
+    dmp->analyticalSolutionBatch(ts, samples, ys, yds, ydds);
+    dmp->prepareSeek(ts);
+    Dmp* clone = dmp->clone();
+    if (clone->isSeekPrepared()) {
+      cerr << "The checkpoints of prepareSeek() were copied" << endl;
+      all_ok = false;
+    }
+    clone->analyticalSolutionBatch(ts, samples, ys_clone, yds_clone,
+                                   ydds_clone);
+    if (ys_clone != ys || yds_clone != yds || ydds_clone != ydds) {
+      cerr << "analyticalSolutionBatch() differs for a clone" << endl;
+      all_ok = false;
+    }
+    VectorXd x(dmp->dim()), xd(dmp->dim());
+    VectorXd x_clone(dmp->dim()), xd_clone(dmp->dim());
+    clone->prepareSeek(ts);
+    dmp->seek(0.5 * dmp->tau(), x, xd);
+    clone->seek(0.5 * dmp->tau(), x_clone, xd_clone);
+    if (x_clone != x || xd_clone != xd) {
+      cerr << "seek() differs for a clone" << endl;
+      all_ok = false;
+    }
+    delete clone;
+
+    delete dmp_reference;
+    for (int i_clone = 0; i_clone < n_clones; i_clone++)
+      delete clones[i_clone];
+    delete dmp;
+  }
+
+  return all_ok ? 0 : -1;
+}
@@ -0,0 +1,101 @@
+/**
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include <string>
+
+#include "dmp/Dmp.hpp"
+
+// Generated with exportDmpToCpp from the same json file, cf. CMakeLists.txt
+#include "generated_dmp_euler.hpp"
+#include "generated_dmp_runge_kutta.hpp"
+
+using namespace std;
+using namespace Eigen;
+using namespace DmpBbo;
+using namespace nlohmann;
+
+/** Compare the integration of a Dmp with that of the generated code.
+ * \param[in] dmp The Dmp
+ * \param[in] integration "EULER" or "RUNGE_KUTTA"
+ * \param[in] dt Time step of the generated code
+ * \param[in] integrateStart integrateStart() of the generated code
+ * \param[in] integrateStep integrateStep() of the generated code
+ * \return Maximum absolute difference between the states
+ */
+double compare(const Dmp* dmp, string integration, double dt,
+               void (*integrateStart)(double*, double*),
+               void (*integrateStep)(const double*, double*, double*))
+{
+  int dim_x = dmp->dim();
+  VectorXd x(dim_x), xd(dim_x);
+  VectorXd x_gen(dim_x), xd_gen(dim_x);
+  dmp->integrateStart(x, xd);
+  integrateStart(x_gen.data(), xd_gen.data());
+  double max_diff = (x - x_gen).cwiseAbs().maxCoeff();
+  max_diff = std::max(max_diff, (xd - xd_gen).cwiseAbs().maxCoeff());
+
+  int n_time_steps = ceil(1.5 * dmp->tau() / dt);
+  for (int t = 1; t < n_time_steps; t++) {
+    if (integration == "EULER")
+      dmp->integrateStepEuler(dt, x, x, xd);
+    else
+      dmp->integrateStepRungeKutta(dt, x, x, xd);
+    integrateStep(x_gen.data(), x_gen.data(), xd_gen.data());
+    max_diff = std::max(max_diff, (x - x_gen).cwiseAbs().maxCoeff());
+    max_diff = std::max(max_diff, (xd - xd_gen).cwiseAbs().maxCoeff());
+  }
+  cout << integration << ": max difference over " << n_time_steps
+       << " time steps: " << max_diff << endl;
+  return max_diff;
+}
+
+int main(int n_args, char** args)
+{
+  if (n_args != 2) {
+    cout << "Usage: " << args[0] << " <dmp filename.json>" << endl;
+    return -1;
+  }
+
+  ifstream file(args[1]);
+  if (file.fail()) {
+    cerr << "Could not find: " << args[1] << endl;
+    return -1;
+  }
+  Dmp* dmp = json::parse(file).get<Dmp*>();
+
+  double max_diff_euler =
+      compare(dmp, "EULER", dmp_euler::kDt, dmp_euler::integrateStart,
+              dmp_euler::integrateStep);
+  double max_diff_rk = compare(dmp, "RUNGE_KUTTA", dmp_runge_kutta::kDt,
+                               dmp_runge_kutta::integrateStart,
+                               dmp_runge_kutta::integrateStep);
+  delete dmp;
+
+  double tolerance = 10e-10;
+  if (max_diff_euler > tolerance || max_diff_rk > tolerance) {
+    cerr << "Generated code differs from Dmp by more than " << tolerance
+         << endl;
+    return -1;
+  }
+  return 0;
+}
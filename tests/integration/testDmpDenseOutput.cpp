@@ -0,0 +1,116 @@
+/**
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define EIGEN_RUNTIME_NO_MALLOC  // Enable runtime tests for allocations
+
+#include <eigen3/Eigen/Core>
+#include <fstream>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include <string>
+
+#include "dmp/Dmp.hpp"
+#include "eigenutils/eigen_realtime_check.hpp"
+
+using namespace std;
+using namespace Eigen;
+using namespace DmpBbo;
+using namespace nlohmann;
+
+int main(int n_args, char** args)
+{
+  if (n_args != 2) {
+    cout << "Usage: " << args[0] << " <dmp filename.json>" << endl;
+    return -1;
+  }
+
+  ifstream file(args[1]);
+  if (file.fail()) {
+    cerr << "Could not find: " << args[1] << endl;
+    return -1;
+  }
+  Dmp* dmp = json::parse(file).get<Dmp*>();
+  bool all_ok = true;
+
+  // Integrate at 500Hz, output at 4kHz
+  double dt = 1.0 / 500.0;
+  int n_outputs_per_step = 8;
+  int n_steps = floor(1.2 * dmp->tau() / dt);
+
+  // The reference for each output is integrated from the start of the step
+  // with the same number of Runge-Kutta steps as outputs, so that the
+  // difference is mainly due to the interpolation. Only the spring-damper
+  // part is compared, i.e. the part from which y, yd and ydd are computed. The
+  // phase of some Dmps has a kink at tau, which cannot be interpolated.
+  Dmp* dmp_reference = dmp->clone();
+  VectorXd x(dmp->dim()), xd(dmp->dim()), x_prev(dmp->dim());
+  VectorXd x_interp(dmp->dim()), xd_interp(dmp->dim());
+  VectorXd x_ref(dmp->dim()), xd_ref(dmp->dim());
+  double max_error = 0.0;
+  double max_error_estimate = 0.0;
+  double max_diff_ends = 0.0;
+  int n_spring = 2 * dmp->dim_y();
+  dmp->integrateStart(x, xd);
+  for (int i_step = 0; i_step < n_steps; i_step++) {
+    x_prev = x;
+    dmp->integrateStepRungeKutta(dt, x, x, xd);
+
+    ENTERING_REAL_TIME_CRITICAL_CODE
+    double error_estimate = dmp->interpolateStepErrorEstimate();
+    dmp->interpolateStep(0.0, x_interp, xd_interp);
+    double diff_ends = (x_interp - x_prev).cwiseAbs().maxCoeff();
+    dmp->interpolateStep(dt, x_interp, xd_interp);
+    diff_ends = max(diff_ends, (x_interp - x).cwiseAbs().maxCoeff());
+    EXITING_REAL_TIME_CRITICAL_CODE
+
+    max_error_estimate = max(max_error_estimate, error_estimate);
+    max_diff_ends = max(max_diff_ends, diff_ends);
+
+    x_ref = x_prev;
+    double dt_output = dt / n_outputs_per_step;
+    for (int i_out = 1; i_out < n_outputs_per_step; i_out++) {
+      dmp_reference->integrateStepRungeKutta(dt_output, x_ref, x_ref, xd_ref);
+      dmp->interpolateStep(i_out * dt_output, x_interp, xd_interp);
+      double error = (x_interp - x_ref).head(n_spring).cwiseAbs().maxCoeff();
+      max_error = max(max_error, error);
+    }
+  }
+
+  cout << "max |x_interpolated - x_reference| = " << max_error << endl;
+  cout << "max error estimate                 = " << max_error_estimate
+       << endl;
+  cout << "max difference at the step ends    = " << max_diff_ends << endl;
+  if (max_diff_ends > 10e-14) {
+    cerr << "The interpolation does not pass through the integrated states"
+         << endl;
+    all_ok = false;
+  }
+  if (max_error > 10e-6) {
+    cerr << "The interpolation error is too large" << endl;
+    all_ok = false;
+  }
+  if (max_error > 10.0 * max_error_estimate) {
+    cerr << "The interpolation error is underestimated" << endl;
+    all_ok = false;
+  }
+
+  delete dmp_reference;
+  delete dmp;
+  return all_ok ? 0 : -1;
+}
@@ -0,0 +1,105 @@
+/**
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <fstream>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include <string>
+
+#include "dmp/Dmp.hpp"
+
+using namespace std;
+using namespace Eigen;
+using namespace DmpBbo;
+using namespace nlohmann;
+
+int main(int n_args, char** args)
+{
+  if (n_args != 2) {
+    cout << "Usage: " << args[0] << " <dmp filename.json>" << endl;
+    return -1;
+  }
+
+  ifstream file(args[1]);
+  if (file.fail()) {
+    cerr << "Could not find: " << args[1] << endl;
+    return -1;
+  }
+  Dmp* dmp = json::parse(file).get<Dmp*>();
+  int D = dmp->dim_y();
+  bool all_ok = true;
+
+  // Reference: Runge-Kutta integration with a small time step
+  int n_coarse = 100;
+  int n_substeps = 100;
+  double dt = 1.2 * dmp->tau() / n_coarse;
+  VectorXd ts = VectorXd::LinSpaced(n_coarse + 1, 0.0, n_coarse * dt);
+  MatrixXd ys_reference(n_coarse + 1, D);
+  VectorXd x(dmp->dim()), xd(dmp->dim());
+  dmp->integrateStart(x, xd);
+  ys_reference.row(0) = x.head(D);
+  for (int tt = 1; tt <= n_coarse; tt++) {
+    for (int ss = 0; ss < n_substeps; ss++)
+      dmp->integrateStepRungeKutta(dt / n_substeps, x, x, xd);
+    ys_reference.row(tt) = x.head(D);
+  }
+
+  // The exact integration of the spring-damper system must be more accurate
+  // than Euler integration at the same time step.
+  double tolerances[3] = {5e-02, 2e-02, 10e-04};
+  double max_diffs[3];
+  int i_integration = 0;
+  for (string integration : {"EULER", "EXACT_ZOH", "EXACT_FOH"}) {
+    dmp->set_analytical_solution_integration(integration);
+    MatrixXd xs, xds;
+    dmp->analyticalSolution(ts, xs, xds);
+    double max_diff = (xs.leftCols(D) - ys_reference).cwiseAbs().maxCoeff();
+    double tolerance = tolerances[i_integration];
+    max_diffs[i_integration++] = max_diff;
+    cout << integration << ": max |y - y_reference| = " << max_diff << endl;
+    if (max_diff > tolerance) {
+      cerr << integration << " differs from Runge-Kutta integration by more "
+           << "than " << tolerance << endl;
+      all_ok = false;
+    }
+  }
+  if (!(max_diffs[2] < max_diffs[1] && max_diffs[1] < max_diffs[0])) {
+    cerr << "Exact integration is not more accurate than Euler integration"
+         << endl;
+    all_ok = false;
+  }
+
+  // Parallel integration must give the same result as serial integration
+  VectorXd ts_fine = VectorXd::LinSpaced(10001, 0.0, n_coarse * dt);
+  MatrixXd xs_serial, xds_serial, xs_parallel, xds_parallel;
+  dmp->analyticalSolution(ts_fine, xs_serial, xds_serial);
+  dmp->set_analytical_solution_n_threads(4);
+  dmp->analyticalSolution(ts_fine, xs_parallel, xds_parallel);
+  double max_diff = (xs_parallel - xs_serial).cwiseAbs().maxCoeff();
+  max_diff = max(max_diff, (xds_parallel - xds_serial).cwiseAbs().maxCoeff());
+  cout << "max |x_parallel - x_serial| = " << max_diff << endl;
+  if (max_diff > 10e-12) {
+    cerr << "Parallel and serial integration differ by " << max_diff << endl;
+    all_ok = false;
+  }
+
+  delete dmp;
+
+  return all_ok ? 0 : -1;
+}
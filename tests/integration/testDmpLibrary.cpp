@@ -0,0 +1,175 @@
+/**
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <eigen3/Eigen/Core>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+
+#include "dmp/Dmp.hpp"
+#include "dmp/DmpLibrary.hpp"
+#include "dmp/DmpLibraryIndex.hpp"
+#include "eigenutils/eigen_json.hpp"
+
+using namespace std;
+using namespace Eigen;
+using namespace DmpBbo;
+using namespace nlohmann;
+
+int main(int n_args, char** args)
+{
+  if (n_args != 2) {
+    cout << "Usage: " << args[0] << " <dmp filename.json>" << endl;
+    return -1;
+  }
+
+  ifstream file(args[1]);
+  if (file.fail()) {
+    cerr << "Could not find: " << args[1] << endl;
+    return -1;
+  }
+  json j = json::parse(file);
+  bool all_ok = true;
+
+  // Dmps with random initial and attractor states and time constants
+  int n_dmps = 500;
+  int dim_y = j.at("_y_init").get<VectorXd>().size();
+  srand(0);
+  vector<json> j_dmps(n_dmps);
+  vector<string> names(n_dmps);
+  for (int i_dmp = 0; i_dmp < n_dmps; i_dmp++) {
+    VectorXd y_init = VectorXd::Random(dim_y);
+    VectorXd y_attr = VectorXd::Random(dim_y);
+    j_dmps[i_dmp] = j;
+    j_dmps[i_dmp]["_y_init"] = y_init;
+    j_dmps[i_dmp]["_y_attr"] = y_attr;
+    j_dmps[i_dmp]["_tau"] = 1.0 + 0.5 * (VectorXd::Random(1)[0] + 1.0);
+    // The goal system stores its own copy of the initial and attractor state.
+    j_dmps[i_dmp]["_goal_system"]["_x_init"] = y_init;
+    j_dmps[i_dmp]["_goal_system"]["_x_attr"] = y_attr;
+    names[i_dmp] = "dmp_" + to_string(i_dmp);
+  }
+
+  string filename_library = "testDmpLibrary.dmplib";
+  if (!DmpLibrary::write(filename_library, names, j_dmps)) return -1;
+  DmpLibrary* library = DmpLibrary::open(filename_library, 8);
+  if (library == NULL) return -1;
+
+  // Round trip: the index and the loaded Dmps are those that were written
+  VectorXd ts = VectorXd::LinSpaced(101, 0.0, 2.5);
+  MatrixXd xs, xds, xs_loaded, xds_loaded;
+  double max_diff = 0.0;
+  for (int i_dmp = 0; i_dmp < n_dmps; i_dmp++) {
+    int i_library = library->find(names[i_dmp]);
+    const json& j_dmp = j_dmps[i_dmp];
+    if (i_library < 0 || library->name(i_library) != names[i_dmp] ||
+        library->dim_y(i_library) != dim_y ||
+        library->tau(i_library) != j_dmp.at("_tau").get<double>() ||
+        library->y_init(i_library) != j_dmp.at("_y_init").get<VectorXd>() ||
+        library->y_attr(i_library) != j_dmp.at("_y_attr").get<VectorXd>()) {
+      cerr << "The index entry of " << names[i_dmp] << " differs" << endl;
+      all_ok = false;
+      continue;
+    }
+    if (i_dmp % 25 != 0) continue;
+    Dmp* dmp = j_dmp.get<Dmp*>();
+    dmp->analyticalSolution(ts, xs, xds);
+    // Twice, to also compare the Dmp from the cache.
+    for (int i_get = 0; i_get < 2; i_get++) {
+      library->get(i_library)->analyticalSolution(ts, xs_loaded, xds_loaded);
+      max_diff = max(max_diff, (xs - xs_loaded).cwiseAbs().maxCoeff());
+    }
+    delete dmp;
+  }
+  cout << "max |xs - xs_loaded| = " << max_diff << endl;
+  if (max_diff > 10e-12) {
+    cerr << "The loaded Dmps differ from the written ones" << endl;
+    all_ok = false;
+  }
+  if (library->find("no_such_dmp") != -1 || library->get("no_such_dmp")) {
+    cerr << "Found a Dmp that is not in the library" << endl;
+    all_ok = false;
+  }
+  if (library->get(0) == library->get(0)) {
+    cerr << "get() returned the same Dmp twice" << endl;
+    all_ok = false;
+  }
+
+  // k-nearest neighbors and radius queries against a brute force search
+  int k = 5;
+  double radius = 0.5;
+  DmpLibraryIndex index(library);
+  MatrixXd descriptors(index.dim_descriptor(), n_dmps);
+  for (int i_dmp = 0; i_dmp < n_dmps; i_dmp++)
+    descriptors.col(i_dmp) = index.descriptor(
+        library->y_init(i_dmp), library->y_attr(i_dmp), library->tau(i_dmp));
+  int n_queries = 200;
+  int n_different = 0;
+  vector<int> nearest, within;
+  vector<double> distances;
+  for (int i_query = 0; i_query < n_queries; i_query++) {
+    VectorXd query = index.descriptor(VectorXd::Random(dim_y),
+                                      VectorXd::Random(dim_y), 1.5);
+    index.nearest(query, k, nearest, distances);
+    index.withinRadius(query, radius, within, distances);
+
+    VectorXd sq_dists =
+        (descriptors.colwise() - query).colwise().squaredNorm();
+    vector<int> order(n_dmps);
+    for (int i_dmp = 0; i_dmp < n_dmps; i_dmp++) order[i_dmp] = i_dmp;
+    sort(order.begin(), order.end(),
+         [&sq_dists](int a, int b) { return sq_dists(a) < sq_dists(b); });
+    vector<int> within_brute;
+    for (int i = 0; i < n_dmps && sq_dists(order[i]) <= radius * radius; i++)
+      within_brute.push_back(order[i]);
+    order.resize(k);
+    if (order != nearest || within_brute != within) n_different++;
+  }
+  cout << "queries that differ from brute force: " << n_different << " of "
+       << n_queries << endl;
+  if (n_different > 0) all_ok = false;
+  delete library;
+
+  // A library whose index points outside the file must be rejected.
+  ifstream library_file(filename_library, ios::binary);
+  string image((istreambuf_iterator<char>(library_file)),
+               istreambuf_iterator<char>());
+  library_file.close();
+  // Header (24 bytes), then the name (64 bytes), dim_y and n_basis_functions
+  // of the first entry.
+  uint64_t descriptors_offset = image.size() - 8;
+  memcpy(&image[24 + 64 + 8], &descriptors_offset, sizeof(uint64_t));
+  string filename_corrupt = "testDmpLibraryCorrupt.dmplib";
+  ofstream corrupt_file(filename_corrupt, ios::binary);
+  corrupt_file.write(image.data(), image.size());
+  corrupt_file.close();
+  library = DmpLibrary::open(filename_corrupt);
+  if (library != NULL) {
+    cerr << "Opened a library whose descriptors lie outside the file" << endl;
+    all_ok = false;
+    delete library;
+  }
+
+  return all_ok ? 0 : -1;
+}
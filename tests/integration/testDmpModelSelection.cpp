@@ -0,0 +1,208 @@
+/**
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <eigen3/Eigen/Core>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+
+#include "dmp/Dmp.hpp"
+#include "dmp/DmpModelSelection.hpp"
+#include "dmp/Trajectory.hpp"
+#include "threadutils/ThreadPool.hpp"
+
+using namespace std;
+using namespace Eigen;
+using namespace DmpBbo;
+
+typedef DmpModelSelection::Candidate Candidate;
+
+/** Make a candidate that has been evaluated.
+ * \param[in] n_parameters Number of parameters
+ * \param[in] mean_absolute_error Mean absolute error
+ * \return The candidate
+ */
+Candidate makeCandidate(int n_parameters, double mean_absolute_error)
+{
+  Candidate candidate;
+  candidate.fa_class = "FunctionApproximatorRBFN";
+  candidate.n_basis_functions = n_parameters;
+  candidate.intersection_height = 0.5;
+  candidate.regularization = 0.0;
+  candidate.n_parameters = n_parameters;
+  candidate.mean_absolute_error = mean_absolute_error;
+  candidate.max_absolute_error = mean_absolute_error;
+  return candidate;
+}
+
+int main(int n_args, char** args)
+{
+  bool all_ok = true;
+
+  // A trajectory through a viapoint, which requires a forcing term
+  VectorXd ts = VectorXd::LinSpaced(101, 0.0, 1.0);
+  VectorXd y_from(2), y_to(2), viapoint(6);
+  y_from << 0.0, 0.5;
+  y_to << 1.0, -0.5;
+  viapoint << 0.2, 1.0, 0.0, 0.0, 0.0, 0.0;
+  Trajectory trajectory =
+      Trajectory::generatePolynomialTrajectoryThroughViapoint(
+          ts, y_from, viapoint, 0.4, y_to);
+
+  vector<int> n_bfs = {3, 6, 10};
+  vector<double> heights = {0.5, 0.8};
+  vector<double> regularizations = {0.0, 1e-4, 1e-1};
+  vector<vector<string>> configurations = {
+      {"FunctionApproximatorRBFN", "KULVICIUS_2012_JOINING", "NO_SCALING",
+       "EULER"},
+      {"FunctionApproximatorLWR", "IJSPEERT_2002_MOVEMENT",
+       "AMPLITUDE_SCALING", "EXACT_ZOH"}};
+  ThreadPool thread_pool(3);
+  for (const vector<string>& configuration : configurations) {
+    const string& fa_class = configuration[0];
+    const string& dmp_type = configuration[1];
+    const string& scaling = configuration[2];
+    const string& integration = configuration[3];
+    string suffix = " (" + fa_class + ", " + dmp_type + ")";
+
+    vector<Candidate> candidates, candidates_parallel;
+    if (!DmpModelSelection::evaluate(trajectory, fa_class, n_bfs, heights,
+                                     regularizations, candidates, dmp_type,
+                                     scaling, integration) ||
+        !DmpModelSelection::evaluate(trajectory, fa_class, n_bfs, heights,
+                                     regularizations, candidates_parallel,
+                                     dmp_type, scaling, integration,
+                                     &thread_pool)) {
+      cerr << "Could not evaluate the grid" << suffix << endl;
+      all_ok = false;
+      continue;
+    }
+    unsigned int n_candidates =
+        n_bfs.size() * heights.size() * regularizations.size();
+    if (candidates.size() != n_candidates ||
+        candidates_parallel.size() != n_candidates) {
+      cerr << "Expected " << n_candidates << " candidates" << suffix << endl;
+      all_ok = false;
+      continue;
+    }
+
+    // Each candidate has the error of a Dmp trained with its meta-parameters,
+    // and the grid is ordered with the regularization varying fastest.
+    double max_diff = 0.0;
+    for (unsigned int i = 0; i < n_candidates; i++) {
+      const Candidate& c = candidates[i];
+      int i_reg = i % regularizations.size();
+      int i_height = (i / regularizations.size()) % heights.size();
+      int i_bfs = i / (regularizations.size() * heights.size());
+      if (c.fa_class != fa_class || c.n_basis_functions != n_bfs[i_bfs] ||
+          c.intersection_height != heights[i_height] ||
+          c.regularization != regularizations[i_reg]) {
+        cerr << "Candidate " << i << " has the wrong meta-parameters" << suffix
+             << endl;
+        all_ok = false;
+        continue;
+      }
+      const Candidate& c_parallel = candidates_parallel[i];
+      if (c_parallel.n_parameters != c.n_parameters ||
+          c_parallel.mean_absolute_error != c.mean_absolute_error ||
+          c_parallel.max_absolute_error != c.max_absolute_error) {
+        cerr << "Candidate " << i << " differs when evaluated in parallel"
+             << suffix << endl;
+        all_ok = false;
+      }
+
+      Dmp* dmp = Dmp::fromTrajectory(
+          trajectory, DmpModelSelection::toMetaParams(c), dmp_type, scaling);
+      if (dmp == NULL) {
+        cerr << "Could not train candidate " << i << suffix << endl;
+        all_ok = false;
+        continue;
+      }
+      dmp->set_analytical_solution_integration(integration);
+      VectorXd parameters;
+      dmp->getLinearParameterVector(parameters);
+      Trajectory reproduced;
+      dmp->analyticalSolution(ts, reproduced);
+      delete dmp;
+      ArrayXXd errors = (reproduced.ys() - trajectory.ys()).array().abs();
+      if (c.n_parameters != parameters.size()) {
+        cerr << "Candidate " << i << " has " << c.n_parameters
+             << " parameters instead of " << parameters.size() << suffix
+             << endl;
+        all_ok = false;
+      }
+      max_diff = max(max_diff, fabs(c.mean_absolute_error - errors.mean()));
+      max_diff = max(max_diff, fabs(c.max_absolute_error - errors.maxCoeff()));
+    }
+    cout << "max |error - error_dmp| = " << max_diff << suffix << endl;
+    if (max_diff > 10e-10) {
+      cerr << "The errors differ from those of the trained Dmps" << suffix
+           << endl;
+      all_ok = false;
+    }
+
+    // Without a maximum error, the candidate with the lowest error is best.
+    int i_best = DmpModelSelection::selectBest(candidates);
+    for (unsigned int i = 0; i < n_candidates; i++) {
+      if (candidates[i].mean_absolute_error <
+          candidates[i_best].mean_absolute_error) {
+        cerr << "Candidate " << i << " has a lower error than the best one "
+             << i_best << suffix << endl;
+        all_ok = false;
+      }
+    }
+  }
+
+  // The fewest parameters with an acceptable error, ties broken by the error.
+  // If no candidate is acceptable, the one with the lowest error.
+  vector<Candidate> candidates = {makeCandidate(10, 0.01),
+                                  makeCandidate(5, 0.04),
+                                  makeCandidate(5, 0.03),
+                                  makeCandidate(3, 0.2),
+                                  makeCandidate(20, 0.001)};
+  candidates.push_back(makeCandidate(2, 0.0));
+  candidates.back().mean_absolute_error = -1.0;  // Not evaluated
+  vector<double> max_errors = {0.0, 0.05, 0.02, 0.5, 0.0001};
+  vector<int> expected = {4, 2, 0, 3, 4};
+  for (unsigned int i = 0; i < max_errors.size(); i++) {
+    int i_best = DmpModelSelection::selectBest(candidates, max_errors[i]);
+    if (i_best != expected[i]) {
+      cerr << "With max_error=" << max_errors[i] << ", selected candidate "
+           << i_best << " instead of " << expected[i] << endl;
+      all_ok = false;
+    }
+  }
+  if (DmpModelSelection::selectBest(vector<Candidate>()) != -1) {
+    cerr << "Selected a candidate from an empty list" << endl;
+    all_ok = false;
+  }
+
+  // Only RBFN and LWR are supported (prints an error).
+  vector<Candidate> candidates_other;
+  if (DmpModelSelection::evaluate(trajectory, "FunctionApproximatorGMR",
+                                  n_bfs, heights, regularizations,
+                                  candidates_other)) {
+    cerr << "Evaluated a grid of an unsupported function approximator" << endl;
+    all_ok = false;
+  }
+
+  return all_ok ? 0 : -1;
+}
@@ -0,0 +1,162 @@
+/**
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <eigen3/Eigen/Core>
+#include <fstream>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <thread>
+
+#include "dmp/Dmp.hpp"
+#include "dmp/DmpModelWatcher.hpp"
+#include "eigenutils/eigen_json.hpp"
+
+using namespace std;
+using namespace Eigen;
+using namespace DmpBbo;
+using namespace nlohmann;
+
+/** Write a file, and move it into place, as an optimization loop would.
+ * \param[in] filename Name of the file
+ * \param[in] contents Contents of the file
+ */
+void writeModel(const string& filename, const string& contents)
+{
+  ofstream file(filename + ".tmp");
+  file << contents;
+  file.close();
+  rename((filename + ".tmp").c_str(), filename.c_str());
+}
+
+/** Call swapIfUpdated() until a condition holds, or until a timeout.
+ * \param[in] watcher The watcher
+ * \param[in] condition The condition on the statistics of the watcher
+ * \return The number of consumers that were swapped in total
+ */
+template <typename Condition>
+int swapUntil(DmpModelWatcher& watcher, Condition condition)
+{
+  int n_swapped = 0;
+  for (int i_try = 0; i_try < 500; i_try++) {
+    n_swapped += watcher.swapIfUpdated();
+    if (condition(watcher.statistics())) break;
+    this_thread::sleep_for(chrono::milliseconds(10));
+  }
+  return n_swapped;
+}
+
+/** Get the maximum difference between the trajectories of two Dmps.
+ * \param[in] dmp1 The first Dmp
+ * \param[in] dmp2 The second Dmp
+ * \return The maximum difference between the states
+ */
+double maxDifference(const Dmp* dmp1, const Dmp* dmp2)
+{
+  VectorXd ts = VectorXd::LinSpaced(101, 0.0, 1.5 * dmp1->tau());
+  MatrixXd xs1, xds1, xs2, xds2;
+  dmp1->analyticalSolution(ts, xs1, xds1);
+  dmp2->analyticalSolution(ts, xs2, xds2);
+  return (xs1 - xs2).cwiseAbs().maxCoeff();
+}
+
+int main(int n_args, char** args)
+{
+  if (n_args != 2) {
+    cout << "Usage: " << args[0] << " <dmp filename.json>" << endl;
+    return -1;
+  }
+
+  ifstream file(args[1]);
+  if (file.fail()) {
+    cerr << "Could not find: " << args[1] << endl;
+    return -1;
+  }
+  json j = json::parse(file);
+  bool all_ok = true;
+
+  string filename_model = "testDmpModelWatcher.json";
+  writeModel(filename_model, j.dump());
+  Dmp* original = j.get<Dmp*>();
+  // The consumer is a clone, whose parameters are shared with the original
+  // until it is registered.
+  Dmp* dmp = original->clone();
+
+  DmpModelWatcher watcher(filename_model);
+  if (!watcher.isWatching()) return -1;
+  watcher.addConsumer(dmp);
+
+  // A new model is swapped into the consumer, but not into the original.
+  json j_update = j;
+  VectorXd y_attr = j.at("_y_attr");
+  y_attr.array() += 0.1;
+  j_update["_y_attr"] = y_attr;
+  j_update["_goal_system"]["_x_attr"] = y_attr;
+  j_update["_function_approximators"][0]["_model_params"]["weights"] =
+      2.0 * j.at("_function_approximators")[0]
+                .at("_model_params")
+                .at("weights")
+                .get<VectorXd>();
+  writeModel(filename_model, j_update.dump());
+  swapUntil(watcher, [](const DmpModelWatcher::Statistics& statistics) {
+    return statistics.n_reloads > 0;
+  });
+  Dmp* dmp_update = j_update.get<Dmp*>();
+  Dmp* dmp_reference = j.get<Dmp*>();
+  double diff_update = maxDifference(dmp, dmp_update);
+  double diff_original = maxDifference(original, dmp_reference);
+  cout << "max |xs - xs_update| = " << diff_update << endl;
+  if (watcher.statistics().n_reloads != 1 || diff_update > 10e-12) {
+    cerr << "The new model was not swapped into the consumer" << endl;
+    all_ok = false;
+  }
+  if (diff_original > 10e-12) {
+    cerr << "Swapping a new model into a clone changed the original" << endl;
+    all_ok = false;
+  }
+
+  // An invalid model is reported in the statistics, and not swapped.
+  writeModel(filename_model, "{ \"this is\": \"not a Dmp\" }");
+  int n_swapped =
+      swapUntil(watcher, [](const DmpModelWatcher::Statistics& statistics) {
+        return statistics.n_failed_parses > 0;
+      });
+  DmpModelWatcher::Statistics statistics = watcher.statistics();
+  cout << "last parse error: " << statistics.last_parse_error << endl;
+  if (n_swapped != 0 || statistics.n_failed_parses != 1 ||
+      statistics.last_parse_error.empty()) {
+    cerr << "The invalid model was not reported" << endl;
+    all_ok = false;
+  }
+  if (maxDifference(dmp, dmp_update) > 10e-12) {
+    cerr << "The invalid model changed the consumer" << endl;
+    all_ok = false;
+  }
+
+  watcher.removeConsumer(dmp);
+  remove(filename_model.c_str());
+  delete dmp_reference;
+  delete dmp_update;
+  delete dmp;
+  delete original;
+
+  return all_ok ? 0 : -1;
+}
@@ -0,0 +1,116 @@
+/**
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <fstream>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include <string>
+
+#include "dmp/Dmp.hpp"
+
+using namespace std;
+using namespace Eigen;
+using namespace DmpBbo;
+using namespace nlohmann;
+
+/** Integrate a Dmp, and return the positions over time.
+ * \param[in] dmp The Dmp to integrate
+ * \param[in] dt Integration time step
+ * \param[in] n_steps Number of time steps
+ * \param[out] ys Positions over time (n_steps x dim_y)
+ */
+void integrate(const Dmp* dmp, double dt, int n_steps, MatrixXd& ys)
+{
+  VectorXd x(dmp->dim()), xd(dmp->dim());
+  VectorXd y(dmp->dim_y()), yd(dmp->dim_y()), ydd(dmp->dim_y());
+  ys.resize(n_steps, dmp->dim_y());
+  dmp->integrateStart(x, xd);
+  for (int i_step = 0; i_step < n_steps; i_step++) {
+    dmp->integrateStep(dt, x, x, xd);
+    dmp->stateAsPosVelAcc(x, xd, y, yd, ydd);
+    ys.row(i_step) = y;
+  }
+}
+
+int main(int n_args, char** args)
+{
+  if (n_args != 2) {
+    cout << "Usage: " << args[0] << " <dmp filename.json>" << endl;
+    return -1;
+  }
+
+  ifstream file(args[1]);
+  if (file.fail()) {
+    cerr << "Could not find: " << args[1] << endl;
+    return -1;
+  }
+  json j = json::parse(file);
+  Dmp* dmp = j.get<Dmp*>();
+  bool all_ok = true;
+
+  // Integrate at 1kHz, and update the forcing term at 200Hz.
+  double dt = 0.001;
+  int n_steps = floor(1.2 * dmp->tau() / dt);
+  MatrixXd ys_full, ys_multi;
+  integrate(dmp, dt, n_steps, ys_full);
+  double phase_interval = 1.0 / (200.0 * dmp->tau());
+  for (string interpolation : {"LINEAR", "CUBIC"}) {
+    dmp->set_forcing_term_phase_interval(phase_interval, interpolation);
+    integrate(dmp, dt, n_steps, ys_multi);
+    double max_diff = (ys_multi - ys_full).cwiseAbs().maxCoeff();
+    double tolerance = (interpolation == "LINEAR" ? 10e-05 : 10e-07);
+    cout << interpolation << ": max |y_multi - y_full| = " << max_diff << endl;
+    if (max_diff > tolerance) {
+      cerr << "Multi-rate integration with " << interpolation
+           << " interpolation differs by more than " << tolerance << endl;
+      all_ok = false;
+    }
+  }
+
+  // Setting the parameters must invalidate the cached knots, also without
+  // calling integrateStart().
+  VectorXd x(dmp->dim()), xd(dmp->dim()), xd_ref(dmp->dim());
+  dmp->integrateStart(x, xd);
+  for (int i_step = 0; i_step < 10; i_step++) dmp->integrateStep(dt, x, x, xd);
+  VectorXd weights;
+  dmp->getLinearParameterVector(weights);
+  weights *= 2.0;
+  dmp->setLinearParameterVector(weights);
+  dmp->differentialEquation(x, xd);
+
+  Dmp* dmp_ref = j.get<Dmp*>();
+  dmp_ref->set_forcing_term_phase_interval(phase_interval, "CUBIC");
+  dmp_ref->setLinearParameterVector(weights);
+  VectorXd x_ref(dmp->dim());
+  dmp_ref->integrateStart(x_ref, xd_ref);
+  dmp_ref->differentialEquation(x, xd_ref);
+  double max_diff = (xd - xd_ref).cwiseAbs().maxCoeff();
+  cout << "After setLinearParameterVector(): max |xd - xd_ref| = " << max_diff
+       << endl;
+  if (max_diff > 0.0) {
+    cerr << "The knots were not updated after setLinearParameterVector()"
+         << endl;
+    all_ok = false;
+  }
+
+  delete dmp;
+  delete dmp_ref;
+
+  return all_ok ? 0 : -1;
+}
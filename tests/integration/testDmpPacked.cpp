@@ -0,0 +1,165 @@
+/**
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+
+#include "dmp/Dmp.hpp"
+#include "dynamicalsystems/ExponentialSystem.hpp"
+#include "dynamicalsystems/SigmoidSystem.hpp"
+#include "dynamicalsystems/TimeSystem.hpp"
+#include "functionapproximators/FunctionApproximatorRBFN.hpp"
+
+using namespace std;
+using namespace Eigen;
+using namespace DmpBbo;
+using namespace nlohmann;
+
+/** Integrate a Dmp with integrateStep(), and return the states over time.
+ * \param[in] dmp The Dmp to integrate
+ * \param[out] xs States over time (n_steps x dim)
+ */
+void integrate(const Dmp* dmp, MatrixXd& xs)
+{
+  int n_steps = 1000;
+  double dt = 1.2 * dmp->tau() / n_steps;
+  VectorXd x(dmp->dim()), xd(dmp->dim());
+  xs.resize(n_steps, dmp->dim());
+  dmp->integrateStart(x, xd);
+  for (int i_step = 0; i_step < n_steps; i_step++) {
+    dmp->integrateStep(dt, x, x, xd);
+    xs.row(i_step) = x;
+  }
+}
+
+/** Compare integration with and without packing the forcing term, also after
+ * changing the parameters.
+ * \param[in] dmp The Dmp
+ * \param[in] scalar_type "FLOAT64" or "FLOAT32", cf. Dmp::packForcingTerm()
+ * \return Maximum absolute difference between the states, relative to the
+ * largest absolute state, or -1 if the forcing term could not be packed.
+ */
+double compare(Dmp* dmp, string scalar_type)
+{
+  VectorXd weights;
+  dmp->getLinearParameterVector(weights);
+  double max_diff = 0.0;
+  double max_abs = 0.0;
+  for (double factor : {1.0, -0.5}) {
+    dmp->setLinearParameterVector(factor * weights);
+    MatrixXd xs_unpacked, xs_packed;
+    integrate(dmp, xs_unpacked);
+    if (!dmp->packForcingTerm(scalar_type)) return -1.0;
+    integrate(dmp, xs_packed);
+    dmp->unpackForcingTerm();
+    max_diff = max(max_diff, (xs_packed - xs_unpacked).cwiseAbs().maxCoeff());
+    max_abs = max(max_abs, xs_unpacked.cwiseAbs().maxCoeff());
+  }
+  dmp->setLinearParameterVector(weights);
+  return max_diff / max_abs;
+}
+
+/** Construct a Dmp with RBFNs.
+ * \param[in] n_dims Number of dimensions
+ * \param[in] n_basis_functions Number of basis functions per dimension
+ * \param[in] shared_basis_functions Whether all dimensions have the same
+ * centers and widths
+ * \return The Dmp
+ */
+Dmp* createDmp(int n_dims, int n_basis_functions, bool shared_basis_functions)
+{
+  VectorXd centers = VectorXd::LinSpaced(n_basis_functions, 0.0, 1.0);
+  vector<FunctionApproximator*> function_approximators(n_dims);
+  for (int i_dim = 0; i_dim < n_dims; i_dim++) {
+    double width = (shared_basis_functions ? 0.02 : 0.02 + 0.005 * i_dim);
+    VectorXd widths = VectorXd::Constant(n_basis_functions, width);
+    VectorXd weights = 100.0 * VectorXd::Random(n_basis_functions);
+    function_approximators[i_dim] =
+        new FunctionApproximatorRBFN(centers, widths, weights);
+  }
+  VectorXd y_init = VectorXd::Zero(n_dims);
+  VectorXd y_attr = VectorXd::Ones(n_dims);
+  double tau = 1.0;
+  VectorXd one_1 = VectorXd::Ones(1);
+  ExponentialSystem* goal_system =
+      new ExponentialSystem(tau, y_init, y_attr, 15);
+  SigmoidSystem* gating_system = new SigmoidSystem(tau, one_1, -10, 0.9 * tau);
+  TimeSystem* phase_system = new TimeSystem(tau);
+  return new Dmp(tau, y_init, y_attr, function_approximators, 20.0,
+                 goal_system, phase_system, gating_system);
+}
+
+int main(int n_args, char** args)
+{
+  if (n_args != 2) {
+    cout << "Usage: " << args[0] << " <dmp filename.json>" << endl;
+    return -1;
+  }
+
+  ifstream file(args[1]);
+  if (file.fail()) {
+    cerr << "Could not find: " << args[1] << endl;
+    return -1;
+  }
+  file.close();
+
+  // All Dmps in the directory of the json file, e.g. demos/cpp/json
+  vector<string> names;
+  vector<Dmp*> dmps;
+  boost::filesystem::path directory =
+      boost::filesystem::absolute(args[1]).parent_path();
+  for (boost::filesystem::directory_iterator it(directory);
+       it != boost::filesystem::directory_iterator(); ++it) {
+    if (it->path().extension() != ".json") continue;
+    ifstream json_file(it->path().string());
+    json j = json::parse(json_file, nullptr, false);
+    if (!j.is_object() || j.value("class", "") != "Dmp") continue;
+    names.push_back(it->path().filename().string());
+    dmps.push_back(j.get<Dmp*>());
+  }
+  names.push_back("7D, shared basis functions");
+  dmps.push_back(createDmp(7, 50, true));
+  names.push_back("7D, different basis functions");
+  dmps.push_back(createDmp(7, 50, false));
+
+  // Maximum difference relative to the largest absolute state
+  vector<string> scalar_types = {"FLOAT64", "FLOAT32"};
+  vector<double> tolerances = {10e-14, 10e-7};
+  bool all_ok = true;
+  for (unsigned int i_dmp = 0; i_dmp < dmps.size(); i_dmp++) {
+    for (unsigned int i_type = 0; i_type < scalar_types.size(); i_type++) {
+      double max_diff = compare(dmps[i_dmp], scalar_types[i_type]);
+      cout << names[i_dmp] << " (" << scalar_types[i_type]
+           << "): max |x_packed - x_unpacked| / max |x| = " << max_diff
+           << endl;
+      if (max_diff < 0.0 || max_diff > tolerances[i_type]) {
+        cerr << "Packed and unpacked forcing terms differ by more than "
+             << tolerances[i_type] << endl;
+        all_ok = false;
+      }
+    }
+    delete dmps[i_dmp];
+  }
+
+  return all_ok ? 0 : -1;
+}
@@ -0,0 +1,83 @@
+/**
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <eigen3/Eigen/Core>
+#include <fstream>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include <string>
+
+#include "dmp/Dmp.hpp"
+
+using namespace std;
+using namespace Eigen;
+using namespace DmpBbo;
+using namespace nlohmann;
+
+int main(int n_args, char** args)
+{
+  if (n_args != 2) {
+    cout << "Usage: " << args[0] << " <dmp filename.json>" << endl;
+    return -1;
+  }
+
+  ifstream file(args[1]);
+  if (file.fail()) {
+    cerr << "Could not find: " << args[1] << endl;
+    return -1;
+  }
+  Dmp* dmp = json::parse(file).get<Dmp*>();
+  bool all_ok = true;
+
+  // Enough time steps for several blocks of the parallel prefix scan
+  int n_time_steps = 20000;
+  VectorXd ts = VectorXd::LinSpaced(n_time_steps, 0.0, 1.2 * dmp->tau());
+
+  for (string integration : {"EULER", "EXACT_ZOH", "EXACT_FOH"}) {
+    dmp->set_analytical_solution_integration(integration);
+    dmp->set_analytical_solution_n_threads(1);
+    MatrixXd xs_serial, xds_serial;
+    dmp->analyticalSolution(ts, xs_serial, xds_serial);
+    double scale = xs_serial.cwiseAbs().maxCoeff();
+
+    // Also use more threads than there are hardware threads, so that the
+    // parallel code is tested on any machine.
+    for (int n_threads : {2, 3, 4, 7}) {
+      dmp->set_analytical_solution_n_threads(n_threads, false);
+      MatrixXd xs, xds;
+      dmp->analyticalSolution(ts, xs, xds);
+      double max_diff = (xs - xs_serial).cwiseAbs().maxCoeff();
+      max_diff = max(max_diff, (xds - xds_serial).cwiseAbs().maxCoeff());
+      cout << integration << ", " << n_threads
+           << " threads: max |x_parallel - x_serial| = " << max_diff << endl;
+
+      // Only the blocks of the prefix scan change the rounding errors
+      bool prefix_scan = (integration != "EULER" && n_threads >= 3);
+      double tolerance = prefix_scan ? 10e-13 * scale : 0.0;
+      if (max_diff > tolerance) {
+        cerr << integration << ": the result with " << n_threads
+             << " threads differs from the serial one" << endl;
+        all_ok = false;
+      }
+    }
+  }
+
+  delete dmp;
+  return all_ok ? 0 : -1;
+}
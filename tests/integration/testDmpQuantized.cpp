@@ -0,0 +1,139 @@
+/**
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cmath>
+#include <eigen3/Eigen/Core>
+#include <fstream>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+
+#include "dmp/Dmp.hpp"
+#include "functionapproximators/FunctionApproximatorRBFN.hpp"
+#include "functionapproximators/FunctionApproximatorRBFNQuantized.hpp"
+#include "functionapproximators/QuantizedArray.hpp"
+
+using namespace std;
+using namespace Eigen;
+using namespace DmpBbo;
+using namespace nlohmann;
+
+/** Quantize the function approximators of a Dmp, and check the errors.
+ * \param[in] dmp The Dmp
+ * \param[in] format The requested format
+ * \param[in] expected_format The format that should be used
+ * \param[in] max_relative_error Maximum error of the outputs of the function
+ * approximators, relative to the largest absolute weight
+ * \return true if the errors are within the bound
+ */
+bool checkQuantizedDmp(const Dmp* dmp, string format, string expected_format,
+                       double max_relative_error)
+{
+  Dmp* quantized = dmp->clone();
+  VectorXd max_errors;
+  if (!quantized->quantizeFunctionApproximators(format, max_errors)) {
+    cerr << "Could not quantize the Dmp with " << format << endl;
+    delete quantized;
+    return false;
+  }
+  bool ok = true;
+  for (int i_dim = 0; i_dim < dmp->dim_y(); i_dim++) {
+    const FunctionApproximatorRBFN* rbfn =
+        dynamic_cast<const FunctionApproximatorRBFN*>(
+            dmp->function_approximator(i_dim));
+    const FunctionApproximatorRBFNQuantized* fa =
+        dynamic_cast<const FunctionApproximatorRBFNQuantized*>(
+            quantized->function_approximator(i_dim));
+    double relative_error =
+        max_errors[i_dim] / rbfn->weights().cwiseAbs().maxCoeff();
+    cout << format << ": dimension " << i_dim << ", " << fa->format()
+         << ", relative error " << relative_error << endl;
+    if (fa->format() != expected_format) {
+      cerr << format << " was stored as " << fa->format() << endl;
+      ok = false;
+    }
+    if (relative_error > max_relative_error) {
+      cerr << format << ": relative error " << relative_error
+           << " exceeds " << max_relative_error << endl;
+      ok = false;
+    }
+  }
+  delete quantized;
+  return ok;
+}
+
+int main(int n_args, char** args)
+{
+  if (n_args != 2) {
+    cout << "Usage: " << args[0] << " <dmp filename.json>" << endl;
+    return -1;
+  }
+
+  ifstream file(args[1]);
+  if (file.fail()) {
+    cerr << "Could not find: " << args[1] << endl;
+    return -1;
+  }
+  json j = json::parse(file);
+  bool all_ok = true;
+
+  // The error of each format, relative to the largest weight
+  Dmp* dmp = j.get<Dmp*>();
+  all_ok &= checkQuantizedDmp(dmp, "FLOAT32", "FLOAT32", 1e-6);
+  all_ok &= checkQuantizedDmp(dmp, "FLOAT16", "FLOAT16", 5e-3);
+  all_ok &= checkQuantizedDmp(dmp, "INT16", "INT16", 5e-4);
+
+  // Weights that exceed the range of FLOAT16 are stored as INT16.
+  VectorXd weights;
+  dmp->getLinearParameterVector(weights);
+  double max_weight = weights.cwiseAbs().maxCoeff();
+  dmp->setLinearParameterVector(1e6 / max_weight * weights);
+  all_ok &= checkQuantizedDmp(dmp, "FLOAT16", "INT16", 5e-4);
+  delete dmp;
+
+  // Values within the range of FLOAT16 are rounded to 11 significant bits.
+  VectorXd values = VectorXd::Random(1000) * QuantizedArray::kMaxFloat16;
+  QuantizedArray array(values, "FLOAT16");
+  VectorXd dequantized;
+  array.get(dequantized);
+  double max_relative_error =
+      ((dequantized - values).array() / values.array()).abs().maxCoeff();
+  cout << "FLOAT16 array: relative error " << max_relative_error << endl;
+  if (array.format() != "FLOAT16" || max_relative_error > pow(2.0, -11)) {
+    cerr << "FLOAT16 array: relative error " << max_relative_error
+         << " exceeds 2^-11" << endl;
+    all_ok = false;
+  }
+
+  // Values that exceed its range are saturated by set(), not made infinite.
+  values[0] = 1e6;
+  values[1] = -65519.0;  // Would round to -infinity
+  array.set(values);
+  array.get(dequantized);
+  if (dequantized[0] != QuantizedArray::kMaxFloat16 ||
+      dequantized[1] != -QuantizedArray::kMaxFloat16) {
+    cerr << "FLOAT16 array: " << values[0] << " and " << values[1]
+         << " were stored as " << dequantized[0] << " and " << dequantized[1]
+         << endl;
+    all_ok = false;
+  }
+
+  return all_ok ? 0 : -1;
+}
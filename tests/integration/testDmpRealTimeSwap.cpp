@@ -0,0 +1,214 @@
+/**
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define EIGEN_RUNTIME_NO_MALLOC  // Enable runtime tests for allocations
+
+#include <eigen3/Eigen/Core>
+#include <fstream>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include <string>
+
+#include "dmp/Dmp.hpp"
+#include "eigenutils/eigen_realtime_check.hpp"
+#include "functionapproximators/FunctionApproximatorLWR.hpp"
+#include "functionapproximators/FunctionApproximatorRBFN.hpp"
+
+using namespace std;
+using namespace Eigen;
+using namespace DmpBbo;
+using namespace nlohmann;
+
+/** Integration time step. */
+const double dt = 0.01;
+
+/** Integrate a Dmp with integrateStep(), optionally switching to the
+ * parameters of another Dmp half-way with copyParametersRealTime().
+ * \param[in] dmp The Dmp to integrate
+ * \param[in] dmp_new The Dmp to switch to (NULL: do not switch)
+ * \param[in] n_steps Number of time steps
+ * \param[out] xs States over time (n_steps x dim)
+ * \return false if switching failed
+ */
+bool integrate(Dmp* dmp, const Dmp* dmp_new, int n_steps, MatrixXd& xs)
+{
+  bool success = true;
+  VectorXd x(dmp->dim()), xd(dmp->dim());
+  xs.resize(n_steps, dmp->dim());
+  dmp->integrateStart(x, xd);
+  for (int i_step = 0; i_step < n_steps; i_step++) {
+    if (dmp_new != NULL && i_step == n_steps / 2) {
+      ENTERING_REAL_TIME_CRITICAL_CODE
+      success = dmp->copyParametersRealTime(*dmp_new);
+      EXITING_REAL_TIME_CRITICAL_CODE
+    }
+    dmp->integrateStep(dt, x, x, xd);
+    xs.row(i_step) = x;
+  }
+  return success;
+}
+
+/** Remove the last basis function of a function approximator in json.
+ * \param[in,out] j The json of a Dmp
+ * \param[in] i_dim The dimension of the function approximator
+ */
+void removeBasisFunction(json& j, int i_dim)
+{
+  json& model_params = j["_function_approximators"][i_dim]["_model_params"];
+  for (string name : {"centers", "widths", "weights"})
+    model_params[name].erase(model_params[name].size() - 1);
+}
+
+int main(int n_args, char** args)
+{
+  if (n_args != 2) {
+    cout << "Usage: " << args[0] << " <dmp filename.json>" << endl;
+    return -1;
+  }
+
+  ifstream file(args[1]);
+  if (file.fail()) {
+    cerr << "Could not find: " << args[1] << endl;
+    return -1;
+  }
+  json j = json::parse(file);
+  bool all_ok = true;
+
+  // The Dmp to switch to, with other parameters and attractor state
+  Dmp* dmp_new = j.get<Dmp*>();
+  VectorXd parameters;
+  dmp_new->getLinearParameterVector(parameters);
+  dmp_new->setLinearParameterVector(-parameters);
+  dmp_new->set_y_attr(VectorXd::Zero(dmp_new->dim_y()));
+
+  // Dmps that do not have the same structure
+  json j_fewer_bfs = j;
+  removeBasisFunction(j_fewer_bfs, 0);
+  json j_scaling = j;
+  j_scaling["_forcing_term_scaling"] = "NO_SCALING";
+  vector<Dmp*> dmps_other = {j_fewer_bfs.get<Dmp*>(), j_scaling.get<Dmp*>()};
+  vector<FunctionApproximator*> fas_1D = {
+      dmp_new->function_approximator(0)->clone()};
+  dmps_other.push_back(new Dmp(dmp_new->tau(), VectorXd::Zero(1),
+                               VectorXd::Ones(1), fas_1D,
+                               "KULVICIUS_2012_JOINING"));
+
+  int n_steps = floor(1.5 * dmp_new->tau() / dt);
+  for (bool packed : {false, true}) {
+    string suffix = packed ? " (packed)" : "";
+
+    // Switching half-way gives the same states as integrating the first half
+    // with the original Dmp, and the second half with the new one.
+    Dmp* dmp = j.get<Dmp*>();
+    if (packed) dmp->packForcingTerm();
+    MatrixXd xs_switch, xs_reference(n_steps, dmp->dim());
+    bool success = integrate(dmp, dmp_new, n_steps, xs_switch);
+    Dmp* dmp_first = j.get<Dmp*>();
+    VectorXd x(dmp->dim()), xd(dmp->dim());
+    dmp_first->integrateStart(x, xd);
+    for (int i_step = 0; i_step < n_steps; i_step++) {
+      Dmp* dmp_step = (i_step < n_steps / 2 ? dmp_first : dmp_new);
+      dmp_step->integrateStep(dt, x, x, xd);
+      xs_reference.row(i_step) = x;
+    }
+    double max_diff = (xs_switch - xs_reference).cwiseAbs().maxCoeff();
+    if (!success || max_diff > 10e-12) {
+      cerr << "Switching to the new parameters failed" << suffix << endl;
+      all_ok = false;
+    }
+
+    // After switching, the Dmp is the same as the new one
+    MatrixXd xs_new;
+    integrate(dmp_new, NULL, n_steps, xs_new);
+    MatrixXd xs_after;
+    integrate(dmp, NULL, n_steps, xs_after);
+    max_diff = (xs_after - xs_new).cwiseAbs().maxCoeff();
+    if (max_diff > 10e-12) {
+      cerr << "The Dmp does not have the new parameters" << suffix << endl;
+      all_ok = false;
+    }
+    delete dmp_first;
+    delete dmp;
+
+    // Dmps with another structure are rejected, and nothing is copied
+    for (unsigned int i_other = 0; i_other < dmps_other.size(); i_other++) {
+      Dmp* dmp = j.get<Dmp*>();
+      if (packed) dmp->packForcingTerm();
+      MatrixXd xs_reference, xs;
+      integrate(dmp, NULL, n_steps, xs_reference);
+      bool copied = integrate(dmp, dmps_other[i_other], n_steps, xs);
+      if (copied || xs != xs_reference) {
+        cerr << "Copied the parameters of Dmp " << i_other
+             << ", which has another structure" << suffix << endl;
+        all_ok = false;
+      }
+      delete dmp;
+    }
+
+    // Function approximators with another structure are rejected as well
+    dmp = j.get<Dmp*>();
+    if (packed) dmp->packForcingTerm();
+    VectorXd parameters_before, parameters_after;
+    dmp->getLinearParameterVector(parameters_before);
+    const FunctionApproximator* fa_fewer_bfs =
+        dmps_other[0]->function_approximator(0);
+    if (dmp->copyFunctionApproximatorParametersRealTime(0, *fa_fewer_bfs)) {
+      cerr << "Copied a function approximator with fewer basis functions"
+           << suffix << endl;
+      all_ok = false;
+    }
+    if (!dmp->copyFunctionApproximatorParametersRealTime(
+            0, *dmp_new->function_approximator(0))) {
+      cerr << "Could not copy a function approximator" << suffix << endl;
+      all_ok = false;
+    }
+    dmp->getLinearParameterVector(parameters_after);
+    int n_0 = dmp->function_approximator(0)->getLinearParameterVectorSize();
+    int n_1 = parameters.size() - n_0;
+    if (parameters_after.head(n_0) != -parameters.head(n_0) ||
+        parameters_after.tail(n_1) != parameters_before.tail(n_1)) {
+      cerr << "The parameters of the function approximator were not copied "
+           << "to dimension 0 only" << suffix << endl;
+      all_ok = false;
+    }
+    delete dmp;
+  }
+
+  // An LWR does not have the same structure as an RBFN with the same centers
+  const FunctionApproximatorRBFN* rbfn =
+      dynamic_cast<const FunctionApproximatorRBFN*>(
+          dmp_new->function_approximator(0));
+  if (rbfn != NULL) {
+    int n_bfs = rbfn->centers().rows();
+    FunctionApproximatorLWR lwr(rbfn->centers(), rbfn->widths(),
+                                MatrixXd::Zero(n_bfs, 1),
+                                MatrixXd::Zero(n_bfs, 1));
+    if (!rbfn->hasSameStructure(*rbfn) || rbfn->hasSameStructure(lwr) ||
+        lwr.hasSameStructure(*rbfn) || !lwr.hasSameStructure(lwr) ||
+        rbfn->hasSameStructure(*dmps_other[0]->function_approximator(0))) {
+      cerr << "hasSameStructure() is wrong for RBFN and LWR" << endl;
+      all_ok = false;
+    }
+  }
+
+  for (unsigned int i_other = 0; i_other < dmps_other.size(); i_other++)
+    delete dmps_other[i_other];
+  delete dmp_new;
+  return all_ok ? 0 : -1;
+}
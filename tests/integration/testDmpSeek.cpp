@@ -0,0 +1,121 @@
+/**
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "dmp/Dmp.hpp"
+
+using namespace std;
+using namespace Eigen;
+using namespace DmpBbo;
+using namespace nlohmann;
+
+/** Compare the states returned by seek() with those of analyticalSolution().
+ * \param[in] dmp The Dmp
+ * \param[in] ts The times for prepareSeek()
+ * \return Maximum absolute difference between the states
+ */
+double compare(Dmp* dmp, const VectorXd& ts)
+{
+  int n_time_steps = ts.size();
+  MatrixXd xs, xds;
+  dmp->analyticalSolution(ts, xs, xds);
+  dmp->prepareSeek(ts, 10);
+
+  VectorXd x(dmp->dim()), xd(dmp->dim());
+  double max_diff = 0.0;
+  auto update = [&](const VectorXd& x_expected, const VectorXd& xd_expected) {
+    max_diff = std::max(max_diff, (x - x_expected).cwiseAbs().maxCoeff());
+    max_diff = std::max(max_diff, (xd - xd_expected).cwiseAbs().maxCoeff());
+  };
+
+  // Times on the grid, in random order
+  vector<int> order(n_time_steps);
+  for (int tt = 0; tt < n_time_steps; tt++) order[tt] = tt;
+  shuffle(order.begin(), order.end(), mt19937(0));
+  for (int tt : order) {
+    if (!dmp->seek(ts[tt], x, xd)) return -1.0;
+    update(xs.row(tt), xds.row(tt));
+  }
+
+  // Times in between, which must give the same state as an analytical
+  // solution that ends with a step to that time.
+  for (int tt : {0, 9, 10, 11, 123, n_time_steps - 2}) {
+    double t = ts[tt] + 0.37 * (ts[tt + 1] - ts[tt]);
+    VectorXd ts_to_t(tt + 2);
+    ts_to_t.head(tt + 1) = ts.head(tt + 1);
+    ts_to_t[tt + 1] = t;
+    MatrixXd xs_to_t, xds_to_t;
+    dmp->analyticalSolution(ts_to_t, xs_to_t, xds_to_t);
+    dmp->seek(t, x, xd);
+    update(xs_to_t.row(tt + 1), xds_to_t.row(tt + 1));
+  }
+
+  // Times outside of the grid are clamped
+  dmp->seek(ts[0] - 1.0, x, xd);
+  update(xs.row(0), xds.row(0));
+  dmp->seek(ts[n_time_steps - 1] + 1.0, x, xd);
+  update(xs.row(n_time_steps - 1), xds.row(n_time_steps - 1));
+
+  return max_diff;
+}
+
+int main(int n_args, char** args)
+{
+  if (n_args != 2) {
+    cout << "Usage: " << args[0] << " <dmp filename.json>" << endl;
+    return -1;
+  }
+
+  ifstream file(args[1]);
+  if (file.fail()) {
+    cerr << "Could not find: " << args[1] << endl;
+    return -1;
+  }
+  Dmp* dmp = json::parse(file).get<Dmp*>();
+
+  VectorXd ts = VectorXd::LinSpaced(501, 0.0, 1.2 * dmp->tau());
+  double tolerance = 10e-10;
+  bool all_ok = true;
+  for (string integration : {"EULER", "EXACT_ZOH", "EXACT_FOH"}) {
+    dmp->set_analytical_solution_integration(integration);
+    double max_diff = compare(dmp, ts);
+    cout << integration << ": max difference seek/analyticalSolution: "
+         << max_diff << endl;
+    if (max_diff < 0.0 || max_diff > tolerance) all_ok = false;
+  }
+
+  // Changing the Dmp invalidates the checkpoints
+  dmp->set_tau(1.1 * dmp->tau());
+  if (dmp->isSeekPrepared()) all_ok = false;
+  delete dmp;
+
+  if (!all_ok) {
+    cerr << "seek() differs from analyticalSolution() by more than "
+         << tolerance << endl;
+    return -1;
+  }
+  return 0;
+}
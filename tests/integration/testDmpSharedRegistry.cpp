@@ -0,0 +1,211 @@
+/**
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <eigen3/Eigen/Core>
+#include <fstream>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+
+#include "dmp/Dmp.hpp"
+#include "dmp/DmpLibrary.hpp"
+#include "dmp/DmpSharedRegistry.hpp"
+#include "eigenutils/eigen_json.hpp"
+
+using namespace std;
+using namespace Eigen;
+using namespace DmpBbo;
+using namespace nlohmann;
+
+/** Make Dmps whose attractor states are offset by different amounts.
+ * \param[in] j_dmp The json of a Dmp
+ * \param[in] n_dmps Number of Dmps to make
+ * \param[in] offset Offset of the attractor state of the first Dmp
+ * \param[out] names The names of the Dmps
+ * \param[out] j_dmps The json of the Dmps
+ */
+void makeDmps(const json& j_dmp, int n_dmps, double offset,
+              vector<string>& names, vector<json>& j_dmps)
+{
+  VectorXd y_attr = j_dmp.at("_y_attr");
+  names.resize(n_dmps);
+  j_dmps.resize(n_dmps);
+  for (int i_dmp = 0; i_dmp < n_dmps; i_dmp++) {
+    j_dmps[i_dmp] = j_dmp;
+    VectorXd y_attr_i =
+        y_attr + VectorXd::Constant(y_attr.size(), offset + i_dmp);
+    j_dmps[i_dmp]["_y_attr"] = y_attr_i;
+    // The goal system stores its own copy of the attractor state.
+    j_dmps[i_dmp]["_goal_system"]["_x_attr"] = y_attr_i;
+    names[i_dmp] = "dmp_" + to_string(i_dmp);
+  }
+}
+
+/** Check that a Dmp from a library is the same as the Dmp it was made from.
+ * \param[in] library The library
+ * \param[in] name Name of the Dmp in the library
+ * \param[in] j_dmp The json the Dmp was made from
+ * \return true if the Dmps give the same trajectory, false otherwise
+ */
+bool sameDmp(DmpLibrary* library, const string& name, const json& j_dmp)
+{
+  VectorXd ts = VectorXd::LinSpaced(101, 0.0, 1.5);
+  MatrixXd xs, xds, xs_shared, xds_shared;
+  Dmp* dmp = j_dmp.get<Dmp*>();
+  dmp->analyticalSolution(ts, xs, xds);
+  delete dmp;
+  shared_ptr<Dmp> dmp_shared = library->get(name);
+  if (!dmp_shared) return false;
+  dmp_shared->analyticalSolution(ts, xs_shared, xds_shared);
+  return (xs - xs_shared).cwiseAbs().maxCoeff() < 10e-12;
+}
+
+int main(int n_args, char** args)
+{
+  if (n_args != 2) {
+    cout << "Usage: " << args[0] << " <dmp filename.json>" << endl;
+    return -1;
+  }
+
+  ifstream file(args[1]);
+  if (file.fail()) {
+    cerr << "Could not find: " << args[1] << endl;
+    return -1;
+  }
+  json j = json::parse(file);
+  bool all_ok = true;
+
+  // A name per process, so that tests that run at the same time do not
+  // interfere.
+  string registry_name = "testDmpSharedRegistry." + to_string(getpid());
+  int n_dmps = 50;
+  vector<string> names, names_update;
+  vector<json> j_dmps, j_dmps_update;
+  makeDmps(j, n_dmps, 0.0, names, j_dmps);
+  makeDmps(j, n_dmps, 100.0, names_update, j_dmps_update);
+
+  // Nothing has been published yet (attach() prints an error).
+  if (DmpSharedRegistry::version(registry_name) != 0 ||
+      DmpSharedRegistry::attach(registry_name) != NULL) {
+    cerr << "Attached to a registry entry that was not published" << endl;
+    all_ok = false;
+  }
+  if (DmpSharedRegistry::publish("invalid/name", names, j_dmps)) {
+    cerr << "Published under a name that contains '/'" << endl;
+    all_ok = false;
+  }
+
+  uint64_t version;
+  if (!DmpSharedRegistry::publish(registry_name, names, j_dmps, &version)) {
+    cerr << "Could not publish " << registry_name << endl;
+    return -1;
+  }
+  if (version == 0 || DmpSharedRegistry::version(registry_name) != version) {
+    cerr << "The current version is not the published one" << endl;
+    all_ok = false;
+  }
+
+  // Another process attaches to the registry, and gets the same Dmps.
+  pid_t pid = fork();
+  if (pid == 0) {
+    uint64_t child_version;
+    DmpLibrary* library =
+        DmpSharedRegistry::attach(registry_name, 4, &child_version);
+    bool child_ok = library != NULL && child_version == version &&
+                    library->n_dmps() == n_dmps &&
+                    sameDmp(library, names[10], j_dmps[10]) &&
+                    sameDmp(library, names[n_dmps - 1], j_dmps[n_dmps - 1]);
+    delete library;
+    _exit(child_ok ? 0 : 1);
+  }
+  int status;
+  if (pid < 0 || waitpid(pid, &status, 0) != pid || !WIFEXITED(status) ||
+      WEXITSTATUS(status) != 0) {
+    cerr << "Another process did not get the published Dmps" << endl;
+    all_ok = false;
+  }
+
+  // Publishing an update does not change a version that is attached to.
+  uint64_t old_version, new_version;
+  DmpLibrary* old_library =
+      DmpSharedRegistry::attach(registry_name, 4, &old_version);
+  if (old_library == NULL) return -1;
+  if (!DmpSharedRegistry::publish(registry_name, names_update, j_dmps_update,
+                                  &new_version)) {
+    cerr << "Could not publish an update of " << registry_name << endl;
+    return -1;
+  }
+  if (new_version <= old_version ||
+      DmpSharedRegistry::version(registry_name) != new_version) {
+    cerr << "The update did not become the current version" << endl;
+    all_ok = false;
+  }
+  DmpLibrary* new_library = DmpSharedRegistry::attach(registry_name, 4);
+  if (new_library == NULL) return -1;
+  int i_dmp = old_library->find(names[10]);
+  if (i_dmp < 0 ||
+      old_library->y_attr(i_dmp) != j_dmps[10].at("_y_attr").get<VectorXd>() ||
+      !sameDmp(old_library, names[10], j_dmps[10])) {
+    cerr << "The old version changed after publishing an update" << endl;
+    all_ok = false;
+  }
+  i_dmp = new_library->find(names_update[10]);
+  if (i_dmp < 0 ||
+      new_library->y_attr(i_dmp) !=
+          j_dmps_update[10].at("_y_attr").get<VectorXd>() ||
+      !sameDmp(new_library, names_update[10], j_dmps_update[10])) {
+    cerr << "Attaching after an update did not give the new version" << endl;
+    all_ok = false;
+  }
+
+  // The shared memory object of the old version has been unlinked, so that it
+  // is freed once the last process deletes its library.
+  string old_object =
+      "/dmpbbo." + registry_name + ".v" + to_string(old_version);
+  int fd = shm_open(old_object.c_str(), O_RDONLY, 0);
+  if (fd >= 0) {
+    cerr << old_object << " was not unlinked after an update" << endl;
+    all_ok = false;
+    close(fd);
+  }
+
+  // Removing the entry does not affect the libraries that are attached.
+  if (!DmpSharedRegistry::remove(registry_name) ||
+      DmpSharedRegistry::version(registry_name) != 0 ||
+      DmpSharedRegistry::remove(registry_name)) {
+    cerr << "Could not remove " << registry_name << endl;
+    all_ok = false;
+  }
+  if (!sameDmp(new_library, names_update[n_dmps - 1],
+               j_dmps_update[n_dmps - 1])) {
+    cerr << "An attached library changed after removing the entry" << endl;
+    all_ok = false;
+  }
+  delete old_library;
+  delete new_library;
+
+  return all_ok ? 0 : -1;
+}
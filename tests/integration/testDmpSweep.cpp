@@ -0,0 +1,105 @@
+/**
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <fstream>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include <string>
+
+#include "dmp/Dmp.hpp"
+#include "eigenutils/eigen_json.hpp"
+
+using namespace std;
+using namespace Eigen;
+using namespace DmpBbo;
+using namespace nlohmann;
+
+int main(int n_args, char** args)
+{
+  if (n_args != 2) {
+    cout << "Usage: " << args[0] << " <dmp filename.json>" << endl;
+    return -1;
+  }
+
+  ifstream file(args[1]);
+  if (file.fail()) {
+    cerr << "Could not find: " << args[1] << endl;
+    return -1;
+  }
+  json j = json::parse(file);
+  bool all_ok = true;
+
+  int n_candidates = 20;
+  int n_time_steps = 500;
+  double tolerance = 10e-10;
+  for (string scaling : {"AMPLITUDE_SCALING", "G_MINUS_Y0_SCALING"}) {
+    j["_forcing_term_scaling"] = scaling;
+    Dmp* dmp = j.get<Dmp*>();
+    int D = dmp->dim_y();
+    VectorXd ts = VectorXd::LinSpaced(n_time_steps, 0.0, 1.2 * dmp->tau());
+
+    // Candidate start and goal states around the ones of the Dmp
+    VectorXd y_init = j.at("_y_init");
+    VectorXd y_attr = j.at("_y_attr");
+    MatrixXd y_inits = y_init.transpose().replicate(n_candidates, 1);
+    MatrixXd y_attrs = y_attr.transpose().replicate(n_candidates, 1);
+    y_inits += 0.5 * MatrixXd::Random(n_candidates, D);
+    y_attrs += 0.5 * MatrixXd::Random(n_candidates, D);
+
+    // Reference solution, which must not change by calling the sweep
+    MatrixXd xs_before, xds_before;
+    dmp->analyticalSolution(ts, xs_before, xds_before);
+
+    // All candidates at once
+    MatrixXd ys, yds, ydds;
+    dmp->analyticalSolutionSweep(ts, y_inits, y_attrs, ys, yds, ydds);
+
+    MatrixXd xs, xds;
+    dmp->analyticalSolution(ts, xs, xds);
+    if (xs != xs_before || xds != xds_before) {
+      cerr << "analyticalSolutionSweep() changed the state of the Dmp" << endl;
+      all_ok = false;
+    }
+
+    // One analytical solution per candidate
+    double max_diff = 0.0;
+    for (int i_cand = 0; i_cand < n_candidates; i_cand++) {
+      Dmp* dmp_cand = dmp->clone();
+      VectorXd y_init_cand = y_inits.row(i_cand);
+      VectorXd y_attr_cand = y_attrs.row(i_cand);
+      dmp_cand->set_y_init(y_init_cand);
+      dmp_cand->set_y_attr(y_attr_cand);
+      dmp_cand->analyticalSolution(ts, xs, xds);
+      double diff =
+          (ys.middleCols(i_cand * D, D) - xs.leftCols(D)).cwiseAbs().maxCoeff();
+      max_diff = max(max_diff, diff);
+      delete dmp_cand;
+    }
+    cout << scaling << ": max |y_sweep - y_candidate| = " << max_diff << endl;
+    if (max_diff > tolerance) {
+      cerr << "analyticalSolutionSweep() differs by more than " << tolerance
+           << " from analyticalSolution()" << endl;
+      all_ok = false;
+    }
+
+    delete dmp;
+  }
+
+  return all_ok ? 0 : -1;
+}
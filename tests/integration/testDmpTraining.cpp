@@ -0,0 +1,167 @@
+/**
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <eigen3/Eigen/Core>
+#include <fstream>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+
+#include "dmp/Dmp.hpp"
+#include "dmp/Trajectory.hpp"
+#include "threadutils/ThreadPool.hpp"
+
+using namespace std;
+using namespace Eigen;
+using namespace DmpBbo;
+using namespace nlohmann;
+
+/** Get the maximum difference between a trajectory and the trajectory of a
+ * Dmp, relative to the range of the positions.
+ * \param[in] dmp The Dmp
+ * \param[in] trajectory The trajectory
+ * \return The maximum difference between the positions
+ */
+double reproductionError(const Dmp* dmp, const Trajectory& trajectory)
+{
+  MatrixXd ys, yds, ydds;
+  dmp->analyticalSolutionTrajectory(trajectory.ts(), ys, yds, ydds);
+  const MatrixXd& ys_demo = trajectory.ys();
+  double range = (ys_demo.colwise().maxCoeff() - ys_demo.colwise().minCoeff())
+                     .maxCoeff();
+  return (ys - ys_demo).cwiseAbs().maxCoeff() / range;
+}
+
+int main(int n_args, char** args)
+{
+  if (n_args != 2) {
+    cout << "Usage: " << args[0] << " <dmp filename.json>" << endl;
+    return -1;
+  }
+
+  ifstream file(args[1]);
+  if (file.fail()) {
+    cerr << "Could not find: " << args[1] << endl;
+    return -1;
+  }
+  json j = json::parse(file);
+  bool all_ok = true;
+
+  // A Dmp that is trained with the trajectory of a Dmp reproduces it, if
+  // it has the same function approximators.
+  Dmp* dmp = j.get<Dmp*>();
+  VectorXd ts = VectorXd::LinSpaced(201, 0.0, dmp->tau());
+  Trajectory trajectory;
+  dmp->analyticalSolution(ts, trajectory);
+  json fa_meta_params = j.at("_function_approximators")[0];
+  fa_meta_params.erase("_model_params");
+  Dmp* trained = Dmp::fromTrajectory(trajectory, fa_meta_params);
+  double error =
+      (trained == NULL ? 1.0 : reproductionError(trained, trajectory));
+  cout << "json Dmp: relative reproduction error " << error << endl;
+  if (error > 10e-4) {
+    cerr << "The trained Dmp does not reproduce the trajectory" << endl;
+    all_ok = false;
+  }
+  delete trained;
+  delete dmp;
+
+  // A demonstration through a viapoint, for each type of Dmp and function
+  // approximator. With these numbers of basis functions, the viapoint is
+  // reproduced up to about 2% of the range of the movement.
+  VectorXd y_init(2), y_attr(2);
+  y_init << 0.0, 1.0;
+  y_attr << 0.4, 0.5;
+  VectorXd viapoint = VectorXd::Zero(6);
+  viapoint.head(2) << 0.8, 1.2;
+  ts = VectorXd::LinSpaced(201, 0.0, 1.0);
+  Trajectory demonstration =
+      Trajectory::generatePolynomialTrajectoryThroughViapoint(
+          ts, y_init, viapoint, 0.4, y_attr);
+  vector<json> fas_meta_params = {
+      {{"class", "FunctionApproximatorRBFN"},
+       {"_meta_params",
+        {{"n_basis_functions_per_dim", {25}}, {"intersection_height", 0.7}}}},
+      {{"class", "FunctionApproximatorLWR"},
+       {"_meta_params",
+        {{"n_basis_functions_per_dim", {15}}, {"intersection_height", 0.5}}}}};
+  vector<string> dmp_types = {"IJSPEERT_2002_MOVEMENT",
+                              "KULVICIUS_2012_JOINING", "COUNTDOWN_2013"};
+  ThreadPool thread_pool(2);
+  for (const json& meta_params : fas_meta_params) {
+    for (string dmp_type : dmp_types) {
+      string name = meta_params.at("class").get<string>() + ", " + dmp_type;
+      Dmp* dmp = Dmp::fromTrajectory(demonstration, meta_params, dmp_type);
+      if (dmp == NULL) {
+        cerr << name << ": training failed" << endl;
+        all_ok = false;
+        continue;
+      }
+      double error = reproductionError(dmp, demonstration);
+      cout << name << ": relative reproduction error " << error << endl;
+      if (error > 5e-2 || dmp->tau() != ts[ts.size() - 1]) {
+        cerr << name << ": the trained Dmp does not reproduce the trajectory"
+             << endl;
+        all_ok = false;
+      }
+
+      // Training in a thread pool gives the same parameters.
+      Dmp* dmp_pool = Dmp::fromTrajectory(demonstration, meta_params, dmp_type,
+                                          "NO_SCALING", &thread_pool);
+      VectorXd parameters, parameters_pool;
+      dmp->getLinearParameterVector(parameters);
+      if (dmp_pool != NULL) dmp_pool->getLinearParameterVector(parameters_pool);
+      if (parameters != parameters_pool) {
+        cerr << name << ": training in a thread pool gives other parameters"
+             << endl;
+        all_ok = false;
+      }
+      delete dmp_pool;
+
+      // Training with a trajectory of another dimensionality fails, and does
+      // not change the Dmp.
+      Trajectory demonstration_1D =
+          Trajectory::generateMinJerkTrajectory(ts, y_init.head(1),
+                                                y_attr.head(1));
+      if (dmp->train(demonstration_1D, meta_params) ||
+          reproductionError(dmp, demonstration) != error) {
+        cerr << name << ": training with a 1D trajectory changed the Dmp"
+             << endl;
+        all_ok = false;
+      }
+
+      // Training fails if a function approximator cannot be trained, and
+      // does not change the Dmp either.
+      Trajectory demonstration_other =
+          Trajectory::generateMinJerkTrajectory(0.5 * ts, 2.0 * y_init, y_attr);
+      json meta_params_invalid = {{"class", meta_params.at("class")}};
+      VectorXd y_init_dmp = dmp->y_init();
+      if (dmp->train(demonstration_other, meta_params_invalid) ||
+          dmp->tau() != ts[ts.size() - 1] || dmp->y_init() != y_init_dmp ||
+          reproductionError(dmp, demonstration) != error) {
+        cerr << name << ": training that failed changed the Dmp" << endl;
+        all_ok = false;
+      }
+      delete dmp;
+    }
+  }
+
+  return all_ok ? 0 : -1;
+}
@@ -0,0 +1,243 @@
+/**
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define EIGEN_RUNTIME_NO_MALLOC  // Enable runtime tests for allocations
+
+#include <cmath>
+#include <eigen3/Eigen/Core>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+
+#include "dmp/Dmp.hpp"
+#include "dmp/DmpWithSchedules.hpp"
+#include "eigenutils/eigen_json.hpp"
+#include "eigenutils/eigen_realtime_check.hpp"
+#include "functionapproximators/FunctionApproximator.hpp"
+
+using namespace std;
+using namespace Eigen;
+using namespace DmpBbo;
+using namespace nlohmann;
+
+/** Compute the schedules as in the Python class DmpWithSchedules, i.e. by
+ * calling predict() for each function approximator, and clipping the outputs.
+ * \param[in] dmp The Dmp with schedules
+ * \param[in] phases Phases for which to compute the schedules
+ * \return The schedules (T x dim_schedules())
+ */
+MatrixXd referenceSchedules(const DmpWithSchedules* dmp, const VectorXd& phases)
+{
+  MatrixXd schedules(phases.size(), dmp->dim_schedules());
+  MatrixXd output;
+  for (int i_dim = 0; i_dim < dmp->dim_schedules(); i_dim++) {
+    dmp->function_approximator_schedules(i_dim)->predict(phases, output);
+    schedules.col(i_dim) = output.col(0)
+                               .cwiseMax(dmp->min_schedules()[i_dim])
+                               .cwiseMin(dmp->max_schedules()[i_dim]);
+  }
+  return schedules;
+}
+
+/** Integrate a Dmp with schedules step by step, with real-time checks.
+ * \param[in] dmp The Dmp with schedules
+ * \param[in] ts Times at which to integrate
+ * \param[out] xs States (T x dim())
+ * \param[out] schedules Schedules (T x dim_schedules())
+ */
+void integrate(const DmpWithSchedules* dmp, const VectorXd& ts, MatrixXd& xs,
+               MatrixXd& schedules)
+{
+  xs.resize(ts.size(), dmp->dim());
+  schedules.resize(ts.size(), dmp->dim_schedules());
+  VectorXd x(dmp->dim()), xd(dmp->dim()), sched(dmp->dim_schedules());
+  dmp->integrateStartSched(x, xd, sched);
+  xs.row(0) = x;
+  schedules.row(0) = sched;
+  for (int tt = 1; tt < ts.size(); tt++) {
+    ENTERING_REAL_TIME_CRITICAL_CODE
+    dmp->integrateStepSched(ts[tt] - ts[tt - 1], x, x, xd, sched);
+    EXITING_REAL_TIME_CRITICAL_CODE
+    xs.row(tt) = x;
+    schedules.row(tt) = sched;
+  }
+}
+
+/** Read a json file.
+ * \param[in] filename Name of the file
+ * \param[out] j The json in the file
+ * \return false if the file could not be found
+ */
+bool readJson(const string& filename, json& j)
+{
+  ifstream file(filename);
+  if (file.fail()) {
+    cerr << "Could not find: " << filename << endl;
+    return false;
+  }
+  j = json::parse(file);
+  return true;
+}
+
+int main(int n_args, char** args)
+{
+  if (n_args != 2) {
+    cout << "Usage: " << args[0] << " <dmp filename.json>" << endl;
+    return -1;
+  }
+
+  // The function approximators of the schedules are in the same directory.
+  string filename_dmp = args[1];
+  string directory = filename_dmp.substr(0, filename_dmp.rfind('/') + 1);
+  json j_dmp, j_rbfn, j_lwr;
+  if (!readJson(filename_dmp, j_dmp) ||
+      !readJson(directory + "RBFN_1D_for_cpp.json", j_rbfn) ||
+      !readJson(directory + "LWR_1D_for_cpp.json", j_lwr))
+    return -1;
+  bool all_ok = true;
+
+  // The json files were written by dmpbbo.json_for_cpp.savejson_for_cpp().
+  // A Python DmpWithSchedules is saved as a Dmp, with the function
+  // approximators of the schedules and their bounds (None if unbounded).
+  json j_sched = j_dmp;
+  j_sched["class"] = "DmpWithSchedules";
+  j_sched["_func_apps_schedules"] = {j_rbfn, j_lwr};
+  j_sched["min_schedules"] = nullptr;
+  j_sched["max_schedules"] = nullptr;
+
+  // Schedules with the same basis functions as the forcing term, for which
+  // the activations are computed only once.
+  json j_shared = j_sched;
+  j_shared["_func_apps_schedules"] = j_dmp["_function_approximators"];
+  for (json& j_fa : j_shared["_func_apps_schedules"]) {
+    MatrixXd weights = j_fa["_model_params"]["weights"];
+    j_fa["_model_params"]["weights"] = MatrixXd(-2.0 * weights);
+  }
+
+  Dmp* dmp = j_dmp.get<Dmp*>();
+  VectorXd ts = VectorXd::LinSpaced(201, 0.0, 1.2 * dmp->tau());
+  MatrixXd xs_dmp, xds_dmp, xs_dmp_step(ts.size(), dmp->dim());
+  dmp->analyticalSolution(ts, xs_dmp, xds_dmp);
+  VectorXd x(dmp->dim()), xd(dmp->dim());
+  dmp->integrateStart(x, xd);
+  xs_dmp_step.row(0) = x;
+  for (int tt = 1; tt < ts.size(); tt++) {
+    dmp->integrateStep(ts[tt] - ts[tt - 1], x, x, xd);
+    xs_dmp_step.row(tt) = x;
+  }
+  int i_phase = 3 * dmp->dim_y();
+  delete dmp;
+
+  for (bool shared : {false, true}) {
+    for (bool bounded : {false, true}) {
+      string suffix = string(" (") + (shared ? "shared" : "separate") +
+                      " basis functions" + (bounded ? ", bounded)" : ")");
+      json j = shared ? j_shared : j_sched;
+      DmpWithSchedules* dmp_sched = j.get<DmpWithSchedules*>();
+      if (dmp_sched->min_schedules().array().isFinite().any() ||
+          dmp_sched->max_schedules().array().isFinite().any()) {
+        cerr << "Bounds of None were read as finite" << suffix << endl;
+        all_ok = false;
+      }
+
+      MatrixXd xs, xds, schedules;
+      if (bounded) {
+        // Bounds in the middle of the range of each schedule, so that they
+        // clip, as np.clip() in Python. Python saves them as flat arrays.
+        dmp_sched->analyticalSolutionSched(ts, xs, xds, schedules);
+        VectorXd lower = schedules.colwise().minCoeff();
+        VectorXd upper = schedules.colwise().maxCoeff();
+        VectorXd min_schedules = 0.75 * lower + 0.25 * upper;
+        VectorXd max_schedules = 0.25 * lower + 0.75 * upper;
+        j["min_schedules"] = vector<double>(
+            min_schedules.data(), min_schedules.data() + min_schedules.size());
+        j["max_schedules"] = vector<double>(
+            max_schedules.data(), max_schedules.data() + max_schedules.size());
+        delete dmp_sched;
+        dmp_sched = j.get<DmpWithSchedules*>();
+        if (dmp_sched->min_schedules() != min_schedules ||
+            dmp_sched->max_schedules() != max_schedules) {
+          cerr << "The bounds were not read from json" << suffix << endl;
+          all_ok = false;
+        }
+      }
+
+      MatrixXd xs_step, schedules_step;
+      integrate(dmp_sched, ts, xs_step, schedules_step);
+      dmp_sched->analyticalSolutionSched(ts, xs, xds, schedules);
+
+      // The schedules are those of Python, and the states those of the Dmp.
+      MatrixXd reference = referenceSchedules(dmp_sched, xs_step.col(i_phase));
+      double max_diff_step = (schedules_step - reference).cwiseAbs().maxCoeff();
+      reference = referenceSchedules(dmp_sched, xs.col(i_phase));
+      double max_diff_ana = (schedules - reference).cwiseAbs().maxCoeff();
+      double max_diff_xs =
+          max((xs_step - xs_dmp_step).cwiseAbs().maxCoeff(),
+              (xs - xs_dmp).cwiseAbs().maxCoeff());
+      cout << "max |schedules - python|: " << max_diff_step << " (step), "
+           << max_diff_ana << " (analytical); max |xs - xs_dmp|: "
+           << max_diff_xs << suffix << endl;
+      if (max_diff_step > 10e-12 || max_diff_ana > 10e-12) {
+        cerr << "The schedules differ from those in Python" << suffix << endl;
+        all_ok = false;
+      }
+      if (max_diff_xs > 10e-12) {
+        cerr << "The schedules change the states of the Dmp" << suffix
+             << endl;
+        all_ok = false;
+      }
+      if (bounded) {
+        ArrayXXd clipped =
+            (schedules.rowwise() - dmp_sched->min_schedules().transpose())
+                .array()
+                .min((dmp_sched->max_schedules().transpose().replicate(
+                          ts.size(), 1) -
+                      schedules)
+                         .array());
+        if ((clipped.colwise().minCoeff() != 0.0).any()) {
+          cerr << "The bounds do not clip every schedule" << suffix << endl;
+          all_ok = false;
+        }
+      }
+
+      // Round trip through json
+      json j_saved = dmp_sched;
+      DmpWithSchedules* dmp_loaded = j_saved.get<DmpWithSchedules*>();
+      MatrixXd xs_loaded, schedules_loaded;
+      integrate(dmp_loaded, ts, xs_loaded, schedules_loaded);
+      if (j_saved.at("class") != "DmpWithSchedules" ||
+          xs_loaded != xs_step || schedules_loaded != schedules_step) {
+        cerr << "The Dmp changed after saving it to json" << suffix << endl;
+        all_ok = false;
+      }
+      if (!bounded && (!j_saved.at("min_schedules").is_null() ||
+                       !j_saved.at("max_schedules").is_null())) {
+        cerr << "Bounds were saved, but there are none" << suffix << endl;
+        all_ok = false;
+      }
+      delete dmp_loaded;
+      delete dmp_sched;
+    }
+  }
+
+  return all_ok ? 0 : -1;
+}
@@ -0,0 +1,82 @@
+/**
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <fstream>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include <string>
+
+#include "eigenutils/eigen_file_io.hpp"
+#include "eigenutils/eigen_json.hpp"
+#include "functionapproximators/FunctionApproximator.hpp"
+
+using namespace std;
+using namespace Eigen;
+using namespace DmpBbo;
+using namespace nlohmann;
+
+int main(int n_args, char** args)
+{
+  if (n_args != 4) {
+    cout << "Usage: " << args[0] << " <directory> <fa_name> <n_dims>" << endl;
+    return -1;
+  }
+
+  string directory = args[1];
+  string fa_name = args[2];
+  int n_dims = atoi(args[3]);
+  string basename = directory + "/" + fa_name + "_" + to_string(n_dims) + "D";
+
+  // The meta-parameters are those of the function approximator trained in
+  // Python.
+  string filename_json = basename + "_for_cpp.json";
+  ifstream file(filename_json);
+  if (file.fail()) {
+    cerr << "Could not find: " << filename_json << endl;
+    return -1;
+  }
+  json j = json::parse(file);
+
+  MatrixXd inputs, targets;
+  string filename_inputs = basename + "_training_inputs.txt";
+  string filename_targets = basename + "_training_targets.txt";
+  if (!loadMatrix(filename_inputs, inputs) ||
+      !loadMatrix(filename_targets, targets)) {
+    cerr << "Could not load: " << filename_inputs << " or " << filename_targets
+         << endl;
+    return -1;
+  }
+
+  FunctionApproximator* fa =
+      FunctionApproximator::train(j, inputs, targets.col(0));
+  if (fa == NULL) {
+    cerr << "Could not train: " << filename_json << endl;
+    return -1;
+  }
+
+  // Write the model parameters with full precision, so that they can be
+  // compared with those trained in Python.
+  json j_trained = fa;
+  ofstream file_trained(basename + "_trained_cpp.json");
+  file_trained << j_trained.dump(2) << endl;
+
+  delete fa;
+
+  return 0;
+}
@@ -0,0 +1,179 @@
+/**
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <boost/filesystem.hpp>
+#include <eigen3/Eigen/Core>
+#include <fstream>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+
+#include "bbo/LearningSessionLog.hpp"
+
+using namespace std;
+using namespace Eigen;
+using namespace DmpBbo;
+using namespace nlohmann;
+namespace fs = boost::filesystem;
+
+/** Check a condition, and print a message if it does not hold.
+ * \param[in] condition The condition
+ * \param[in] message Message to print if the condition does not hold
+ * \return The condition
+ */
+bool check(bool condition, const string& message)
+{
+  if (!condition) cerr << message << endl;
+  return condition;
+}
+
+/** Check that a log contains a matrix.
+ * \param[in] log The log
+ * \param[in] key Key of the matrix
+ * \param[in] expected The expected matrix
+ * \return true if the log contains the expected matrix
+ */
+bool checkMatrix(const LearningSessionLog* log, const string& key,
+                 const MatrixXd& expected)
+{
+  MatrixXd matrix;
+  return check(log->readMatrix(key, matrix) && matrix == expected,
+               "Could not read the matrix '" + key + "' from the log");
+}
+
+int main(int n_args, char** args)
+{
+  fs::path directory = fs::temp_directory_path() / fs::unique_path();
+  fs::create_directories(directory);
+  string filename = (directory / "session.dmpbbolog").string();
+  string index_filename = filename + ".idx";
+  bool all_ok = true;
+
+  // Append matrices, vectors, json and rollouts
+  MatrixXd a = MatrixXd::Random(3, 2);
+  VectorXd b = VectorXd::Random(4);
+  json c = {{"d", 4}, {"e", {1.0, 2.0}}};
+  VectorXd sample = VectorXd::Random(5);
+  MatrixXd cost_vars = MatrixXd::Random(10, 3);
+  VectorXd cost = VectorXd::Random(2);
+  LearningSessionLog* log = LearningSessionLog::open(filename);
+  all_ok &= check(log != NULL, "Could not create the log");
+  if (log == NULL) return -1;
+  all_ok &= check(log->appendMatrix("a", a), "Could not append 'a'");
+  all_ok &= check(log->appendVector("b", b), "Could not append 'b'");
+  all_ok &= check(log->appendJson("c", c), "Could not append 'c'");
+  all_ok &= check(log->appendRollout(2, 1, sample, cost_vars, cost),
+                  "Could not append the rollout");
+  delete log;
+
+  // Reopen the log, and read everything
+  vector<string> keys = {"a",
+                         "b",
+                         "c",
+                         LearningSessionLog::key("sample", 2, 1),
+                         LearningSessionLog::key("cost_vars", 2, 1),
+                         LearningSessionLog::key("cost", 2, 1)};
+  log = LearningSessionLog::open(filename, true);
+  if (log == NULL) return -1;
+  all_ok &= check(log->keys() == keys, "Wrong keys after reopening");
+  all_ok &= check(log->getNumberOfUpdates() == 3, "Wrong number of updates");
+  all_ok &= checkMatrix(log, "a", a);
+  all_ok &= checkMatrix(log, "b", b);
+  all_ok &= checkMatrix(log, keys[3], sample);
+  all_ok &= checkMatrix(log, keys[4], cost_vars);
+  all_ok &= checkMatrix(log, keys[5], cost);
+  json j;
+  all_ok &= check(log->readJson("c", j) && j == c, "Could not read 'c'");
+  all_ok &= check(!log->exists("f") && !log->readMatrix("f", a),
+                  "Read a key that was not appended");
+  all_ok &= check(!log->appendMatrix("f", a),
+                  "Appended to a log opened for reading only");
+  delete log;
+
+  // Appending a key again replaces its value, but not its position
+  MatrixXd a_new = MatrixXd::Random(2, 2);
+  log = LearningSessionLog::open(filename);
+  if (log == NULL) return -1;
+  all_ok &= check(log->appendMatrix("a", a_new), "Could not append 'a'");
+  delete log;
+  log = LearningSessionLog::open(filename, true);
+  if (log == NULL) return -1;
+  all_ok &= check(log->keys() == keys, "Wrong keys after appending 'a'");
+  all_ok &= checkMatrix(log, "a", a_new);
+  delete log;
+
+  // A truncated record at the end is ignored, and removed before appending
+  uint64_t data_size = fs::file_size(filename);
+  uint64_t index_size = fs::file_size(index_filename);
+  log = LearningSessionLog::open(filename);
+  if (log == NULL) return -1;
+  all_ok &= check(log->appendMatrix("f", MatrixXd::Random(20, 20)),
+                  "Could not append 'f'");
+  delete log;
+  fs::resize_file(filename, (data_size + fs::file_size(filename)) / 2);
+  log = LearningSessionLog::open(filename, true);
+  if (log == NULL) return -1;
+  all_ok &= check(log->keys() == keys, "The truncated record was read");
+  delete log;
+  MatrixXd g = MatrixXd::Random(2, 3);
+  log = LearningSessionLog::open(filename);
+  if (log == NULL) return -1;
+  all_ok &= check(fs::file_size(filename) == data_size &&
+                      fs::file_size(index_filename) == index_size,
+                  "The truncated record was not removed");
+  all_ok &= check(log->appendMatrix("g", g), "Could not append 'g'");
+  delete log;
+  keys.push_back("g");
+  log = LearningSessionLog::open(filename, true);
+  if (log == NULL) return -1;
+  all_ok &= check(log->keys() == keys, "Wrong keys after the truncation");
+  all_ok &= checkMatrix(log, "g", g);
+  all_ok &= checkMatrix(log, "a", a_new);
+  delete log;
+
+  // A missing index is recovered from the records in the data file, also if
+  // the data file ends with an incomplete record header
+  fs::remove(index_filename);
+  data_size = fs::file_size(filename);
+  ofstream(filename.c_str(), ios::binary | ios::app) << string("DBSR\0", 5);
+  log = LearningSessionLog::open(filename, true);
+  if (log == NULL) return -1;
+  all_ok &= check(log->keys() == keys, "Wrong keys without the index");
+  all_ok &= checkMatrix(log, "a", a_new);
+  all_ok &= checkMatrix(log, "g", g);
+  delete log;
+  log = LearningSessionLog::open(filename);
+  if (log == NULL) return -1;
+  all_ok &= check(fs::file_size(filename) == data_size,
+                  "The incomplete record header was not removed");
+  all_ok &= check(log->appendJson("h", c), "Could not append 'h'");
+  delete log;
+  keys.push_back("h");
+  log = LearningSessionLog::open(filename, true);
+  if (log == NULL) return -1;
+  all_ok &= check(fs::exists(index_filename), "The index was not recreated");
+  all_ok &= check(log->keys() == keys, "Wrong keys after recovering the index");
+  all_ok &= checkMatrix(log, keys[3], sample);
+  all_ok &= check(log->readJson("h", j) && j == c, "Could not read 'h'");
+  delete log;
+
+  fs::remove_all(directory);
+  return all_ok ? 0 : -1;
+}
@@ -0,0 +1,129 @@
+/**
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <eigen3/Eigen/Core>
+#include <iostream>
+#include <string>
+
+#include "functionapproximators/FunctionApproximatorLWR.hpp"
+#include "functionapproximators/FunctionApproximatorRBFN.hpp"
+#include "functionapproximators/RecursiveLeastSquares.hpp"
+
+using namespace std;
+using namespace Eigen;
+using namespace DmpBbo;
+
+/** Make training data for a 1D or 2D function approximator.
+ * \param[in] n_dims Dimensionality of the inputs (1 or 2)
+ * \param[out] inputs Inputs (n_samples X n_dims)
+ * \param[out] targets Targets (n_samples)
+ */
+void targetFunction(int n_dims, MatrixXd& inputs, VectorXd& targets)
+{
+  if (n_dims == 1) {
+    inputs = VectorXd::LinSpaced(200, 0.0, 2.0);
+    targets = 3.0 * (-inputs.array()).exp() *
+              (2.0 * inputs.array().square()).sin();
+  } else {
+    VectorXd xs = VectorXd::LinSpaced(20, -2.0, 2.0);
+    inputs.resize(xs.size() * xs.size(), 2);
+    targets.resize(inputs.rows());
+    for (int i = 0; i < xs.size(); i++) {
+      for (int j = 0; j < xs.size(); j++) {
+        int ii = i * xs.size() + j;
+        inputs.row(ii) << xs[i], xs[j];
+        targets[ii] = 2.5 * xs[i] * exp(-xs[i] * xs[i] - xs[j] * xs[j]);
+      }
+    }
+  }
+}
+
+/** Update a learner with all samples, and compare its predictions with those
+ * of a batch regression.
+ * \param[in] name Name of the function approximator, for the output
+ * \param[in] initial Function approximator with the basis functions of the
+ * batch regression, and zero parameters
+ * \param[in] batch The function approximator trained with batch regression
+ * \param[in] inputs Inputs of the training data
+ * \param[in] targets Targets of the training data
+ * \param[in] initial_covariance Initial covariance of the learner, which
+ * corresponds to a regularization of 1/initial_covariance
+ * \return true if the predictions are the same
+ */
+bool compare(string name, const FunctionApproximator& initial,
+             const FunctionApproximator& batch, const MatrixXd& inputs,
+             const VectorXd& targets, double initial_covariance)
+{
+  RecursiveLeastSquares* rls =
+      RecursiveLeastSquares::create(initial, 1.0, initial_covariance, 0.0);
+  for (int i_sample = 0; i_sample < inputs.rows(); i_sample++)
+    rls->updateRealTime(inputs.row(i_sample), targets[i_sample]);
+
+  MatrixXd outputs_rls, outputs_batch;
+  rls->function_approximator().predict(inputs, outputs_rls);
+  batch.predict(inputs, outputs_batch);
+  delete rls;
+
+  double max_diff = (outputs_rls - outputs_batch).cwiseAbs().maxCoeff();
+  cout << name << ": max |outputs_rls - outputs_batch| = " << max_diff << endl;
+  if (max_diff > 10e-12) {
+    cerr << name << ": recursive and batch least squares differ" << endl;
+    return false;
+  }
+  return true;
+}
+
+int main(int n_args, char** args)
+{
+  bool all_ok = true;
+
+  // Without forgetting, and with all basis functions active, recursive least
+  // squares from zero parameters with an initial covariance c converges to
+  // the batch regression with a regularization of 1/c.
+  double initial_covariance = 1000.0;
+  double regularization = 1.0 / initial_covariance;
+  for (int n_dims = 1; n_dims <= 2; n_dims++) {
+    MatrixXd inputs;
+    VectorXd targets;
+    targetFunction(n_dims, inputs, targets);
+    VectorXi n_bfs_per_dim = VectorXi::Constant(n_dims, n_dims == 1 ? 9 : 5);
+    string suffix = " " + to_string(n_dims) + "D";
+
+    FunctionApproximatorRBFN* rbfn = FunctionApproximatorRBFN::train(
+        inputs, targets, n_bfs_per_dim, 0.7, regularization);
+    FunctionApproximatorRBFN rbfn_initial(
+        rbfn->centers(), rbfn->widths(),
+        VectorXd::Zero(rbfn->weights().size()));
+    all_ok &= compare("RBFN" + suffix, rbfn_initial, *rbfn, inputs, targets,
+                      initial_covariance);
+    delete rbfn;
+
+    FunctionApproximatorLWR* lwr = FunctionApproximatorLWR::train(
+        inputs, targets, n_bfs_per_dim, 0.5, regularization);
+    FunctionApproximatorLWR lwr_initial(
+        lwr->centers(), lwr->widths(),
+        MatrixXd::Zero(lwr->slopes().rows(), lwr->slopes().cols()),
+        MatrixXd::Zero(lwr->offsets().size(), 1));
+    all_ok &= compare("LWR" + suffix, lwr_initial, *lwr, inputs, targets,
+                      initial_covariance);
+    delete lwr;
+  }
+
+  return all_ok ? 0 : -1;
+}
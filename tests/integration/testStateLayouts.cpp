@@ -0,0 +1,281 @@
+/**
+ * This file is part of DmpBbo, a set of libraries and programs for the
+ * black-box optimization of dynamical movement primitives.
+ * Copyright (C) 2026 The DmpBbo contributors
+ *
+ * DmpBbo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * DmpBbo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <cmath>
+#include <eigen3/Eigen/Core>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+
+#include "dmp/Dmp.hpp"
+#include "dynamicalsystems/DynamicalSystem.hpp"
+
+using namespace std;
+using namespace Eigen;
+using namespace DmpBbo;
+using namespace nlohmann;
+
+typedef Stride<Dynamic, Dynamic> DynamicStride;
+
+/** Largest absolute difference between two matrices.
+ * \param[in] a First matrix
+ * \param[in] b Second matrix
+ * \return Largest absolute difference (infinity if the sizes differ)
+ */
+double maxDiff(const MatrixXd& a, const MatrixXd& b)
+{
+  if (a.rows() != b.rows() || a.cols() != b.cols())
+    return numeric_limits<double>::infinity();
+  if (a.size() == 0) return 0.0;
+  return (a - b).cwiseAbs().maxCoeff();
+}
+
+/** Views on a buffer that contains T x D values in every other row or column,
+ * whose other entries are NaN, so that writing to them can be detected.
+ */
+struct StridedBuffer {
+  /** Constructor.
+   * \param[in] T Number of time steps
+   * \param[in] D Dimensionality of the state
+   * \param[in] layout Whether the time steps are rows or columns
+   */
+  StridedBuffer(int T, int D, DynamicalSystem::StateLayout layout)
+      : layout(layout)
+  {
+    double nan = numeric_limits<double>::quiet_NaN();
+    if (layout == DynamicalSystem::TIME_STEPS_IN_ROWS)
+      buffer = MatrixXd::Constant(2 * T, D, nan);  // Every other row
+    else
+      buffer = MatrixXd::Constant(D, 2 * T, nan);  // Every other column
+  }
+
+  /** Get a T x D view on the buffer.
+   * \return The view
+   */
+  StridedMatrixMap view(void)
+  {
+    if (layout == DynamicalSystem::TIME_STEPS_IN_ROWS)
+      return StridedMatrixMap(buffer.data(), buffer.rows() / 2, buffer.cols(),
+                              DynamicStride(buffer.rows(), 2));
+    return StridedMatrixMap(buffer.data(), buffer.cols() / 2, buffer.rows(),
+                            DynamicStride(1, 2 * buffer.rows()));
+  }
+
+  /** Get the values in the view.
+   * \return T x D values
+   */
+  MatrixXd values(void) { return view(); }
+
+  /** Check whether the entries outside the view were not written.
+   * \return true if they are all NaN
+   */
+  bool gapsUntouched(void) const
+  {
+    if (layout == DynamicalSystem::TIME_STEPS_IN_ROWS) {
+      for (int row = 1; row < buffer.rows(); row += 2)
+        if (!buffer.row(row).array().isNaN().all()) return false;
+    } else {
+      for (int col = 1; col < buffer.cols(); col += 2)
+        if (!buffer.col(col).array().isNaN().all()) return false;
+    }
+    return true;
+  }
+
+  /** The layout of the buffer. */
+  DynamicalSystem::StateLayout layout;
+  /** The buffer. */
+  MatrixXd buffer;
+};
+
+/** Compare the analytical solution of a system in all layouts with the one in
+ * a T x D matrix.
+ * \param[in] system The dynamical system
+ * \param[in] ts Times for which to compute the analytical solution
+ * \param[in] name Name of the system, for error messages
+ * \return true if all layouts give exactly the same solution
+ */
+bool checkLayouts(const DynamicalSystem* system, const VectorXd& ts,
+                  const string& name)
+{
+  int T = ts.size();
+  int D = system->dim();
+  MatrixXd xs, xds;
+  system->analyticalSolution(ts, xs, xds, DynamicalSystem::TIME_STEPS_IN_ROWS);
+
+  // D x T, also when the size of the matrices that are passed selects it.
+  MatrixXd xs_cols, xds_cols, xs_sized(D, T), xds_sized(D, T);
+  system->analyticalSolution(ts, xs_cols, xds_cols,
+                             DynamicalSystem::TIME_STEPS_IN_COLUMNS);
+  system->analyticalSolution(ts, xs_sized, xds_sized);
+  double max_diff =
+      max(maxDiff(xs_cols.transpose(), xs), maxDiff(xds_cols.transpose(), xds));
+  if (D != T)
+    max_diff = max(max_diff, max(maxDiff(xs_sized.transpose(), xs),
+                                 maxDiff(xds_sized.transpose(), xds)));
+
+  // Every other row or column of a larger buffer
+  bool gaps_untouched = true;
+  for (DynamicalSystem::StateLayout layout :
+       {DynamicalSystem::TIME_STEPS_IN_ROWS,
+        DynamicalSystem::TIME_STEPS_IN_COLUMNS}) {
+    StridedBuffer xs_strided(T, D, layout), xds_strided(T, D, layout);
+    system->analyticalSolution(ts, xs_strided.view(), xds_strided.view());
+    max_diff = max(max_diff, max(maxDiff(xs_strided.values(), xs),
+                                 maxDiff(xds_strided.values(), xds)));
+    gaps_untouched = gaps_untouched && xs_strided.gapsUntouched() &&
+                     xds_strided.gapsUntouched();
+  }
+
+  if (max_diff != 0.0 || !gaps_untouched) {
+    cerr << name << ": max difference between layouts " << max_diff
+         << (gaps_untouched ? "" : ", wrote outside the strided view") << endl;
+    return false;
+  }
+  return true;
+}
+
+/** Compare analyticalSolutionTrajectory() in all layouts with the channels of
+ * analyticalSolution(), cf. statesAsTrajectory().
+ * \param[in] dmp The Dmp
+ * \param[in] ts Times for which to compute the analytical solution
+ * \param[in] name Name of the Dmp, for error messages
+ * \return true if all layouts give exactly the same solution
+ */
+bool checkTrajectoryLayouts(const Dmp* dmp, const VectorXd& ts,
+                            const string& name)
+{
+  int T = ts.size();
+  int D = dmp->dim_y();
+  MatrixXd xs, xds;
+  dmp->analyticalSolution(ts, xs, xds);
+  vector<MatrixXd> reference = {xs.leftCols(D), xds.leftCols(D),
+                                xds.middleCols(D, D) / dmp->tau()};
+
+  double max_diff = 0.0;
+  vector<MatrixXd> rows(3), cols(3);
+  dmp->analyticalSolutionTrajectory(ts, rows[0], rows[1], rows[2]);
+  dmp->analyticalSolutionTrajectory(ts, cols[0], cols[1], cols[2],
+                                    DynamicalSystem::TIME_STEPS_IN_COLUMNS);
+  for (int i = 0; i < 3; i++)
+    max_diff = max(max_diff, max(maxDiff(rows[i], reference[i]),
+                                 maxDiff(cols[i].transpose(), reference[i])));
+
+  bool gaps_untouched = true;
+  for (DynamicalSystem::StateLayout layout :
+       {DynamicalSystem::TIME_STEPS_IN_ROWS,
+        DynamicalSystem::TIME_STEPS_IN_COLUMNS}) {
+    vector<StridedBuffer> strided(3, StridedBuffer(T, D, layout));
+    dmp->analyticalSolutionTrajectory(ts, strided[0].view(), strided[1].view(),
+                                      strided[2].view());
+    for (int i = 0; i < 3; i++) {
+      max_diff = max(max_diff, maxDiff(strided[i].values(), reference[i]));
+      gaps_untouched = gaps_untouched && strided[i].gapsUntouched();
+    }
+  }
+
+  if (max_diff != 0.0 || !gaps_untouched) {
+    cerr << name << ": max difference between trajectory layouts " << max_diff
+         << (gaps_untouched ? "" : ", wrote outside the strided view") << endl;
+    return false;
+  }
+  return true;
+}
+
+int main(int n_args, char** args)
+{
+  if (n_args != 2) {
+    cout << "Usage: " << args[0] << " <dmp filename.json>" << endl;
+    return -1;
+  }
+
+  // The json files of the dynamical systems are in the same directory.
+  string filename_dmp = args[1];
+  string directory = filename_dmp.substr(0, filename_dmp.rfind('/') + 1);
+  vector<string> names = {"Dmp",
+                          "ExponentialSystem_1D",
+                          "ExponentialSystem_2D",
+                          "SigmoidSystem_1D",
+                          "SigmoidSystem_2D",
+                          "SpringDamperSystem_1D",
+                          "SpringDamperSystem_2D",
+                          "TimeSystem",
+                          "TimeCountDownSystem"};
+  vector<json> jsons(names.size());
+  for (unsigned int i = 0; i < names.size(); i++) {
+    string filename = directory + names[i] + "_for_cpp.json";
+    ifstream file(filename);
+    if (file.fail()) {
+      cerr << "Could not find: " << filename << endl;
+      return -1;
+    }
+    jsons[i] = json::parse(file);
+  }
+  bool all_ok = true;
+
+  // More than 1024 time steps, so that the Dmp uses several threads.
+  VectorXd ts = VectorXd::LinSpaced(2501, 0.0, 2.0);
+  for (unsigned int i = 1; i < names.size(); i++) {
+    DynamicalSystem* system = jsons[i].get<DynamicalSystem*>();
+    all_ok = checkLayouts(system, ts, names[i]) && all_ok;
+    delete system;
+  }
+
+  for (string integration : {"EULER", "EXACT_ZOH", "EXACT_FOH"}) {
+    for (int n_threads : {1, 2}) {
+      string name = "Dmp (" + integration + ", " + to_string(n_threads) +
+                    " thread" + (n_threads > 1 ? "s)" : ")");
+      Dmp* dmp = jsons[0].get<Dmp*>();
+      dmp->set_analytical_solution_integration(integration);
+      dmp->set_analytical_solution_n_threads(n_threads, false);
+      all_ok = checkLayouts(dmp, ts, name) && all_ok;
+      all_ok = checkTrajectoryLayouts(dmp, ts, name) && all_ok;
+      delete dmp;
+    }
+  }
+
+  // analyticalSolutionTrajectory() reuses its memory for fewer time steps,
+  // and grows it for more. The results must not depend on earlier calls.
+  Dmp* dmp = jsons[0].get<Dmp*>();
+  Dmp* dmp_fresh = dmp->clone();
+  VectorXd ts_short = ts.head(ts.size() / 3);
+  VectorXd ts_long = VectorXd::LinSpaced(3001, 0.0, 2.0);
+  for (const VectorXd* ts_call : {&ts, &ts_short, &ts_long, &ts_short}) {
+    MatrixXd ys, yds, ydds, ys_fresh, yds_fresh, ydds_fresh;
+    dmp->analyticalSolutionTrajectory(*ts_call, ys, yds, ydds);
+    Dmp* dmp_new = dmp_fresh->clone();
+    dmp_new->analyticalSolutionTrajectory(*ts_call, ys_fresh, yds_fresh,
+                                          ydds_fresh);
+    delete dmp_new;
+    if (maxDiff(ys, ys_fresh) != 0.0 || maxDiff(yds, yds_fresh) != 0.0 ||
+        maxDiff(ydds, ydds_fresh) != 0.0) {
+      cerr << "analyticalSolutionTrajectory() with " << ts_call->size()
+           << " time steps depends on earlier calls" << endl;
+      all_ok = false;
+    }
+  }
+  all_ok = checkTrajectoryLayouts(dmp, ts_short, "Dmp (after reuse)") && all_ok;
+  delete dmp_fresh;
+  delete dmp;
+
+  return all_ok ? 0 : -1;
+}
@@ -103,14 +103,18 @@ def main(directory, **kwargs):
     fa_outputs_ana_cpp = np.loadtxt(os.path.join(d, "fa_outputs_ana.txt"))
     xs_step_cpp = np.loadtxt(os.path.join(d, "xs_step.txt"))
     xds_step_cpp = np.loadtxt(os.path.join(d, "xds_step.txt"))
+    xs_seek_cpp = np.loadtxt(os.path.join(d, "xs_seek.txt"))
 
     max_diff_ana = np.max(np.abs(xs_ana - np.reshape(xs_ana_cpp, xs_ana.shape)))
     max_diff_step = np.max(np.abs(xs_step - np.reshape(xs_step_cpp, xs_step.shape)))
+    max_diff_seek = np.max(np.abs(xs_ana - np.reshape(xs_seek_cpp, xs_ana.shape)))
     if verbose:
         print(f"    max_diff_ana = {max_diff_ana}")
         print(f"    max_diff_step = {max_diff_step}")
+        print(f"    max_diff_seek = {max_diff_seek}")
     assert max_diff_ana < 10e-7
     assert max_diff_step < 10e-7
+    assert max_diff_seek < 10e-7
 
     # Plotting
     if save or show:
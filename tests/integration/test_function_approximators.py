@@ -18,6 +18,7 @@
 
 
 import argparse
+import json
 import os
 import tempfile
 from pathlib import Path
@@ -120,6 +121,35 @@ def train(directory, fa_name, n_dims, **kwargs):
         print(f"    max_diff = {max_diff}  ({fa_name}, {n_dims}D)")
     assert max_diff < 10e-7
 
+    # Train a function approximator with regularization in Python and in C++
+    # with the same data and meta-parameters, and compare the model parameters.
+    # Python solves the least squares with numpy (inv), C++ with a Cholesky
+    # decomposition in Eigen, so the parameters only agree up to rounding
+    # errors, which grow with the condition number of the least squares.
+    regularization = 0.1
+    if fa_name == "LWR":
+        fa_reg = FunctionApproximatorLWR(n_rfs, intersection, regularization)
+    else:
+        fa_reg = FunctionApproximatorRBFN(n_rfs, intersection, regularization)
+    fa_reg.train(inputs, targets)
+
+    directory_reg = Path(directory, "regularized")
+    directory_reg.mkdir(parents=True, exist_ok=True)
+    jc.savejson_for_cpp(Path(directory_reg, f"{basename}_for_cpp.json"), fa_reg)
+    np.savetxt(os.path.join(directory_reg, f"{basename}_training_inputs.txt"), inputs)
+    np.savetxt(os.path.join(directory_reg, f"{basename}_training_targets.txt"), targets)
+    execute_binary("testFunctionApproximatorTraining", f"{directory_reg} {fa_name} {n_dims}")
+    with open(Path(directory_reg, f"{basename}_trained_cpp.json")) as file:
+        model_params_cpp = json.load(file)["_model_params"]
+
+    for name, values in fa_reg._model_params.items():
+        values = np.ravel(values)
+        values_cpp = np.ravel(np.array(model_params_cpp[name]))
+        max_diff = np.max(np.abs(values - values_cpp))
+        if verbose:
+            print(f"    max_diff {name} = {max_diff}  ({fa_name}, {n_dims}D, regularized)")
+        assert max_diff < 10e-9 * max(1.0, np.max(np.abs(values)))
+
     if show or save:
         h_pyt, ax = fa.plot(inputs, targets=targets)
 
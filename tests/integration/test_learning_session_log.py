@@ -0,0 +1,100 @@
+# This file is part of DmpBbo, a set of libraries and programs for the
+# black-box optimization of dynamical movement primitives.
+# Copyright (C) 2026 The DmpBbo contributors
+#
+# DmpBbo is free software: you can redistribute it and/or modify
+# it under the terms of the GNU Lesser General Public License as published by
+# the Free Software Foundation, either version 2 of the License, or
+# (at your option) any later version.
+#
+# DmpBbo is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public License
+# along with DmpBbo.  If not, see <http://www.gnu.org/licenses/>.
+""" Test for storing a learning session in a binary log (LearningSessionLog) """
+
+from pathlib import Path
+
+import numpy as np
+
+from dmpbbo.bbo.CostFunction import CostFunction
+from dmpbbo.bbo.DistributionGaussian import DistributionGaussian
+from dmpbbo.bbo.LearningSession import LearningSession
+from dmpbbo.bbo.LearningSessionLog import LearningSessionLog
+from dmpbbo.bbo.run_optimization import run_optimization
+from dmpbbo.bbo.updaters import UpdaterCovarDecay
+
+
+class CostFunctionDistanceToPoint(CostFunction):
+    """ CostFunction in which the distance to a pre-defined point must be minimized."""
+
+    def __init__(self, point):
+        self.point = np.asarray(point)
+
+    def evaluate(self, sample):
+        return [np.linalg.norm(sample - self.point)]
+
+
+def test_learning_session_log(tmp_path):
+    """ Function called for test. """
+    cost_function = CostFunctionDistanceToPoint([2.0, 2.0])
+    updater = UpdaterCovarDecay(eliteness=10, weighting_method="PI-BB", covar_decay_factor=0.8)
+
+    # Same optimization, saved to files and to a binary log
+    sessions = []
+    for binary_log in [False, True]:
+        np.random.seed(0)
+        distribution = DistributionGaussian(np.full(2, 5.0), np.eye(2))
+        directory = Path(tmp_path, f"binary_log_{binary_log}")
+        run_optimization(cost_function, distribution, updater, 10, 10, directory, binary_log)
+        sessions.append(LearningSession.from_dir(directory))
+
+    assert Path(tmp_path, "binary_log_True", LearningSession.log_filename).is_file()
+    assert not Path(tmp_path, "binary_log_True", "update00000").exists()
+
+    session_files, session_log = sessions
+    assert session_log.get_n_updates() == session_files.get_n_updates()
+    curve_files, _ = session_files.get_learning_curve()
+    curve_log, _ = session_log.get_learning_curve()
+    assert np.allclose(curve_files, curve_log)
+    for i_update in range(session_files.get_n_updates()):
+        for name in ["samples", "costs", "weights"]:
+            values_files = session_files.ask(name, i_update)
+            values_log = session_log.ask(name, i_update)
+            assert np.allclose(values_files, values_log)
+        distribution_files = session_files.ask("distribution", i_update)
+        distribution_log = session_log.ask("distribution", i_update)
+        assert np.allclose(distribution_files.covar, distribution_log.covar)
+
+    # Records that are missing from the index, e.g. because the program was interrupted, are
+    # recovered. An incomplete record at the end is removed before appending.
+    filename = Path(tmp_path, "log.dmpbbolog")
+    log = LearningSessionLog(filename)
+    log.append_all([("a", np.eye(3)), ("b", [1.0, 2.0]), ("c", {"d": 4})])
+    log.close()
+    Path(f"{filename}.idx").unlink()
+    with open(filename, "ab") as f:
+        f.write(b"DBSR\x00")
+
+    log = LearningSessionLog(filename)
+    assert log.keys() == ["a", "b", "c"]
+    log.append("e", 5)
+    log.append_all(
+        [("f", True), ("g", ["x", 1.0]), ("h", np.arange(3)), ("i", [[1.0], [2.0, 3.0]])]
+    )
+    log.close()
+
+    log = LearningSessionLog(filename, read_only=True)
+    assert np.allclose(log.read("a"), np.eye(3))
+    assert log.read("b").shape == (2,)
+    assert log.read("c") == {"d": 4}
+    # Only floating point arrays are stored as float64 arrays, all other objects as JSON text
+    assert log.read("e") == 5 and isinstance(log.read("e"), int)
+    assert log.read("f") is True
+    assert log.read("g") == ["x", 1.0]
+    assert log.read("h").dtype == np.arange(3).dtype
+    assert np.array_equal(log.read("h"), np.arange(3))
+    assert log.read("i") == [[1.0], [2.0, 3.0]]